@@ -189,6 +189,27 @@ static unsigned char Branched;
 // Branched - 1 if the instruction branched
 int OpCodes=2; // 1 = documented only, 2 = commonoly used undocumenteds, 3 = full set
 int BHardware=0; // 0 = all hardware, 1 = basic hardware only
+
+/* Co-processor scheduling.  Each co-processor is owed a fixed amount of work
+   per host instruction; the debt is paid off every CoProQuantum host
+   instructions, or straight away when the tube registers change state.  A
+   co-processor that hands back early keeps the rest of its debt, so the long
+   run clock ratio is the same as running it in lock-step (CoProQuantum=1) */
+#define ARM_PER_INSTRUCTION		4		// ARM instructions per host instruction
+#define MC68K_PER_INSTRUCTION	1		// 68k steps per host instruction
+#define I186_PER_INSTRUCTION	(12 * 4)	// 80186 cycles per host instruction
+
+int CoProQuantum=COPRO_DEFAULT_QUANTUM;
+static int CoProInstructions=0;		// Host instructions since the co-processors last ran
+static bool CoProBehind=false;		// A co-processor handed back with debt left
+static unsigned char CoProIntStatus=0;	// TubeintStatus and TubeNMIStatus when the
+static unsigned char CoProNMIStatus=0;	// co-processors last ran
+static int ArmDebt=0;
+static int MC68kDebt=0;
+#ifdef M512COPRO_ENABLED
+static int I186Debt=0;
+#endif
+unsigned int CoProExecuted[COPRO_COUNT];	// Free running, for the status line
 // 1 if first cycle happened
 
 /* Get a two byte address from the program counter, and then post inc the program counter */
@@ -1061,6 +1082,15 @@ void Init6502core(void) {
   intStatus=0;
   NMIStatus=0;
   NMILock=0;
+
+  /* Co-processors start with a clean slate too */
+  CoProInstructions=0;
+  CoProBehind=false;
+  CoProIntStatus=CoProNMIStatus=0;
+  ArmDebt=MC68kDebt=0;
+#ifdef M512COPRO_ENABLED
+  I186Debt=0;
+#endif
 } /* Init6502core */
 
 #include "via.h"
@@ -1138,6 +1168,83 @@ void MemoryDump6502(int addr, int count)
 	
 }
 
+/*-------------------------------------------------------------------------*/
+/* Pay off a 68k board's debt, returns true if it handed back early */
+template <class T> static bool RunMC68kCoPro(T *CoPro) {
+	unsigned int Cycles=CoPro->cpu->cyclesRun;
+	unsigned int Instructions=CoPro->cpu->instructionsRun;
+
+	CoPro->Exec(MC68kDebt);
+	MC68kDebt-=(int)(CoPro->cpu->cyclesRun - Cycles);
+	CoProExecuted[COPRO_MC68K]+=CoPro->cpu->instructionsRun - Instructions;
+	return MC68kDebt > 0;
+}
+
+/*-------------------------------------------------------------------------*/
+/* Run the co-processors for the host instructions since they last ran     */
+static void RunCoProcessors(void) {
+	int Executed;
+
+	TubeStateChanged=false;
+	CoProBehind=false;
+
+	if (Enable_Arm) {
+		ArmDebt+=CoProInstructions * ARM_PER_INSTRUCTION;
+		Executed=arm->exec(ArmDebt);
+		ArmDebt-=Executed;
+		CoProExecuted[COPRO_ARM]+=Executed;
+		CoProBehind|=(ArmDebt > 0);
+	}
+
+	if (mc68kTube_CiscOS || mc68kTube_Cumana || mc68kTube_Casper) {
+		MC68kDebt+=CoProInstructions * MC68K_PER_INSTRUCTION;
+		if (mc68kTube_CiscOS)
+			CoProBehind|=RunMC68kCoPro(obj_copro_ciscos);
+		else if (mc68kTube_Cumana)
+			CoProBehind|=RunMC68kCoPro(obj_copro_cumana);
+		else
+			CoProBehind|=RunMC68kCoPro(obj_copro_casper);
+	}
+
+#ifdef M512COPRO_ENABLED
+	if (Tube186Enabled) {
+		// i186_execute() doesn't watch the tube itself, so pay the debt off
+		// a host instruction's worth at a time and stop when it changes
+		I186Debt+=CoProInstructions * I186_PER_INSTRUCTION;
+		while (I186Debt > 0 && !TubeStateChanged) {
+			Executed=i186_execute(I186_PER_INSTRUCTION);
+			I186Debt-=Executed;
+			CoProExecuted[COPRO_I186]+=Executed;
+		}
+		CoProBehind|=(I186Debt > 0);
+	}
+#endif
+
+	CoProInstructions=0;
+	CoProIntStatus=TubeintStatus;
+	CoProNMIStatus=TubeNMIStatus;
+}
+
+/*-------------------------------------------------------------------------*/
+/* Build the co-processor part of the status line from the work done since */
+/* the last call, Ticks ms ago                                             */
+void CoProStatus(char *Text, unsigned int Ticks) {
+	static unsigned int LastExecuted[COPRO_COUNT];
+	static const char *Format[COPRO_COUNT] = {
+		"  ARM: %.2f MIPS", "  68k: %.2f MIPS", "  80186: %.2f MHz"
+	};
+	unsigned int Executed;
+	int CoPro;
+
+	Text[0]=0;
+	for (CoPro=0; CoPro<COPRO_COUNT; CoPro++) {
+		Executed=CoProExecuted[CoPro] - LastExecuted[CoPro];
+		LastExecuted[CoPro]=CoProExecuted[CoPro];
+		if (Executed != 0 && Ticks != 0)
+			sprintf(Text+strlen(Text), Format[CoPro], Executed / (Ticks * 1000.0));
+	}
+}
+
 /*-------------------------------------------------------------------------*/
 /* Execute one 6502 instruction, move program counter on                   */
 void Exec6502Instruction(void) {
@@ -1162,22 +1269,9 @@ void Exec6502Instruction(void) {
 
 		z80_execute();
 
-		if (Enable_Arm)
-			arm->exec(4);
-
-		if (mc68kTube_CiscOS)
-			obj_copro_ciscos->Exec(1);
-
-		if (mc68kTube_Cumana)
-			obj_copro_cumana->Exec(1);
-
-		if (mc68kTube_Casper)
-			obj_copro_casper->Exec(1);
-
-#ifdef M512COPRO_ENABLED
-		if (Tube186Enabled)
-			i186_execute(12 * 4);
-#endif
+		if (++CoProInstructions >= CoProQuantum || TubeStateChanged || CoProBehind ||
+			TubeintStatus != CoProIntStatus || TubeNMIStatus != CoProNMIStatus)
+			RunCoProcessors();
 
 		Branched=0;
 		iFlagJustCleared=false;
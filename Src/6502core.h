@@ -104,6 +104,13 @@ void AdjustForIOWrite(void);
 int i186_execute(int num_cycles);
 #endif
 
+/* Co-processor scheduling (see 6502core.cpp) */
+#define COPRO_DEFAULT_QUANTUM	64
+enum CoProTypes { COPRO_ARM, COPRO_MC68K, COPRO_I186, COPRO_COUNT };
+extern int CoProQuantum;
+extern unsigned int CoProExecuted[COPRO_COUNT];
+void CoProStatus(char *Text, unsigned int Ticks);
+
 extern int SwitchOnCycles; // Reset delay
 extern int OpCodes;
 extern int BHardware;
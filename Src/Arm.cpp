@@ -82,47 +82,13 @@ CArm::CArm()
 	// reset instruction execution counter
 	executionCount = 0;
 
+	// not profiling until asked to
+	profile = NULL;
+
 	// ??? profiling usage of different modes
 	previousProcessorMode = SVC_MODE;
 	modeCounter = 0;
 
-	// ??? profiling usage of different exceptions
-	if(dynamicProfilingExceptionFreq)
-	{
-		resetCounter = 0;
-		undefCounter = 0;
-		swiCounter = 0;
-		prefAbortCounter = 0;
-		dataAbortCounter = 0;
-		addrExcepCounter = 0;
-		irqCounter = 0;
-		fiqCounter = 0;
-		exceptionLastExecutionCount = 0;
-	}
-
-	if(dynamicProfilingRegisterUse)
-	{
-		for(int regNumber=0; regNumber<16; regNumber++)
-		{
-			registerGotCounter[regNumber] = 0;
-			registerSetCounter[regNumber] = 0;
-		}
-	}
-
-	if(dynamicProfilingConditionalExecution)
-	{
-		for(int condition=0; condition<16; condition++)
-		{
-			conditionallyExecuted[condition] =0;
-			conditionallyNotExecuted[condition] = 0;
-		}
-	}
-
-	if(dynamicProfilingCoprocessorUse)
-	{
-		lastCopro = 0;
-	}
-
 	iocounter = 0;
 	
 	modeTotal[USR_MODE] = 0;
@@ -163,6 +129,18 @@ CArm::CArm()
 	
 	memset(ramMemory, 0, 0x400000);
 	memcpy(ramMemory, romMemory, 0x4000);
+	flushBlockCache();
+
+	// RAM is mirrored through the first 16 MBytes, ROM sits at 0x3000000
+	memset(memoryRegions, 0, sizeof(memoryRegions));
+	for(int region=0; region<(0x1000000 >> ARM_REGION_SHIFT); region++)
+	{
+		memoryRegions[region].memory = ramMemory;
+		memoryRegions[region].limit = 0x400000;
+		memoryRegions[region].writable = TRUE;
+	}
+	memoryRegions[0x3000000 >> ARM_REGION_SHIFT].memory = romMemory;
+	memoryRegions[0x3000000 >> ARM_REGION_SHIFT].limit = 0x4000;
 
 	uint32 memoryValue = 0;
 	for(int x=0; x<4*11; x+=4)
@@ -173,12 +151,14 @@ CArm::CArm()
 	
 }
 
-void CArm::exec(int count)
+int CArm::exec(int count)
 {
 
 	uint32 ci;
 	char disassembly[256];
 	char addressS[64];
+	int executed = 0;
+	int ran;
 	
 	while (count > 0)
 	{
@@ -224,9 +204,24 @@ void CArm::exec(int count)
 //			trace = 100;
 //		}
 	
-		run();
-		count--;
+		// a cached block at a time, unless each instruction needs
+		// tracing or profiling
+		if (trace || profile)
+		{
+			run();
+			ran = 1;
+		}
+		else
+			ran = runBlock(count);
+		count -= ran;
+		executed += ran;
+
+		// hand back to the host as soon as the tube needs its attention
+		if (TubeStateChanged)
+			break;
 	}
+
+	return executed;
 }
 
 CArm::~CArm()
@@ -237,14 +232,7 @@ CArm::~CArm()
 	//modeInfo.Format("usr=%d fiq=%d irq=%d svc=%d \n", modeTotal[USR_MODE], modeTotal[FIQ_MODE], modeTotal[IRQ_MODE], modeTotal[SVC_MODE] );
 	//reportFile.WriteString(modeInfo);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequencyReport();
-
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsageReport();
-
-	if(dynamicProfilingConditionalExecution)
-		dynamicProfilingConditionalExeReport();
+	setProfiling(FALSE);
 }
 
 void CArm::run()
@@ -279,7 +267,7 @@ void CArm::run()
 		prefetchInvalid = FALSE;
 
 		// refill the pipeline by fetching into the prefetch instruction
-		if( !readWord(pc, prefetchInstruction) )
+		if( !fetchInstruction(pc, prefetchDecoded) )
 		{
 			exceptionDataAbort();
 			return;
@@ -288,9 +276,10 @@ void CArm::run()
 	}
 
 	// prefetched instruction becomes the current instruction
-	currentInstruction = prefetchInstruction;	
+	ArmDecoded current = prefetchDecoded;
+	currentInstruction = current.instruction;
 	// prefetch next instruction
-	if( !readWord(pc, prefetchInstruction) )
+	if( !fetchInstruction(pc, prefetchDecoded) )
 	{
 		exceptionPrefetchAbort();
 		return;
@@ -302,2494 +291,2647 @@ void CArm::run()
 	// increment total instruction executed counter
 	executionCount++;
 	
-	if(dynamicProfilingConditionalExecution)
-		dynamicProfilingConditionalExe(currentInstruction);
+	if(profile)
+		profileInstruction(currentInstruction);
 
 	// instruction condition codes match PSR so that instruction should be executed
-	if( executeConditionally(currentInstruction) )
+	if( conditionPassed(current.condition) )
+	{
+		// run the handler for the instruction's bits 20-27, picked when it
+		// was decoded. Undefined instructions skip the PC update below
+		if( !current.handler(this) )
+			return;
+	}
+
+	// handle PC incrementation (happens whether instruction conditionally executed or not)
+	// if prefetch invalidated
+	if(prefetchInvalid)
+	{
+		if( !refillPrefetch() )
+		{
+			exceptionPrefetchAbort();
+			return;
+		}
+	}
+	else
+	{
+		// else if prefetch ok
+		pc += 4;
+		setRegister( 15, getRegister(15) + 4 );
+	}
+
+	checkInterrupts();
+}
+
+// the pipeline after an instruction changed r15: start fetching from the new
+// PC, with r15 8 ahead of it. Returns FALSE if the fetch failed
+inline bool CArm::refillPrefetch()
+{
+	pc = getRegister(15);
+	// adjust PC but don't change prefetch
+	setRegister( 15, (getRegister(15) + 8) & PC_MASK );
+	
+	prefetchInvalid = FALSE;
+
+	if( !fetchInstruction(pc, prefetchDecoded) )
+		return FALSE;
+	pc += 4;
+	return TRUE;
+}
+
+// take any interrupt that is waiting, between instructions
+inline void CArm::checkInterrupts()
+{
+	if(TubeNMIStatus)
+	{
+		if (processorMode != FIQ_MODE)
+		{
+//			WriteLog("Entering FIQ Mode\n");
+			exceptionFastInterruptRequest();
+		}
+	}
+	else if(TubeintStatus & (1<<R1))
+	{
+		if (processorMode != IRQ_MODE)
+		{
+//			WriteLog("Entering IRQ Mode\n");
+			exceptionInterruptRequest();
+		}
+	}
+	else if(TubeintStatus & (1<<R4))
+	{
+		if (processorMode != IRQ_MODE)
+		{
+//			WriteLog("Entering IRQ Mode\n");
+			exceptionInterruptRequest();
+		}
+	}
+	
+	if(signals.all != 0)
+	{
+		if(signals.step_once)
+		{
+			//break;
+		}
+		if(signals.fast_interrupt)
+		{
+			exceptionFastInterruptRequest();
+		}
+		else if(signals.interrupt)
+		{
+			exceptionInterruptRequest();
+		}
+	}
+}
+
+// run instructions from block, starting at index and stopping before limit.
+// Each one is run as run() would, with r15 and the pc stepped along for it,
+// but straight from the block rather than through the prefetch. Stops early
+// after an instruction that changes the flow, the processor mode or the
+// tube, or that writes to the page the block came from, as the interrupt
+// checks or the rest of the block may then differ. Leaves index after the
+// last instruction run. Returns FALSE if that instruction skips the PC
+// update, like run() does for undefined instructions.
+// Blocks with no conditional instructions are run with Conditional FALSE,
+// so the condition check drops out of the loop
+template<bool Conditional>
+inline bool CArm::runInstructions(const ArmBlock *block, uint32& index, uint32 limit)
+{
+	const ArmDecoded *instruction;
+	uint mode = processorMode;
+
+	for(;;)
+	{
+		instruction = &block->instructions[index++];
+		currentInstruction = instruction->instruction;
+
+		if( !Conditional || conditionPassed(instruction->condition) )
+		{
+			if( !instruction->handler(this) )
+				return FALSE;
+		}
+
+		if( index == limit || prefetchInvalid || TubeStateChanged ||
+			processorMode != mode || block->length == 0 )
+			return TRUE;
+
+		pc += 4;
+		setRegister( 15, getRegister(15) + 4 );
+	}
+}
+
+// run up to count instructions from the cached block holding the current
+// one, then leave the pipeline and interrupts as run() would after the last.
+// Falls back to run() for one instruction if the pipeline needs refilling or
+// the current instruction isn't cached. Returns the instructions run
+int CArm::runBlock(int count)
+{
+	ArmBlock *block = fetchBlock;
+	uint32 length = block->length;
+	uint32 first = (pc - 4 - block->address) >> 2;
+	uint32 index = first;
+	uint32 limit;
+	bool completed;
+	int executed;
+
+	if( prefetchInvalid || first >= length )
+	{
+		run();
+		return 1;
+	}
+
+	limit = length;
+	if( (uint32) count < length - first )
+		limit = first + count;
+
+	if( block->conditional )
+		completed = runInstructions<TRUE>(block, index, limit);
+	else
+		completed = runInstructions<FALSE>(block, index, limit);
+
+	executed = index - first;
+	instr_count += executed;
+	executionCount += executed;
+
+	if( !completed )
+		return executed;
+
+	if(prefetchInvalid)
+	{
+		if( !refillPrefetch() )
+		{
+			exceptionPrefetchAbort();
+			return executed;
+		}
+	}
+	else
 	{
-		// decode instruction type from bits 20-27
-		switch( getField(currentInstruction, 20, 27) )
+		pc += 4;
+		setRegister( 15, getRegister(15) + 4 );
+
+		// the next instruction as it was when the block was built, as the
+		// prefetch would have read it before the last instruction ran
+		if( index < length )
+			prefetchDecoded = block->instructions[index];
+		else if( !fetchInstruction(pc - 4, prefetchDecoded) )
 		{
+			exceptionPrefetchAbort();
+			return executed;
+		}
+	}
+
+	checkInterrupts();
+	return executed;
+}
+
+//////////////////////////////////////////////////////////////////////
+// instruction handlers
+//////////////////////////////////////////////////////////////////////
+
+// the instruction in currentInstruction, for its bits 20-27. Operation is a
+// constant in each copy, so the switch folds down to the one case. Returns
+// FALSE for an undefined instruction, which mustn't be followed by the
+// usual PC update
+template<uint Operation>
+inline bool CArm::execute()
+{
+	switch( Operation )
+	{
 
-			// data processing instructions have operand 2 as register
+		// data processing instructions have operand 2 as register
 
-			// and rd, rn, rm
-			// mul rd, rm, rs
-			case 0x00:
+		// and rd, rn, rm
+		// mul rd, rm, rs
+		case 0x00:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// mul rd, rm, rs
-					performMul();
-				}
-				else
-				{
-					// and rd, rn, rm
-					setDestination( andOperator(getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2()) );
-				}
-				break;
+				// mul rd, rm, rs
+				performMul();
 			}
-			// andS rd, rn, rm
-			// mulS rd, rm, rs
-			case 0x01:
+			else
 			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// mulS rd, rm, rs
-					performMulS();
-				}
-				else
-				{
-					// andS rd, rn, rm
-					setDestinationS( andOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S()) ); 
-				}
-				break;
+				// and rd, rn, rm
+				setDestination( andOperator(getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2()) );
 			}
-			// eor rd, rn, rm
-			// mla rd, rm, rs
-			case 0x02:
+			break;
+		}
+		// andS rd, rn, rm
+		// mulS rd, rm, rs
+		case 0x01:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// mla rd, rm, rs
-					performMla();
-				}
-				else
-				{
-					// eor rd, rn, rm
-					setDestination( eorOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				}
-				break;
+				// mulS rd, rm, rs
+				performMulS();
 			}
-			// eorS rd, rn, rm
-			// mlaS rd, rm, rs
-			case 0x03:
+			else
 			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// mlaS rd, rm, rs
-					performMlaS();
-				}
-				else
-				{
-					// eorS rd, rn, rm
-					setDestinationS( eorOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() ) );
-				}
-				break;
+				// andS rd, rn, rm
+				setDestinationS( andOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S()) ); 
 			}
-			// sub rd, rn, rm 
-			case 0x04:
+			break;
+		}
+		// eor rd, rn, rm
+		// mla rd, rm, rs
+		case 0x02:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				setDestination( subOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// mla rd, rm, rs
+				performMla();
 			}
-			// subS rd, rn, rm
-			case 0x05:
+			else
 			{
-				setDestinationS( subOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// eor rd, rn, rm
+				setDestination( eorOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
 			}
-			// rsb rd, rn, rm 
-			case 0x06:
+			break;
+		}
+		// eorS rd, rn, rm
+		// mlaS rd, rm, rs
+		case 0x03:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				// note reversal of operand 1 and 2
-				setDestination( subOperator( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
-				break;
+				// mlaS rd, rm, rs
+				performMlaS();
 			}
-			// rsbS rd, rn, rm
-			case 0x07:
+			else
 			{
-				setDestinationS( subOperatorS( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
-				break;
+				// eorS rd, rn, rm
+				setDestinationS( eorOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() ) );
 			}
-			// add rd, rn, rm 
-			case 0x08:
+			break;
+		}
+		// sub rd, rn, rm 
+		case 0x04:
+		{
+			setDestination( subOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// subS rd, rn, rm
+		case 0x05:
+		{
+			setDestinationS( subOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// rsb rd, rn, rm 
+		case 0x06:
+		{
+			// note reversal of operand 1 and 2
+			setDestination( subOperator( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
+			break;
+		}
+		// rsbS rd, rn, rm
+		case 0x07:
+		{
+			setDestinationS( subOperatorS( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
+			break;
+		}
+		// add rd, rn, rm 
+		case 0x08:
+		{
+			setDestination( addOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// addS rd, rn, rm
+		case 0x09:
+		{
+			setDestinationS( addOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// adc rd, rn, rm
+		case 0x0A:
+		{
+			setDestination( adcOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// adcS rd, rn, rm
+		case 0x0B:
+		{
+			setDestinationS( adcOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// sbc rd, rn, rm 
+		case 0x0C:
+		{
+			setDestination( sbcOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// sbcS rd, rn, rm
+		case 0x0D:
+		{
+			setDestinationS( sbcOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// rsc rd, rn, rm
+		case 0x0E:
+		{
+			setDestination( sbcOperator( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
+			break;
+		}
+		// rscS rd, rn, rm
+		case 0x0F:
+		{
+			setDestinationS( sbcOperatorS( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
+			break;
+		}
+		// tst rd, rn, rm
+		// swp rd, rn, rm
+		case 0x10:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				setDestination( addOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// swp rd, rn, rm
+				performSingleDataSwapWord();
 			}
-			// addS rd, rn, rm
-			case 0x09:
+			else
 			{
-				setDestinationS( addOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// tst rd, rn, rm
+				// S flag (bit 20) not set so NOP
+				// ARM6 = MRS
 			}
-			// adc rd, rn, rm
-			case 0x0A:
+			break;
+		}
+		// tstP (PSR), rn, rm
+		// tst rn, rm
+		case 0x11:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				setDestination( adcOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// tstP (PSR), rn, rm
+				// updates entire PSR (if in user mode then just condition flags)
+				setProcessorStatusRegister( andOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
 			}
-			// adcS rd, rn, rm
-			case 0x0B:
+			else
 			{
-				setDestinationS( adcOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// tst rn, rm
+				// updates only condition flags
+				(void)andOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() );
 			}
-			// sbc rd, rn, rm 
-			case 0x0C:
+			break;
+		}
+		// teq rd, rn, rm
+		case 0x12:
+		{
+			// S flag (bit 20) not set so NOP
+			// ARM6 - MSR
+			break;
+		}
+		// teqP (PSR), rn, rm 
+		// teq rn, rm
+		case 0x13:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				setDestination( sbcOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// teqP (PSR), rn, rm
+				setProcessorStatusRegister( eorOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
 			}
-			// sbcS rd, rn, rm
-			case 0x0D:
+			else
 			{
-				setDestinationS( sbcOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
+				// teq rn, rm
+				(void)eorOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() );
 			}
-			// rsc rd, rn, rm
-			case 0x0E:
+			break;
+		}
+		// swp rd, rn, rm
+		// cmp rd, rn, rm - NOP
+		case 0x14:
+		{
+			if( isExtendedInstruction(currentInstruction) )
 			{
-				setDestination( sbcOperator( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
-				break;
+				// swp rd, rn, rm
+				performSingleDataSwapByte();
 			}
-			// rscS rd, rn, rm
-			case 0x0F:
+			else
 			{
-				setDestinationS( sbcOperatorS( getDataProcessingRegisterOperand2(), getDataProcessingRegisterOperand1() ) );
-				break;
+				// cmp rd, rn, rm
+				// S flag (bit 20) not set so NOP
+				// ARM6 - MRS
 			}
-			// tst rd, rn, rm
-			// swp rd, rn, rm
-			case 0x10:
+			break;
+		}
+		// cmpP (PSR), rn, rm
+		// cmp rn, rm
+		case 0x15:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// swp rd, rn, rm
-					performSingleDataSwapWord();
-				}
-				else
-				{
-					// tst rd, rn, rm
-					// S flag (bit 20) not set so NOP
-					// ARM6 = MRS
-				}
-				break;
+				// cmpP (PSR), rn, rm
+				setProcessorStatusRegister( subOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
 			}
-			// tstP (PSR), rn, rm
-			// tst rn, rm
-			case 0x11:
+			else
 			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// tstP (PSR), rn, rm
-					// updates entire PSR (if in user mode then just condition flags)
-					setProcessorStatusRegister( andOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				}
-				else
-				{
-					// tst rn, rm
-					// updates only condition flags
-					(void)andOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() );
-				}
-				break;
+				// cmp rn, rm
+				(void)subOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() );
 			}
-			// teq rd, rn, rm
-			case 0x12:
+			break;
+			
+		}
+		// cmn rd, rn, rm - NOP
+		case 0x16:
+		{
+			// S flag (bit 20) not set so NOP
+			// ARM6 - MSR
+			break;
+		}
+		// cmnP (PSR), rn, rm 
+		// cmn rn, rm
+		case 0x17:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				// S flag (bit 20) not set so NOP
-				// ARM6 - MSR
-				break;
+				// cmnP (PSR), rn, rm
+				setProcessorStatusRegister( addOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
 			}
-			// teqP (PSR), rn, rm 
-			// teq rn, rm
-			case 0x13:
+			else
 			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// teqP (PSR), rn, rm
-					setProcessorStatusRegister( eorOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				}
-				else
-				{
-					// teq rn, rm
-					(void)eorOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() );
-				}
-				break;
-			}
-			// swp rd, rn, rm
-			// cmp rd, rn, rm - NOP
-			case 0x14:
-			{
-				if( isExtendedInstruction(currentInstruction) )
-				{
-					// swp rd, rn, rm
-					performSingleDataSwapByte();
-				}
-				else
-				{
-					// cmp rd, rn, rm
-					// S flag (bit 20) not set so NOP
-					// ARM6 - MRS
-				}
-				break;
-			}
-			// cmpP (PSR), rn, rm
-			// cmp rn, rm
-			case 0x15:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// cmpP (PSR), rn, rm
-					setProcessorStatusRegister( subOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				}
-				else
-				{
-					// cmp rn, rm
-					(void)subOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() );
-				}
-				break;
-				
-			}
-			// cmn rd, rn, rm - NOP
-			case 0x16:
-			{
-				// S flag (bit 20) not set so NOP
-				// ARM6 - MSR
-				break;
-			}
-			// cmnP (PSR), rn, rm 
-			// cmn rn, rm
-			case 0x17:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// cmnP (PSR), rn, rm
-					setProcessorStatusRegister( addOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				}
-				else
-				{
-					// cmn rn, rm
-					(void)addOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() );
-				}
-				break;
+				// cmn rn, rm
+				(void)addOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() );
 			}
-			// orr rd, rn, rm 
-			case 0x18:
-			{
-				setDestination( orrOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
-				break;
-			}
-			// orrS rd, rn, rm
-			case 0x19:
-			{
-				setDestinationS( orrOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() ) );
-				break;
-			}
-			// mov rd, rn, rm		(rn is ignored)
-			case 0x1A:
-			{
-				setDestination( getDataProcessingRegisterOperand2() );
+			break;
+		}
+		// orr rd, rn, rm 
+		case 0x18:
+		{
+			setDestination( orrOperator( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// orrS rd, rn, rm
+		case 0x19:
+		{
+			setDestinationS( orrOperatorS( getDataProcessingRegisterOperand1(), getDataProcessingRegisterOperand2S() ) );
+			break;
+		}
+		// mov rd, rn, rm		(rn is ignored)
+		case 0x1A:
+		{
+			setDestination( getDataProcessingRegisterOperand2() );
 
-				// ??? remove keepRunning - for simple code only
-				// checks for mov pc,r14
-				//if(currentInstruction == 0xE1A0F00E)
-				//	keepRunning = FALSE;
-				break;
-			}
-			// movS rd, rn, rm
-			case 0x1B:
-			{
-				uint32 value = getDataProcessingRegisterOperand2S();
-				updateNZFlags( value );
-				setDestinationS( value );
-				break;
-			}
-			// bic rd, rn, rm 
-			case 0x1C:
-			{
-				// and with inverted operand2
-				setDestination( andOperator( getDataProcessingRegisterOperand1(), ~getDataProcessingRegisterOperand2() ) );
-				break;
-			}
-			// bicS rd, rn, rm
-			case 0x1D:
-			{
-				setDestinationS( andOperatorS( getDataProcessingRegisterOperand1(), ~getDataProcessingRegisterOperand2S() ) );
-				break;
-			}
-			// mvn rd, rn, rm 
-			case 0x1E:
-			{
-				setDestination( ~getDataProcessingRegisterOperand2() );
-				break;
-			}
-			// mvnS rd, rn, rm
-			case 0x1F:
-			{
-				uint32 value = ~getDataProcessingRegisterOperand2S();
-				updateNZFlags( value );
-				setDestinationS( value );
-				break;
-			}
+			// ??? remove keepRunning - for simple code only
+			// checks for mov pc,r14
+			//if(currentInstruction == 0xE1A0F00E)
+			//	keepRunning = FALSE;
+			break;
+		}
+		// movS rd, rn, rm
+		case 0x1B:
+		{
+			uint32 value = getDataProcessingRegisterOperand2S();
+			updateNZFlags( value );
+			setDestinationS( value );
+			break;
+		}
+		// bic rd, rn, rm 
+		case 0x1C:
+		{
+			// and with inverted operand2
+			setDestination( andOperator( getDataProcessingRegisterOperand1(), ~getDataProcessingRegisterOperand2() ) );
+			break;
+		}
+		// bicS rd, rn, rm
+		case 0x1D:
+		{
+			setDestinationS( andOperatorS( getDataProcessingRegisterOperand1(), ~getDataProcessingRegisterOperand2S() ) );
+			break;
+		}
+		// mvn rd, rn, rm 
+		case 0x1E:
+		{
+			setDestination( ~getDataProcessingRegisterOperand2() );
+			break;
+		}
+		// mvnS rd, rn, rm
+		case 0x1F:
+		{
+			uint32 value = ~getDataProcessingRegisterOperand2S();
+			updateNZFlags( value );
+			setDestinationS( value );
+			break;
+		}
 
-			// data processing instructions have operand 2 as an immediate value
+		// data processing instructions have operand 2 as an immediate value
 
-			// and rd, rn, imm
-			case 0x20:
-			{
-				setDestination( andOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// andS rd, rn, imm
-			case 0x21:
-			{
-				setDestinationS( andOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
-				break;
-			}
-			// eor rd, rn, imm
-			case 0x22:
-			{
-				setDestination( eorOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// eorS rd, rn, imm
-			case 0x23:
-			{
-				setDestinationS( eorOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
-				break;
-			}
-			// sub rd, rn, imm 
-			case 0x24:
-			{
-				setDestination( subOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// subS rd, rn, imm
-			case 0x25:
-			{
-				setDestinationS( subOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// rsb rd, rn, imm 
-			case 0x26:
-			{
-				setDestination( subOperator( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
-				break;
-			}
-			// rsbS rd, rn, imm 
-			case 0x27:
-			{
-				setDestinationS( subOperatorS( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
-				break;
-			}
-			// add rd, rn, imm 
-			case 0x28:
-			{
-				setDestination( addOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// addS rd, rn, imm 
-			case 0x29:
-			{
-				setDestinationS( addOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// adc rd, rn, imm
-			case 0x2A:
-			{
-				setDestination( adcOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// adcS rd, rn, imm
-			case 0x2B:
-			{
-				setDestinationS( adcOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// sbc rd, rn, imm
-			case 0x2C:
-			{
-				setDestination( sbcOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// sbcS rd, rn, imm
-			case 0x2D:
-			{
-				setDestinationS( sbcOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// rsc rd, rn, imm
-			case 0x2E:
-			{
-				setDestination( sbcOperator( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
-				break;
-			}
-			// rscS rd, rn, imm
-			case 0x2F:
-			{
-				setDestinationS( sbcOperatorS( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
-				break;
-			}
-			// tst rd, rn, imm
-			case 0x30:
-			{
-				// S flag (bit 20) not set so NOP
-				break;
-			}
-			// tstP (PSR), rn, imm
-			// tst rn, imm
-			case 0x31:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// tstP (PSR), rn, imm
-					setProcessorStatusRegister( andOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				}
-				else
-				{
-					// tst rn, imm
-					(void)andOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() );
-				}
-			}
-			// teq rd, rn, imm
-			case 0x32:
-			{
-				// S flag (bit 20) not set so NOP
-				break;
-			}
-			// teqP (PSR), rn, imm
-			// teq rn, imm
-			case 0x33:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// tstP (PSR), rn, imm
-					setProcessorStatusRegister( eorOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				}
-				else
-				{
-					// tst rn, imm
-					(void)eorOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ); 
-				}
-
-				break;
-			}
-			// cmp rd, rn, imm
-			case 0x34:
-			{
-				// S flag (bit 20) not set so NOP
-				break;
-			}
-			// cmpP (PSR), rn, imm
-			// cmp rn, imm
-			case 0x35:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// cmpP (PSR), rn, imm
-					setProcessorStatusRegister( subOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				}
-				else
-				{
-					// cmp rn, imm
-					(void)subOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() );
-				}
-				break;
-			}
-			// cmn rd, rn, imm
-			case 0x36:
-			{
-				// S flag (bit 20) not set so NOP
-				break;
-			}
-			// cmnP (PSR), rn, imm 
-			// cmn rn, imm
-			case 0x37:
-			{
-				uint rd = getField(currentInstruction, 12, 15);
-				if( rd == 15 )
-				{
-					// cmnP (PSR), rn, imm
-					setProcessorStatusRegister( addOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				}
-				else
-				{
-					// cmn rn, imm
-					(void)addOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() );
-				}
-				break;
-			}
-			// orr rd, rn, imm
-			case 0x38:
-			{
-				setDestination( orrOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
-				break;
-			}
-			// orrS rd, rn, imm
-			case 0x39:
-			{
-				setDestinationS( orrOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
-				break;
-			}
-			// mov rd, rn, imm		(rn is ignored)
-			case 0x3A:
-			{
-				// literally just fetch operand and set the destination to it 
-				setDestination( getDataProcessingImmediateOperand2() );
-				break;
-			}
-			// movS rd, rn, imm
-			case 0x3B:
-			{
-				uint32 value = getDataProcessingImmediateOperand2S();
-				updateNZFlags(value);
-				setDestinationS( value );
-				break;
-			}
-			// bic rd, rn, imm
-			case 0x3C:
+		// and rd, rn, imm
+		case 0x20:
+		{
+			setDestination( andOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// andS rd, rn, imm
+		case 0x21:
+		{
+			setDestinationS( andOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
+			break;
+		}
+		// eor rd, rn, imm
+		case 0x22:
+		{
+			setDestination( eorOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// eorS rd, rn, imm
+		case 0x23:
+		{
+			setDestinationS( eorOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
+			break;
+		}
+		// sub rd, rn, imm 
+		case 0x24:
+		{
+			setDestination( subOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// subS rd, rn, imm
+		case 0x25:
+		{
+			setDestinationS( subOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// rsb rd, rn, imm 
+		case 0x26:
+		{
+			setDestination( subOperator( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
+			break;
+		}
+		// rsbS rd, rn, imm 
+		case 0x27:
+		{
+			setDestinationS( subOperatorS( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
+			break;
+		}
+		// add rd, rn, imm 
+		case 0x28:
+		{
+			setDestination( addOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// addS rd, rn, imm 
+		case 0x29:
+		{
+			setDestinationS( addOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// adc rd, rn, imm
+		case 0x2A:
+		{
+			setDestination( adcOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// adcS rd, rn, imm
+		case 0x2B:
+		{
+			setDestinationS( adcOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// sbc rd, rn, imm
+		case 0x2C:
+		{
+			setDestination( sbcOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// sbcS rd, rn, imm
+		case 0x2D:
+		{
+			setDestinationS( sbcOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// rsc rd, rn, imm
+		case 0x2E:
+		{
+			setDestination( sbcOperator( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
+			break;
+		}
+		// rscS rd, rn, imm
+		case 0x2F:
+		{
+			setDestinationS( sbcOperatorS( getDataProcessingImmediateOperand2(), getDataProcessingImmediateOperand1() ) );
+			break;
+		}
+		// tst rd, rn, imm
+		case 0x30:
+		{
+			// S flag (bit 20) not set so NOP
+			break;
+		}
+		// tstP (PSR), rn, imm
+		// tst rn, imm
+		case 0x31:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				setDestination( andOperator( getDataProcessingImmediateOperand1(), ~getDataProcessingImmediateOperand2() ) );
-				break;
+				// tstP (PSR), rn, imm
+				setProcessorStatusRegister( andOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
 			}
-			// bicS rd, rn, imm
-			case 0x3D:
+			else
 			{
-				setDestinationS( andOperatorS( getDataProcessingImmediateOperand1(), ~getDataProcessingImmediateOperand2S() ) );
-				break;
+				// tst rn, imm
+				(void)andOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() );
 			}
-			// mvn rd, rn, imm
-			case 0x3E:
+		}
+		// teq rd, rn, imm
+		case 0x32:
+		{
+			// S flag (bit 20) not set so NOP
+			break;
+		}
+		// teqP (PSR), rn, imm
+		// teq rn, imm
+		case 0x33:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				setDestination( ~getDataProcessingImmediateOperand2() );
-				break;
+				// tstP (PSR), rn, imm
+				setProcessorStatusRegister( eorOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
 			}
-			// mvnS rd, rn, imm
-			case 0x3F:
+			else
 			{
-				uint32 value = ~getDataProcessingImmediateOperand2S();
-				updateNZFlags(value);
-				setDestinationS(value);
-				break;
+				// tst rn, imm
+				(void)eorOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ); 
 			}
 
-			// single data transfer immediate
-
-			// str rd, [rn], -imm
-			case 0x40:
+			break;
+		}
+		// cmp rd, rn, imm
+		case 0x34:
+		{
+			// S flag (bit 20) not set so NOP
+			break;
+		}
+		// cmpP (PSR), rn, imm
+		// cmp rn, imm
+		case 0x35:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				// if str performed ok
-				if( performDataTransferStoreWord(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-				}
-				break;
+				// cmpP (PSR), rn, imm
+				setProcessorStatusRegister( subOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
 			}
-			// ldr rd, [rn], -imm
-			case 0x41:
+			else
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				uint32 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadWord(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// cmp rn, imm
+				(void)subOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() );
 			}
-			// strT rd, [rn], -imm
-			case 0x42:
+			break;
+		}
+		// cmn rd, rn, imm
+		case 0x36:
+		{
+			// S flag (bit 20) not set so NOP
+			break;
+		}
+		// cmnP (PSR), rn, imm 
+		// cmn rn, imm
+		case 0x37:
+		{
+			uint rd = getField(currentInstruction, 12, 15);
+			if( rd == 15 )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				clearTrans();
-
-				// if str performed ok
-				if( performDataTransferStoreWord(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-				}
-
-				if(processorMode != USR_MODE)
-				{
-					setTrans();
-				}
-
-				break;
+				// cmnP (PSR), rn, imm
+				setProcessorStatusRegister( addOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
 			}
-			// ldrT rd, [rn], -imm
-			case 0x43:
+			else
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				clearTrans();
-
-				uint32 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadWord(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-					
-					if(processorMode != USR_MODE)
-					{
-						setTrans();
-					}
-					
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// cmn rn, imm
+				(void)addOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() );
 			}
-			// strB rd, [rn], -imm
-			case 0x44:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				// storeValue get cast to uint8 when written to memory
+			break;
+		}
+		// orr rd, rn, imm
+		case 0x38:
+		{
+			setDestination( orrOperator( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// orrS rd, rn, imm
+		case 0x39:
+		{
+			setDestinationS( orrOperatorS( getDataProcessingImmediateOperand1(), getDataProcessingImmediateOperand2S() ) );
+			break;
+		}
+		// mov rd, rn, imm		(rn is ignored)
+		case 0x3A:
+		{
+			// literally just fetch operand and set the destination to it 
+			setDestination( getDataProcessingImmediateOperand2() );
+			break;
+		}
+		// movS rd, rn, imm
+		case 0x3B:
+		{
+			uint32 value = getDataProcessingImmediateOperand2S();
+			updateNZFlags(value);
+			setDestinationS( value );
+			break;
+		}
+		// bic rd, rn, imm
+		case 0x3C:
+		{
+			setDestination( andOperator( getDataProcessingImmediateOperand1(), ~getDataProcessingImmediateOperand2() ) );
+			break;
+		}
+		// bicS rd, rn, imm
+		case 0x3D:
+		{
+			setDestinationS( andOperatorS( getDataProcessingImmediateOperand1(), ~getDataProcessingImmediateOperand2S() ) );
+			break;
+		}
+		// mvn rd, rn, imm
+		case 0x3E:
+		{
+			setDestination( ~getDataProcessingImmediateOperand2() );
+			break;
+		}
+		// mvnS rd, rn, imm
+		case 0x3F:
+		{
+			uint32 value = ~getDataProcessingImmediateOperand2S();
+			updateNZFlags(value);
+			setDestinationS(value);
+			break;
+		}
 
-				// if str performed ok
-				if( performDataTransferStoreByte(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-				}
+		// single data transfer immediate
 
-				break;
-			}
-			// ldrB rd, [rn], -imm
-			case 0x45:
+		// str rd, [rn], -imm
+		case 0x40:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			
+			// if str performed ok
+			if( performDataTransferStoreWord(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				uint8 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadByte(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
 			}
-			// strBT rd, [rn], -imm
-			case 0x46:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				clearTrans();
-
-				// if str performed ok
-				if( performDataTransferStoreByte(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-				}
-
-				if(processorMode != USR_MODE)
-				{
-					setTrans();
-				}
+			break;
+		}
+		// ldr rd, [rn], -imm
+		case 0x41:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
 
-				break;
-			}
-			// ldrBT rd, [rn], -imm
-			case 0x47:
+			uint32 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadWord(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				clearTrans();
-
-				uint8 location;
-				// if str performed ok
-				if( performDataTransferLoadByte(baseAddress, location) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
-				
-					if(processorMode != USR_MODE)
-					{
-						setTrans();
-					}
-				
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
+				// set register value
+				setRegisterWithPrefetch(rd, location);
 			}
+			break;
+		}
+		// strT rd, [rn], -imm
+		case 0x42:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
 			
-			// repeats opcodes 0x40 - 0x47 except that immediate offset is added rather
-			// than subtracted from the base register
+			clearTrans();
 
-			// str rd, [rn], imm
-			case 0x48:
+			// if str performed ok
+			if( performDataTransferStoreWord(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				// if str performed ok
-				if( performDataTransferStoreWord(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-				}
-				break;
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
 			}
-			// ldr rd, [rn], imm
-			case 0x49:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
 
-				uint32 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadWord(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
-			}
-			// strT rd, [rn], imm
-			case 0x4A:
+			if(processorMode != USR_MODE)
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				clearTrans();
+				setTrans();
+			}
 
-				// if str performed ok
-				if( performDataTransferStoreWord(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-				}
+			break;
+		}
+		// ldrT rd, [rn], -imm
+		case 0x43:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
+
+			clearTrans();
 
+			uint32 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadWord(baseAddress, location) )
+			{
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
+				
 				if(processorMode != USR_MODE)
 				{
 					setTrans();
 				}
-				break;
+				
+				// set register value
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldrT rd, [rn], imm
-			case 0x4B:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				clearTrans();
+			break;
+		}
+		// strB rd, [rn], -imm
+		case 0x44:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			// storeValue get cast to uint8 when written to memory
 
-				uint32 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadWord(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-					
-					if(processorMode != USR_MODE)
-					{
-						setTrans();
-					}
-					
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
-			}
-			// strB rd, [rn], imm
-			case 0x4C:
+			// if str performed ok
+			if( performDataTransferStoreByte(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				// storeValue get cast to uint8 when written to memory
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
+			}
 
-				// if str performed ok
-				if( performDataTransferStoreByte(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-				}
+			break;
+		}
+		// ldrB rd, [rn], -imm
+		case 0x45:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
 
-				break;
-			}
-			// ldrB rd, [rn], imm
-			case 0x4D:
+			uint8 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadByte(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address
-				uint32 baseAddress = getRegister( rn );	// get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
+				// set register value
+				setRegisterWithPrefetch(rd, location);
+			}
+			break;
+		}
+		// strBT rd, [rn], -imm
+		case 0x46:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			
+			clearTrans();
 
-				uint8 location;
-				// if not problems loading word from memory
-				if( performDataTransferLoadByte(baseAddress, location) )
-				{
-					// update base address
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-					// set register value
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+			// if str performed ok
+			if( performDataTransferStoreByte(baseAddress, storeValue) )
+			{
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
 			}
-			// strBT rd, [rn], imm
-			case 0x4E:
+
+			if(processorMode != USR_MODE)
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get value to store from rd
-				uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
-				
-				clearTrans();
+				setTrans();
+			}
 
-				// if str performed ok
-				if( performDataTransferStoreByte(baseAddress, storeValue) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-				}
+			break;
+		}
+		// ldrBT rd, [rn], -imm
+		case 0x47:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
+
+			clearTrans();
 
+			uint8 location;
+			// if str performed ok
+			if( performDataTransferLoadByte(baseAddress, location) )
+			{
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress - getDataTransferValueImmediate() );
+			
 				if(processorMode != USR_MODE)
 				{
 					setTrans();
 				}
-
-				break;
+			
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldrBT rd, [rn], imm
-			case 0x4F:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint32 baseAddress = getRegister( rn ); // get base address from rn
-				// get register to load into
-				uint rd = getField(currentInstruction, 12, 15);
-
-				clearTrans();
+			break;
+		}
+		
+		// repeats opcodes 0x40 - 0x47 except that immediate offset is added rather
+		// than subtracted from the base register
 
-				uint8 location;
-				// if str performed ok
-				if( performDataTransferLoadByte(baseAddress, location) )
-				{
-					// then update base register
-					setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
-				
-					if(processorMode != USR_MODE)
-					{
-						setTrans();
-					}
-				
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+		// str rd, [rn], imm
+		case 0x48:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			
+			// if str performed ok
+			if( performDataTransferStoreWord(baseAddress, storeValue) )
+			{
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
 			}
+			break;
+		}
+		// ldr rd, [rn], imm
+		case 0x49:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
 
-			// str rd, [rn, -imm]
-			case 0x50:
+			uint32 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadWord(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreWord( getRegister(rn) - getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
+				// set register value
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldr rd, [rn, -imm]
-			case 0x51:
+			break;
+		}
+		// strT rd, [rn], imm
+		case 0x4A:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint32 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			
+			clearTrans();
+
+			// if str performed ok
+			if( performDataTransferStoreWord(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 location;
-				if( performDataTransferLoadWord( getRegister(rn) - getDataTransferValueImmediate(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
 			}
-			// str rd, [rn, -imm]!
-			// ! means write back the index-adjusted address to the base register
-			case 0x52:
+
+			if(processorMode != USR_MODE)
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) - getDataTransferValueImmediate();
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setTrans();
 			}
-			// ldr rd, [rn, -imm]!
-			case 0x53:
+			break;
+		}
+		// ldrT rd, [rn], imm
+		case 0x4B:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
+
+			clearTrans();
+
+			uint32 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadWord(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) - getDataTransferValueImmediate();
-				uint32 location;
-				if( performDataTransferLoadWord( address, location ) )
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
+				
+				if(processorMode != USR_MODE)
 				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
+					setTrans();
 				}
-				break;
+				
+				// set register value
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn, -imm]
-			case 0x54:
+			break;
+		}
+		// strB rd, [rn], imm
+		case 0x4C:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			// storeValue get cast to uint8 when written to memory
+
+			// if str performed ok
+			if( performDataTransferStoreByte(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreByte( getRegister(rn) - getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
 			}
-			// ldrB rd, [rn, -imm]
-			case 0x55:
+
+			break;
+		}
+		// ldrB rd, [rn], imm
+		case 0x4D:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address
+			uint32 baseAddress = getRegister( rn );	// get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
+
+			uint8 location;
+			// if not problems loading word from memory
+			if( performDataTransferLoadByte(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint8 location;
-				if( performDataTransferLoadByte( getRegister(rn) - getDataTransferValueImmediate(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// update base address
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
+				// set register value
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn, -imm]!
-			case 0x56:
+			break;
+		}
+		// strBT rd, [rn], imm
+		case 0x4E:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get value to store from rd
+			uint8 storeValue = getRegisterWithPSRAndPipelining( getField(currentInstruction, 12, 15));
+			
+			clearTrans();
+
+			// if str performed ok
+			if( performDataTransferStoreByte(baseAddress, storeValue) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) - getDataTransferValueImmediate();
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
 			}
-			// ldrB rd, [rn, -imm]!
-			case 0x57:
+
+			if(processorMode != USR_MODE)
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) - getDataTransferValueImmediate();
-				uint8 location;
-				if( performDataTransferLoadByte( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setTrans();
 			}
 
-			// repeat of 0x50 - 0x57 but adding rather than subtracting the offset
+			break;
+		}
+		// ldrBT rd, [rn], imm
+		case 0x4F:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint32 baseAddress = getRegister( rn ); // get base address from rn
+			// get register to load into
+			uint rd = getField(currentInstruction, 12, 15);
 
-			// str rd, [rn, imm]
-			case 0x58:
-			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreWord( getRegister(rn) + getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
-				break;
-			}
-			// ldr rd, [rn, imm]
-			case 0x59:
+			clearTrans();
+
+			uint8 location;
+			// if str performed ok
+			if( performDataTransferLoadByte(baseAddress, location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 location;
-				if( performDataTransferLoadWord( getRegister(rn) + getDataTransferValueImmediate(), location) )
+				// then update base register
+				setRegisterWithPrefetch(rn, baseAddress + getDataTransferValueImmediate() );
+			
+				if(processorMode != USR_MODE)
 				{
-					setRegisterWithPrefetch(rd, location);
+					setTrans();
 				}
-				break;
+			
+				setRegisterWithPrefetch(rd, location);
 			}
-			// str rd, [rn, imm]!
-			case 0x5A:
+			break;
+		}
+
+		// str rd, [rn, -imm]
+		case 0x50:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreWord( getRegister(rn) - getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldr rd, [rn, -imm]
+		case 0x51:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 location;
+			if( performDataTransferLoadWord( getRegister(rn) - getDataTransferValueImmediate(), location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) + getDataTransferValueImmediate();
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldr rd, [rn, imm]!
-			case 0x5B:
+			break;
+		}
+		// str rd, [rn, -imm]!
+		// ! means write back the index-adjusted address to the base register
+		case 0x52:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) - getDataTransferValueImmediate();
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) + getDataTransferValueImmediate();
-				uint32 location;
-				if( performDataTransferLoadWord( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// strB rd, [rn, imm]
-			case 0x5C:
+			break;
+		}
+		// ldr rd, [rn, -imm]!
+		case 0x53:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) - getDataTransferValueImmediate();
+			uint32 location;
+			if( performDataTransferLoadWord( address, location ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreByte( getRegister(rn) + getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldrB rd, [rn, imm]
-			case 0x5D:
+			break;
+		}
+		// strB rd, [rn, -imm]
+		case 0x54:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreByte( getRegister(rn) - getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldrB rd, [rn, -imm]
+		case 0x55:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint8 location;
+			if( performDataTransferLoadByte( getRegister(rn) - getDataTransferValueImmediate(), location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint8 location;
-				if( performDataTransferLoadByte( getRegister(rn) + getDataTransferValueImmediate(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn, imm]!
-			case 0x5E:
+			break;
+		}
+		// strB rd, [rn, -imm]!
+		case 0x56:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) - getDataTransferValueImmediate();
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) + getDataTransferValueImmediate();
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// ldrB rd, [rn, imm]!
-			case 0x5F:
+			break;
+		}
+		// ldrB rd, [rn, -imm]!
+		case 0x57:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) - getDataTransferValueImmediate();
+			uint8 location;
+			if( performDataTransferLoadByte( address, location ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) + getDataTransferValueImmediate();
-				uint8 location;
-				if( performDataTransferLoadByte( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
+			break;
+		}
 
-			// single data transfer register
-			// in every case, if bit 4 is set then throw undefined instruction exception
-
-			// str rd, [rn], -reg
-			// implicit write back
-			case 0x60:
-			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-				}
-				break;
-			}
-			// ldr rd, [rn], -reg
-			case 0x61:
-			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint32 location;
-				if( performDataTransferLoadWord( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
-			}
-			// strT rd, [rn],-reg
-			case 0x62:
-			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-			
-				clearTrans();
+		// repeat of 0x50 - 0x57 but adding rather than subtracting the offset
 
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-				}
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
-			}
-			// ldrT rd, [rn], -reg
-			case 0x63:
+		// str rd, [rn, imm]
+		case 0x58:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreWord( getRegister(rn) + getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldr rd, [rn, imm]
+		case 0x59:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 location;
+			if( performDataTransferLoadWord( getRegister(rn) + getDataTransferValueImmediate(), location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint32 location;
-				
-				clearTrans();
-
-				if( performDataTransferLoadWord( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-					if( processorMode != USR_MODE )
-					{
-						setTrans();
-					}
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn], -reg
-			case 0x64:
+			break;
+		}
+		// str rd, [rn, imm]!
+		case 0x5A:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) + getDataTransferValueImmediate();
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// ldrB rd, [rn], -reg
-			case 0x65:
+			break;
+		}
+		// ldr rd, [rn, imm]!
+		case 0x5B:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) + getDataTransferValueImmediate();
+			uint32 location;
+			if( performDataTransferLoadWord( address, location ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint8 location;
-				if( performDataTransferLoadByte( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strBT rd, [rn],-reg
-			case 0x66:
+			break;
+		}
+		// strB rd, [rn, imm]
+		case 0x5C:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreByte( getRegister(rn) + getDataTransferValueImmediate(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldrB rd, [rn, imm]
+		case 0x5D:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint8 location;
+			if( performDataTransferLoadByte( getRegister(rn) + getDataTransferValueImmediate(), location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				
-				clearTrans();
-
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-				}
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldrBT rd, [rn], -reg
-			case 0x67:
+			break;
+		}
+		// strB rd, [rn, imm]!
+		case 0x5E:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) + getDataTransferValueImmediate();
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint8 location;
-				
-				clearTrans();
-
-				if( performDataTransferLoadByte( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
-					if( processorMode != USR_MODE )
-					{
-						setTrans();
-					}
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
+			break;
+		}
+		// ldrB rd, [rn, imm]!
+		case 0x5F:
+		{
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) + getDataTransferValueImmediate();
+			uint8 location;
+			if( performDataTransferLoadByte( address, location ) )
+			{
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
+			}
+			break;
+		}
 
-			// repeat of 0x60-0x67 but incrementing the offset
+		// single data transfer register
+		// in every case, if bit 4 is set then throw undefined instruction exception
 
-			// str rd, [rn], reg
-			case 0x68:
+		// str rd, [rn], -reg
+		// implicit write back
+		case 0x60:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldr rd, [rn], reg
-			case 0x69:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint32 location;
-				if( performDataTransferLoadWord( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
 			}
-			// strT rd, [rn], reg
-			case 0x6A:
+			break;
+		}
+		// ldr rd, [rn], -reg
+		case 0x61:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				
-				clearTrans();
-
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-				}
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldrT rd, [rn], reg
-			case 0x6B:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint32 location;
+			if( performDataTransferLoadWord( address, location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint32 location;
-				
-				clearTrans();
-
-				if( performDataTransferLoadWord( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-					if( processorMode != USR_MODE )
-					{
-						setTrans();
-					}
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn], reg
-			case 0x6C:
+			break;
+		}
+		// strT rd, [rn],-reg
+		case 0x62:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldrB rd, [rn], reg
-			case 0x6D:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+		
+			clearTrans();
+
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint8 location;
-				if( performDataTransferLoadByte( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
 			}
-			// strBT rd, [rn], reg
-			case 0x6E:
+			if( processorMode != USR_MODE )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn);
-				
-				clearTrans();
+				setTrans();
+			}
+			break;
+		}
+		// ldrT rd, [rn], -reg
+		case 0x63:
+		{
+			if( getBit(currentInstruction, 4) )
+			{
+				exceptionUndefinedInstruction();
+				return FALSE;
+			}
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint32 location;
+			
+			clearTrans();
 
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-				}
+			if( performDataTransferLoadWord( address, location) )
+			{
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
 				if( processorMode != USR_MODE )
 				{
 					setTrans();
 				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldrBT rd, [rn],reg
-			case 0x6F:
+			break;
+		}
+		// strB rd, [rn], -reg
+		case 0x64:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn);
-				uint8 location;
-				
-				clearTrans();
-
-				if( performDataTransferLoadByte( address, location) )
-				{
-					setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
-					if( processorMode != USR_MODE )
-					{
-						setTrans();
-					}
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// str rd, [rn, -reg]
-			case 0x70:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreWord( getRegister(rn) - getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
 			}
-			// ldr rd, [rn, -reg]
-			case 0x71:
+			break;
+		}
+		// ldrB rd, [rn], -reg
+		case 0x65:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 location;
-				if( performDataTransferLoadWord( getRegister(rn) - getDataTransferValueRegister(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// str rd, [rn, -reg]!
-			case 0x72:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint8 location;
+			if( performDataTransferLoadByte( address, location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) - getDataTransferValueRegister();
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldr rd, [rn, -reg]!
-			case 0x73:
+			break;
+		}
+		// strBT rd, [rn],-reg
+		case 0x66:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) - getDataTransferValueRegister();
-				uint32 location;
-				if( performDataTransferLoadWord( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// strB rd, [rn, -reg]
-			case 0x74:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			
+			clearTrans();
+
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreByte( getRegister(rn) - getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
 			}
-			// ldrB rd, [rn, -reg]
-			case 0x75:
+			if( processorMode != USR_MODE )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint8 location;
-				if( performDataTransferLoadByte( getRegister(rn) - getDataTransferValueRegister(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setTrans();
 			}
-			// strB rd, [rn, -reg]!
-			case 0x76:
+			break;
+		}
+		// ldrBT rd, [rn], -reg
+		case 0x67:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) - getDataTransferValueRegister();
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldrB rd, [rn, -reg]!
-			case 0x77:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint8 location;
+			
+			clearTrans();
+
+			if( performDataTransferLoadByte( address, location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) - getDataTransferValueRegister();
-				uint8 location;
-				if( performDataTransferLoadByte( address, location ) )
+				setRegisterWithPrefetch(rn, address - getDataTransferValueRegister() );
+				if( processorMode != USR_MODE )
 				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
+					setTrans();
 				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
+			break;
+		}
 
-			// repeat of 0x70 - 0x77 but with index added
+		// repeat of 0x60-0x67 but incrementing the offset
 
-			// str rd, [rn, reg]
-			case 0x78:
+		// str rd, [rn], reg
+		case 0x68:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreWord( getRegister(rn) + getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldr rd, [rn, reg]
-			case 0x79:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 location;
-				if( performDataTransferLoadWord( getRegister(rn) + getDataTransferValueRegister(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
 			}
-			// str rd, [rn, reg]!
-			case 0x7A:
+			break;
+		}
+		// ldr rd, [rn], reg
+		case 0x69:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) + getDataTransferValueRegister();
-				if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldr rd, [rn, reg]!
-			case 0x7B:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint32 location;
+			if( performDataTransferLoadWord( address, location) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) + getDataTransferValueRegister();
-				uint32 location;
-				if( performDataTransferLoadWord( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
+				setRegisterWithPrefetch(rd, location);
 			}
-			// strB rd, [rn, reg]
-			case 0x7C:
+			break;
+		}
+		// strT rd, [rn], reg
+		case 0x6A:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				performDataTransferStoreByte( getRegister(rn) + getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldrB rd, [rn, reg]
-			case 0x7D:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			
+			clearTrans();
+
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint8 location;
-				if( performDataTransferLoadByte( getRegister(rn) + getDataTransferValueRegister(), location) )
-				{
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
 			}
-			// strB rd, [rn, reg]!
-			case 0x7E:
+			if( processorMode != USR_MODE )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to store
-				uint32 address = getRegister(rn) + getDataTransferValueRegister();
-				if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setTrans();
 			}
-			// ldrB rd, [rn, reg]!
-			case 0x7F:
+			break;
+		}
+		// ldrT rd, [rn], reg
+		case 0x6B:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				if( getBit(currentInstruction, 4) )
-				{
-					exceptionUndefinedInstruction();
-					return;
-				}
-				uint rn = getField(currentInstruction, 16, 19); // base address register
-				uint rd = getField(currentInstruction, 12, 15); // get register to load to
-				uint32 address = getRegister(rn) + getDataTransferValueRegister();
-				uint8 location;
-				if( performDataTransferLoadByte( address, location ) )
-				{
-					// writeback
-					setRegisterWithPrefetch(rn, address);
-					setRegisterWithPrefetch(rd, location);
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint32 location;
+			
+			clearTrans();
 
-			// block data transfer
-
-			// notes:
-			// number of bits set in register list is * 4 for the number of bytes
-			// per register that is to be stored to get the final address
-			// syntax:
-			// rn is the base address
-			// DA - decrement after, DB - decrement before
-			// IA - increment after, IB - increment before
-			// ! means write back value to rn after data transfer
-			// ^ S flag is set meaning repercussions for PSR if r15 involved, see manuals
-			// stmDA rn, {list}
-			case 0x80:
-			{
-				uint32 rn = getField(currentInstruction, 16, 19);
-				uint32 baseAddress = getRegisterWithPSR(rn);
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2);
-				performBlockDataTransferStore(rn, baseAfterTransfer+4, baseAddress);
-				break;
-			}
-			// ldmDA rn, {list}
-			case 0x81:
-			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAfterTransfer+4, baseAddress);
-				break;
-			}
-			// stmDA rn!, {list}
-			case 0x82:
+			if( performDataTransferLoadWord( address, location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStore(rn, baseAfterTransfer+4, baseAfterTransfer);
-				break;
-			}
-			// ldmDA rn!, {list}
-			case 0x83:
-			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAfterTransfer+4, baseAfterTransfer);
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
+				if( processorMode != USR_MODE )
+				{
+					setTrans();
+				}
+				setRegisterWithPrefetch(rd, location);
 			}
-			// stmDA rn, {list}^
-			case 0x84:
+			break;
+		}
+		// strB rd, [rn], reg
+		case 0x6C:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAfterTransfer+4, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmDA rn, {list}^
-			case 0x85:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAfterTransfer+4, baseAddress);
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
 			}
-			// stmDA rn!, {list}^
-			case 0x86:
+			break;
+		}
+		// ldrB rd, [rn], reg
+		case 0x6D:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAfterTransfer+4, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmDA rn!, {list}^
-			case 0x87:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint8 location;
+			if( performDataTransferLoadByte( address, location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAfterTransfer+4, baseAfterTransfer);
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
+				setRegisterWithPrefetch(rd, location);
 			}
-			// stmIA rn, {list}
-			case 0x88:
+			break;
+		}
+		// strBT rd, [rn], reg
+		case 0x6E:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferStore(rn, baseAddress, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmIA rn, {list}
-			case 0x89:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn);
+			
+			clearTrans();
+
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferLoad(rn, baseAddress, baseAddress);
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
 			}
-			// stmIA rn!, {list}
-			case 0x8A:
+			if( processorMode != USR_MODE )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStore(rn, baseAddress, baseAfterTransfer);
-				break;
+				setTrans();
 			}
-			// ldmIA rn!, {list}
-			case 0x8B:
+			break;
+		}
+		// ldrBT rd, [rn],reg
+		case 0x6F:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAddress, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmIA rn, {list}^
-			case 0x8C:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn);
+			uint8 location;
+			
+			clearTrans();
+
+			if( performDataTransferLoadByte( address, location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferStoreS(rn, baseAddress, baseAddress);
-				break;
+				setRegisterWithPrefetch(rn, address + getDataTransferValueRegister() );
+				if( processorMode != USR_MODE )
+				{
+					setTrans();
+				}
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldmIA rn, {list}^
-			case 0x8D:
+			break;
+		}
+		// str rd, [rn, -reg]
+		case 0x70:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferLoadS(rn, baseAddress, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmIA rn!, {list}^
-			case 0x8E:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreWord( getRegister(rn) - getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldr rd, [rn, -reg]
+		case 0x71:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAddress, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmIA rn!, {list}^
-			case 0x8F:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 location;
+			if( performDataTransferLoadWord( getRegister(rn) - getDataTransferValueRegister(), location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAddress, baseAfterTransfer);
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// stmDB rn, {list}
-			case 0x90:
+			break;
+		}
+		// str rd, [rn, -reg]!
+		case 0x72:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStore(rn, baseAfterTransfer, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmDB rn, {list}
-			case 0x91:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) - getDataTransferValueRegister();
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAfterTransfer, baseAddress);
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// stmDB rn!, {list}
-			case 0x92:
+			break;
+		}
+		// ldr rd, [rn, -reg]!
+		case 0x73:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStore(rn, baseAfterTransfer, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmDB rn!, {list}
-			case 0x93:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) - getDataTransferValueRegister();
+			uint32 location;
+			if( performDataTransferLoadWord( address, location ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAfterTransfer, baseAfterTransfer);
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// stmDB rn, {list}^
-			case 0x94:
+			break;
+		}
+		// strB rd, [rn, -reg]
+		case 0x74:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAfterTransfer, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmDB rn, {list}^
-			case 0x95:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreByte( getRegister(rn) - getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldrB rd, [rn, -reg]
+		case 0x75:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAfterTransfer, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmDB rn!, {list}^
-			case 0x96:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint8 location;
+			if( performDataTransferLoadByte( getRegister(rn) - getDataTransferValueRegister(), location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAfterTransfer, baseAfterTransfer);
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldmDB rn!, {list}^
-			case 0x97:
+			break;
+		}
+		// strB rd, [rn, -reg]!
+		case 0x76:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAfterTransfer, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmIB rn, {list}
-			case 0x98:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) - getDataTransferValueRegister();
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferStore(rn, baseAddress+4, baseAddress);
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// ldmIB rn, {list}
-			case 0x99:
+			break;
+		}
+		// ldrB rd, [rn, -reg]!
+		case 0x77:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferLoad(rn, baseAddress+4, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmIB rn!, {list}
-			case 0x9A:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) - getDataTransferValueRegister();
+			uint8 location;
+			if( performDataTransferLoadByte( address, location ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStore(rn, baseAddress+4, baseAfterTransfer);
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// ldmIB rn!, {list}
-			case 0x9B:
+			break;
+		}
+
+		// repeat of 0x70 - 0x77 but with index added
+
+		// str rd, [rn, reg]
+		case 0x78:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoad(rn, baseAddress+4, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// stmIB rn, {list}^
-			case 0x9C:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreWord( getRegister(rn) + getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldr rd, [rn, reg]
+		case 0x79:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferStoreS(rn, baseAddress+4, baseAddress);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmIB rn, {list}^
-			case 0x9D:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 location;
+			if( performDataTransferLoadWord( getRegister(rn) + getDataTransferValueRegister(), location) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				performBlockDataTransferLoadS(rn, baseAddress+4, baseAddress);
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// stmIB rn!, {list}^
-			case 0x9E:
+			break;
+		}
+		// str rd, [rn, reg]!
+		case 0x7A:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferStoreS(rn, baseAddress+4, baseAfterTransfer);
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// ldmIB rn!, {list}^
-			case 0x9F:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) + getDataTransferValueRegister();
+			if( performDataTransferStoreWord( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
-				uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
-				uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
-				uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
-				performBlockDataTransferLoadS(rn, baseAddress+4, baseAfterTransfer);
-				break;
-			}
-
-			// branch
-
-			// B PC + offset
-			case 0xA0:
-			case 0xA1:
-			case 0xA2:
-			case 0xA3:
-			case 0xA4:
-			case 0xA5:
-			case 0xA6:
-			case 0xA7:
-			// B PC- offset
-			case 0xA8:
-			case 0xA9:
-			case 0xAA:
-			case 0xAB:
-			case 0xAC:
-			case 0xAD:
-			case 0xAE:
-			case 0xAF:
-			{
-				performBranch();
-				break;
-			}
-			// BL PC + offset
-			case 0xB0:
-			case 0xB1:
-			case 0xB2:
-			case 0xB3:
-			case 0xB4:
-			case 0xB5:
-			case 0xB6:
-			case 0xB7:
-			// BL PC- offset
-			case 0xB8:
-			case 0xB9:
-			case 0xBA:
-			case 0xBB:
-			case 0xBC:
-			case 0xBD:
-			case 0xBE:
-			case 0xBF:
-			{
-				// store the current PC in link register (r14)
-				// -4 accounts for the pipelining not adjusting this value
-				setRegister(14, getRegisterWithPSR(15) - 4);
-				// perform branch as usual
-				performBranch();
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-
-			// co-processor data transfer
-
-			// STC Crd, [rn], -imm
-			case 0xC0:
-			case 0xC4:
+			break;
+		}
+		// ldr rd, [rn, reg]!
+		case 0x7B:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// LDC Crd, [rn], -imm
-			case 0xC1:
-			case 0xC5:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) + getDataTransferValueRegister();
+			uint32 location;
+			if( performDataTransferLoadWord( address, location ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// STRC Crd, [rn],-imm
-			case 0xC2:
-			case 0xC6:
+			break;
+		}
+		// strB rd, [rn, reg]
+		case 0x7C:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				clearTrans();
-
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
-				}
-				
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// LDRC Crd, [rn], -imm
-			case 0xC3:
-			case 0xC7:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			performDataTransferStoreByte( getRegister(rn) + getDataTransferValueRegister(), getRegisterWithPSRAndPipelining(rd) );
+			break;
+		}
+		// ldrB rd, [rn, reg]
+		case 0x7D:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				clearTrans();
-
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
-				}
-
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// STC Crd, [rn], imm
-			case 0xC8:
-			case 0xCC:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint8 location;
+			if( performDataTransferLoadByte( getRegister(rn) + getDataTransferValueRegister(), location) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
-				}
-				break;
+				setRegisterWithPrefetch(rd, location);
 			}
-			// LDC Crd, [rn], imm
-			case 0xC9:
-			case 0xCD:
+			break;
+		}
+		// strB rd, [rn, reg]!
+		case 0x7E:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// STRC Crd, [rn],imm
-			case 0xCA:
-			case 0xCE:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to store
+			uint32 address = getRegister(rn) + getDataTransferValueRegister();
+			if( performDataTransferStoreByte( address, getRegisterWithPSRAndPipelining(rd) ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				clearTrans();
-
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
-				}
-				
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
 			}
-			// LDRC Crd, [rn], imm
-			case 0xCB:
-			case 0xCF:
+			break;
+		}
+		// ldrB rd, [rn, reg]!
+		case 0x7F:
+		{
+			if( getBit(currentInstruction, 4) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn);
-				clearTrans();
-
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
-				}
-
-				if( processorMode != USR_MODE )
-				{
-					setTrans();
-				}
-				break;
+				exceptionUndefinedInstruction();
+				return FALSE;
 			}
-			// STC Crd, [rn, -imm]
-			case 0xD0:
-			case 0xD4:
+			uint rn = getField(currentInstruction, 16, 19); // base address register
+			uint rd = getField(currentInstruction, 12, 15); // get register to load to
+			uint32 address = getRegister(rn) + getDataTransferValueRegister();
+			uint8 location;
+			if( performDataTransferLoadByte( address, location ) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				coprocessorDataTransferStore( getRegister(rn) - coprocessorDataTransferOffset() );
-				break;
+				// writeback
+				setRegisterWithPrefetch(rn, address);
+				setRegisterWithPrefetch(rd, location);
 			}
-			// LDC Crd, [rn, -imm]
-			case 0xD1:
-			case 0xD5:
+			break;
+		}
+
+		// block data transfer
+
+		// notes:
+		// number of bits set in register list is * 4 for the number of bytes
+		// per register that is to be stored to get the final address
+		// syntax:
+		// rn is the base address
+		// DA - decrement after, DB - decrement before
+		// IA - increment after, IB - increment before
+		// ! means write back value to rn after data transfer
+		// ^ S flag is set meaning repercussions for PSR if r15 involved, see manuals
+		// stmDA rn, {list}
+		case 0x80:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);
+			uint32 baseAddress = getRegisterWithPSR(rn);
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2);
+			performBlockDataTransferStore(rn, baseAfterTransfer+4, baseAddress);
+			break;
+		}
+		// ldmDA rn, {list}
+		case 0x81:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAfterTransfer+4, baseAddress);
+			break;
+		}
+		// stmDA rn!, {list}
+		case 0x82:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStore(rn, baseAfterTransfer+4, baseAfterTransfer);
+			break;
+		}
+		// ldmDA rn!, {list}
+		case 0x83:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAfterTransfer+4, baseAfterTransfer);
+			break;
+		}
+		// stmDA rn, {list}^
+		case 0x84:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAfterTransfer+4, baseAddress);
+			break;
+		}
+		// ldmDA rn, {list}^
+		case 0x85:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAfterTransfer+4, baseAddress);
+			break;
+		}
+		// stmDA rn!, {list}^
+		case 0x86:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAfterTransfer+4, baseAfterTransfer);
+			break;
+		}
+		// ldmDA rn!, {list}^
+		case 0x87:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAfterTransfer+4, baseAfterTransfer);
+			break;
+		}
+		// stmIA rn, {list}
+		case 0x88:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferStore(rn, baseAddress, baseAddress);
+			break;
+		}
+		// ldmIA rn, {list}
+		case 0x89:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferLoad(rn, baseAddress, baseAddress);
+			break;
+		}
+		// stmIA rn!, {list}
+		case 0x8A:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStore(rn, baseAddress, baseAfterTransfer);
+			break;
+		}
+		// ldmIA rn!, {list}
+		case 0x8B:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAddress, baseAfterTransfer);
+			break;
+		}
+		// stmIA rn, {list}^
+		case 0x8C:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferStoreS(rn, baseAddress, baseAddress);
+			break;
+		}
+		// ldmIA rn, {list}^
+		case 0x8D:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferLoadS(rn, baseAddress, baseAddress);
+			break;
+		}
+		// stmIA rn!, {list}^
+		case 0x8E:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAddress, baseAfterTransfer);
+			break;
+		}
+		// ldmIA rn!, {list}^
+		case 0x8F:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAddress, baseAfterTransfer);
+			break;
+		}
+		// stmDB rn, {list}
+		case 0x90:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStore(rn, baseAfterTransfer, baseAddress);
+			break;
+		}
+		// ldmDB rn, {list}
+		case 0x91:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAfterTransfer, baseAddress);
+			break;
+		}
+		// stmDB rn!, {list}
+		case 0x92:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStore(rn, baseAfterTransfer, baseAfterTransfer);
+			break;
+		}
+		// ldmDB rn!, {list}
+		case 0x93:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAfterTransfer, baseAfterTransfer);
+			break;
+		}
+		// stmDB rn, {list}^
+		case 0x94:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAfterTransfer, baseAddress);
+			break;
+		}
+		// ldmDB rn, {list}^
+		case 0x95:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAfterTransfer, baseAddress);
+			break;
+		}
+		// stmDB rn!, {list}^
+		case 0x96:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAfterTransfer, baseAfterTransfer);
+			break;
+		}
+		// ldmDB rn!, {list}^
+		case 0x97:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress - (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAfterTransfer, baseAfterTransfer);
+			break;
+		}
+		// stmIB rn, {list}
+		case 0x98:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferStore(rn, baseAddress+4, baseAddress);
+			break;
+		}
+		// ldmIB rn, {list}
+		case 0x99:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferLoad(rn, baseAddress+4, baseAddress);
+			break;
+		}
+		// stmIB rn!, {list}
+		case 0x9A:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStore(rn, baseAddress+4, baseAfterTransfer);
+			break;
+		}
+		// ldmIB rn!, {list}
+		case 0x9B:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoad(rn, baseAddress+4, baseAfterTransfer);
+			break;
+		}
+		// stmIB rn, {list}^
+		case 0x9C:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferStoreS(rn, baseAddress+4, baseAddress);
+			break;
+		}
+		// ldmIB rn, {list}^
+		case 0x9D:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			performBlockDataTransferLoadS(rn, baseAddress+4, baseAddress);
+			break;
+		}
+		// stmIB rn!, {list}^
+		case 0x9E:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferStoreS(rn, baseAddress+4, baseAfterTransfer);
+			break;
+		}
+		// ldmIB rn!, {list}^
+		case 0x9F:
+		{
+			uint32 rn = getField(currentInstruction, 16, 19);			// register containing base address
+			uint32 baseAddress = getRegisterWithPSR(rn);				// get base address
+			uint32 registerList = getField(currentInstruction, 0,15);	// list of regs to transfer
+			uint32 baseAfterTransfer = baseAddress + (countSetBits(registerList) << 2); // calculate final address
+			performBlockDataTransferLoadS(rn, baseAddress+4, baseAfterTransfer);
+			break;
+		}
+
+		// branch
+
+		// B PC + offset
+		case 0xA0:
+		case 0xA1:
+		case 0xA2:
+		case 0xA3:
+		case 0xA4:
+		case 0xA5:
+		case 0xA6:
+		case 0xA7:
+		// B PC- offset
+		case 0xA8:
+		case 0xA9:
+		case 0xAA:
+		case 0xAB:
+		case 0xAC:
+		case 0xAD:
+		case 0xAE:
+		case 0xAF:
+		{
+			performBranch();
+			break;
+		}
+		// BL PC + offset
+		case 0xB0:
+		case 0xB1:
+		case 0xB2:
+		case 0xB3:
+		case 0xB4:
+		case 0xB5:
+		case 0xB6:
+		case 0xB7:
+		// BL PC- offset
+		case 0xB8:
+		case 0xB9:
+		case 0xBA:
+		case 0xBB:
+		case 0xBC:
+		case 0xBD:
+		case 0xBE:
+		case 0xBF:
+		{
+			// store the current PC in link register (r14)
+			// -4 accounts for the pipelining not adjusting this value
+			setRegister(14, getRegisterWithPSR(15) - 4);
+			// perform branch as usual
+			performBranch();
+			break;
+		}
+
+		// co-processor data transfer
+
+		// STC Crd, [rn], -imm
+		case 0xC0:
+		case 0xC4:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			if( coprocessorDataTransferStore(address) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				coprocessorDataTransferLoad( getRegister(rn) - coprocessorDataTransferOffset() );
-				break;
+				setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
 			}
-			// STC Crd, [rn, -imm]!
-			case 0xD2:
-			case 0xD6:
+			break;
+		}
+		// LDC Crd, [rn], -imm
+		case 0xC1:
+		case 0xC5:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			if( coprocessorDataTransferLoad(address) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn) - coprocessorDataTransferOffset();
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
 			}
-			// LDC Crd, [rn, -imm]!
-			case 0xD3:
-			case 0xD7:
+			break;
+		}
+		// STRC Crd, [rn],-imm
+		case 0xC2:
+		case 0xC6:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			clearTrans();
+
+			if( coprocessorDataTransferStore(address) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn) - coprocessorDataTransferOffset();
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
 			}
-			// STC Crd, [rn, imm]
-			case 0xD8:
-			case 0xDC:
+			
+			if( processorMode != USR_MODE )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				coprocessorDataTransferStore( getRegister(rn) + coprocessorDataTransferOffset() );
-				break;
+				setTrans();
 			}
-			// LDC Crd, [rn, imm]
-			case 0xD9:
-			case 0xDD:
+			break;
+		}
+		// LDRC Crd, [rn], -imm
+		case 0xC3:
+		case 0xC7:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			clearTrans();
+
+			if( coprocessorDataTransferLoad(address) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				coprocessorDataTransferLoad( getRegister(rn) + coprocessorDataTransferOffset() );
-				break;
+				setRegisterWithPrefetch(rn, address - coprocessorDataTransferOffset() );
 			}
-			// STC Crd, [rn, imm]!
-			case 0xDA:
-			case 0xDE:
+
+			if( processorMode != USR_MODE )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn) + coprocessorDataTransferOffset();
-				if( coprocessorDataTransferStore(address) )
-				{
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
+				setTrans();
 			}
-			// LDC Crd, [rn, imm]!
-			case 0xDB:
-			case 0xDF:
+			break;
+		}
+		// STC Crd, [rn], imm
+		case 0xC8:
+		case 0xCC:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			if( coprocessorDataTransferStore(address) )
 			{
-				uint rn = getField(currentInstruction, 16, 19);
-				uint32 address = getRegister(rn) + coprocessorDataTransferOffset();
-				if( coprocessorDataTransferLoad(address) )
-				{
-					setRegisterWithPrefetch(rn, address);
-				}
-				break;
-			}
-		
-			// MRC
-			// CDO
-			case 0xE0:
-			case 0xE2:
-			case 0xE4:
-			case 0xE6:
-			case 0xE8:
-			case 0xEA:
-			case 0xEC:
-			case 0xEE:
-			{
-				if ( getBit(currentInstruction, 4) )
-				{
-					// MRC
-					coprocessorRegisterTransferWrite();
-				}
-				else
-				{
-					// CDO
-					coprocessorDataOperation();
-				}
-				break;
+				setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
 			}
-			// MCR
-			// CDO
-			case 0xE1:
-			case 0xE3:
-			case 0xE5:
-			case 0xE7:
-			case 0xE9:
-			case 0xEB:
-			case 0xED:
-			case 0xEF:
-			{
-				if ( getBit(currentInstruction, 4) )
-				{
-					// MCR
-					coprocessorRegisterTransferRead();
-				}
-				else
-				{
-					// CDO
-					coprocessorDataOperation();
-				}
-				break;
-				break;
+			break;
+		}
+		// LDC Crd, [rn], imm
+		case 0xC9:
+		case 0xCD:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			if( coprocessorDataTransferLoad(address) )
+			{
+				setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
 			}
-			
-			// software interrupt
-			case 0xF0:
-			case 0xF1:
-			case 0xF2:
-			case 0xF3:
-			case 0xF4:
-			case 0xF5:
-			case 0xF6:
-			case 0xF7:
-			case 0xF8:
-			case 0xF9:
-			case 0xFA:
-			case 0xFB:
-			case 0xFC:
-			case 0xFD:
-			case 0xFE:
-			case 0xFF:
-			{
-				/*
-				// ??? remove me
-				// simplistic SWI faking
-				switch( getField(currentInstruction, 0, 23) )
-				{
-					// OS_NewLine
-					case 0x00003:
-					{
-						TRACE("\n");
-						break;
-					}
-					// OS_WriteI+"*"
-					case 0x0012A:
-					{
-						TRACE("*");
-						break;
-					}
-				}
-				*/
+			break;
+		}
+		// STRC Crd, [rn],imm
+		case 0xCA:
+		case 0xCE:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			clearTrans();
 
-				// throw software interrupt exception
-				exceptionSoftwareInterrupt();
-				break;
+			if( coprocessorDataTransferStore(address) )
+			{
+				setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
 			}
 			
-			default :	// ??? DISPLAY ERROR MESSAGE - I'VE MISSED OUT AN INSTRUCTION CASE
-						WriteLog("ERROR UNKNOWN OPCODE %02x\n", getField(currentInstruction, 20, 27) );
-						break;
-		} // end instruction decoding switch
-	} // end conditional execution
+			if( processorMode != USR_MODE )
+			{
+				setTrans();
+			}
+			break;
+		}
+		// LDRC Crd, [rn], imm
+		case 0xCB:
+		case 0xCF:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn);
+			clearTrans();
 
-	// handle PC incrementation (happens whether instruction conditionally executed or not)
-	// if prefetch invalidated
-	if(prefetchInvalid)
-	{
-	
-		pc = getRegister(15);
-		// adjust PC but don't change prefetch
-		setRegister( 15, (getRegister(15) + 8) & PC_MASK );
-		
-		prefetchInvalid = FALSE;
+			if( coprocessorDataTransferLoad(address) )
+			{
+				setRegisterWithPrefetch(rn, address + coprocessorDataTransferOffset() );
+			}
 
-		if( !readWord(pc, prefetchInstruction) )
+			if( processorMode != USR_MODE )
+			{
+				setTrans();
+			}
+			break;
+		}
+		// STC Crd, [rn, -imm]
+		case 0xD0:
+		case 0xD4:
 		{
-			exceptionPrefetchAbort();
-			return;
+			uint rn = getField(currentInstruction, 16, 19);
+			coprocessorDataTransferStore( getRegister(rn) - coprocessorDataTransferOffset() );
+			break;
 		}
-		pc += 4;
-	}
-	else
-	{
-		// else if prefetch ok
-		pc += 4;
-		setRegister( 15, getRegister(15) + 4 );
-	}
-
-	// check for interrupts
-
-	if(TubeNMIStatus)
-	{
-		if (processorMode != FIQ_MODE)
+		// LDC Crd, [rn, -imm]
+		case 0xD1:
+		case 0xD5:
 		{
-//			WriteLog("Entering FIQ Mode\n");
-			exceptionFastInterruptRequest();
+			uint rn = getField(currentInstruction, 16, 19);
+			coprocessorDataTransferLoad( getRegister(rn) - coprocessorDataTransferOffset() );
+			break;
 		}
-	}
-	else if(TubeintStatus & (1<<R1))
-	{
-		if (processorMode != IRQ_MODE)
+		// STC Crd, [rn, -imm]!
+		case 0xD2:
+		case 0xD6:
 		{
-//			WriteLog("Entering IRQ Mode\n");
-			exceptionInterruptRequest();
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn) - coprocessorDataTransferOffset();
+			if( coprocessorDataTransferStore(address) )
+			{
+				setRegisterWithPrefetch(rn, address);
+			}
+			break;
 		}
-	}
-	else if(TubeintStatus & (1<<R4))
-	{
-		if (processorMode != IRQ_MODE)
+		// LDC Crd, [rn, -imm]!
+		case 0xD3:
+		case 0xD7:
 		{
-//			WriteLog("Entering IRQ Mode\n");
-			exceptionInterruptRequest();
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn) - coprocessorDataTransferOffset();
+			if( coprocessorDataTransferLoad(address) )
+			{
+				setRegisterWithPrefetch(rn, address);
+			}
+			break;
+		}
+		// STC Crd, [rn, imm]
+		case 0xD8:
+		case 0xDC:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			coprocessorDataTransferStore( getRegister(rn) + coprocessorDataTransferOffset() );
+			break;
+		}
+		// LDC Crd, [rn, imm]
+		case 0xD9:
+		case 0xDD:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			coprocessorDataTransferLoad( getRegister(rn) + coprocessorDataTransferOffset() );
+			break;
+		}
+		// STC Crd, [rn, imm]!
+		case 0xDA:
+		case 0xDE:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn) + coprocessorDataTransferOffset();
+			if( coprocessorDataTransferStore(address) )
+			{
+				setRegisterWithPrefetch(rn, address);
+			}
+			break;
+		}
+		// LDC Crd, [rn, imm]!
+		case 0xDB:
+		case 0xDF:
+		{
+			uint rn = getField(currentInstruction, 16, 19);
+			uint32 address = getRegister(rn) + coprocessorDataTransferOffset();
+			if( coprocessorDataTransferLoad(address) )
+			{
+				setRegisterWithPrefetch(rn, address);
+			}
+			break;
 		}
-	}
 	
-	if(signals.all != 0)
-	{
-		if(signals.step_once)
+		// MRC
+		// CDO
+		case 0xE0:
+		case 0xE2:
+		case 0xE4:
+		case 0xE6:
+		case 0xE8:
+		case 0xEA:
+		case 0xEC:
+		case 0xEE:
 		{
-			//break;
+			if ( getBit(currentInstruction, 4) )
+			{
+				// MRC
+				coprocessorRegisterTransferWrite();
+			}
+			else
+			{
+				// CDO
+				coprocessorDataOperation();
+			}
+			break;
 		}
-		if(signals.fast_interrupt)
+		// MCR
+		// CDO
+		case 0xE1:
+		case 0xE3:
+		case 0xE5:
+		case 0xE7:
+		case 0xE9:
+		case 0xEB:
+		case 0xED:
+		case 0xEF:
 		{
-			exceptionFastInterruptRequest();
+			if ( getBit(currentInstruction, 4) )
+			{
+				// MCR
+				coprocessorRegisterTransferRead();
+			}
+			else
+			{
+				// CDO
+				coprocessorDataOperation();
+			}
+			break;
+			break;
 		}
-		else if(signals.interrupt)
+		
+		// software interrupt
+		case 0xF0:
+		case 0xF1:
+		case 0xF2:
+		case 0xF3:
+		case 0xF4:
+		case 0xF5:
+		case 0xF6:
+		case 0xF7:
+		case 0xF8:
+		case 0xF9:
+		case 0xFA:
+		case 0xFB:
+		case 0xFC:
+		case 0xFD:
+		case 0xFE:
+		case 0xFF:
 		{
-			exceptionInterruptRequest();
+			/*
+			// ??? remove me
+			// simplistic SWI faking
+			switch( getField(currentInstruction, 0, 23) )
+			{
+				// OS_NewLine
+				case 0x00003:
+				{
+					TRACE("\n");
+					break;
+				}
+				// OS_WriteI+"*"
+				case 0x0012A:
+				{
+					TRACE("*");
+					break;
+				}
+			}
+			*/
+
+			// throw software interrupt exception
+			exceptionSoftwareInterrupt();
+			break;
 		}
-	}
+		
+		default :	// ??? DISPLAY ERROR MESSAGE - I'VE MISSED OUT AN INSTRUCTION CASE
+					WriteLog("ERROR UNKNOWN OPCODE %02x\n", getField(currentInstruction, 20, 27) );
+					break;
+	} // end instruction decoding switch
+
+	return TRUE;
+}
 
+template<uint Operation>
+bool CArm::dispatch(CArm *arm)
+{
+	return arm->execute<Operation>();
 }
 
+#define ARM_HANDLER(operation)		&CArm::dispatch<operation>
+#define ARM_HANDLERS_4(operation)	ARM_HANDLER(operation), ARM_HANDLER((operation) + 1), \
+									ARM_HANDLER((operation) + 2), ARM_HANDLER((operation) + 3)
+#define ARM_HANDLERS_16(operation)	ARM_HANDLERS_4(operation), ARM_HANDLERS_4((operation) + 4), \
+									ARM_HANDLERS_4((operation) + 8), ARM_HANDLERS_4((operation) + 12)
+#define ARM_HANDLERS_64(operation)	ARM_HANDLERS_16(operation), ARM_HANDLERS_16((operation) + 16), \
+									ARM_HANDLERS_16((operation) + 32), ARM_HANDLERS_16((operation) + 48)
+
+const ArmHandler CArm::handlers[256] =
+{
+	ARM_HANDLERS_64(0x00), ARM_HANDLERS_64(0x40), ARM_HANDLERS_64(0x80), ARM_HANDLERS_64(0xc0)
+};
+
+#undef ARM_HANDLER
+#undef ARM_HANDLERS_4
+#undef ARM_HANDLERS_16
+#undef ARM_HANDLERS_64
+
 //////////////////////////////////////////////////////////////////////
 // instruction templates
 //////////////////////////////////////////////////////////////////////
@@ -2801,6 +2943,30 @@ inline bool CArm::isExtendedInstruction(uint32 instruction)
 	return ((instruction & 0x90) == 0x90);
 }
 
+// condition code look up table, shared by executeConditionally() and
+// conditionPassed(). Index is 8 bits;
+// 0-3: processor condition flags NZCV
+// 4-8: instruction condition code
+// ??? my version, untested
+static const bool testCondition[256] = {
+	0,0,0,0,1,1,1,1,0,0,0,0,1,1,1,1,	// eq
+	1,1,1,1,0,0,0,0,1,1,1,1,0,0,0,0,	// ne
+	0,0,1,1,0,0,1,1,0,0,1,1,0,0,1,1,	// cs
+	1,1,0,0,1,1,0,0,1,1,0,0,1,1,0,0,	// cc
+	0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,	// mi
+	1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,	// pl
+	0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,	// vs
+	1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,	// vc
+	0,0,1,1,0,0,0,0,0,0,1,1,0,0,0,0,	// hi
+	1,1,0,0,1,1,1,1,1,1,0,0,1,1,1,1,	// ls
+	1,0,1,0,1,0,1,0,0,1,0,1,0,1,0,1,	// ge
+	0,1,0,1,0,1,0,1,1,0,1,0,1,0,1,0,	// lt
+	1,0,1,0,0,0,0,0,0,1,0,1,0,0,0,0,	// gt
+	0,1,0,1,1,1,1,1,1,0,1,0,1,1,1,1,	// le
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,	// al
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0		// nv
+};
+
 // returns TRUE if we should execute the instruction, false otherwise
 inline bool CArm::executeConditionally(uint32 instruction)
 {
@@ -2832,32 +2998,15 @@ inline bool CArm::executeConditionally(uint32 instruction)
 	return getBit(test[instruction>>28], conditionFlags);
 	*/
 
-	// ??? my version, untested
-	static const bool testCondition[256] = {
-		0,0,0,0,1,1,1,1,0,0,0,0,1,1,1,1,	// eq
-		1,1,1,1,0,0,0,0,1,1,1,1,0,0,0,0,	// ne
-		0,0,1,1,0,0,1,1,0,0,1,1,0,0,1,1,	// cs
-		1,1,0,0,1,1,0,0,1,1,0,0,1,1,0,0,	// cc
-		0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,	// mi
-		1,1,1,1,1,1,1,1,0,0,0,0,0,0,0,0,	// pl
-		0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,	// vs
-		1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,	// vc
-		0,0,1,1,0,0,0,0,0,0,1,1,0,0,0,0,	// hi
-		1,1,0,0,1,1,1,1,1,1,0,0,1,1,1,1,	// ls
-		1,0,1,0,1,0,1,0,0,1,0,1,0,1,0,1,	// ge
-		0,1,0,1,0,1,0,1,1,0,1,0,1,0,1,0,	// lt
-		1,0,1,0,0,0,0,0,0,1,0,1,0,0,0,0,	// gt
-		0,1,0,1,1,1,1,1,1,0,1,0,1,1,1,1,	// le
-		1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,	// al
-		0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0		// nv
-	};
-
-	// index into table is 8 bits;
-	// 0-3: processor condition flags NZCV
-	// 4-8: instruction condition code
 	return testCondition[ ((instruction>>24) & 0xf0) | conditionFlags];
 }
 
+// as executeConditionally(), for a condition already decoded by decodeInstruction()
+inline bool CArm::conditionPassed(uint8 condition)
+{
+	return testCondition[condition | conditionFlags];
+}
+
 // puts the value in the correct register for the current (data processing) instruction
 inline void CArm::setDestination(uint32 value)
 {
@@ -3723,11 +3872,232 @@ inline bool CArm::isValidAddress(uint32 address)
 	return ((address & 0xFC000000) == 0 );
 }
 
+//////////////////////////////////////////////////////////////////////
+// basic block cache
+//////////////////////////////////////////////////////////////////////
+
+// fetch an instruction word, from the current block if it's in there
+inline bool CArm::fetchInstruction(uint32 address, ArmDecoded& destination)
+{
+	uint32 index = (address - fetchBlock->address) >> 2;
+
+	if( index >= fetchBlock->length || (address & 3) )
+	{
+		// taken branches mostly land on the start of a block already built
+		fetchBlock = &blockCache[(address >> 2) & (ARM_BLOCK_CACHE_SIZE - 1)];
+		if( fetchBlock->address != address || fetchBlock->length == 0 )
+		{
+			fetchBlock = lookupBlock(address);
+			if( fetchBlock->length == 0 )
+			{
+				if( !readWord(address, destination.instruction) )
+					return FALSE;
+				decodeInstruction(destination);
+				return TRUE;
+			}
+		}
+		index = 0;
+	}
+
+	destination = fetchBlock->instructions[index];
+	return TRUE;
+}
+
+// find the block starting at address, building it if need be. Returns the
+// empty block if the address can't be cached
+ArmBlock *CArm::lookupBlock(uint32 address)
+{
+	ArmBlock *block = &blockCache[(address >> 2) & (ARM_BLOCK_CACHE_SIZE - 1)];
+	uint32 pageEnd;
+	uint32 length;
+
+	if( block->length != 0 && block->address == address )
+		return block;
+
+	if( address & 3 )
+		return &noBlock;
+
+	if( address >= 0x1000000 && (address < 0x3000000 || address >= 0x3004000) )
+		return &noBlock;
+
+	// the slot's old block, if it still has one, is replaced
+	if( block->pagePrevious != NULL )
+		unlinkBlock(block);
+
+	// stop at the end of the page, after anything that changes the flow or
+	// before a word that can't be read (the prefetch aborts there)
+	pageEnd = (address | (ARM_CODE_PAGE_SIZE - 1)) + 1;
+	block->address = address;
+	block->conditional = FALSE;
+	for(length = 0; length < ARM_BLOCK_LENGTH && address < pageEnd; length++, address += 4)
+	{
+		if( !readWord(address, block->instructions[length].instruction) )
+			break;
+		decodeInstruction(block->instructions[length]);
+		if( block->instructions[length].condition != 0xe0 )
+			block->conditional = TRUE;
+		if( isBlockEnd(block->instructions[length].instruction) )
+		{
+			length++;
+			break;
+		}
+	}
+	block->length = length;
+
+	// RAM blocks go on their page's list, so writes to the page can find them
+	if( length != 0 && block->address < 0x1000000 )
+	{
+		ArmBlock **first = &codePageBlocks[(block->address & 0x3fffff) >> ARM_CODE_PAGE_SHIFT];
+
+		block->pageNext = *first;
+		if( *first != NULL )
+			(*first)->pagePrevious = &block->pageNext;
+		block->pagePrevious = first;
+		*first = block;
+	}
+
+	return block;
+}
+
+// pull out the condition and pick the handler for bits 20-27
+inline void CArm::decodeInstruction(ArmDecoded& decoded)
+{
+	decoded.handler = handlers[getField(decoded.instruction, 20, 27)];
+	decoded.condition = (uint8) ((decoded.instruction >> 24) & 0xf0);
+}
+
+// TRUE for unconditional branches, SWIs, anything that always loads r15 and
+// anything that might be undefined or go to a coprocessor. Conditional
+// instructions don't end a block, the prefetch usually falls through them
+inline bool CArm::isBlockEnd(uint32 instruction)
+{
+	if( getField(instruction, 28, 31) != 0xe )
+		return FALSE;
+
+	switch( getField(instruction, 25, 27) )
+	{
+		// data processing and multiply/swap
+		case 0:
+		case 1:
+			return getField(instruction, 12, 15) == 15;
+
+		// single data transfer
+		case 2:
+		case 3:
+			return getBit(instruction, 20) && getField(instruction, 12, 15) == 15;
+
+		// block data transfer
+		case 4:
+			return getBit(instruction, 20) && getBit(instruction, 15);
+
+		// branch, coprocessor and SWI
+		default:
+			return TRUE;
+	}
+}
+
+// called on every RAM write, drops blocks the write may have changed
+inline void CArm::checkCodeWrite(uint32 address)
+{
+	if( codePageBlocks[(address & 0x3fffff) >> ARM_CODE_PAGE_SHIFT] != NULL )
+		invalidateCodePage((address & 0x3fffff) >> ARM_CODE_PAGE_SHIFT);
+}
+
+// drop every block built from a RAM page, going down the page's list
+void CArm::invalidateCodePage(uint page)
+{
+	ArmBlock *block = codePageBlocks[page];
+
+	codePageBlocks[page] = NULL;
+	while( block != NULL )
+	{
+		block->length = 0;
+		block->pagePrevious = NULL;
+		block = block->pageNext;
+	}
+}
+
+// take a block off its page's list
+void CArm::unlinkBlock(ArmBlock *block)
+{
+	*block->pagePrevious = block->pageNext;
+	if( block->pageNext != NULL )
+		block->pageNext->pagePrevious = block->pagePrevious;
+	block->pagePrevious = NULL;
+}
+
+void CArm::flushBlockCache()
+{
+	for(int index = 0; index < ARM_BLOCK_CACHE_SIZE; index++)
+	{
+		blockCache[index].length = 0;
+		blockCache[index].pagePrevious = NULL;
+	}
+	memset(codePageBlocks, 0, sizeof(codePageBlocks));
+
+	noBlock.address = 0;
+	noBlock.length = 0;
+	noBlock.pagePrevious = NULL;
+	fetchBlock = &noBlock;
+}
+
 //////////////////////////////////////////////////////////////////////
 // low level interface to rest of memory system
 ////////////////////////////////////////////////// ////////////////////
 
+// word aligned RAM and ROM accesses are a single load or store (the host is
+// little endian, like the ARM), everything else goes through the slow path
 inline bool CArm::readWord(uint32 address, uint32& destination)
+{
+	const ArmMemoryRegion *region = &memoryRegions[(address >> ARM_REGION_SHIFT) & (ARM_REGIONS - 1)];
+
+	if( (address & (0xFC000000 | 3)) == 0 && region->memory != NULL &&
+		(address & ARM_REGION_MASK) < region->limit )
+	{
+		destination = *(uint32 *)(region->memory + (address & ARM_REGION_MASK));
+		return TRUE;
+	}
+
+	return readWordSlow(address, destination);
+}
+
+inline bool CArm::writeWord(uint32 address, uint32 data)
+{
+	const ArmMemoryRegion *region = &memoryRegions[(address >> ARM_REGION_SHIFT) & (ARM_REGIONS - 1)];
+
+	if( (address & (0xFC000000 | 3)) == 0 && region->writable &&
+		(address & ARM_REGION_MASK) < region->limit )
+	{
+		checkCodeWrite(address);
+		*(uint32 *)(region->memory + (address & ARM_REGION_MASK)) = data;
+		return TRUE;
+	}
+
+	return writeWordSlow(address, data);
+}
+
+// for LDM/STM, returns host memory for count words at address if all of
+// them can be accessed directly, NULL if any would need the slow path
+inline uint32 *CArm::directWords(uint32 address, uint count, bool write)
+{
+	const ArmMemoryRegion *region = &memoryRegions[(address >> ARM_REGION_SHIFT) & (ARM_REGIONS - 1)];
+	uint32 offset = address & ARM_REGION_MASK;
+
+	if( (address & (0xFC000000 | 3)) != 0 || region->memory == NULL ||
+		offset + (count << 2) > region->limit || (write && !region->writable) )
+		return NULL;
+
+	// at most 64 bytes, so no more than two pages
+	if( write )
+	{
+		checkCodeWrite(address);
+		checkCodeWrite(address + (count << 2) - 1);
+	}
+
+	return (uint32 *)(region->memory + offset);
+}
+
+bool CArm::readWordSlow(uint32 address, uint32& destination)
 {
 	// read word at address into destination, return TRUE if ok
 	uint32 value = 0;
@@ -3764,11 +4134,13 @@ inline bool CArm::readWord(uint32 address, uint32& destination)
 	return FALSE;
 }
 
-inline bool CArm::writeWord(uint32 address, uint32 data)
+bool CArm::writeWordSlow(uint32 address, uint32 data)
 {
 
 	if (address < 0x1000000)
 	{
+		checkCodeWrite(address);
+		checkCodeWrite(address + 3);
 		ramMemory[(address & 0x3fffff)] = data & 0xff;
 		ramMemory[(address & 0x3fffff)+1] = (data >> 8) & 0xff;
 		ramMemory[(address & 0x3fffff)+2] = (data >> 16) & 0xff;
@@ -3836,6 +4208,7 @@ inline bool CArm::writeByte(uint32 address, uint8 value)
 		}
 */
 		
+		checkCodeWrite(address);
 		ramMemory[(address & 0x3fffff)] = value & 0xff;
 
 //		if ((value & 0xff) == 255)
@@ -3886,6 +4259,7 @@ inline bool CArm::performBlockDataTransferStore(uint rn, uint32 initialAddress,
 	if(isValidAddress(initialAddress))
 	{
 		// register list is in bits 0-15 of the current instruction
+		uint32 *words = directWords(initialAddress, countSetBits(getField(currentInstruction, 0, 15)), TRUE);
 
 		// find and store the first register in the list (except r15)
 		int index;
@@ -3895,7 +4269,9 @@ inline bool CArm::performBlockDataTransferStore(uint rn, uint32 initialAddress,
 			if( getBit(currentInstruction, index) )
 			{
 				// write word to memory
-				if( !writeWord(initialAddress, getRegister(index) ) )
+				if( words != NULL )
+					*words++ = getRegister(index);
+				else if( !writeWord(initialAddress, getRegister(index) ) )
 				{
 					// ??? rn is highly unlikely to be r15 and the result is unpredictable if it is
 					// in event of a data abort, update rn
@@ -3922,7 +4298,9 @@ inline bool CArm::performBlockDataTransferStore(uint rn, uint32 initialAddress,
 			if( getBit(currentInstruction, index) )
 			{
 				// write word to memory
-				if( !writeWord(initialAddress, getRegister(index) ) )
+				if( words != NULL )
+					*words++ = getRegister(index);
+				else if( !writeWord(initialAddress, getRegister(index) ) )
 				{
 					exceptionDataAbort();
 					return FALSE;
@@ -3934,7 +4312,9 @@ inline bool CArm::performBlockDataTransferStore(uint rn, uint32 initialAddress,
 		// handle r15 separately
 		if( getBit(currentInstruction, 15) )
 		{
-			if( !writeWord(initialAddress, getRegisterWithPSRAndPipelining(15) ) )
+			if( words != NULL )
+				*words = getRegisterWithPSRAndPipelining(15);
+			else if( !writeWord(initialAddress, getRegisterWithPSRAndPipelining(15) ) )
 			{
 				exceptionDataAbort();
 				return FALSE;
@@ -4061,6 +4441,8 @@ inline bool CArm::performBlockDataTransferLoad(uint rn, uint32 initialAddress, u
 {
 	if( isValidAddress(initialAddress) )
 	{
+		uint32 *words = directWords(initialAddress, countSetBits(getField(currentInstruction, 0, 15)), FALSE);
+
 		// handle writeback
 		//if(rn != 15)
 			setRegister(rn, finalAddress);
@@ -4073,7 +4455,9 @@ inline bool CArm::performBlockDataTransferLoad(uint rn, uint32 initialAddress, u
 			{
 				// read appropriate word from memory
 				uint32 location;
-				if( !readWord(initialAddress, location) )
+				if( words != NULL )
+					location = *words++;
+				else if( !readWord(initialAddress, location) )
 				{
 					// update base address
 					if(rn != 15)
@@ -4419,9 +4803,6 @@ inline void CArm::setProcessorStatusFlags(uint32 mask, uint32 value)
 // if it's r15 then don't update PSR but do invalidate the prefetch
 inline void CArm::setRegisterWithPrefetch(uint regNumber, uint32 value)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, FALSE);
-
 	// if r15 then only adjust PC (not PSR as well)
 	if(regNumber == 15)
 	{
@@ -4438,27 +4819,18 @@ inline void CArm::setRegisterWithPrefetch(uint regNumber, uint32 value)
 // plain accessor method for registers, adjusts PSR if r15 etc.
 inline void CArm::setRegister(uint regNumber, uint32 value)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, FALSE);
-
 	r[regNumber] = value;
 }
 
 // get the plain value of a register (without psr if r15)
 inline uint32 CArm::getRegister(uint regNumber)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, TRUE);
-
 	return r[regNumber];
 }
 
 // get the value of a register (with psr if r15)
 inline uint32 CArm::getRegisterWithPSR(uint regNumber)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, TRUE);
-
 	if(regNumber == 15)
 	{
 		return ( r[15] | getProcessorStatusRegister() );
@@ -4472,9 +4844,6 @@ inline uint32 CArm::getRegisterWithPSR(uint regNumber)
 // get the value of a register (if r15 then +4 for pipelining effect)
 inline uint32 CArm::getRegisterWithPipelining(uint regNumber)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, TRUE);
-
 	if(regNumber == 15)
 	{
 		return r[15] + 4;
@@ -4488,9 +4857,6 @@ inline uint32 CArm::getRegisterWithPipelining(uint regNumber)
 // get the value of a register (if r15 then with PSR and +4 for pipelining effect)
 inline uint32 CArm::getRegisterWithPSRAndPipelining(uint regNumber)
 {
-	if(dynamicProfilingRegisterUse)
-		dynamicProfilingRegisterUsage(regNumber, TRUE);
-
 	if(regNumber == 15)
 	{
 		return ( r[15] | getProcessorStatusRegister() ) + 4;
@@ -4672,8 +5038,8 @@ inline void CArm::exceptionReset()
 	// jump to reset vector
 	setRegisterWithPrefetch(15, RESET_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("Reset Exception", resetCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_RESET]++;
 }
 
 // note, in each of these cases, calling setProcessorStatusFlags can cahnge the processor
@@ -4696,8 +5062,8 @@ inline void CArm::exceptionUndefinedInstruction()
 	// jump to address exception vector
 	setRegisterWithPrefetch(15, UNDEFINED_INSTRUCTION_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("Undefined Instruction Exception", undefCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_UNDEFINED]++;
 }
 
 inline void CArm::exceptionSoftwareInterrupt()
@@ -4715,8 +5081,8 @@ inline void CArm::exceptionSoftwareInterrupt()
 	// jump to address exception vector
 	setRegisterWithPrefetch(15, SOFTWARE_INTERRUPT_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("SWI Exception", swiCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_SWI]++;
 }
 
 inline void CArm::exceptionPrefetchAbort()
@@ -4734,8 +5100,8 @@ inline void CArm::exceptionPrefetchAbort()
 	// jump to vector
 	setRegisterWithPrefetch(15, PREFETCH_ABORT_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("Prefetch Abort Exception", prefAbortCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_PREFETCH_ABORT]++;
 }
 
 inline void CArm::exceptionDataAbort()
@@ -4753,8 +5119,8 @@ inline void CArm::exceptionDataAbort()
 	// jump to vector
 	setRegisterWithPrefetch(15, DATA_ABORT_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("Data Abort Exception", dataAbortCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_DATA_ABORT]++;
 
 }
 
@@ -4773,8 +5139,8 @@ inline void CArm::exceptionInterruptRequest()
 	// jump to vector
 	setRegisterWithPrefetch(15, INTERRUPT_REQUEST_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("IRQ Exception", irqCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_IRQ]++;
 }
 
 inline void CArm::exceptionFastInterruptRequest()
@@ -4792,8 +5158,8 @@ inline void CArm::exceptionFastInterruptRequest()
 	// jump to vector
 	setRegisterWithPrefetch(15, FAST_INTERRUPT_REQUEST_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("FIQ Exception", fiqCounter);	
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_FIQ]++;
 }
 
 // only occurs on 26 bit architectures
@@ -4813,8 +5179,8 @@ inline void CArm::exceptionAddress()
 	// jump to vector
 	setRegisterWithPrefetch(15, ADDRESS_EXCEPTION_VECTOR);
 
-	if(dynamicProfilingExceptionFreq)
-		dynamicProfilingExceptionFrequency("Address Exception", addrExcepCounter);
+	if(profile)
+		profile->exceptions[ARM_EXCEPTION_ADDRESS]++;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -4858,9 +5224,6 @@ inline bool CArm::coprocessorRegisterTransferRead()
 
 	uint coprocessorNumber = getField(currentInstruction, 8, 11);
 
-	if(dynamicProfilingCoprocessorUse)
-		dynamicProfilingCoprocessorUsage(currentInstruction);
-
 	exceptionUndefinedInstruction();
 	return FALSE;
 }
@@ -4870,9 +5233,6 @@ inline bool CArm::coprocessorDataOperation()
 {
 	uint coprocessorNumber = getField(currentInstruction, 8, 11);
 
-	if(dynamicProfilingCoprocessorUse)
-		dynamicProfilingCoprocessorUsage(currentInstruction);
-
 	exceptionUndefinedInstruction();
 	return FALSE;
 }
@@ -4880,9 +5240,6 @@ inline bool CArm::coprocessorDataOperation()
 // get the coprocessor data transfer immediate offset from the current instruction
 inline uint32 CArm::coprocessorDataTransferOffset()
 {
-	if(dynamicProfilingCoprocessorUse)
-		dynamicProfilingCoprocessorUsage(currentInstruction);
-
 	return (currentInstruction & 0xff) << 2;
 }
 
@@ -4971,77 +5328,271 @@ int CArm::GetMode()
 }
 
 //////////////////////////////////////////////////////////////////////
-// Dynamic Profiling routines, for testing ARM feature usage
+// Dynamic Profiling routines, for seeing where ARM code spends its time
 //////////////////////////////////////////////////////////////////////
 
-void CArm::dynamicProfilingExceptionFrequency(char *exceptionName, uint32 &counter)
+static const char *opcodeClassNames[ARM_OP_CLASSES] =
 {
-	WriteLog("%s executionCount=%d\n", exceptionName, executionCount - exceptionLastExecutionCount);
-	exceptionLastExecutionCount = executionCount;
-	counter++;
-}
+	"dataRegister", "dataImmediate", "multiply", "swap", "singleTransfer",
+	"blockTransfer", "branch", "coproTransfer", "coproOperation", "swi", "undefined"
+};
 
-void CArm::dynamicProfilingExceptionFrequencyReport()
-{
-	WriteLog(">>>>>>>>>> Report Totals\n");
-	WriteLog("Reset = %d\n", resetCounter);
-	WriteLog("Undefined Instruction = %d\n", undefCounter);
-	WriteLog("SWI = %d\n", swiCounter);
-	WriteLog("prefetch abort = %d\n", prefAbortCounter);
-	WriteLog("data abort = %d\n", dataAbortCounter);
-	WriteLog("address exception = %d\n", addrExcepCounter);
-	WriteLog("IRQ exception = %d\n", irqCounter);
-	WriteLog("FIQ exception = %d\n", fiqCounter);
-}
+static const char *exceptionNames[ARM_EXCEPTIONS] =
+{
+	"reset", "undefined", "swi", "prefetchAbort", "dataAbort", "address", "irq", "fiq"
+};
+
+static const char *conditionNames[16] =
+{
+	"eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc",
+	"hi", "ls", "ge", "lt", "gt", "le", "al", "nv"
+};
 
-void CArm::dynamicProfilingRegisterUsage(uint regNumber, bool get)
+// start (with all counts cleared) or stop profiling
+void CArm::setProfiling(bool enable)
 {
-	if(get)
+	if(enable)
 	{
-		registerGotCounter[regNumber]++;
+		if(profile == NULL)
+			profile = (ArmProfile *) malloc(sizeof(ArmProfile));
+
+		resetProfile();
 	}
 	else
 	{
-		registerSetCounter[regNumber]++;
+		free(profile);
+		profile = NULL;
 	}
 }
 
-void CArm::dynamicProfilingRegisterUsageReport()
+void CArm::resetProfile()
 {
-	WriteLog("Register usage profiling");
+	if(profile)
+		memset(profile, 0, sizeof(ArmProfile));
+}
 
-	for(int regNumber=0; regNumber<16; regNumber++)
+// decode the instruction class from bits 4-7 and 24-27
+ArmOpcodeClass CArm::opcodeClassOf(uint32 instruction)
+{
+	switch( getField(instruction, 25, 27) )
 	{
-		WriteLog("r%d got=%d set=%d\n", regNumber, registerGotCounter[regNumber], registerSetCounter[regNumber] );
+		case 0:
+			if( (instruction & 0x0fc000f0) == 0x00000090 )
+				return ARM_OP_MULTIPLY;
+			if( (instruction & 0x0fb00ff0) == 0x01000090 )
+				return ARM_OP_SWAP;
+			return ARM_OP_DATA_REGISTER;
+		case 1:
+			return ARM_OP_DATA_IMMEDIATE;
+		case 2:
+			return ARM_OP_SINGLE_TRANSFER;
+		case 3:
+			// register offset with bit 4 set is undefined
+			return getBit(instruction, 4) ? ARM_OP_UNDEFINED : ARM_OP_SINGLE_TRANSFER;
+		case 4:
+			return ARM_OP_BLOCK_TRANSFER;
+		case 5:
+			return ARM_OP_BRANCH;
+		case 6:
+			return ARM_OP_COPRO_TRANSFER;
+		default:
+			return getBit(instruction, 24) ? ARM_OP_SWI : ARM_OP_COPRO_OPERATION;
 	}
 }
 
-void CArm::dynamicProfilingConditionalExe(uint32 currentInstruction)
+// called from run() for every instruction while profiling
+void CArm::profileInstruction(uint32 instruction)
 {
-	if( executeConditionally(currentInstruction) )
+	uint32 address = (r[15] - 8) & PC_MASK;
+	uint condition = getField(instruction, 28, 31);
+	ArmOpcodeClass opcodeClass = opcodeClassOf(instruction);
+
+	profile->instructions++;
+	profile->opcodeClass[opcodeClass]++;
+
+	if(address < 0x400000)
+		profile->ramHits[address >> 2]++;
+	else if( (address & ~0x3fff) == 0x3000000 )
+		profile->romHits[(address & 0x3fff) >> 2]++;
+	else
+		profile->otherHits++;
+
+	if(opcodeClass == ARM_OP_COPRO_TRANSFER || opcodeClass == ARM_OP_COPRO_OPERATION)
+		profile->coprocessor[ getField(instruction, 8, 11) ]++;
+
+	if( executeConditionally(instruction) )
 	{
-		// executed
-		conditionallyExecuted[ getField(currentInstruction, 28, 31) ]++;
+		profile->conditionallyExecuted[condition]++;
+		profileRegisters(instruction, opcodeClass);
 	}
 	else
 	{
-		// not executed
-		conditionallyNotExecuted[ getField(currentInstruction, 28, 31) ]++;
+		profile->conditionallyNotExecuted[condition]++;
 	}
 }
 
-void CArm::dynamicProfilingConditionalExeReport()
+// count the registers an executed instruction reads and writes, from
+// its encoding rather than in the register accessors so they stay free
+void CArm::profileRegisters(uint32 instruction, ArmOpcodeClass opcodeClass)
 {
-	WriteLog("Conditional Execution profiling");
+	uint rn = getField(instruction, 16, 19);
+	uint rd = getField(instruction, 12, 15);
+	uint rm = getField(instruction, 0, 3);
 
-	for(int condition=0; condition<16; condition++)
+	switch(opcodeClass)
 	{
-		WriteLog("cond=%d exe=%d not=%d\n", condition, conditionallyExecuted[condition], conditionallyNotExecuted[condition] );
+		case ARM_OP_DATA_REGISTER:
+		case ARM_OP_DATA_IMMEDIATE:
+		{
+			uint opcode = getField(instruction, 21, 24);
+
+			// mov and mvn have no operand 1
+			if(opcode != 0xd && opcode != 0xf)
+				profile->registerGot[rn]++;
+			// tst, teq, cmp and cmn only set the PSR
+			if(opcode < 0x8 || opcode > 0xb)
+				profile->registerSet[rd]++;
+			if(opcodeClass == ARM_OP_DATA_REGISTER)
+			{
+				profile->registerGot[rm]++;
+				if( getBit(instruction, 4) )
+					profile->registerGot[ getField(instruction, 8, 11) ]++;
+			}
+			break;
+		}
+		case ARM_OP_MULTIPLY:
+			// destination in bits 16-19, accumulator in 12-15
+			profile->registerSet[rn]++;
+			profile->registerGot[rm]++;
+			profile->registerGot[ getField(instruction, 8, 11) ]++;
+			if( getBit(instruction, 21) )
+				profile->registerGot[rd]++;
+			break;
+		case ARM_OP_SWAP:
+			profile->registerGot[rn]++;
+			profile->registerGot[rm]++;
+			profile->registerSet[rd]++;
+			break;
+		case ARM_OP_SINGLE_TRANSFER:
+			profile->registerGot[rn]++;
+			if( getBit(instruction, 20) )
+				profile->registerSet[rd]++;
+			else
+				profile->registerGot[rd]++;
+			if( getBit(instruction, 25) )
+				profile->registerGot[rm]++;
+			break;
+		case ARM_OP_BLOCK_TRANSFER:
+			profile->registerGot[rn]++;
+			for(int regNumber=0; regNumber<16; regNumber++)
+			{
+				if( getBit(instruction, regNumber) )
+				{
+					if( getBit(instruction, 20) )
+						profile->registerSet[regNumber]++;
+					else
+						profile->registerGot[regNumber]++;
+				}
+			}
+			break;
+		case ARM_OP_BRANCH:
+			if( getBit(instruction, 24) )
+				profile->registerSet[14]++;
+			break;
+		case ARM_OP_COPRO_TRANSFER:
+			profile->registerGot[rn]++;
+			break;
+		default:
+			break;
 	}
 }
 
-void CArm::dynamicProfilingCoprocessorUsage(uint32 currentInstruction)
+// write the profile out as JSON, returns FALSE if not profiling or the
+// file can't be written
+bool CArm::dumpProfile(const char *fileName)
 {
-	WriteLog("copro number=%d instructions=%d\n", getField(currentInstruction, 8, 11), executionCount - lastCopro);
-	lastCopro = executionCount;
+	uint32 hotAddress[ARM_PROFILE_HOT_PCS];
+	uint32 hotCount[ARM_PROFILE_HOT_PCS];
+	int hotPCs = 0;
+	int i;
+
+	if(profile == NULL)
+		return FALSE;
+
+	FILE *fd = fopen(fileName, "w");
+	if(fd == NULL)
+		return FALSE;
+
+	// keep the busiest addresses, sorted by count, as the RAM and
+	// ROM histograms are scanned
+	for(uint32 word = 0; word < ARM_PROFILE_RAM_WORDS + ARM_PROFILE_ROM_WORDS; word++)
+	{
+		uint32 count;
+		uint32 address;
+
+		if(word < ARM_PROFILE_RAM_WORDS)
+		{
+			count = profile->ramHits[word];
+			address = word << 2;
+		}
+		else
+		{
+			count = profile->romHits[word - ARM_PROFILE_RAM_WORDS];
+			address = 0x3000000 + ((word - ARM_PROFILE_RAM_WORDS) << 2);
+		}
+
+		if(count == 0 || (hotPCs == ARM_PROFILE_HOT_PCS && count <= hotCount[hotPCs - 1]))
+			continue;
+
+		if(hotPCs < ARM_PROFILE_HOT_PCS)
+			hotPCs++;
+
+		for(i = hotPCs - 1; i > 0 && hotCount[i - 1] < count; i--)
+		{
+			hotAddress[i] = hotAddress[i - 1];
+			hotCount[i] = hotCount[i - 1];
+		}
+		hotAddress[i] = address;
+		hotCount[i] = count;
+	}
+
+	fprintf(fd, "{\n");
+	fprintf(fd, "  \"instructions\": %llu,\n", profile->instructions);
+
+	fprintf(fd, "  \"opcodeClasses\": {");
+	for(i = 0; i < ARM_OP_CLASSES; i++)
+		fprintf(fd, "%s\n    \"%s\": %llu", i ? "," : "", opcodeClassNames[i], profile->opcodeClass[i]);
+	fprintf(fd, "\n  },\n");
+
+	fprintf(fd, "  \"exceptions\": {");
+	for(i = 0; i < ARM_EXCEPTIONS; i++)
+		fprintf(fd, "%s\n    \"%s\": %llu", i ? "," : "", exceptionNames[i], profile->exceptions[i]);
+	fprintf(fd, "\n  },\n");
+
+	fprintf(fd, "  \"conditions\": {");
+	for(i = 0; i < 16; i++)
+		fprintf(fd, "%s\n    \"%s\": { \"executed\": %llu, \"notExecuted\": %llu }", i ? "," : "",
+			conditionNames[i], profile->conditionallyExecuted[i], profile->conditionallyNotExecuted[i]);
+	fprintf(fd, "\n  },\n");
+
+	fprintf(fd, "  \"registers\": [");
+	for(i = 0; i < 16; i++)
+		fprintf(fd, "%s\n    { \"got\": %llu, \"set\": %llu }", i ? "," : "",
+			profile->registerGot[i], profile->registerSet[i]);
+	fprintf(fd, "\n  ],\n");
+
+	fprintf(fd, "  \"coprocessors\": [");
+	for(i = 0; i < 16; i++)
+		fprintf(fd, "%s%llu", i ? ", " : "", profile->coprocessor[i]);
+	fprintf(fd, "],\n");
+
+	fprintf(fd, "  \"hotPCs\": [");
+	for(i = 0; i < hotPCs; i++)
+		fprintf(fd, "%s\n    { \"pc\": \"%08x\", \"count\": %u }", i ? "," : "", hotAddress[i], hotCount[i]);
+	fprintf(fd, "\n  ],\n");
+
+	fprintf(fd, "  \"otherPCs\": %llu\n", profile->otherHits);
+	fprintf(fd, "}\n");
+
+	return fclose(fd) == 0;
 }
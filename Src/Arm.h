@@ -92,11 +92,102 @@ union Signals
 	};
 };
 
-// dynamic profiling options
-const bool dynamicProfilingExceptionFreq = FALSE;
-const bool dynamicProfilingRegisterUse = FALSE;
-const bool dynamicProfilingConditionalExecution = FALSE;
-const bool dynamicProfilingCoprocessorUse = TRUE;
+// basic block cache, holding straight line runs of decoded instructions that
+// runBlock() runs one after another, without the prefetch or readWord()
+#define ARM_BLOCK_CACHE_SIZE	2048		// blocks, direct mapped on start address
+#define ARM_BLOCK_LENGTH		32			// most instructions held in a block
+#define ARM_CODE_PAGE_SHIFT		12			// blocks never cross a 4 KByte page
+#define ARM_CODE_PAGE_SIZE		(1 << ARM_CODE_PAGE_SHIFT)
+#define ARM_CODE_PAGES			(0x400000 >> ARM_CODE_PAGE_SHIFT)
+
+// memory map for the word aligned fast path, 4 MByte regions covering the
+// 26 bit address space. Regions with no memory (or only part of a region,
+// like the tube) go through the slow path
+#define ARM_REGION_SHIFT		22
+#define ARM_REGIONS				(0x4000000 >> ARM_REGION_SHIFT)
+#define ARM_REGION_MASK			((1 << ARM_REGION_SHIFT) - 1)
+
+struct ArmMemoryRegion
+{
+	uint8 *memory;							// NULL if not directly mapped
+	uint32 limit;							// bytes of memory from the start of the region
+	bool writable;
+};
+
+// runs the instruction in currentInstruction, one for each value of bits
+// 20-27. Returns FALSE if the PC mustn't be updated after it
+class CArm;
+typedef bool (*ArmHandler)(CArm *arm);
+
+// an instruction as the prefetch hands it to run(), with its handler and
+// condition already picked out. Cached instructions are decoded once, when
+// their block is built
+struct ArmDecoded
+{
+	uint32 instruction;
+	uint8 condition;						// bits 28-31 in the top nibble, ready to index the condition table
+	ArmHandler handler;
+};
+
+struct ArmBlock
+{
+	uint32 address;							// address of the first instruction
+	uint32 length;							// instructions held, 0 if unused
+	bool conditional;						// TRUE if any instruction has a condition other than AL
+	ArmBlock *pageNext;						// next block built from the same RAM page
+	ArmBlock **pagePrevious;				// what points to this block on its page's list, NULL if not on one
+	ArmDecoded instructions[ARM_BLOCK_LENGTH];
+};
+
+// dynamic profiling, switched on and off at run time with setProfiling().
+// When off the only cost is one test of the profile pointer per instruction
+enum ArmOpcodeClass
+{
+	ARM_OP_DATA_REGISTER,					// data processing, register operand 2
+	ARM_OP_DATA_IMMEDIATE,					// data processing, immediate operand 2
+	ARM_OP_MULTIPLY,
+	ARM_OP_SWAP,
+	ARM_OP_SINGLE_TRANSFER,
+	ARM_OP_BLOCK_TRANSFER,
+	ARM_OP_BRANCH,
+	ARM_OP_COPRO_TRANSFER,
+	ARM_OP_COPRO_OPERATION,					// data operations and register transfers
+	ARM_OP_SWI,
+	ARM_OP_UNDEFINED,
+	ARM_OP_CLASSES
+};
+
+enum ArmException
+{
+	ARM_EXCEPTION_RESET,
+	ARM_EXCEPTION_UNDEFINED,
+	ARM_EXCEPTION_SWI,
+	ARM_EXCEPTION_PREFETCH_ABORT,
+	ARM_EXCEPTION_DATA_ABORT,
+	ARM_EXCEPTION_ADDRESS,
+	ARM_EXCEPTION_IRQ,
+	ARM_EXCEPTION_FIQ,
+	ARM_EXCEPTIONS
+};
+
+#define ARM_PROFILE_RAM_WORDS	(0x400000 >> 2)
+#define ARM_PROFILE_ROM_WORDS	(0x4000 >> 2)
+#define ARM_PROFILE_HOT_PCS		32			// busiest addresses written by dumpProfile()
+
+struct ArmProfile
+{
+	uint64 instructions;
+	uint64 opcodeClass[ARM_OP_CLASSES];
+	uint64 conditionallyExecuted[16];
+	uint64 conditionallyNotExecuted[16];
+	uint64 registerGot[16];
+	uint64 registerSet[16];
+	uint64 coprocessor[16];
+	uint64 exceptions[ARM_EXCEPTIONS];
+	uint32 ramHits[ARM_PROFILE_RAM_WORDS];	// instructions executed at each RAM address
+	uint32 romHits[ARM_PROFILE_ROM_WORDS];	// and each ROM address
+	uint64 otherHits;						// anywhere else
+};
 
 extern int Enable_Arm;
 extern int ArmTube;
@@ -108,9 +199,10 @@ class CArm
 
 // functions
 public:
-	void dynamicProfilingCoprocessorUsage(uint32 currentInstruction);
-	void dynamicProfilingExceptionFrequencyReport();
-	void dynamicProfilingExceptionFrequency(char *exceptionName, uint32& counter);
+	void setProfiling(bool enable);
+	bool isProfiling() { return profile != NULL; }
+	void resetProfile();
+	bool dumpProfile(const char *fileName);
 	int GetMode();
 	Reg GetUserRegister(unsigned int reg);
 	void SetMode(int mode);
@@ -163,7 +255,11 @@ public:
 	inline void performSingleDataSwapByte();
 	inline void performSingleDataSwapWord();
 
+	inline bool fetchInstruction(uint32 address, ArmDecoded& destination);
 	inline bool readWord(uint32 address, uint32& destination);
+	bool readWordSlow(uint32 address, uint32& destination);
+	inline uint32 *directWords(uint32 address, uint count, bool write);
+	bool writeWordSlow(uint32 address, uint32 data);
 	inline bool readByte(uint32 address, uint8& destination);
 	inline bool writeByte(uint32 address, uint8 value);
 	inline bool writeWord(uint32 address, uint32 data);
@@ -181,6 +277,7 @@ public:
 	inline void updateAddFlags(uint32 operand1, uint32 operand2, uint32 result);
 	inline void updateSubFlags(uint32 operand1, uint32 operand2, uint32 result);
 	inline bool executeConditionally(uint32 instruction);
+	inline bool conditionPassed(uint8 condition);
 
 	// generic instruction templates
 	inline void setDestinationS(uint32 value);
@@ -228,10 +325,28 @@ public:
 	inline void exceptionDataAbort();
 
 	// control
-	void exec(int count);
+	int exec(int count);			// returns the number of instructions run
 	void run(void);
+	int runBlock(int count);		// returns the number of instructions run
+	template<bool Conditional> inline bool runInstructions(const ArmBlock *block, uint32& index, uint32 limit);
+	inline bool refillPrefetch();
+	inline void checkInterrupts();
 	void reset();
 	
+	// instruction handlers
+	template<uint Operation> inline bool execute();
+	template<uint Operation> static bool dispatch(CArm *arm);
+	static const ArmHandler handlers[256];
+	
+	// basic block cache
+	ArmBlock *lookupBlock(uint32 address);
+	static inline bool isBlockEnd(uint32 instruction);
+	static inline void decodeInstruction(ArmDecoded& decoded);
+	inline void checkCodeWrite(uint32 address);
+	void invalidateCodePage(uint page);
+	void unlinkBlock(ArmBlock *block);
+	void flushBlockCache();
+
 	// utility
 	static inline bool getNegative(uint32 value);
 	static inline bool getPositive(uint32 value);
@@ -249,11 +364,10 @@ public:
 	Word stop_address;
 	
 private:
-	uint32 lastCopro;				// num of instructions executed since last copro instruction profiled
-	void dynamicProfilingConditionalExe(uint32 currentInstruction);
-	void dynamicProfilingConditionalExeReport();
-	void dynamicProfilingRegisterUsageReport();
-	void dynamicProfilingRegisterUsage(uint regNumber, bool get);
+	ArmProfile *profile;			// NULL unless profiling
+	void profileInstruction(uint32 instruction);
+	void profileRegisters(uint32 instruction, ArmOpcodeClass opcodeClass);
+	static ArmOpcodeClass opcodeClassOf(uint32 instruction);
 	
 	
 	
@@ -265,7 +379,7 @@ private:
 	uint trace;
 	
 	bool	prefetchInvalid;
-	uint32	prefetchInstruction;
+	ArmDecoded	prefetchDecoded;
 	uint32	currentInstruction;
 	uint32	r[16];					// current bank of registers
 	uint32	usrR[16];				// user mode registers
@@ -277,6 +391,15 @@ private:
 	// look up tables
 	uint32 immediateCarry[4096];
 	uint32 immediateValue[4096];
+
+	// word aligned fast path memory map
+	ArmMemoryRegion memoryRegions[ARM_REGIONS];
+
+	// basic block cache
+	ArmBlock blockCache[ARM_BLOCK_CACHE_SIZE];
+	ArmBlock noBlock;				// empty block, so fetchBlock is never NULL
+	ArmBlock *fetchBlock;			// block the prefetch is running through
+	ArmBlock *codePageBlocks[ARM_CODE_PAGES];	// blocks built from each RAM page
 	
 	// TEST ENVIRONMENT VARIABLES
 	uint8 romMemory[0x4000];		// 16 KBytes of rom memory
@@ -288,19 +411,6 @@ private:
 	uint32 previousProcessorMode;
 	uint32 modeCounter;
 	uint32 modeTotal[4];
-	uint32 resetCounter;
-	uint32 undefCounter;
-	uint32 swiCounter;
-	uint32 prefAbortCounter;
-	uint32 dataAbortCounter;
-	uint32 addrExcepCounter;
-	uint32 irqCounter;
-	uint32 fiqCounter;
-	uint32 exceptionLastExecutionCount;
-	uint32 registerSetCounter[16];
-	uint32 registerGotCounter[16];
-	uint32 conditionallyExecuted[16];
-	uint32 conditionallyNotExecuted[16];
 	int iocounter;
 	// END OF TEST ENVIRONMENT VARIABLES
 
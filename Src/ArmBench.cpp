@@ -0,0 +1,192 @@
+/****************************************************************
+BeebEm - BBC Micro and Master 128 Emulator
+Copyright (C) 2001  David Sharp
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public
+License along with this program; if not, write to the Free
+Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+Boston, MA  02110-1301, USA.
+****************************************************************/
+
+//////////////////////////////////////////////////////////////////////
+// ArmBench.cpp: times the ARM co-processor core on its own.
+//
+// Not part of BeebEm.exe. It builds as a console program from Arm.cpp
+// and ArmDisassembler.cpp, with stand ins below for the parts of the
+// emulator they call, e.g.
+//
+//   cl /O2 /EHsc ArmBench.cpp Arm.cpp ArmDisassembler.cpp
+//
+// Each test is a small ARM program loaded into RAM at address 0 and run
+// until it sets its done register to zero. The result register is checked
+// against the known answer, then the instruction rate is reported.
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "main.h"
+#include "tube.h"
+#include "beebmem.h"
+
+#include "Arm.h"
+
+#define ARM_BENCH_SLICE		1000000		// instructions per call to exec()
+
+// stand ins for the rest of the emulator
+char RomPath[_MAX_PATH] = "";
+unsigned char TubeintStatus = 0;
+unsigned char TubeNMIStatus = 0;
+bool TubeStateChanged = false;
+
+void WriteLog(char *fmt, ...)
+{
+}
+
+unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr)
+{
+	return 0;
+}
+
+void WriteTubeFromParasiteSide(unsigned char IOAddr, unsigned char IOData)
+{
+}
+
+struct ArmBenchTest
+{
+	const char *name;
+	const uint32 *code;
+	int words;
+	int doneRegister;			// counts down to zero
+	int resultRegister;
+	uint32 result;
+};
+
+// byte sieve of Eratosthenes, 8192 flags at 0x8000, 1000 passes
+//
+//			mov	r5, #1000
+//	outer:	mov	r0, #0x8000
+//			mov	r1, #8192
+//			mov	r6, #1
+//			mov	r9, #0
+//			mov	r2, #0
+//	fill:	strb	r6, [r0, r2]
+//			add	r2, r2, #1
+//			cmp	r2, r1
+//			blt	fill
+//			mov	r3, #0
+//			mov	r2, #0
+//	loop:	ldrb	r8, [r0, r2]
+//			cmp	r8, #0
+//			beq	next
+//			add	r7, r2, r2
+//			add	r7, r7, #3
+//			add	r4, r2, r7
+//	clear:	cmp	r4, r1
+//			bge	cleared
+//			strb	r9, [r0, r4]
+//			add	r4, r4, r7
+//			b	clear
+//	cleared: add	r3, r3, #1
+//	next:	add	r2, r2, #1
+//			cmp	r2, r1
+//			blt	loop
+//			subs	r5, r5, #1
+//			bne	outer
+//	done:	b	done
+static const uint32 sieveCode[] =
+{
+	0xE3A05FFA, 0xE3A00902, 0xE3A01A02, 0xE3A06001, 0xE3A09000, 0xE3A02000,
+	0xE7C06002, 0xE2822001, 0xE1520001, 0xBAFFFFFB, 0xE3A03000, 0xE3A02000,
+	0xE7D08002, 0xE3580000, 0x0A000008, 0xE0827002, 0xE2877003, 0xE0824007,
+	0xE1540001, 0xAA000002, 0xE7C09004, 0xE0844007, 0xEAFFFFFA, 0xE2833001,
+	0xE2822001, 0xE1520001, 0xBAFFFFF0, 0xE2555001, 0x1AFFFFE3, 0xEAFFFFFE
+};
+
+// block copy with LDM/STM, 16 KBytes from 0x8000 to 0x10000, 40960 passes.
+// Each word of the source holds its own address
+//
+//			mov	r10, #0x8000
+//			add	r12, r10, #0x4000
+//	fill:	mov	r0, r10
+//			str	r0, [r10], #4
+//			cmp	r10, r12
+//			blt	fill
+//			mov	r9, #0xa000
+//	outer:	mov	r10, #0x8000
+//			add	r11, r10, #0x8000
+//	copy:	ldmia	r10!, {r0-r7}
+//			stmia	r11!, {r0-r7}
+//			cmp	r10, r12
+//			blt	copy
+//			ldr	r8, [r11, #-4]
+//			subs	r9, r9, #1
+//			bne	outer
+//	done:	b	done
+static const uint32 blockCopyCode[] =
+{
+	0xE3A0A902, 0xE28AC901, 0xE1A0000A, 0xE48A0004, 0xE15A000C, 0xBAFFFFFB,
+	0xE3A09A0A, 0xE3A0A902, 0xE28AB902, 0xE8BA00FF, 0xE8AB00FF, 0xE15A000C,
+	0xBAFFFFFB, 0xE51B8004, 0xE2599001, 0x1AFFFFF6, 0xEAFFFFFE
+};
+
+static const ArmBenchTest tests[] =
+{
+	{ "sieve", sieveCode, sizeof(sieveCode) / sizeof(sieveCode[0]), 5, 3, 1899 },
+	{ "ldm/stm", blockCopyCode, sizeof(blockCopyCode) / sizeof(blockCopyCode[0]), 9, 8, 0xBFFC },
+};
+
+static bool runTest(const ArmBenchTest *test)
+{
+	CArm *arm = new CArm();
+	double executed = 0;
+	clock_t start, ticks;
+	uint32 result;
+	int word;
+
+	for(word = 0; word < test->words; word++)
+		arm->writeWordSlow(word * 4, test->code[word]);
+
+	start = clock();
+	do
+	{
+		executed += arm->exec(ARM_BENCH_SLICE);
+	} while( arm->GetReg(test->doneRegister) != 0 );
+	ticks = clock() - start;
+
+	result = arm->GetReg(test->resultRegister);
+	delete arm;
+
+	if( result != test->result )
+	{
+		printf("%-8s wrong result %u, expected %u\n", test->name, result, test->result);
+		return false;
+	}
+
+	if( ticks == 0 )
+		ticks = 1;
+	printf("%-8s %10.0f instructions in %6.3f s: %7.2f MIPS\n", test->name, executed,
+		(double) ticks / CLOCKS_PER_SEC, executed * CLOCKS_PER_SEC / ticks / 1000000.0);
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	bool ok = true;
+
+	for(int test = 0; test < (int) (sizeof(tests) / sizeof(tests[0])); test++)
+		ok &= runTest(&tests[test]);
+
+	return ok ? 0 : 1;
+}
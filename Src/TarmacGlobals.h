@@ -36,6 +36,7 @@ typedef	unsigned int uint32;
 typedef unsigned int uint;			// assume any unsigned int larger than 8 bits
 typedef	unsigned short uint16;
 typedef	unsigned char uint8;
+typedef	unsigned long long uint64;
 typedef	signed int int32;
 // typedef	signed short int16;
 typedef	signed char int8;
@@ -72,16 +73,10 @@ inline uint32 getField(uint32 w, uint32 s, uint32 e)
 
 inline uint countSetBits(uint32 value)
 {
-	uint total = 0;
-	// while value has some set bits left in it
-	while( value )
-	{
-		// add the value of the bit we're currently looking at
-		total += (value & 1);
-		// shift right and drop the current bit off the end
-		value >>= 1;
-	}
-	return total;
+	// add up pairs of bits, then nibbles, then sum the bytes with a multiply
+	value = value - ((value >> 1) & 0x55555555);
+	value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+	return ( ((value + (value >> 4)) & 0x0f0f0f0f) * 0x01010101 ) >> 24;
 }
 
 //
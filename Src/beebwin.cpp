@@ -182,6 +182,7 @@ BeebWin::BeebWin()
 	m_RelativeSpeed = 1;
 	m_FramesPerSecond = 50;
 	strcpy(m_szTitle, WindowTitle);
+	m_CoProStatus[0] = 0;
 	m_AviDC = NULL;
 	m_AviDIB = NULL;
 	m_CaptureBitmapPending = false;
@@ -1809,6 +1810,7 @@ BOOL BeebWin::UpdateTiming(void)
 		m_ScreenRefreshCount = 0;
 		m_RelativeSpeed = ((TotalCycles - m_LastStatsTotalCycles) / 2000.0) /
 								(TickCount - m_LastStatsTickCount);
+		CoProStatus(m_CoProStatus, TickCount - m_LastStatsTickCount);
 		m_LastStatsTotalCycles = TotalCycles;
 		m_LastStatsTickCount += 1000;
 		DisplayTiming();
@@ -327,11 +327,12 @@ class BeebWin  {
 	HDC 		m_hDCBitmap;
 	HGDIOBJ 	m_hBitmap;
 	bmiData 	m_bmi;
-	char		m_szTitle[100];
+	char		m_szTitle[200];
 
 	int		m_ScreenRefreshCount;
 	double		m_RelativeSpeed;
 	double		m_FramesPerSecond;
+	char		m_CoProStatus[80];
 
 	char		m_clipboard[32768];
 	int		m_clipboardlen;
@@ -782,8 +782,8 @@ void BeebWin::DisplayTiming(void)
 {
 	if (m_ShowSpeedAndFPS && (m_DisplayRenderer == IDM_DISPGDI || !m_isFullScreen))
 	{
-		sprintf(m_szTitle, "%s  Speed: %2.2f  fps: %2d",
-				WindowTitle, m_RelativeSpeed, (int)m_FramesPerSecond);
+		sprintf(m_szTitle, "%s  Speed: %2.2f  fps: %2d%s",
+				WindowTitle, m_RelativeSpeed, (int)m_FramesPerSecond, m_CoProStatus);
 		SetWindowText(m_hWnd, m_szTitle);
 	}
 }
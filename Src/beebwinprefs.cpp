@@ -470,6 +470,11 @@ void BeebWin::LoadPreferences()
 	if (!PrefsGetBinaryValue("TubeEnabled",&TubeEnabled,1))
 		TubeEnabled=0;
 
+	if (PrefsGetDWORDValue("CoProQuantum",dword) && dword > 0)
+		CoProQuantum=dword;
+	else
+		CoProQuantum=COPRO_DEFAULT_QUANTUM;
+
 #ifdef M512COPRO_ENABLED
 	if (!PrefsGetBinaryValue("Tube186Enabled",&Tube186Enabled,1))
 		Tube186Enabled=0;
@@ -725,6 +730,7 @@ void BeebWin::SavePreferences(bool saveAll)
 		PrefsSetBinaryValue("TorchTube",&TorchTube,1);
 		PrefsSetBinaryValue("AcornZ80",&AcornZ80,1);
 		PrefsSetBinaryValue("TubeEnabled",&TubeEnabled,1);
+		PrefsSetDWORDValue("CoProQuantum",CoProQuantum);
 #ifdef M512COPRO_ENABLED
 		PrefsSetBinaryValue("Tube186Enabled",&Tube186Enabled,1);
 #endif
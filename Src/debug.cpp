@@ -39,6 +39,7 @@ Boston, MA  02110-1301, USA.
 #include "debug.h"
 #include "z80mem.h"
 #include "z80.h"
+#include "Arm.h"
 
 #define MAX_LINES 4096          // Max lines in info window
 #define LINES_IN_INFO 28        // Visible lines in info window
@@ -111,6 +112,7 @@ static MemoryMap MemoryMaps[17];
 BOOL CALLBACK DebugDlgProc(HWND hwndDlg, UINT message, WPARAM wParam, LPARAM lParam);
 extern HWND hCurrentDialog;
 extern HACCEL hCurrentAccelTable;
+extern CArm *arm;
 
 
 
@@ -152,7 +154,8 @@ DebugCmd DebugCmdTable[] = {
 	{ "f",		DebugCmdFile,"",""}, // Alias of "file"
 	{ "echo",	DebugCmdEcho, "string", "Write string to console." },
 	{ "!",	DebugCmdEcho, "","" }, // Alias of "echo"
-	{ "script",	DebugCmdScript, "[filename]", "Executes a debugger script." }
+	{ "script",	DebugCmdScript, "[filename]", "Executes a debugger script." },
+	{ "armprofile",	DebugCmdArmProfile, "on/off/reset/dump [file]", "Profiles the ARM co-processor, dump writes JSON." }
 };
 
 InstInfo optable[256] =
@@ -1876,6 +1879,51 @@ bool DebugCmdScript(char *args)
 	return true;
 }
 
+bool DebugCmdArmProfile(char *args)
+{
+	char command[8];
+	char filename[MAX_PATH];
+	memset(filename, 0, MAX_PATH);
+
+	if(sscanf(args, "%7s %259c", command, filename) < 1)
+		return false;
+
+	if(arm == NULL)
+	{
+		DebugDisplayInfo("ARM co-processor is not running.");
+		return true;
+	}
+
+	if(_stricmp(command, "on") == 0)
+	{
+		arm->setProfiling(true);
+		DebugDisplayInfo("ARM profiling on.");
+	}
+	else if(_stricmp(command, "off") == 0)
+	{
+		arm->setProfiling(false);
+		DebugDisplayInfo("ARM profiling off.");
+	}
+	else if(_stricmp(command, "reset") == 0)
+	{
+		arm->resetProfile();
+	}
+	else if(_stricmp(command, "dump") == 0 && filename[0] != '\0')
+	{
+		if(!arm->isProfiling())
+			DebugDisplayInfo("ARM profiling is off.");
+		else if(arm->dumpProfile(filename))
+			DebugDisplayInfoF("ARM profile written to %s", filename);
+		else
+			DebugDisplayInfoF("Failed to write ARM profile to %s", filename);
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
 bool DebugCmdLabels(char *args)
 {
 	int i;
@@ -150,5 +150,6 @@ bool DebugCmdGoto(char* args);
 bool DebugCmdFile(char* args);
 bool DebugCmdEcho(char* args);
 bool DebugCmdScript(char *args);
+bool DebugCmdArmProfile(char *args);
 
 #endif
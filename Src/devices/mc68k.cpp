@@ -44,6 +44,11 @@ mc68k::mc68k(int CPUType, int FPUType, int MMUType) {
 			this->EXTERNAL_ADDRESS_MASK = 0xFFFFFFFF;
 			break;
 	}
+
+	this->traceRegisters = false;
+	this->linearDecode = false;
+	if (handlerListCount == 0)
+		this->buildDecodeTable();
 }
 
 mc68k::~mc68k(void) {
@@ -51,6 +56,282 @@ mc68k::~mc68k(void) {
 
 
 
+/* Opcode decoding */
+
+OPCODE			mc68k::decodeTable[0x10000];
+mc68k::HANDLER	mc68k::handlerLists[MC68K_MAX_HANDLER_LISTS][MC68K_MAX_HANDLERS + 1];
+int				mc68k::handlerListCount = 0;
+
+#define DECODE(h)	do { if (count < MC68K_MAX_HANDLERS) list[count++] = &mc68k::h; } while (0)
+
+// Work out which handlers an opcode runs. Some opcodes match more than one
+// of these tests and then all of the handlers run, in this order.
+int mc68k::decodeOpcode(unsigned short opcode, HANDLER *list) {
+	int		count = 0;
+
+	if ((opcode & 0xFF00) == 0x0000)
+		DECODE(ORIhandler);			// ORI
+
+	if ((opcode & 0xFF00) == 0x0200)
+		DECODE(ANDIhandler);		// ANDI
+
+	if ((opcode & 0xFF00) == 0x0400)
+		DECODE(CMPISUBIhandler);	// SUBI
+
+	if ((opcode & 0xFF00) == 0x0600)
+		DECODE(ADDIhandler);		// ADDI
+
+	if ((opcode & 0xFF00) == 0x0A00)
+		DECODE(EORIhandler);		// EORI
+
+	if ((opcode & 0xFF00) == 0x0C00)
+		DECODE(CMPISUBIhandler);	// CMPI
+
+	if ((opcode & 0xFFC0) == 0x0800)
+		DECODE(BTSThandler);		// BTST
+
+	if ((opcode & 0xFFC0) == 0x0840)
+		DECODE(BCHGhandler);		// BCHG
+
+	if ((opcode & 0xFFC0) == 0x0880)
+		DECODE(BCLRhandler);		// BCLR
+
+	if ((opcode & 0xFFC0) == 0x08C0)
+		DECODE(BSEThandler);		// BSET
+
+	if ((opcode & 0xF138) == 0x0108)
+		DECODE(MOVEPhandler);		// MOVEP
+
+	if (((opcode & 0xC000) == 0x0000) && (opcode & 0x3000) != 0)
+		DECODE(MOVEhandler);		// MOVE / MOVEA
+
+	if ((opcode & 0xFFC0) == 0x40C0)
+		DECODE(MOVEfromSRhandler);	// MOVE from SR
+
+	if ((opcode & 0xFFC0) == 0x44C0)
+		DECODE(MOVEtoCCRhandler);	// MOVE to CCR
+
+	if ((opcode & 0xFFC0) == 0x46C0)
+		DECODE(MOVEtoSRhandler);	// MOVE to SR
+
+	if (((opcode & 0xFB00) == 0x4000) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(NEGhandler);			// NEG and NEGX
+
+	if ((opcode & 0xFF00) == 0x4200)
+		DECODE(CLRhandler);			// CLR
+
+	if (((opcode & 0xFF00) == 0x4600) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(NOThandler);			// NOT
+
+	if ((opcode & 0xFFB8) == 0x4880)
+		DECODE(EXThandler);			// EXT
+
+	if ((opcode & 0xFFC0) == 0x4800)
+		DECODE(NBCDhandler);		// NBCD
+
+	if ((opcode & 0xFFF8) == 0x4840)
+		DECODE(SWAPhandler);		// SWAP
+
+	if (((opcode & 0xFFC0) == 0x4840) && ((opcode & 0x0038) != 0x0000))
+		DECODE(PEAhandler);			// PEA
+
+	if (opcode == 0x4AFC)
+		DECODE(ILLEGALhandler);		// ILLEGAL
+
+	if ((opcode & 0xFFC0) == 0x4AC0)
+		DECODE(TAShandler);			// TAS
+
+	if ((opcode & 0xFF00) == 0x4A00)
+		DECODE(TSThandler);			// TST
+
+	if ((opcode & 0xFFF0) == 0x4E40)
+		DECODE(TRAPhandler);		// TRAP
+
+	if ((opcode & 0xFFF8) == 0x4E50)
+		DECODE(LINKhandler);		// LINK
+
+	if ((opcode & 0xFFF8) == 0x4E58)
+		DECODE(UNLINKhandler);		// UNLINK
+
+	if ((opcode & 0xFFF0) == 0x4E60)
+		DECODE(MOVEUSPhandler);		// MOVE USP
+
+	if (opcode == 0x4E70)
+		DECODE(RESEThandler);		// RESET
+
+	// 0x4E71 NOP has nothing to do
+
+	if (opcode == 0x4E72)
+		DECODE(STOPhandler);		// STOP
+
+	if (opcode == 0x4E73)
+		DECODE(RTEhandler);			// RTE
+
+	if (opcode == 0x4E75)
+		DECODE(RTShandler);			// RTS
+
+	if (opcode == 0x4E76)
+		DECODE(TRAPVhandler);		// TRAPV
+
+	if (opcode == 0x4E77)
+		DECODE(RTRhandler);			// RTR
+
+	if ((opcode & 0xFFC0) == 0x4E80)
+		DECODE(JSRhandler);			// JSR
+
+	if ((opcode & 0xFFC0) == 0x4EC0)
+		DECODE(JMPhandler);			// JMP
+
+	if ((opcode & 0xFB80) == 0x4880)
+		DECODE(MOVEMhandler);		// MOVEM
+
+	if ((opcode & 0xF1C0) == 0x41C0)
+		DECODE(LEAhandler);			// LEA
+
+	if ((opcode & 0xF1C0) == 0x4180)
+		DECODE(CHKhandler);			// CHK
+
+	if (((opcode & 0xF100) == 0x5000) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(ADDQhandler);		// ADDQ
+
+	if (((opcode & 0xF100) == 0x5100) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(SUBQhandler);		// SUBQ
+
+	if ((opcode & 0xF0C0) == 0x50C0)
+		DECODE(SccDBcchandler);		// Scc / DBcc
+
+	if ((opcode & 0xF000) == 0x6000)
+		DECODE(Bcchandler);			// BRA / BSR / Bcc
+
+	if ((opcode & 0xF100) == 0x7000)
+		DECODE(MOVEQhandler);		// MOVEQ
+
+	if ((opcode & 0xF1C0) == 0x80C0)
+		DECODE(DIVUhandler);		// DIVU
+
+	if ((opcode & 0xF1C0) == 0x81C0)
+		DECODE(DIVShandler);		// DIVS
+
+	if ((opcode & 0xF1F0) == 0x8100)
+		DECODE(SBCDhandler);		// SBCD
+
+	if ((opcode & 0xF000) == 0x8000)
+		DECODE(ORhandler);			// OR
+
+	if ((opcode & 0xF000) == 0x9000) {		// SUB / SUBA / SUBX
+		if ((opcode & 0xF0C0) == 0x90C0)
+			DECODE(SUBAhandler);	// SUBA
+		else {
+			if ((opcode & 0xF130) == 0x9100)
+				DECODE(SUBXhandler);	// SUBX
+
+			DECODE(SUBhandler);		// SUB
+		}
+	}
+
+	if ((opcode & 0xF000) == 0xB000) {		// EOR, CMPM, CMP and CMPA
+		if ((opcode & 0xF0C0) == 0xB0C0)
+			DECODE(CMPAhandler);	// CMPA
+		else if ((opcode & 0xF138) == 0xB108)
+			DECODE(CMPMhandler);	// CMPM
+		else if ((opcode & 0xF100) == 0xB100)
+			DECODE(EORhandler);		// EOR
+		else if ((opcode & 0xF100) == 0xB000)
+			DECODE(CMPhandler);		// CMP
+	}
+
+	if ((opcode & 0xF000) == 0xC000) {		// MULU, MULS, ABCD, EXG and AND
+		if ((opcode & 0xF1C0) == 0xC0C0)
+			DECODE(MULUhandler);	// MULU
+
+		if ((opcode & 0xF1C0) == 0xC1C0)
+			DECODE(MULShandler);	// MULS
+
+		if ((opcode & 0xF1F0) == 0xC100)
+			DECODE(ABCDhandler);	// ABCD
+
+		if ((opcode & 0xF130) == 0xC100)
+			DECODE(EXGhandler);		// EXG
+		else if ((opcode & 0x00C0) != 0x00C0)
+			DECODE(ANDhandler);		// AND
+	}
+
+	if ((opcode & 0xF000) == 0xD000) {		// ADD
+		if ((opcode & 0xF0C0) == 0xD0C0)
+			DECODE(ADDAhandler);	// ADDA
+		else if ((opcode & 0xF130) == 0xD100)
+			DECODE(ADDXhandler);	// ADDX
+		else
+			DECODE(ADDhandler);		// ADD
+	}
+
+	if ((opcode & 0xFCC0) == 0xE0C0)
+		DECODE(ASxLSx_handler);		// ASR / ASL / LSR / LSL memory
+
+	if (((opcode & 0xF010) == 0xE000) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(ASxLSx_handler);		// ASR / ASL / LSR / LSL register
+
+	if ((opcode & 0xFCC0) == 0xE4C0)
+		DECODE(ROxROXx_handler);	// ROR / ROL / ROXR / ROXL memory
+
+	if (((opcode & 0xF010) == 0xE010) && ((opcode & 0x00C0) != 0x00C0))
+		DECODE(ROxROXx_handler);	// ROR / ROL / ROXR / ROXL register
+
+	return (count);
+}
+
+#undef DECODE
+
+// Split an opcode into the effective address, size, register and condition fields the handlers use.
+void mc68k::decodeFields(unsigned short opcode, OPCODE *decoded) {
+	decoded->ea			= (opcode & 0x003F);
+	decoded->size		= ((opcode & 0x00C0) >> 6);
+	decoded->reg		= ((opcode & 0x0E00) >> 9);
+	decoded->condition	= ((opcode & 0x0F00) >> 8);
+}
+
+// Build the decode table that maps every opcode to its list of handlers and
+// its effective address, size, register and condition fields. Identical handler lists
+// are shared, there are only a few dozen different ones.
+void mc68k::buildDecodeTable(void) {
+	HANDLER	list[MC68K_MAX_HANDLERS];
+	int		opcode, count, i, l;
+
+	handlerLists[0][0] = NULL;					// List 0 is the empty list
+	handlerListCount = 1;
+
+	for (opcode = 0; opcode < 0x10000; opcode++) {
+		count = this->decodeOpcode(opcode, list);
+
+		for (l = 0; l < handlerListCount; l++) {
+			for (i = 0; i < count; i++)
+				if (handlerLists[l][i] != list[i])
+					break;
+			if ((i == count) && (handlerLists[l][count] == NULL))
+				break;
+		}
+
+		if (l == handlerListCount) {
+			if (handlerListCount == MC68K_MAX_HANDLER_LISTS) {
+				WriteLog("%s::buildDecodeTable - out of handler lists at opcode %04X\n", __FILENAME__, opcode);
+				l = 0;
+			} else {
+				for (i = 0; i < count; i++)
+					handlerLists[l][i] = list[i];
+				handlerLists[l][count] = NULL;
+				handlerListCount++;
+			}
+		}
+
+		decodeTable[opcode].handlers	= l;
+		this->decodeFields(opcode, &decodeTable[opcode]);
+	}
+
+	WriteLog("%s::buildDecodeTable - %d handler lists\n", __FILENAME__, handlerListCount);
+}
+
+
+
 /* Main code */
 
 void mc68k::Reset(void) {
@@ -97,12 +378,17 @@ void mc68k::Reset(void) {
 	this->cpu.sr.reg	= 0x2700;								// Only supervisor bit is set on a reset
 	cyclecount			= 1000000;
 	this->DEBUG			= false;
+	this->traceRegisters	= false;
+	this->cyclesRun		= 0;
+	this->instructionsRun	= 0;
 }
 
 void mc68k::Exec(int Cycles) {
-	unsigned int	value;
-
-	unsigned char	size;
+	HANDLER			*handler;
+	HANDLER			list[MC68K_MAX_HANDLERS];
+	int				count, i;
+	unsigned char	intStatus = TubeintStatus;		// The tube interrupt lines the board sampled before calling us
+	unsigned char	nmiStatus = TubeNMIStatus;
 
 	while (Cycles > 0) {
 //		if (this->cpu.pc == 0x000007D4)	// Casper
@@ -155,404 +441,39 @@ void mc68k::Exec(int Cycles) {
 
 		if ((!this->cpu.stop) && (cyclecount > 0)) {
 			this->cpu.instruction_reg = this->readWord(this->cpu.pc);
-			this->dumpRegisters();
+			if (this->traceRegisters)
+				this->dumpRegisters();
 			this->cpu.pc += 2;
 
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0000)
-				this->ORIhandler();			// ORI
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0200)
-				this->ANDIhandler();		// ANDI
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0400)
-				this->CMPISUBIhandler();	// SUBI
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0600)
-				this->ADDIhandler();		// ADDI
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0A00)
-				this->EORIhandler();		// EORI
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x0C00)
-				this->CMPISUBIhandler();	// CMPI
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x0800)
-				this->BTSThandler();		// BTST
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x0840)
-				this->BCHGhandler();		// BCHG
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x0880)
-				this->BCLRhandler();		// BCLR
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x08C0)
-				this->BSEThandler();		// BSET
-
-			if ((this->cpu.instruction_reg & 0xF138) == 0x0108)
-				this->MOVEPhandler();		// MOVEP
-
-			if (((this->cpu.instruction_reg & 0xC000) == 0x0000) && (this->cpu.instruction_reg & 0x3000) != 0)
-				this->MOVEhandler();		// MOVE / MOVEA
-
-			if ((this->cpu.instruction_reg & 0xF900) == 0x4000) {
-				size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-				if (((this->cpu.instruction_reg & 0xFFC0) == 0x40C0) && (size == 0x03)) {		// MOVE from SR
-					if (((this->cpu.type != MC68008L) && (this->cpu.type != MC68008P) && (this->cpu.type != MC68000)) && this->cpu.sr.flag.s)	// Privileged instruction on > 68010
-						this->pendingException = PRIVILEGE_VIOLATION;
-					else
-						this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x01, this->cpu.sr.reg);
-				}
-
-				if (((this->cpu.instruction_reg & 0xFFC0) == 0x44C0) && (size == 0x03))			// MOVE to CCR
-					this->cpu.sr.reg = ((this->cpu.sr.reg & 0xFF00) | (getOperandValue(this->cpu.instruction_reg & 0x3F, 0x01) & 0x00FF));
-
-				if (((this->cpu.instruction_reg & 0xFFC0) == 0x46C0) && (size == 0x03)) {		// MOVE to SR
-					if (this->cpu.sr.flag.s)								// Only privileged instruction on > 68010
-						this->cpu.sr.reg = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x01);
-					else
-						this->pendingException = PRIVILEGE_VIOLATION;
-				}
-			}
-
-			if (((this->cpu.instruction_reg & 0xFB00) == 0x4000) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))			// NEG and NEGX
-				this->NEGhandler();
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x4200) {		// CLR
-				size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-				if (size == 0x03)
-					this->pendingException = ILLEGAL_INSTRUCTION;
-				else {
-					this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, 0);
-					this->cpu.sr.flag.c = false;
-					this->cpu.sr.flag.v = false;
-					this->cpu.sr.flag.n = false;
-					this->cpu.sr.flag.z = true;
-				}
-			}
-
-			if (((this->cpu.instruction_reg & 0xFF00) == 0x4600) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))		// NOT
-				this->NOThandler();
-
-			if ((this->cpu.instruction_reg & 0xFFB8) == 0x4880)
-				this->EXThandler();		// EXT
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x4800)
-				this->NBCDhandler();		// NBCD
-
-			if ((this->cpu.instruction_reg & 0xFFF8) == 0x4840)
-				this->SWAPhandler();		// SWAP
-
-			if (((this->cpu.instruction_reg & 0xFFC0) == 0x4840) && ((this->cpu.instruction_reg & 0x0038) != 0x0000)) {		// PEA
-				if ((this->cpu.instruction_reg & 0x3F) == 0x3A) {		// Hack because PEA's with PC+Displacement don't read the address
-					value = this->cpu.pc + this->readWord(this->cpu.pc);
-					this->cpu.pc += 2;
-				} else
-					value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x02);
-
-				if (this->cpu.sr.flag.s) {
-					this->cpu.ssp -= 4;
-					writeLong(this->cpu.ssp, value);			// In Supervisor mode, so use the Supervisor Stack
-				} else {
-					this->cpu.usp -= 4;
-					writeLong(this->cpu.usp, value);
-				}
-			}
-
-			if (this->cpu.instruction_reg == 0x4AFC)		// ILLEGAL
-				this->pendingException = ILLEGAL_INSTRUCTION;
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x4AC0)
-				this->TAShandler();		// TAS
-
-			if ((this->cpu.instruction_reg & 0xFF00) == 0x4A00)
-				this->TSThandler();		// TST
-
-			if ((this->cpu.instruction_reg & 0xFFF0) == 0x4E40)
-				this->pendingException = (TRAP0 + (this->cpu.instruction_reg & 0x000F));		// TRAP
-
-			if ((this->cpu.instruction_reg & 0xFFF8) == 0x4E50)	
-				this->LINKhandler();	// LINK
-
-			if ((this->cpu.instruction_reg & 0xFFF8) == 0x4E58)
-				this->UNLINKhandler();		// UNLINK
-
-			if ((this->cpu.instruction_reg & 0xFFF0) == 0x4E60) {		// MOVE USP
-				if (this->cpu.sr.flag.s) {
-					if (this->cpu.instruction_reg & 0x0008)
-						this->cpu.a[this->cpu.instruction_reg & 0x0007] = this->cpu.usp;
-					else
-						this->cpu.usp = this->cpu.a[this->cpu.instruction_reg & 0x0007];
-				} else
-					this->pendingException = PRIVILEGE_VIOLATION;
-			}
-
-			if (this->cpu.instruction_reg == 0x4E70) {		// RESET
-				if (this->cpu.sr.flag.s)
-					this->pendingException = RESET;			// Should do this differently; RESET just asserts the RESET line
-				else
-					this->pendingException = PRIVILEGE_VIOLATION;
-			}
-
-			if (this->cpu.instruction_reg == 0x4E71) {		// NOP
-			}
-
-			if (this->cpu.instruction_reg == 0x4E72) {		// STOP
-				if (this->cpu.sr.flag.s) {
-					value = this->readWord(this->cpu.pc);
-					this->cpu.sr.reg = (value & 0xFFFF);
-					this->cpu.stop = true;
-				} else
-					this->pendingException = PRIVILEGE_VIOLATION;
-			}
-
-			if (this->cpu.instruction_reg == 0x4E73) {		// RTE
-				if (this->cpu.sr.flag.s) {
-					this->cpu.sr.reg = this->readWord(this->cpu.ssp);
-					this->cpu.ssp += 2;
-					this->cpu.pc = this->readLong(this->cpu.ssp);
-					this->cpu.ssp += 4;
-				} else
-					this->pendingException = PRIVILEGE_VIOLATION;
-			}
-
-			if (this->cpu.instruction_reg == 0x4E75) {		// RTS
-				if (this->cpu.sr.flag.s) {
-					this->cpu.pc = this->readLong(this->cpu.ssp);
-					this->cpu.ssp += 4;
-				} else {
-					this->cpu.pc = this->readLong(this->cpu.usp);
-					this->cpu.usp += 4;
-				}
-			}
-
-			if (this->cpu.instruction_reg == 0x4E76)		// TRAPV
-				if (this->cpu.sr.flag.v)
-					this->pendingException = TRAPV_INSTRUCTION;
-
-			if (this->cpu.instruction_reg == 0x4E77) {		// RTR
-				this->cpu.sr.reg &= 0xFF00;
-				this->cpu.sr.reg |= (this->readWord(this->cpu.ssp) & 0x00FF);
-				this->cpu.ssp += 2;
-				this->cpu.pc = this->readLong(this->cpu.ssp);
-				this->cpu.ssp += 4;
-			}
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x4E80) {		// JSR
-				value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x02);
-				if ((this->cpu.instruction_reg & 0x38) == 0x10)			// Hack because JSR's with (Ax) don't read the address
-					value = this->cpu.a[this->cpu.instruction_reg & 0x07];
-				if ((this->cpu.instruction_reg & 0x3F) == 0x38)			// Hack because JSR's with $xxxx.W don't read the address
-					value = this->signExtend(this->readWord(this->cpu.pc - 2));
-
-				if (this->cpu.sr.flag.s) {
-					this->cpu.ssp -= 4;
-					writeLong(this->cpu.ssp, this->cpu.pc);			// In Supervisor mode, so use the Supervisor Stack
-				} else {
-					this->cpu.usp -= 4;
-					writeLong(this->cpu.usp, this->cpu.pc);
-				}
-				this->cpu.pc = (value & this->INTERNAL_ADDRESS_MASK);
-				if (this->cpu.pc & 1)
-					this->pendingException = ADDRESS_ERROR;
-			}
-
-			if ((this->cpu.instruction_reg & 0xFFC0) == 0x4EC0) {		// JMP
-				value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x02);
-				if ((this->cpu.instruction_reg & 0x38) == 0x10)			// Hack because JMP's with (Ax) don't read the address
-					value = this->cpu.a[this->cpu.instruction_reg & 0x07];
-				if ((this->cpu.instruction_reg & 0x3F) == 0x38)			// Hack because JMP's with $xxxx.W don't read the address
-					value = this->signExtend(this->readWord(this->cpu.pc - 2));
-
-				this->cpu.pc = (value & this->INTERNAL_ADDRESS_MASK);
-				if (this->cpu.pc & 1)
-					this->pendingException = ADDRESS_ERROR;
-			}
-
-			if ((this->cpu.instruction_reg & 0xFB80) == 0x4880)
-				this->MOVEMhandler();		// MOVEM
-
-			if ((this->cpu.instruction_reg & 0xF1C0) == 0x41C0)
-				this->LEAhandler();			// LEA
-
-			if ((this->cpu.instruction_reg & 0xF1C0) == 0x4180)
-				this->CHKhandler();			// CHK
-
-			if (((this->cpu.instruction_reg & 0xF100) == 0x5000) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))
-				this->ADDQhandler();		// ADDQ
-
-			if (((this->cpu.instruction_reg & 0xF100) == 0x5100) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))
-				this->SUBQhandler();		// SUBQ
-
-			if ((this->cpu.instruction_reg & 0xF0C0) == 0x50C0) {		// Scc / DBcc
-				if ((this->cpu.instruction_reg & 0xF0F8) == 0x50C8) {	// DBcc
-					if (evaluateConditionCode((this->cpu.instruction_reg & 0x0F00) >> 16)) {
-						this->cpu.d[this->cpu.instruction_reg & 0x0007] = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFF0000) | ((this->cpu.d[this->cpu.instruction_reg & 0x0007] -1) & 0x0000FFFF);
-						if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) != 0x0000FFFF)
-							this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
-						else
-							this->cpu.pc += 2;
-					} else
-						this->cpu.pc += 2;
-				} else {											// Scc
-					if (evaluateConditionCode((this->cpu.instruction_reg & 0x0F00) >> 16))
-						this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, 0xFF);
-					else
-						this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, 0x00);
-				}
-			}
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0x6000) {		// BRA / BSR / Bcc
-				switch (this->cpu.instruction_reg & 0xFF00) {
-					case 0x6000 :		// BRA
-						if (this->cpu.instruction_reg & 0x00FF)
-							if (this->cpu.instruction_reg & 0x0080)
-								this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
-							else
-								this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
-						else
-							this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
-						break;
-
-					case 0x6100 :		// BSR
-						if (this->cpu.instruction_reg & 0x00FF) {
-							if (this->cpu.sr.flag.s) {
-								this->cpu.ssp -= 4;
-								writeLong(this->cpu.ssp, this->cpu.pc);
-							} else {
-								this->cpu.usp -= 4;
-								writeLong(this->cpu.usp, this->cpu.pc);
-							}
-							if (this->cpu.instruction_reg & 0x0080)
-								this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
-							else
-								this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
-						} else {
-							if (this->cpu.sr.flag.s) {
-								this->cpu.ssp -= 4;
-								writeLong(this->cpu.ssp, this->cpu.pc+2);
-							} else {
-								this->cpu.usp -= 4;
-								writeLong(this->cpu.usp, this->cpu.pc+2);
-							}
-							this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
-						}
-						break;
-
-					default :			// Bcc
-						if (evaluateConditionCode((this->cpu.instruction_reg & 0x0F00) >> 8)) {
-							if (this->cpu.instruction_reg & 0x00FF) {
-								if (this->cpu.instruction_reg & 0x0080)
-									this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
-								else
-									this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
-							} else
-								this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
-						} else
-							if ((this->cpu.instruction_reg & 0x00FF) == 0)
-								this->cpu.pc += 2;
-						break;
-				}
-			}
-
-			if ((this->cpu.instruction_reg & 0xF100) == 0x7000) {		// MOVEQ
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.instruction_reg & 0x00FF);
-				if (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x00000080)
-					this->cpu.d[(this->cpu.instruction_reg & 0x0E00)] = 0xFFFFFF00 | (this->cpu.d[this->cpu.instruction_reg & 0x0E00] & 0x000000FF);
-
-				this->cpu.sr.flag.c = 0;
-				this->cpu.sr.flag.v = 0;
-				this->cpu.sr.flag.z = ((this->cpu.instruction_reg & 0x00FF) == 0);
-				this->cpu.sr.flag.n = ((this->cpu.instruction_reg & 0x0080) == 0x80);
-			}
-
-			if ((this->cpu.instruction_reg & 0xF1C0) == 0x80C0)
-				this->DIVUhandler();		// DIVU
-
-			if ((this->cpu.instruction_reg & 0xF1C0) == 0x81C0)
-				this->DIVShandler();		// DIVS
-
-			if ((this->cpu.instruction_reg & 0xF1F0) == 0x8100)
-				this->SBCDhandler();		// SBCD
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0x8000)
-				this->ORhandler();		// OR
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0x9000) {		// SUB / SUBA / SUBX
-				if ((this->cpu.instruction_reg & 0xF0C0) == 0x90C0) {	// SUBA
-					size = ((this->cpu.instruction_reg & 0x0100) >> 7);
-					value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
-					if (size == 0x01)
-						this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] -= (value & 0x0000FFFF);
-					else
-						this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] -= value;
-				} else {
-					if ((this->cpu.instruction_reg & 0xF130) == 0x9100)			// SUBX
-						this->SUBXhandler();
-
-					if (((this->cpu.instruction_reg & 0xF130) != 0xD100) && ((this->cpu.instruction_reg & 0xF000) == 0x9000))		// SUB
-						this->SUBhandler();
-				}
-			}
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0xB000) {		// EOR, CMPM, CMP and CMPA
-				if ((this->cpu.instruction_reg & 0xF0C0) == 0xB0C0)		// CMPA
-					this->CMPAhandler();
-				else if ((this->cpu.instruction_reg & 0xF138) == 0xB108)		// CMPM
-					this->CMPMhandler();
-				else if ((this->cpu.instruction_reg & 0xF100) == 0xB100)		// EOR
-					this->EORhandler();
-				else if ((this->cpu.instruction_reg & 0xF100) == 0xB000)		// CMP
-					this->CMPhandler();
-			}
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0xC000) {			// MULU, MULS, ABCD, EXG and AND
-				if ((this->cpu.instruction_reg & 0xF1C0) == 0xC0C0)
-					this->MULUhandler();		// MULU
-
-				if ((this->cpu.instruction_reg & 0xF1C0) == 0xC1C0)
-					this->MULShandler();		// MULS
-
-				if ((this->cpu.instruction_reg & 0xF1F0) == 0xC100)
-					this->ABCDhandler();		// ABCD
-
-				if ((this->cpu.instruction_reg & 0xF130) == 0xC100)
-					this->EXGhandler();			// EXG
-
-				else if (((this->cpu.instruction_reg & 0xF000) == 0xC000) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))
-					this->ANDhandler();		// AND
-			}
-
-			if ((this->cpu.instruction_reg & 0xF000) == 0xD000) {		// ADD
-				if ((this->cpu.instruction_reg & 0xF0C0) == 0xD0C0)
-					this->ADDAhandler();		// ADDA
-				else {
-					if ((this->cpu.instruction_reg & 0xF130) == 0xD100)
-						this->ADDXhandler();	// ADDX
-					if ((this->cpu.instruction_reg & 0xF130) != 0xD100)
-						this->ADDhandler();	// ADD
-				}
+			if (this->linearDecode) {										// Decode the way Exec did before the table, for comparison
+				count = this->decodeOpcode(this->cpu.instruction_reg, list);
+				this->decodeFields(this->cpu.instruction_reg, &this->linearOp);
+				this->op = &this->linearOp;
+				for (i = 0; i < count; i++)
+					(this->*list[i])();
+			} else {
+				this->op = &decodeTable[this->cpu.instruction_reg];			// Run every handler the opcode decodes to, in order
+				for (handler = handlerLists[this->op->handlers]; *handler != NULL; handler++)
+					(this->**handler)();
 			}
 
-			if ((this->cpu.instruction_reg & 0xFCC0) == 0xE0C0)
-				this->ASxLSx_handler();		// ASR / ASL / LSR / LSL register
-
-			if (((this->cpu.instruction_reg & 0xF010) == 0xE000) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))
-				this->ASxLSx_handler();		// ASR / ASL / LSR / LSL immediate
-
-			if ((this->cpu.instruction_reg & 0xFCC0) == 0xE4C0)
-				this->ROxROXx_handler();		// ROR / ROL / ROXR / ROXL register
-
-			if (((this->cpu.instruction_reg & 0xF010) == 0xE010) && ((this->cpu.instruction_reg & 0x00C0) != 0x00C0))
-				this->ROxROXx_handler();		// ASR / ASL / LSR / LSL immediate
-		
-			if (this->DEBUG == true)
+			if (this->traceRegisters)
 				WriteLog("\n\n");
+
+			this->instructionsRun++;
 		}
 
 		if ((this->cpu.sr.flag.t0 == false) && (this->cpu.sr.flag.t1 == true))				// Generate a trace exception when the Trace bit is set in the Status Register
 			this->pendingException = TRACE;
 
 		Cycles--;								// Not cycle exact at the moment, but it works for now...
+		this->cyclesRun++;
+
+		if (TubeStateChanged)					// Let the host respond to the tube
+			break;
+
+		if ((TubeintStatus != intStatus) || (TubeNMIStatus != nmiStatus))	// Hand back so the board samples its interrupt lines again
+			break;
 	}
 }
 
@@ -1708,26 +1629,23 @@ void mc68k::dumpRegisters(void) {
 //	else
 //		a7 = this->cpu.usp;
 
-	if (this->DEBUG) {
-
-//		WriteLog("%08X   %04X   A0=%08X A1=%08X A2=%08X A3=%08X A4=%08X A5=%08X A6=%08X USP=%08X SSP=%08X D0=%08X D1=%08X D2=%08X D3=%08X D4=%08X D5=%08X D6=%08X D7=%08X SR=%04X\n", this->cpu.pc, this->cpu.instruction_reg, this->cpu.a[0], this->cpu.a[1], this->cpu.a[2], this->cpu.a[3], this->cpu.a[4], this->cpu.a[5], this->cpu.a[6], this->cpu.usp, this->cpu.ssp, this->cpu.d[0], this->cpu.d[1], this->cpu.d[2], this->cpu.d[3], this->cpu.d[4], this->cpu.d[5], this->cpu.d[6], this->cpu.d[7], this->cpu.sr.reg);
-		WriteLog("D0=%08X D4=%08X A0=%08X A4=%08X    T_S__INT___XNZVC\n", this->cpu.d[0], this->cpu.d[4], this->cpu.a[0], this->cpu.a[4]);
-		WriteLog("D1=%08X D5=%08X A1=%08X A5=%08X SR=%s\n", this->cpu.d[1], this->cpu.d[5], this->cpu.a[1], this->cpu.a[5], output);
-		WriteLog("D2=%08X D6=%08X A2=%08X A6=%08X US=%08X\n", this->cpu.d[2], this->cpu.d[6], this->cpu.a[2], this->cpu.a[6], this->cpu.usp);
-		WriteLog("D3=%08X D7=%08X A3=%08X A7=%08X SS=%08X\n", this->cpu.d[3], this->cpu.d[7], this->cpu.a[3], (this->cpu.sr.flag.s ? this->cpu.ssp : this->cpu.usp), this->cpu.ssp);
-		WriteLog("PC=%08X  Code=%04X", this->cpu.pc, this->cpu.instruction_reg);
-	}
+//	WriteLog("%08X   %04X   A0=%08X A1=%08X A2=%08X A3=%08X A4=%08X A5=%08X A6=%08X USP=%08X SSP=%08X D0=%08X D1=%08X D2=%08X D3=%08X D4=%08X D5=%08X D6=%08X D7=%08X SR=%04X\n", this->cpu.pc, this->cpu.instruction_reg, this->cpu.a[0], this->cpu.a[1], this->cpu.a[2], this->cpu.a[3], this->cpu.a[4], this->cpu.a[5], this->cpu.a[6], this->cpu.usp, this->cpu.ssp, this->cpu.d[0], this->cpu.d[1], this->cpu.d[2], this->cpu.d[3], this->cpu.d[4], this->cpu.d[5], this->cpu.d[6], this->cpu.d[7], this->cpu.sr.reg);
+	WriteLog("D0=%08X D4=%08X A0=%08X A4=%08X    T_S__INT___XNZVC\n", this->cpu.d[0], this->cpu.d[4], this->cpu.a[0], this->cpu.a[4]);
+	WriteLog("D1=%08X D5=%08X A1=%08X A5=%08X SR=%s\n", this->cpu.d[1], this->cpu.d[5], this->cpu.a[1], this->cpu.a[5], output);
+	WriteLog("D2=%08X D6=%08X A2=%08X A6=%08X US=%08X\n", this->cpu.d[2], this->cpu.d[6], this->cpu.a[2], this->cpu.a[6], this->cpu.usp);
+	WriteLog("D3=%08X D7=%08X A3=%08X A7=%08X SS=%08X\n", this->cpu.d[3], this->cpu.d[7], this->cpu.a[3], (this->cpu.sr.flag.s ? this->cpu.ssp : this->cpu.usp), this->cpu.ssp);
+	WriteLog("PC=%08X  Code=%04X", this->cpu.pc, this->cpu.instruction_reg);
 }
 
 void mc68k::ABCDhandler(void) {
 	unsigned int	value, value2, result, result2;
 
-	if (this->cpu.instruction_reg & 0x0008) {				// -(An) memory to memory operation
-		value = this->getOperandValue(((this->cpu.instruction_reg & 0x0007) | 0x0008), 0x00);			// Source value
-		value2 = this->getOperandValue((((this->cpu.instruction_reg & 0x0E00) >> 9) | 0x0008), 0x00);	// Destination value
+	if (this->op->ea & 0x08) {				// -(An) memory to memory operation
+		value = this->getOperandValue(((this->op->ea & 0x07) | 0x0008), 0x00);			// Source value
+		value2 = this->getOperandValue((this->op->reg | 0x0008), 0x00);	// Destination value
 	} else {											// Dn to Dn operation
-		value = this->cpu.d[(this->cpu.instruction_reg & 0x0007)];
-		value2 = this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)];
+		value = this->cpu.d[this->op->ea & 0x07];
+		value2 = this->cpu.d[this->op->reg];
 	}
 
 	if ((value & 0x0F) > 9)
@@ -1757,48 +1675,48 @@ void mc68k::ABCDhandler(void) {
 		this->cpu.sr.flag.x = true;
 	}
 	this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
-	if (this->cpu.instruction_reg & 0x0008)					// -(An) memory to memory operation
-		this->setOperandValue((((this->cpu.instruction_reg & 0x0E00) >> 9) | 0x0008), 0x00, ((result % 10) + ((result / 10) << 4)));
+	if (this->op->ea & 0x08)					// -(An) memory to memory operation
+		this->setOperandValue((this->op->reg | 0x0008), 0x00, ((result % 10) + ((result / 10) << 4)));
 	else
-		this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] = result;
+		this->cpu.d[this->op->reg] = result;
 }
 
 void mc68k::ADDhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) + (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF));
+				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) + (this->cpu.d[this->op->reg] & 0x000000FF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) + (value & 0x000000FF));
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80)==0) && (((value|result)&0x80)!=0)) || ((value&result&0x80)!=0);
-			this->cpu.sr.flag.v = ((0x80&(value^0x80)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80))!=0)||((0x80&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80)&value)!=0);
+				result = (this->cpu.d[this->op->reg] & 0xFFFFFF00) | ((this->cpu.d[this->op->reg] & 0x000000FF) + (value & 0x000000FF));
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x80)==0) && (((value|result)&0x80)!=0)) || ((value&result&0x80)!=0);
+			this->cpu.sr.flag.v = ((0x80&(value^0x80)&this->cpu.d[this->op->reg]&(result^0x80))!=0)||((0x80&result&(this->cpu.d[this->op->reg]^0x80)&value)!=0);
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			break;
 		case 0x01 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) + (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF));
+				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) + (this->cpu.d[this->op->reg] & 0x0000FFFF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) + (value & 0x0000FFFF));
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x8000)==0) && (((value|result)&0x8000)!=0)) || ((value&result&0x8000)!=0);
-			this->cpu.sr.flag.v = ((0x8000&(value^0x8000)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x8000))!=0)||((0x8000&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x8000)&value)!=0);
+				result = (this->cpu.d[this->op->reg] & 0xFFFF0000) | ((this->cpu.d[this->op->reg] & 0x0000FFFF) + (value & 0x0000FFFF));
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x8000)==0) && (((value|result)&0x8000)!=0)) || ((value&result&0x8000)!=0);
+			this->cpu.sr.flag.v = ((0x8000&(value^0x8000)&this->cpu.d[this->op->reg]&(result^0x8000))!=0)||((0x8000&result&(this->cpu.d[this->op->reg]^0x8000)&value)!=0);
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			break;
 		case 0x02 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value + this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]);
+				result = (value + this->cpu.d[this->op->reg]);
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] + value);
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
-			this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80000000)&value)!=0);
+				result = (this->cpu.d[this->op->reg] + value);
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
+			this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.d[this->op->reg]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.d[this->op->reg]^0x80000000)&value)!=0);
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = (result & 0x80000000) == 0x80000000;
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
@@ -1809,10 +1727,10 @@ void mc68k::ADDhandler(void) {
 			break;
 	}
 	if (this->cpu.instruction_reg & 0x0100) {		// Destination is operand
-		this->rewindPC(this->cpu.instruction_reg & 0x38);
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+		this->rewindPC(this->op->ea & 0x38);
+		this->setOperandValue(this->op->ea, size, result);
 	} else
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+		this->cpu.d[this->op->reg] = result;
 }
 
 void mc68k::ADDAhandler(void) {
@@ -1820,11 +1738,11 @@ void mc68k::ADDAhandler(void) {
 	unsigned int	value;
 
 	size = ((this->cpu.instruction_reg & 0x0100) >> 7);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	value = this->getOperandValue(this->op->ea, size);
 	if (size == 0x01)
-		this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] += (value & 0x0000FFFF);
+		this->cpu.a[this->op->reg] += (value & 0x0000FFFF);
 	else
-		this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] += value;
+		this->cpu.a[this->op->reg] += value;
 }
 
 void mc68k::ADDIhandler(void) {
@@ -1836,8 +1754,8 @@ void mc68k::ADDIhandler(void) {
 	short		sword;
 	int			slong;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	start = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	start = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :					// ADDI.B
 			parameter1 = (this->readWord(this->cpu.pc) & 0xFF);
@@ -1883,42 +1801,42 @@ void mc68k::ADDIhandler(void) {
 			return;
 			break;
 	}
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+	this->setOperandValue(this->op->ea, size, result);
 }
 
 void mc68k::ADDQhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :
-			result = (value & 0xFFFFFF00) | ((value + ((this->cpu.instruction_reg & 0x0E00) >> 9)) & 0x000000FF);
+			result = (value & 0xFFFFFF00) | ((value + this->op->reg) & 0x000000FF);
 			this->cpu.sr.flag.c = (((result&0x80)==0) && ((value&0x80)!=0));
 			this->cpu.sr.flag.v = (0x80&result&(value^0x80))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80) == 0x80);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x01 :
-			result = (value & 0xFFFF0000) | ((value + ((this->cpu.instruction_reg & 0x0E00) >> 9)) & 0x0000FFFF);
+			result = (value & 0xFFFF0000) | ((value + this->op->reg) & 0x0000FFFF);
 			this->cpu.sr.flag.c = (((result&0x8000)==0) && ((value&0x8000)!=0));
 			this->cpu.sr.flag.v = (0x8000&result&(value^0x8000))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x8000) == 0x8000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x02 :
-			result = value + ((this->cpu.instruction_reg & 0x0E00) >> 9);
+			result = value + this->op->reg;
 			this->cpu.sr.flag.c = (((result&0x80000000)==0) && ((value&0x80000000)!=0));
 			this->cpu.sr.flag.v = (0x80000000&result&(value^0x80000000))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x03 :
 			this->pendingException = ILLEGAL_INSTRUCTION;
@@ -1931,38 +1849,38 @@ void mc68k::ADDXhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	if (this->cpu.instruction_reg & 0x0008) {			// -(An) memory to memory operation
+	size = this->op->size;
+	if (this->op->ea & 0x08) {			// -(An) memory to memory operation
 		switch (size) {
 			case 0x00 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF;
-				result = (this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF) + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)&result&0x80)!=0);;
-				this->cpu.sr.flag.v = ((0x80&((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF))!=0);;
+				value = this->cpu.a[this->op->reg] & 0x000000FF;
+				result = (this->cpu.a[this->op->ea & 0x07] & 0x000000FF) + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)&result&0x80)!=0);;
+				this->cpu.sr.flag.v = ((0x80&((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.a[this->op->ea & 0x07] & 0x000000FF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x000000FF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | (result & 0x000000FF);
+				this->cpu.a[this->op->reg] = (this->cpu.a[this->op->reg] & 0xFFFFFF00) | (result & 0x000000FF);
 				break;
 			case 0x01 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF;
-				result = (this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)&result&0x8000)!=0);;
-				this->cpu.sr.flag.v = ((0x8000&((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF))!=0);;
+				value = this->cpu.a[this->op->reg] & 0x0000FFFF;
+				result = (this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF) + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)&result&0x8000)!=0);;
+				this->cpu.sr.flag.v = ((0x8000&((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x0000FFFF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | (result & 0x0000FFFF);
+				this->cpu.a[this->op->reg] = (this->cpu.a[this->op->reg] & 0xFFFF0000) | (result & 0x0000FFFF);
 				break;
 			case 0x02 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9];
-				result = this->cpu.a[this->cpu.instruction_reg & 0x0007] + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.a[this->cpu.instruction_reg & 0x0007]|result)&0x80000000)!=0)) || ((this->cpu.a[this->cpu.instruction_reg & 0x0007]&result&0x80000000)!=0);;
-				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.a[this->cpu.instruction_reg & 0x0007]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.a[this->cpu.instruction_reg & 0x0007])!=0);;
+				value = this->cpu.a[this->op->reg];
+				result = this->cpu.a[this->op->ea & 0x07] + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.a[this->op->ea & 0x07]|result)&0x80000000)!=0)) || ((this->cpu.a[this->op->ea & 0x07]&result&0x80000000)!=0);;
+				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.a[this->op->ea & 0x07]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.a[this->op->ea & 0x07])!=0);;
 				this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+				this->cpu.a[this->op->reg] = result;
 				break;
 			case 0x03 :
 				this->pendingException = ILLEGAL_INSTRUCTION;
@@ -1972,34 +1890,34 @@ void mc68k::ADDXhandler(void) {
 	} else {										// Dn to Dn operation
 		switch (size) {
 			case 0x00 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF;
-				result = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF) + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)&result&0x80)!=0);;
-				this->cpu.sr.flag.v = ((0x80&((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF))!=0);;
+				value = this->cpu.d[this->op->reg] & 0x000000FF;
+				result = (this->cpu.d[this->op->ea & 0x07] & 0x000000FF) + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)&result&0x80)!=0);;
+				this->cpu.sr.flag.v = ((0x80&((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[this->op->ea & 0x07] & 0x000000FF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x000000FF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | (result & 0x000000FF);
+				this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0xFFFFFF00) | (result & 0x000000FF);
 				break;
 			case 0x01 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF;
-				result = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)&result&0x8000)!=0);;
-				this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF))!=0);;
+				value = this->cpu.d[this->op->reg] & 0x0000FFFF;
+				result = (this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF) + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)&result&0x8000)!=0);;
+				this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x0000FFFF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | (result & 0x0000FFFF);
+				this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0xFFFF0000) | (result & 0x0000FFFF);
 				break;
 			case 0x02 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9];
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] + value + this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[this->cpu.instruction_reg & 0x0007]|result)&0x80000000)!=0)) || ((this->cpu.d[this->cpu.instruction_reg & 0x0007]&result&0x80000000)!=0);;
-				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[this->cpu.instruction_reg & 0x0007]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[this->cpu.instruction_reg & 0x0007])!=0);;
+				value = this->cpu.d[this->op->reg];
+				result = this->cpu.d[this->op->ea & 0x07] + value + this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[this->op->ea & 0x07]|result)&0x80000000)!=0)) || ((this->cpu.d[this->op->ea & 0x07]&result&0x80000000)!=0);;
+				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[this->op->ea & 0x07]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[this->op->ea & 0x07])!=0);;
 				this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+				this->cpu.d[this->op->reg] = result;
 				break;
 			case 0x03 :
 				this->pendingException = ILLEGAL_INSTRUCTION;
@@ -2013,14 +1931,14 @@ void mc68k::ANDhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) & (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF));
+				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) & (this->cpu.d[this->op->reg] & 0x000000FF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) & (value & 0x000000FF));
+				result = (this->cpu.d[this->op->reg] & 0xFFFFFF00) | ((this->cpu.d[this->op->reg] & 0x000000FF) & (value & 0x000000FF));
 			this->cpu.sr.flag.c = false;
 			this->cpu.sr.flag.v = false;
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
@@ -2028,9 +1946,9 @@ void mc68k::ANDhandler(void) {
 			break;
 		case 0x01 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) & (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF));
+				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) & (this->cpu.d[this->op->reg] & 0x0000FFFF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) & (value & 0x0000FFFF));
+				result = (this->cpu.d[this->op->reg] & 0xFFFF0000) | ((this->cpu.d[this->op->reg] & 0x0000FFFF) & (value & 0x0000FFFF));
 			this->cpu.sr.flag.c = false;
 			this->cpu.sr.flag.v = false;
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
@@ -2038,9 +1956,9 @@ void mc68k::ANDhandler(void) {
 			break;
 		case 0x02 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]);
+				result = (value & this->cpu.d[this->op->reg]);
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & value);
+				result = (this->cpu.d[this->op->reg] & value);
 			this->cpu.sr.flag.c = false;
 			this->cpu.sr.flag.v = false;
 			this->cpu.sr.flag.z = (result == 0);
@@ -2052,9 +1970,9 @@ void mc68k::ANDhandler(void) {
 			break;
 	}
 	if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+		this->setOperandValue(this->op->ea, size, result);
 	else
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+		this->cpu.d[this->op->reg] = result;
 }
 
 void mc68k::ANDIhandler(void) {
@@ -2079,8 +1997,8 @@ void mc68k::ANDIhandler(void) {
 			this->pendingException = PRIVILEGE_VIOLATION;
 	}
 	if ((this->cpu.instruction_reg & 0xFFBF) != 0x023C) {	// ANDI
-		size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-		value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+		size = this->op->size;
+		value = this->getOperandValue(this->op->ea, size);
 		this->cpu.sr.flag.c = false;
 		this->cpu.sr.flag.v = false;
 		switch (size) {
@@ -2113,8 +2031,8 @@ void mc68k::ANDIhandler(void) {
 				return;
 				break;
 		}
-		this->rewindPC(this->cpu.instruction_reg & 0x3F);
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, value);
+		this->rewindPC(this->op->ea);
+		this->setOperandValue(this->op->ea, size, value);
 	}
 }
 
@@ -2122,28 +2040,28 @@ void mc68k::ASxLSx_handler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
+	size = this->op->size;
 	this->cpu.sr.flag.v = false;
 	switch (size) {
 		case 0x00 :
 			if (this->cpu.instruction_reg & 0x0020)
-				value = (this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] & 0x3F);	// Dn modulo 64 mode
+				value = (this->cpu.d[this->op->reg] & 0x3F);	// Dn modulo 64 mode
 			else {
-				value = ((this->cpu.instruction_reg & 0x0E00) >> 9);						// Immediate mode
+				value = this->op->reg;						// Immediate mode
 				if (value == 0)
 					value = 8;
 			}
 			if (this->cpu.instruction_reg & 0x0100) {	// Shift left
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (1 << (8 - value))) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (8 - value))) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (8 - value))) != (((1 << value) - 1) << (8 - value))))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (1 << (8 - value))) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (8 - value))) && ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (8 - value))) != (((1 << value) - 1) << (8 - value))))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] << value;
+				result = this->cpu.d[this->op->ea & 0x07] << value;
 			} else {								// Shift right
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (0x00000080 >> value)) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) != ((1 << value) - 1)))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (0x00000080 >> value)) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) && ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) != ((1 << value) - 1)))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF) >> value);
-				if (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00000080)
+				result = ((this->cpu.d[this->op->ea & 0x07] & 0x000000FF) >> value);
+				if (this->cpu.d[this->op->ea & 0x07] & 0x00000080)
 					result |= (((1 << value) - 1) << (8 - value));	// Set MSB bits on ASR instruction
 				else
 					result &= ~(((1 << value) - 1) << (8 - value));	// Clear MSB bits on ASR instruction
@@ -2153,27 +2071,27 @@ void mc68k::ASxLSx_handler(void) {
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x00000080);
-			this->cpu.d[this->cpu.instruction_reg & 0x0007] = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFFFF00) | (result & 0x000000FF);
+			this->cpu.d[this->op->ea & 0x07] = (this->cpu.d[this->op->ea & 0x07] & 0xFFFFFF00) | (result & 0x000000FF);
 			break;
 		case 0x01 :
 			if (this->cpu.instruction_reg & 0x0020)
-				value = (this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] & 0x3F);	// Dn modulo 64 mode
+				value = (this->cpu.d[this->op->reg] & 0x3F);	// Dn modulo 64 mode
 			else {
-				value = ((this->cpu.instruction_reg & 0x0E00) >> 9);						// Immediate mode
+				value = this->op->reg;						// Immediate mode
 				if (value == 0)
 					value = 8;
 			}
 			if (this->cpu.instruction_reg & 0x0100) {	// Shift left
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (1 << (16 - value))) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (16 - value))) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (16 - value))) != (((1 << value) - 1) << (16 - value))))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (1 << (16 - value))) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (16 - value))) && ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (16 - value))) != (((1 << value) - 1) << (16 - value))))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] << value;
+				result = this->cpu.d[this->op->ea & 0x07] << value;
 			} else {								// Shift right
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (0x00008000 >> value)) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) != ((1 << value) - 1)))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (0x00008000 >> value)) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) && ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) != ((1 << value) - 1)))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) >> value);
-				if (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00008000)
+				result = ((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF) >> value);
+				if (this->cpu.d[this->op->ea & 0x07] & 0x00008000)
 					result |= (((1 << value) - 1) << (16 - value));	// Set MSB bits on ASR instruction
 				else
 					result &= ~(((1 << value) - 1) << (16 - value));	// Clear MSB bits on ASR instruction
@@ -2183,27 +2101,27 @@ void mc68k::ASxLSx_handler(void) {
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x00008000);
-			this->cpu.d[this->cpu.instruction_reg & 0x0007] = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFF0000) | (result & 0x0000FFFF);
+			this->cpu.d[this->op->ea & 0x07] = (this->cpu.d[this->op->ea & 0x07] & 0xFFFF0000) | (result & 0x0000FFFF);
 			break;
 		case 0x02 :
 			if (this->cpu.instruction_reg & 0x0020)
-				value = (this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] & 0x3F);	// Dn modulo 64 mode
+				value = (this->cpu.d[this->op->reg] & 0x3F);	// Dn modulo 64 mode
 			else {
-				value = ((this->cpu.instruction_reg & 0x0E00) >> 9);						// Immediate mode
+				value = this->op->reg;						// Immediate mode
 				if (value == 0)
 					value = 8;
 			}
 			if (this->cpu.instruction_reg & 0x0100) {	// Shift left
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (1 << (32 - value))) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (32 - value))) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & (((1 << value) - 1) << (32 - value))) != (((1 << value) - 1) << (32 - value))))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (1 << (32 - value))) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (32 - value))) && ((this->cpu.d[this->op->ea & 0x07] & (((1 << value) - 1) << (32 - value))) != (((1 << value) - 1) << (32 - value))))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] << value;
+				result = this->cpu.d[this->op->ea & 0x07] << value;
 			} else {								// Shift right
-				this->cpu.sr.flag.c = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & (0x80000000 >> value)) ? true : false;
-				if ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) && ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & ((1 << value) - 1)) != ((1 << value) - 1)))
+				this->cpu.sr.flag.c = (this->cpu.d[this->op->ea & 0x07] & (0x80000000 >> value)) ? true : false;
+				if ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) && ((this->cpu.d[this->op->ea & 0x07] & ((1 << value) - 1)) != ((1 << value) - 1)))
 					this->cpu.sr.flag.v = true;	// Bit change during shift, so set overflow
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] >> value;
-				if (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x80000000)
+				result = this->cpu.d[this->op->ea & 0x07] >> value;
+				if (this->cpu.d[this->op->ea & 0x07] & 0x80000000)
 					result |= (((1 << value) - 1) << (32 - value));	// Set MSB bits on ASR instruction
 				else
 					result &= ~(((1 << value) - 1) << (32 - value));	// Clear MSB bits on ASR instruction
@@ -2213,34 +2131,87 @@ void mc68k::ASxLSx_handler(void) {
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
-			this->cpu.d[this->cpu.instruction_reg & 0x0007] = result;
+			this->cpu.d[this->op->ea & 0x07] = result;
 			break;
 		case 0x03 :
-			value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+			value = this->getOperandValue(this->op->ea, size);
 				WriteLog("mc68k::ASxLSx_handler -- Unimplemented instruction %04X at %08X\n", this->cpu.instruction_reg, this->cpu.pc);
 			break;
 	}
 }
 
+void mc68k::Bcchandler(void) {
+	switch (this->cpu.instruction_reg & 0xFF00) {
+		case 0x6000 :		// BRA
+			if (this->cpu.instruction_reg & 0x00FF)
+				if (this->cpu.instruction_reg & 0x0080)
+					this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
+				else
+					this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
+			else
+				this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
+			break;
+
+		case 0x6100 :		// BSR
+			if (this->cpu.instruction_reg & 0x00FF) {
+				if (this->cpu.sr.flag.s) {
+					this->cpu.ssp -= 4;
+					writeLong(this->cpu.ssp, this->cpu.pc);
+				} else {
+					this->cpu.usp -= 4;
+					writeLong(this->cpu.usp, this->cpu.pc);
+				}
+				if (this->cpu.instruction_reg & 0x0080)
+					this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
+				else
+					this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
+			} else {
+				if (this->cpu.sr.flag.s) {
+					this->cpu.ssp -= 4;
+					writeLong(this->cpu.ssp, this->cpu.pc+2);
+				} else {
+					this->cpu.usp -= 4;
+					writeLong(this->cpu.usp, this->cpu.pc+2);
+				}
+				this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
+			}
+			break;
+
+		default :			// Bcc
+			if (evaluateConditionCode(this->op->condition)) {
+				if (this->cpu.instruction_reg & 0x00FF) {
+					if (this->cpu.instruction_reg & 0x0080)
+						this->cpu.pc += (0xFFFFFF00 | (this->cpu.instruction_reg & 0x00FF));
+					else
+						this->cpu.pc += (this->cpu.instruction_reg & 0x00FF);
+				} else
+					this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
+			} else
+				if ((this->cpu.instruction_reg & 0x00FF) == 0)
+					this->cpu.pc += 2;
+			break;
+	}
+}
+
 void mc68k::BCHGhandler(void) {
 	unsigned char	ubyte;
 	unsigned int	value;
 
 	if (this->cpu.instruction_reg & 0x0100)
-		ubyte = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFF);
+		ubyte = (this->cpu.d[this->op->reg] & 0xFF);
 	else {
 		ubyte = (this->readWord(this->cpu.pc) & 0x00FF);
 		this->cpu.pc += 2;
 	}
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 	if (value & (1 << ubyte))
 		this->cpu.sr.flag.z = false;
 	else
 		this->cpu.sr.flag.z = true;
 	value ^= (1 << ubyte);	// Clear bit
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, value);
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, 0x00, value);
 }
 
 void mc68k::BCLRhandler(void) {
@@ -2248,20 +2219,20 @@ void mc68k::BCLRhandler(void) {
 	unsigned int	value;
 
 	if (this->cpu.instruction_reg & 0x0100)
-		ubyte = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFF);
+		ubyte = (this->cpu.d[this->op->reg] & 0xFF);
 	else {
 		ubyte = (this->readWord(this->cpu.pc) & 0x00FF);
 		this->cpu.pc += 2;
 	}
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 	if (value & (1 << ubyte))
 		this->cpu.sr.flag.z = false;
 	else
 		this->cpu.sr.flag.z = true;
 	value &= (1 << ubyte);	// Clear bit
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, value);
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, 0x00, value);
 }
 
 void mc68k::BSEThandler(void) {
@@ -2269,33 +2240,33 @@ void mc68k::BSEThandler(void) {
 	unsigned int	value;
 
 	if (this->cpu.instruction_reg & 0x0100)
-		ubyte = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFF);
+		ubyte = (this->cpu.d[this->op->reg] & 0xFF);
 	else {
 		ubyte = (this->readWord(this->cpu.pc) & 0x00FF);
 		this->cpu.pc += 2;
 	}
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 	if (value & (1 << ubyte))
 		this->cpu.sr.flag.z = false;
 	else
 		this->cpu.sr.flag.z = true;
 	value |= (1 << ubyte);	// Set bit
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, value);
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, 0x00, value);
 }
 void mc68k::BTSThandler(void) {
 	unsigned char	ubyte;
 	unsigned int	value;
 
 	if (this->cpu.instruction_reg & 0x0100)
-		ubyte = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFF);
+		ubyte = (this->cpu.d[this->op->reg] & 0xFF);
 	else {
 		ubyte = (this->readWord(this->cpu.pc) & 0x00FF);
 		this->cpu.pc += 2;
 	}
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 	if (value & (1 << ubyte))
 		this->cpu.sr.flag.z = false;
 	else
@@ -2305,43 +2276,55 @@ void mc68k::BTSThandler(void) {
 void mc68k::CHKhandler(void) {
 	unsigned int	value;
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x01);
-	if (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] < 0) {
+	value = this->getOperandValue(this->op->ea, 0x01);
+	if (this->cpu.d[this->op->reg] < 0) {
 		this->cpu.sr.flag.n = 1;
 		this->pendingException = CHK_INSTRUCTION;
 	}
-	if (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] > value) {
+	if (this->cpu.d[this->op->reg] > value) {
 		this->cpu.sr.flag.n = 0;
 		this->pendingException = CHK_INSTRUCTION;
 	}
 }
 
+void mc68k::CLRhandler(void) {
+	if (this->op->size == 0x03)
+		this->pendingException = ILLEGAL_INSTRUCTION;
+	else {
+		this->setOperandValue(this->op->ea, this->op->size, 0);
+		this->cpu.sr.flag.c = false;
+		this->cpu.sr.flag.v = false;
+		this->cpu.sr.flag.n = false;
+		this->cpu.sr.flag.z = true;
+	}
+}
+
 void mc68k::CMPhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 
 	switch (size) {
 		case 0x00 :
-			result = ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) - (value & 0x000000FF));
-			this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF)&result&0x80)!=0);
-			this->cpu.sr.flag.v = ((0x80&((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF))!=0);
+			result = ((this->cpu.d[this->op->reg] & 0x000000FF) - (value & 0x000000FF));
+			this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[this->op->reg] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[this->op->reg] & 0x000000FF)&result&0x80)!=0);
+			this->cpu.sr.flag.v = ((0x80&((this->cpu.d[this->op->reg] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[this->op->reg] & 0x000000FF))!=0);
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 			break;
 		case 0x01 :
-			result = ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) - (value & 0x0000FFFF));
-			this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF)&result&0x8000)!=0);
-			this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF))!=0);
+			result = ((this->cpu.d[this->op->reg] & 0x0000FFFF) - (value & 0x0000FFFF));
+			this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[this->op->reg] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[this->op->reg] & 0x0000FFFF)&result&0x8000)!=0);
+			this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[this->op->reg] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[this->op->reg] & 0x0000FFFF))!=0);
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			break;
 		case 0x02 :
-			result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] - value);
-			this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] | result)&0x80000000)!=0)) || ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&result&0x80000000)!=0);
-			this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80000000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9])!=0);
+			result = (this->cpu.d[this->op->reg] - value);
+			this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[this->op->reg] | result)&0x80000000)!=0)) || ((this->cpu.d[this->op->reg]&result&0x80000000)!=0);
+			this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[this->op->reg]^0x80000000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[this->op->reg])!=0);
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 			break;
@@ -2357,17 +2340,17 @@ void mc68k::CMPAhandler(void) {
 	unsigned int	value, result;
 
 	size = ((this->cpu.instruction_reg & 0x0100) >> 8);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, (size + 1));
+	value = this->getOperandValue(this->op->ea, (size + 1));
 	if (size == 1) { // Size is L
-		result = (this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] - value);
-		this->cpu.sr.flag.c = (((this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
-		this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80000000)&value)!=0);
+		result = (this->cpu.a[this->op->reg] - value);
+		this->cpu.sr.flag.c = (((this->cpu.a[this->op->reg]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
+		this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.a[this->op->reg]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.a[this->op->reg]^0x80000000)&value)!=0);
 		this->cpu.sr.flag.z = (result == 0);
 		this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 	} else {		// Size is W
-		result = ((this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) - (value & 0x0000FFFF));
-		this->cpu.sr.flag.c = (((this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
-		this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80000000)&value)!=0);
+		result = ((this->cpu.a[this->op->reg] & 0x0000FFFF) - (value & 0x0000FFFF));
+		this->cpu.sr.flag.c = (((this->cpu.a[this->op->reg]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
+		this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.a[this->op->reg]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.a[this->op->reg]^0x80000000)&value)!=0);
 		this->cpu.sr.flag.z = (result == 0);
 		this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 	}
@@ -2379,12 +2362,12 @@ void mc68k::CMPISUBIhandler(void) {
 	unsigned int	parameter1;
 	unsigned int	result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
+	size = this->op->size;
 	switch (size) {
 		case 0x00 :					// CMPI.B
 			parameter1 = (this->readWord(this->cpu.pc) & 0xFF);
 			this->cpu.pc += 2;
-			start = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+			start = this->getOperandValue(this->op->ea, size);
 			result = ((start & 0xFF) - parameter1);
 //			WriteLog("CMPI.B pc=%08X start=%02X parameter1=%04X result=%02X\n", this->cpu.pc, start, parameter1, result);
 			this->cpu.sr.flag.c = (((parameter1 & 0x80) == 0) && (((start|result) & 0x80) != 0)) || ((start&result&0x80) != 0);
@@ -2395,7 +2378,7 @@ void mc68k::CMPISUBIhandler(void) {
 		case 0x01 :					// CMPI.W
 			parameter1 = this->readWord(this->cpu.pc);
 			this->cpu.pc += 2;
-			start = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+			start = this->getOperandValue(this->op->ea, size);
 			result = ((start & 0xFFFF) - parameter1);
 //			WriteLog("CMPI.W pc=%08X start=%04X parameter1=%04X result=%04X\n", this->cpu.pc, start, parameter1, result);
 			this->cpu.sr.flag.c = (((parameter1 & 0x8000) == 0) && (((start|result) & 0x8000) != 0)) || ((start&result&0x8000) != 0);
@@ -2406,7 +2389,7 @@ void mc68k::CMPISUBIhandler(void) {
 		case 0x02 :					// CMPI.L
 			parameter1 = this->readLong(this->cpu.pc);
 			this->cpu.pc += 4;
-			start = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+			start = this->getOperandValue(this->op->ea, size);
 			result = (start - parameter1);
 //			WriteLog("CMPI.L pc=%08X start=%08X parameter1=%04X result=%08X\n", this->cpu.pc, start, parameter1, result);
 			this->cpu.sr.flag.c = (((parameter1 & 0x80000000) == 0) && (((start|result) & 0x80000000) != 0)) || ((start&result&0x80000000) != 0);
@@ -2420,8 +2403,8 @@ void mc68k::CMPISUBIhandler(void) {
 			break;
 	}
 	if ((this->cpu.instruction_reg & 0x0F00) == 0x0400) {						// Write result back if this is a SUBI
-		this->rewindPC(this->cpu.instruction_reg & 0x3F);
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+		this->rewindPC(this->op->ea);
+		this->setOperandValue(this->op->ea, size, result);
 		this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 	}
 }
@@ -2430,9 +2413,9 @@ void mc68k::CMPMhandler(void) {
 	unsigned char	size;
 	unsigned int	value, value2, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue((this->cpu.instruction_reg & 0x0007) + 0x0018, size);
-	value2 = this->getOperandValue(((this->cpu.instruction_reg & 0x0E00) >> 9) + 0x0018, size);
+	size = this->op->size;
+	value = this->getOperandValue((this->op->ea & 0x07) + 0x0018, size);
+	value2 = this->getOperandValue(this->op->reg + 0x0018, size);
 	switch (size) {
 		case 0x00 :
 			result = ((value2 & 0x000000FF) - (value & 0x000000FF));
@@ -2449,7 +2432,7 @@ void mc68k::CMPMhandler(void) {
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			break;
 		case 0x02 :
-			result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] - value);
+			result = (this->cpu.d[this->op->reg] - value);
 			this->cpu.sr.flag.c = (((value2 & 0x80000000)==0) && (((value | value2) & 0x80000000)!=0)) || ((value & result & 0x80000000)!=0);
 			this->cpu.sr.flag.v = ((0x80000000 & (value ^ 0x80000000) & value2 & (result ^ 0x80000000)) !=0) || ((0x80000000 & result & (value2 ^ 0x80000000) & value) != 0);
 			this->cpu.sr.flag.z = (result == 0);
@@ -2466,21 +2449,21 @@ void mc68k::DIVUhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 
 	if (value) {
-		result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] % value);	// bits 15-0=quotient
+		result = (this->cpu.d[this->op->reg] % value);	// bits 15-0=quotient
 		if (result > 65535)
 			this->cpu.sr.flag.v = true;
 		else
 			this->cpu.sr.flag.v = false;
 		result = result << 16;
-		result |= ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] / value) & 0xFFFF);	// bits 31-16=remainder
+		result |= ((this->cpu.d[this->op->reg] / value) & 0xFFFF);	// bits 31-16=remainder
 		this->cpu.sr.flag.z = (result == 0);
 		this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 		this->cpu.sr.flag.c = false;
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+		this->cpu.d[this->op->reg] = result;
 	} else
 		this->pendingException = DIVIDE_BY_ZERO;
 }
@@ -2489,21 +2472,21 @@ void mc68k::DIVShandler(void) {
 	unsigned char	size;
 	int				signedvalue, signedresult;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	signedvalue = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	signedvalue = this->getOperandValue(this->op->ea, size);
 
 	if (signedvalue) {
-		signedresult = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] % signedvalue);	// bits 15-0=quotient
+		signedresult = (this->cpu.d[this->op->reg] % signedvalue);	// bits 15-0=quotient
 		if ((signedresult < -32768) || (signedresult > 32767))
 			this->cpu.sr.flag.v = true;
 		else
 			this->cpu.sr.flag.v = false;
 		signedresult = signedresult << 16;
-		signedresult |= ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] / signedvalue) & 0xFFFF);	// bits 31-16=remainder
+		signedresult |= ((this->cpu.d[this->op->reg] / signedvalue) & 0xFFFF);	// bits 31-16=remainder
 		this->cpu.sr.flag.z = (signedresult == 0);
 		this->cpu.sr.flag.n = ((signedresult & 0x80000000) == 0x80000000);
 		this->cpu.sr.flag.c = false;
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = signedresult;
+		this->cpu.d[this->op->reg] = signedresult;
 	} else
 		this->pendingException = DIVIDE_BY_ZERO;
 }
@@ -2512,23 +2495,23 @@ void mc68k::EORhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
 	switch (size) {
 		case 0x00 :
-			result = (value ^ (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF));
+			result = (value ^ (this->cpu.d[this->op->reg] & 0x000000FF));
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 			break;
 		case 0x01 :
-			result = (value ^ (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF));
+			result = (value ^ (this->cpu.d[this->op->reg] & 0x0000FFFF));
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			break;
 		case 0x02 :
-			result = (value ^ this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]);
+			result = (value ^ this->cpu.d[this->op->reg]);
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 			break;
@@ -2537,7 +2520,7 @@ void mc68k::EORhandler(void) {
 			return;
 			break;
 	}
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+	this->setOperandValue(this->op->ea, size, result);
 }
 
 void mc68k::EORIhandler(void) {
@@ -2558,8 +2541,8 @@ void mc68k::EORIhandler(void) {
 			this->pendingException = PRIVILEGE_VIOLATION;
 	}
 	if ((this->cpu.instruction_reg & 0xFFBF) != 0x0A3C) {	// EORI
-		size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-		value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+		size = this->op->size;
+		value = this->getOperandValue(this->op->ea, size);
 		this->cpu.sr.flag.c = false;
 		this->cpu.sr.flag.v = false;
 		switch (size) {
@@ -2586,8 +2569,8 @@ void mc68k::EORIhandler(void) {
 				return;
 				break;
 		}
-		this->rewindPC(this->cpu.instruction_reg & 0x3F);
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, value);
+		this->rewindPC(this->op->ea);
+		this->setOperandValue(this->op->ea, size, value);
 	}
 }
 
@@ -2596,19 +2579,19 @@ void mc68k::EXGhandler(void) {
 
 	switch (this->cpu.instruction_reg & 0x00C8) {
 		case 0x0040 :	// Exchange data registers
-			value = this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)];
-			this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] = this->cpu.d[(this->cpu.instruction_reg & 0x0007)];
-			this->cpu.d[(this->cpu.instruction_reg & 0x0007)] = value;
+			value = this->cpu.d[this->op->reg];
+			this->cpu.d[this->op->reg] = this->cpu.d[this->op->ea & 0x07];
+			this->cpu.d[this->op->ea & 0x07] = value;
 			break;
 		case 0x0048 :	// Exchange address registers
-			value = this->cpu.a[((this->cpu.instruction_reg & 0x0E00) >> 9)];
-			this->cpu.a[((this->cpu.instruction_reg & 0x0E00) >> 9)] = this->cpu.a[(this->cpu.instruction_reg & 0x0007)];
-			this->cpu.a[(this->cpu.instruction_reg & 0x0007)] = value;
+			value = this->cpu.a[this->op->reg];
+			this->cpu.a[this->op->reg] = this->cpu.a[this->op->ea & 0x07];
+			this->cpu.a[this->op->ea & 0x07] = value;
 			break;
 		case 0x0088 :	// Exchange data and address register
-			value = this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)];
-			this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] = this->cpu.a[(this->cpu.instruction_reg & 0x0007)];
-			this->cpu.a[(this->cpu.instruction_reg & 0x0007)] = value;
+			value = this->cpu.d[this->op->reg];
+			this->cpu.d[this->op->reg] = this->cpu.a[this->op->ea & 0x07];
+			this->cpu.a[this->op->ea & 0x07] = value;
 			break;
 	}
 }
@@ -2616,7 +2599,7 @@ void mc68k::EXGhandler(void) {
 void mc68k::EXThandler(void) {
 	unsigned int	value, result;
 
-	value = this->cpu.d[this->cpu.instruction_reg & 0x07];
+	value = this->cpu.d[this->op->ea & 0x07];
 	if (this->cpu.instruction_reg & 0x0040) {			// EXT.L
 		result = this->signExtend(value);
 		this->cpu.sr.flag.z = (result == 0);
@@ -2631,23 +2614,62 @@ void mc68k::EXThandler(void) {
 	}
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
-	this->cpu.d[this->cpu.instruction_reg & 0x07] = result;
+	this->cpu.d[this->op->ea & 0x07] = result;
+}
+
+void mc68k::ILLEGALhandler(void) {
+	this->pendingException = ILLEGAL_INSTRUCTION;
+}
+
+void mc68k::JMPhandler(void) {
+	unsigned int	value;
+
+	value = this->getOperandValue(this->op->ea, 0x02);
+	if ((this->op->ea & 0x38) == 0x10)			// Hack because JMP's with (Ax) don't read the address
+		value = this->cpu.a[this->op->ea & 0x07];
+	if (this->op->ea == 0x38)					// Hack because JMP's with $xxxx.W don't read the address
+		value = this->signExtend(this->readWord(this->cpu.pc - 2));
+
+	this->cpu.pc = (value & this->INTERNAL_ADDRESS_MASK);
+	if (this->cpu.pc & 1)
+		this->pendingException = ADDRESS_ERROR;
+}
+
+void mc68k::JSRhandler(void) {
+	unsigned int	value;
+
+	value = this->getOperandValue(this->op->ea, 0x02);
+	if ((this->op->ea & 0x38) == 0x10)			// Hack because JSR's with (Ax) don't read the address
+		value = this->cpu.a[this->op->ea & 0x07];
+	if (this->op->ea == 0x38)					// Hack because JSR's with $xxxx.W don't read the address
+		value = this->signExtend(this->readWord(this->cpu.pc - 2));
+
+	if (this->cpu.sr.flag.s) {
+		this->cpu.ssp -= 4;
+		writeLong(this->cpu.ssp, this->cpu.pc);			// In Supervisor mode, so use the Supervisor Stack
+	} else {
+		this->cpu.usp -= 4;
+		writeLong(this->cpu.usp, this->cpu.pc);
+	}
+	this->cpu.pc = (value & this->INTERNAL_ADDRESS_MASK);
+	if (this->cpu.pc & 1)
+		this->pendingException = ADDRESS_ERROR;
 }
 
 void mc68k::LEAhandler(void) {
 	unsigned int	value;
 	unsigned char	Operand;
 
-	Operand = (this->cpu.instruction_reg & 0x3F);
+	Operand = (this->op->ea);
 	switch (Operand) {
 		case 0x3A :
 			value = this->readWord(this->cpu.pc);
 			if (this->DEBUG)
 				WriteLog(" %04X", value);
 			if (value & 0x8000)
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.pc - (~value & 0xFFFF) - 1;
+				this->cpu.a[this->op->reg] = this->cpu.pc - (~value & 0xFFFF) - 1;
 			else
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.pc + (value & 0xFFFF);
+				this->cpu.a[this->op->reg] = this->cpu.pc + (value & 0xFFFF);
 			this->cpu.pc += 2;
 			break;
 
@@ -2663,9 +2685,9 @@ void mc68k::LEAhandler(void) {
 				WriteLog(" %04X", value);
 			this->cpu.pc += 2;
 			if (value & 0x8000)
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.a[Operand & 7] - (~value & 0xFFFF) - 1;
+				this->cpu.a[this->op->reg] = this->cpu.a[Operand & 7] - (~value & 0xFFFF) - 1;
 			else
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.a[Operand & 7] + (value & 0xFFFF);
+				this->cpu.a[this->op->reg] = this->cpu.a[Operand & 7] + (value & 0xFFFF);
 			break;
 
 		case 0x2F :
@@ -2675,18 +2697,18 @@ void mc68k::LEAhandler(void) {
 			this->cpu.pc += 2;
 			if (value & 0x8000)
 				if (this->cpu.sr.flag.s)
-					this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.ssp - (~value & 0xFFFF) - 1;
+					this->cpu.a[this->op->reg] = this->cpu.ssp - (~value & 0xFFFF) - 1;
 				else
-					this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.usp - (~value & 0xFFFF) - 1;
+					this->cpu.a[this->op->reg] = this->cpu.usp - (~value & 0xFFFF) - 1;
 			else
 				if (this->cpu.sr.flag.s)
-					this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.ssp + (value & 0xFFFF);
+					this->cpu.a[this->op->reg] = this->cpu.ssp + (value & 0xFFFF);
 				else
-					this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->cpu.usp + (value & 0xFFFF);
+					this->cpu.a[this->op->reg] = this->cpu.usp + (value & 0xFFFF);
 			break;
 
 		default :
-			this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = this->getOperandValue(Operand, 0x02);
+			this->cpu.a[this->op->reg] = this->getOperandValue(Operand, 0x02);
 			break;
 	}
 }
@@ -2697,17 +2719,24 @@ void mc68k::LINKhandler(void) {
 	this->cpu.pc += 2;
 	if (this->cpu.sr.flag.s) {
 		this->cpu.ssp -= 4;
-		writeLong(this->cpu.ssp, this->cpu.a[this->cpu.instruction_reg & 0x0007]);
-		this->cpu.a[this->cpu.instruction_reg & 0x0007] = this->cpu.ssp;
+		writeLong(this->cpu.ssp, this->cpu.a[this->op->ea & 0x07]);
+		this->cpu.a[this->op->ea & 0x07] = this->cpu.ssp;
 		this->cpu.ssp += value;
 	} else {
 		this->cpu.usp -= 4;
-		writeLong(this->cpu.usp, this->cpu.a[this->cpu.instruction_reg & 0x0007]);
-		this->cpu.a[this->cpu.instruction_reg & 0x0007] = this->cpu.ssp;
+		writeLong(this->cpu.usp, this->cpu.a[this->op->ea & 0x07]);
+		this->cpu.a[this->op->ea & 0x07] = this->cpu.ssp;
 		this->cpu.usp += value;
 	}
 }
 
+void mc68k::MOVEfromSRhandler(void) {
+	if (((this->cpu.type != MC68008L) && (this->cpu.type != MC68008P) && (this->cpu.type != MC68000)) && this->cpu.sr.flag.s)	// Privileged instruction on > 68010
+		this->pendingException = PRIVILEGE_VIOLATION;
+	else
+		this->setOperandValue(this->op->ea, 0x01, this->cpu.sr.reg);
+}
+
 void mc68k::MOVEhandler(void) {
 	unsigned char	size;
 	unsigned int	value;
@@ -2718,8 +2747,8 @@ void mc68k::MOVEhandler(void) {
 			size = 0;
 		if (size == 3)
 			size = 1;
-		value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
-		this->setOperandValue(((this->cpu.instruction_reg & 0x01C0) >> 3) | ((this->cpu.instruction_reg & 0x0E00) >> 9), size, value);
+		value = this->getOperandValue(this->op->ea, size);
+		this->setOperandValue(((this->cpu.instruction_reg & 0x01C0) >> 3) | this->op->reg, size, value);
 		if ((this->cpu.instruction_reg & 0x01C0) != 0x0040) {	// Only set flags for MOVE instruction, not for MOVEA
 			this->cpu.sr.flag.c = 0;
 			this->cpu.sr.flag.v = 0;
@@ -2865,52 +2894,84 @@ void mc68k::MOVEPhandler(void) {
 	this->cpu.pc += 2;
 	if (this->cpu.instruction_reg & 0x0080) {	// From register to memory
 		if (size) {	// MOVEP.L
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)    , ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0xFF000000) >> 24));
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value) + 2, ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0x00FF0000) >> 16));
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value) + 4, ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0x0000FF00) >> 8));
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value) + 6, ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0x000000FF)));
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)    , ((this->cpu.d[this->op->reg] & 0xFF000000) >> 24));
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value) + 2, ((this->cpu.d[this->op->reg] & 0x00FF0000) >> 16));
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value) + 4, ((this->cpu.d[this->op->reg] & 0x0000FF00) >> 8));
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value) + 6, ((this->cpu.d[this->op->reg] & 0x000000FF)));
 		} else {	// MOVEP.W
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)    , ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0x0000FF00) >> 8));
-			writeByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value) + 2, ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] & 0x000000FF)));						
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)    , ((this->cpu.d[this->op->reg] & 0x0000FF00) >> 8));
+			writeByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value) + 2, ((this->cpu.d[this->op->reg] & 0x000000FF)));						
 		}
 	} else {									// From memory to register
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)]  = (this->readByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)) << 24);
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] |= (this->readByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)) << 16);
+		this->cpu.d[this->op->reg]  = (this->readByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)) << 24);
+		this->cpu.d[this->op->reg] |= (this->readByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)) << 16);
 		if (size) {
-			this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] |= (this->readByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)) << 8);
-			this->cpu.d[(this->cpu.instruction_reg & 0x0E00 >> 9)] |= (this->readByte(this->cpu.a[(this->cpu.instruction_reg & 0x0007)] + signExtend(value)));
+			this->cpu.d[this->op->reg] |= (this->readByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)) << 8);
+			this->cpu.d[this->op->reg] |= (this->readByte(this->cpu.a[this->op->ea & 0x07] + signExtend(value)));
 		}
 	}
 }
 
+void mc68k::MOVEQhandler(void) {
+	this->cpu.d[this->op->reg] = (this->cpu.instruction_reg & 0x00FF);
+	if (this->cpu.d[this->op->reg] & 0x00000080)
+		this->cpu.d[this->op->reg] |= 0xFFFFFF00;
+
+	this->cpu.sr.flag.c = 0;
+	this->cpu.sr.flag.v = 0;
+	this->cpu.sr.flag.z = ((this->cpu.instruction_reg & 0x00FF) == 0);
+	this->cpu.sr.flag.n = ((this->cpu.instruction_reg & 0x0080) == 0x80);
+}
+
+void mc68k::MOVEtoCCRhandler(void) {
+	this->cpu.sr.reg = ((this->cpu.sr.reg & 0xFF00) | (getOperandValue(this->op->ea, 0x01) & 0x00FF));
+}
+
+void mc68k::MOVEtoSRhandler(void) {
+	if (this->cpu.sr.flag.s)								// Only privileged instruction on > 68010
+		this->cpu.sr.reg = this->getOperandValue(this->op->ea, 0x01);
+	else
+		this->pendingException = PRIVILEGE_VIOLATION;
+}
+
+void mc68k::MOVEUSPhandler(void) {
+	if (this->cpu.sr.flag.s) {
+		if (this->op->ea & 0x08)
+			this->cpu.a[this->op->ea & 0x07] = this->cpu.usp;
+		else
+			this->cpu.usp = this->cpu.a[this->op->ea & 0x07];
+	} else
+		this->pendingException = PRIVILEGE_VIOLATION;
+}
+
 void mc68k::MULUhandler(void) {
 	unsigned int	value;
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x01);
+	value = this->getOperandValue(this->op->ea, 0x01);
 
-	this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) * (value & 0x0000FFFF);
+	this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0x0000FFFF) * (value & 0x0000FFFF);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
-	this->cpu.sr.flag.z = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] == 0);
-	this->cpu.sr.flag.n = ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x80000000) == 0x80000000);	// Can a MULU even produce a negative result?
+	this->cpu.sr.flag.z = (this->cpu.d[this->op->reg] == 0);
+	this->cpu.sr.flag.n = ((this->cpu.d[this->op->reg] & 0x80000000) == 0x80000000);	// Can a MULU even produce a negative result?
 }
 
 void mc68k::MULShandler(void) {
 	unsigned int	value;
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x01);
+	value = this->getOperandValue(this->op->ea, 0x01);
 
-	this->cpu.sr.flag.n = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x00008000) == 1) ^ ((value & 0x00008000) == 1));
-	this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) * (value & 0x0000FFFF);
+	this->cpu.sr.flag.n = (((this->cpu.d[this->op->reg] & 0x00008000) == 1) ^ ((value & 0x00008000) == 1));
+	this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0x0000FFFF) * (value & 0x0000FFFF);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
-	this->cpu.sr.flag.z = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] == 0);
+	this->cpu.sr.flag.z = (this->cpu.d[this->op->reg] == 0);
 }
 
 void mc68k::NBCDhandler(void) {
 	unsigned int	value, result;
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 	if ((value & 0x0F) > 9)
 		result = 9;
 	else
@@ -2925,16 +2986,16 @@ void mc68k::NBCDhandler(void) {
 		result--;
 	this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 	this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, ((result % 10) + ((result / 10) << 4)));
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, 0x00, ((result % 10) + ((result / 10) << 4)));
 }
 
 void mc68k::NEGhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	result = 0xFFFFFFFF - value + 1;
 	if ((this->cpu.instruction_reg & 0x0400) && this->cpu.sr.flag.x)				// Check X flag for NEGX
 		result--;
@@ -2961,16 +3022,16 @@ void mc68k::NEGhandler(void) {
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			break;
 	}
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, value);
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, size, value);
 }
 
 void mc68k::NOThandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 
 	switch (size) {
 		case 0x00 :					// NOT.B
@@ -2999,40 +3060,40 @@ void mc68k::NOThandler(void) {
 			return;
 			break;
 	}
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, size, result);
 }
 
 void mc68k::ORhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
 	switch (size) {
 		case 0x00 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) | (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF));
+				result = (value & 0xFFFFFF00) | ((value & 0x000000FF) | (this->cpu.d[this->op->reg] & 0x000000FF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) | (value & 0x000000FF));
+				result = (this->cpu.d[this->op->reg] & 0xFFFFFF00) | ((this->cpu.d[this->op->reg] & 0x000000FF) | (value & 0x000000FF));
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 			break;
 		case 0x01 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) | (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF));
+				result = (value & 0xFFFF0000) | ((value & 0x0000FFFF) | (this->cpu.d[this->op->reg] & 0x0000FFFF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) | (value & 0x0000FFFF));
+				result = (this->cpu.d[this->op->reg] & 0xFFFF0000) | ((this->cpu.d[this->op->reg] & 0x0000FFFF) | (value & 0x0000FFFF));
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			break;
 		case 0x02 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value | this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]);
+				result = (value | this->cpu.d[this->op->reg]);
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] | value);
+				result = (this->cpu.d[this->op->reg] | value);
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = (result & 0x80000000) == 0x80000000;
 			break;
@@ -3042,9 +3103,9 @@ void mc68k::ORhandler(void) {
 			break;
 	}
 	if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+		this->setOperandValue(this->op->ea, size, result);
 	else
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+		this->cpu.d[this->op->reg] = result;
 }
 
 void mc68k::ORIhandler(void) {
@@ -3065,8 +3126,8 @@ void mc68k::ORIhandler(void) {
 			this->pendingException = PRIVILEGE_VIOLATION;
 	}
 	if ((this->cpu.instruction_reg & 0xFFBF) != 0x003C) {	// ORI
-		size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-		value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+		size = this->op->size;
+		value = this->getOperandValue(this->op->ea, size);
 		this->cpu.sr.flag.c = false;
 		this->cpu.sr.flag.v = false;
 		switch (size) {
@@ -3093,22 +3154,47 @@ void mc68k::ORIhandler(void) {
 				return;
 				break;
 		}
-		this->rewindPC(this->cpu.instruction_reg & 0x3F);
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, value);
+		this->rewindPC(this->op->ea);
+		this->setOperandValue(this->op->ea, size, value);
+	}
+}
+
+void mc68k::PEAhandler(void) {
+	unsigned int	value;
+
+	if (this->op->ea == 0x3A) {		// Hack because PEA's with PC+Displacement don't read the address
+		value = this->cpu.pc + this->readWord(this->cpu.pc);
+		this->cpu.pc += 2;
+	} else
+		value = this->getOperandValue(this->op->ea, 0x02);
+
+	if (this->cpu.sr.flag.s) {
+		this->cpu.ssp -= 4;
+		writeLong(this->cpu.ssp, value);			// In Supervisor mode, so use the Supervisor Stack
+	} else {
+		this->cpu.usp -= 4;
+		writeLong(this->cpu.usp, value);
 	}
 }
 
+void mc68k::RESEThandler(void) {
+	if (this->cpu.sr.flag.s)
+		this->pendingException = RESET;			// Should do this differently; RESET just asserts the RESET line
+	else
+		this->pendingException = PRIVILEGE_VIOLATION;
+}
+
 void mc68k::ROxROXx_handler(void) {
 	unsigned char	size, rotation;
 	unsigned int	result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
+	size = this->op->size;
 	this->cpu.sr.flag.v = false;
 	if (size != 0x03) {
 		if (this->cpu.instruction_reg & 0x0020)
-			rotation = (this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] & 0x3F);	// Dn modulo 64 mode
+			rotation = (this->cpu.d[this->op->reg] & 0x3F);	// Dn modulo 64 mode
 		else {
-			rotation = ((this->cpu.instruction_reg & 0x0E00) >> 9);						// Immediate mode
+			rotation = this->op->reg;						// Immediate mode
 			if (rotation == 0)
 				rotation = 8;
 		}
@@ -3120,63 +3206,63 @@ void mc68k::ROxROXx_handler(void) {
 		switch (size) {
 			case 0x00 :
 				if (this->cpu.instruction_reg & 0x0100) {	// Rotate left
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00000080) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x00000080) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROL
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) & 0x000000FF) | (this->cpu.sr.flag.c == true));
+						result = (((this->cpu.d[this->op->ea & 0x07] << 1) & 0x000000FF) | (this->cpu.sr.flag.c == true));
 					else {									// ROXL
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) & 0x000000FF) | (this->cpu.sr.flag.x == true));
+						result = (((this->cpu.d[this->op->ea & 0x07] << 1) & 0x000000FF) | (this->cpu.sr.flag.x == true));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				} else {									// Rotate right
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00000001) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x00000001) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROR
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) & 0x000000FF) | ((this->cpu.sr.flag.c == true) << 7));
+						result = (((this->cpu.d[this->op->ea & 0x07] >> 1) & 0x000000FF) | ((this->cpu.sr.flag.c == true) << 7));
 					else {									// ROXR
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) & 0x000000FF) | ((this->cpu.sr.flag.x == true) << 7));
+						result = (((this->cpu.d[this->op->ea & 0x07] >> 1) & 0x000000FF) | ((this->cpu.sr.flag.x == true) << 7));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				}
-				this->cpu.d[this->cpu.instruction_reg & 0x0007] = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFFFF00) | (result & 0x000000FF);
+				this->cpu.d[this->op->ea & 0x07] = (this->cpu.d[this->op->ea & 0x07] & 0xFFFFFF00) | (result & 0x000000FF);
 				break;
 			case 0x01 :
 				if (this->cpu.instruction_reg & 0x0100) {	// Rotate left
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00008000) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x00008000) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROL
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) & 0x0000FFFF) | (this->cpu.sr.flag.c == true));
+						result = (((this->cpu.d[this->op->ea & 0x07] << 1) & 0x0000FFFF) | (this->cpu.sr.flag.c == true));
 					else {									// ROXL
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) & 0x0000FFFF) | (this->cpu.sr.flag.x == true));
+						result = (((this->cpu.d[this->op->ea & 0x07] << 1) & 0x0000FFFF) | (this->cpu.sr.flag.x == true));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				} else {									// Rotate right
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00000001) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x00000001) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROR
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) & 0x0000FFFF) | ((this->cpu.sr.flag.c == true) << 15));
+						result = (((this->cpu.d[this->op->ea & 0x07] >> 1) & 0x0000FFFF) | ((this->cpu.sr.flag.c == true) << 15));
 					else {									// ROXR
-						result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) & 0x0000FFFF) | ((this->cpu.sr.flag.x == true) << 15));
+						result = (((this->cpu.d[this->op->ea & 0x07] >> 1) & 0x0000FFFF) | ((this->cpu.sr.flag.x == true) << 15));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				}
-				this->cpu.d[this->cpu.instruction_reg & 0x0007] = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFF0000) | (result & 0x0000FFFF);
+				this->cpu.d[this->op->ea & 0x07] = (this->cpu.d[this->op->ea & 0x07] & 0xFFFF0000) | (result & 0x0000FFFF);
 				break;
 			case 0x02 :
 				if (this->cpu.instruction_reg & 0x0100) {	// Rotate left
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x80000000) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x80000000) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROL
-						result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) | (this->cpu.sr.flag.c == true));
+						result = ((this->cpu.d[this->op->ea & 0x07] << 1) | (this->cpu.sr.flag.c == true));
 					else {									// ROXL
-						result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] << 1) | (this->cpu.sr.flag.x == true));
+						result = ((this->cpu.d[this->op->ea & 0x07] << 1) | (this->cpu.sr.flag.x == true));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				} else {									// Rotate right
-					this->cpu.sr.flag.c = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x00000001) != 0);
+					this->cpu.sr.flag.c = ((this->cpu.d[this->op->ea & 0x07] & 0x00000001) != 0);
 					if (this->cpu.instruction_reg & 0x0100)	// ROR
-						result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) | ((this->cpu.sr.flag.c == true) << 31));
+						result = ((this->cpu.d[this->op->ea & 0x07] >> 1) | ((this->cpu.sr.flag.c == true) << 31));
 					else {									// ROXR
-						result = ((this->cpu.d[this->cpu.instruction_reg & 0x0007] >> 1) | ((this->cpu.sr.flag.x == true) << 31));
+						result = ((this->cpu.d[this->op->ea & 0x07] >> 1) | ((this->cpu.sr.flag.x == true) << 31));
 						this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 					}
 				}
-				this->cpu.d[this->cpu.instruction_reg & 0x0007] = result;
+				this->cpu.d[this->op->ea & 0x07] = result;
 				break;
 			case 0x03 :
 				WriteLog("mc68k::ROxROXx_handler -- Unimplemented instruction %04X at %08X\n", this->cpu.instruction_reg, this->cpu.pc);
@@ -3186,15 +3272,43 @@ void mc68k::ROxROXx_handler(void) {
 	}
 }
 
+void mc68k::RTEhandler(void) {
+	if (this->cpu.sr.flag.s) {
+		this->cpu.sr.reg = this->readWord(this->cpu.ssp);
+		this->cpu.ssp += 2;
+		this->cpu.pc = this->readLong(this->cpu.ssp);
+		this->cpu.ssp += 4;
+	} else
+		this->pendingException = PRIVILEGE_VIOLATION;
+}
+
+void mc68k::RTRhandler(void) {
+	this->cpu.sr.reg &= 0xFF00;
+	this->cpu.sr.reg |= (this->readWord(this->cpu.ssp) & 0x00FF);
+	this->cpu.ssp += 2;
+	this->cpu.pc = this->readLong(this->cpu.ssp);
+	this->cpu.ssp += 4;
+}
+
+void mc68k::RTShandler(void) {
+	if (this->cpu.sr.flag.s) {
+		this->cpu.pc = this->readLong(this->cpu.ssp);
+		this->cpu.ssp += 4;
+	} else {
+		this->cpu.pc = this->readLong(this->cpu.usp);
+		this->cpu.usp += 4;
+	}
+}
+
 void mc68k::SBCDhandler(void) {
 	unsigned int	value, value2, result, result2;
 
-	if (this->cpu.instruction_reg & 0x0008) {			// -(An) memory to memory operation
-		value = this->getOperandValue(((this->cpu.instruction_reg & 0x0007) | 0x0008), 0x00);			// Source value
-		value2 = this->getOperandValue((((this->cpu.instruction_reg & 0x0E00) >> 9) | 0x0008), 0x00);	// Destination value
+	if (this->op->ea & 0x08) {			// -(An) memory to memory operation
+		value = this->getOperandValue(((this->op->ea & 0x07) | 0x0008), 0x00);			// Source value
+		value2 = this->getOperandValue((this->op->reg | 0x0008), 0x00);	// Destination value
 	} else {											// Dn to Dn operation
-		value = this->cpu.d[(this->cpu.instruction_reg & 0x0007)];
-		value2 = this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)];
+		value = this->cpu.d[this->op->ea & 0x07];
+		value2 = this->cpu.d[this->op->reg];
 	}
 
 	if ((value & 0x0F) > 9)
@@ -3224,48 +3338,89 @@ void mc68k::SBCDhandler(void) {
 		this->cpu.sr.flag.x = true;
 	}
 	this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
-	if (this->cpu.instruction_reg & 0x0008)					// -(An) memory to memory operation
-		this->setOperandValue((((this->cpu.instruction_reg & 0x0E00) >> 9) | 0x0008), 0x00, ((result % 10) + ((result / 10) << 4)));
+	if (this->op->ea & 0x08)					// -(An) memory to memory operation
+		this->setOperandValue((this->op->reg | 0x0008), 0x00, ((result % 10) + ((result / 10) << 4)));
+	else
+		this->cpu.d[this->op->reg] = result;
+}
+
+void mc68k::SccDBcchandler(void) {
+	if ((this->cpu.instruction_reg & 0xF0F8) == 0x50C8) {	// DBcc
+		if (evaluateConditionCode((this->cpu.instruction_reg & 0x0F00) >> 16)) {
+			this->cpu.d[this->op->ea & 0x07] = (this->cpu.d[this->op->ea & 0x07] & 0xFFFF0000) | ((this->cpu.d[this->op->ea & 0x07] -1) & 0x0000FFFF);
+			if ((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF) != 0x0000FFFF)
+				this->cpu.pc += this->signExtend(this->readWord(this->cpu.pc));
+			else
+				this->cpu.pc += 2;
+		} else
+			this->cpu.pc += 2;
+	} else {											// Scc
+		if (evaluateConditionCode((this->cpu.instruction_reg & 0x0F00) >> 16))
+			this->setOperandValue(this->op->ea, 0x00, 0xFF);
+		else
+			this->setOperandValue(this->op->ea, 0x00, 0x00);
+	}
+}
+
+void mc68k::STOPhandler(void) {
+	unsigned int	value;
+
+	if (this->cpu.sr.flag.s) {
+		value = this->readWord(this->cpu.pc);
+		this->cpu.sr.reg = (value & 0xFFFF);
+		this->cpu.stop = true;
+	} else
+		this->pendingException = PRIVILEGE_VIOLATION;
+}
+
+void mc68k::SUBAhandler(void) {
+	unsigned int	value;
+	unsigned char	size;
+
+	size = ((this->cpu.instruction_reg & 0x0100) >> 7);
+	value = this->getOperandValue(this->op->ea, size);
+	if (size == 0x01)
+		this->cpu.a[this->op->reg] -= (value & 0x0000FFFF);
 	else
-		this->cpu.d[((this->cpu.instruction_reg & 0x0E00) >> 9)] = result;
+		this->cpu.a[this->op->reg] -= value;
 }
 
 void mc68k::SUBhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0x000000FF) | ((value & 0x000000FF) - (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF));
+				result = (value & 0x000000FF) | ((value & 0x000000FF) - (this->cpu.d[this->op->reg] & 0x000000FF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF) - (value & 0x000000FF));
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80)==0) && (((value|result)&0x80)!=0)) || ((value&result&0x80)!=0);
-			this->cpu.sr.flag.v = ((0x80&(value^0x80)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80))!=0)||((0x80&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80)&value)!=0);
+				result = (this->cpu.d[this->op->reg] & 0x000000FF) | ((this->cpu.d[this->op->reg] & 0x000000FF) - (value & 0x000000FF));
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x80)==0) && (((value|result)&0x80)!=0)) || ((value&result&0x80)!=0);
+			this->cpu.sr.flag.v = ((0x80&(value^0x80)&this->cpu.d[this->op->reg]&(result^0x80))!=0)||((0x80&result&(this->cpu.d[this->op->reg]^0x80)&value)!=0);
 			this->cpu.sr.flag.z = ((result & 0x000000FF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			break;
 		case 0x01 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value & 0x0000FFFF) | ((value & 0x0000FFFF) - (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF));
+				result = (value & 0x0000FFFF) | ((value & 0x0000FFFF) - (this->cpu.d[this->op->reg] & 0x0000FFFF));
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) | ((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF) - (value & 0x0000FFFF));
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x8000)==0) && (((value|result)&0x8000)!=0)) || ((value&result&0x8000)!=0);
-			this->cpu.sr.flag.v = ((0x8000&(value^0x8000)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x8000))!=0)||((0x8000&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x8000)&value)!=0);
+				result = (this->cpu.d[this->op->reg] & 0x0000FFFF) | ((this->cpu.d[this->op->reg] & 0x0000FFFF) - (value & 0x0000FFFF));
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x8000)==0) && (((value|result)&0x8000)!=0)) || ((value&result&0x8000)!=0);
+			this->cpu.sr.flag.v = ((0x8000&(value^0x8000)&this->cpu.d[this->op->reg]&(result^0x8000))!=0)||((0x8000&result&(this->cpu.d[this->op->reg]^0x8000)&value)!=0);
 			this->cpu.sr.flag.z = ((result & 0x0000FFFF) == 0);
 			this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
 			break;
 		case 0x02 :
 			if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-				result = (value - this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]);
+				result = (value - this->cpu.d[this->op->reg]);
 			else									// Destination is Dx
-				result = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] - value);
-			this->cpu.sr.flag.c = (((this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
-			this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9]^0x80000000)&value)!=0);
+				result = (this->cpu.d[this->op->reg] - value);
+			this->cpu.sr.flag.c = (((this->cpu.d[this->op->reg]&0x80000000)==0) && (((value|result)&0x80000000)!=0)) || ((value&result&0x80000000)!=0);
+			this->cpu.sr.flag.v = ((0x80000000&(value^0x80000000)&this->cpu.d[this->op->reg]&(result^0x80000000))!=0)||((0x80000000&result&(this->cpu.d[this->op->reg]^0x80000000)&value)!=0);
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = (result & 0x80000080) == 0x80000000;
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
@@ -3276,44 +3431,44 @@ void mc68k::SUBhandler(void) {
 			break;
 	}
 	if (this->cpu.instruction_reg & 0x0100)		// Destination is operand
-		this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+		this->setOperandValue(this->op->ea, size, result);
 	else
-		this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+		this->cpu.d[this->op->reg] = result;
 }
 
 void mc68k::SUBQhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	switch (size) {
 		case 0x00 :
-			result = (value & 0xFFFFFF00) | ((value - ((this->cpu.instruction_reg & 0x0E00) >> 9)) & 0x000000FF);
+			result = (value & 0xFFFFFF00) | ((value - this->op->reg) & 0x000000FF);
 			this->cpu.sr.flag.c = (((result&0x80)==0) && ((value&0x80)!=0));
 			this->cpu.sr.flag.v = (0x80&result&(value^0x80))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80) == 0x80);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x01 :
-			result = (value & 0xFFFF0000) | ((value - ((this->cpu.instruction_reg & 0x0E00) >> 9)) & 0x0000FFFF);
+			result = (value & 0xFFFF0000) | ((value - this->op->reg) & 0x0000FFFF);
 			this->cpu.sr.flag.c = (((result&0x8000)==0) && ((value&0x8000)!=0));
 			this->cpu.sr.flag.v = (0x8000&result&(value^0x8000))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x8000) == 0x8000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x02 :
-			result = value - ((this->cpu.instruction_reg & 0x0E00) >> 9);
+			result = value - this->op->reg;
 			this->cpu.sr.flag.c = (((result&0x80)==0) && ((value&0x80)!=0));
 			this->cpu.sr.flag.v = (0x80000000&result&(value^0x80000000))!=0;
 			this->cpu.sr.flag.z = (result == 0);
 			this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 			this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-			this->setOperandValue(this->cpu.instruction_reg & 0x3F, size, result);
+			this->setOperandValue(this->op->ea, size, result);
 			break;
 		case 0x03 :
 			this->pendingException = ILLEGAL_INSTRUCTION;
@@ -3326,38 +3481,38 @@ void mc68k::SUBXhandler(void) {
 	unsigned char	size;
 	unsigned int	value, result;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	if (this->cpu.instruction_reg & 0x0008) {			// -(An) memory to memory operation
+	size = this->op->size;
+	if (this->op->ea & 0x08) {			// -(An) memory to memory operation
 		switch (size) {
 			case 0x00 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF;
-				result = (this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF) - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)&result&0x80)!=0);;
-				this->cpu.sr.flag.v = ((0x80&((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x000000FF))!=0);;
+				value = this->cpu.a[this->op->reg] & 0x000000FF;
+				result = (this->cpu.a[this->op->ea & 0x07] & 0x000000FF) - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)&result&0x80)!=0);;
+				this->cpu.sr.flag.v = ((0x80&((this->cpu.a[this->op->ea & 0x07] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.a[this->op->ea & 0x07] & 0x000000FF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x000000FF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | (result & 0x000000FF);
+				this->cpu.a[this->op->reg] = (this->cpu.a[this->op->reg] & 0xFFFFFF00) | (result & 0x000000FF);
 				break;
 			case 0x01 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF;
-				result = (this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)&result&0x8000)!=0);;
-				this->cpu.sr.flag.v = ((0x8000&((this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.a[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF))!=0);;
+				value = this->cpu.a[this->op->reg] & 0x0000FFFF;
+				result = (this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF) - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)&result&0x8000)!=0);;
+				this->cpu.sr.flag.v = ((0x8000&((this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.a[this->op->ea & 0x07] & 0x0000FFFF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x0000FFFF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | (result & 0x0000FFFF);
+				this->cpu.a[this->op->reg] = (this->cpu.a[this->op->reg] & 0xFFFF0000) | (result & 0x0000FFFF);
 				break;
 			case 0x02 :
-				value = this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9];
-				result = this->cpu.a[this->cpu.instruction_reg & 0x0007] - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.a[this->cpu.instruction_reg & 0x0007]|result)&0x80000000)!=0)) || ((this->cpu.a[this->cpu.instruction_reg & 0x0007]&result&0x80000000)!=0);;
-				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.a[this->cpu.instruction_reg & 0x0007]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.a[this->cpu.instruction_reg & 0x0007])!=0);;
+				value = this->cpu.a[this->op->reg];
+				result = this->cpu.a[this->op->ea & 0x07] - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.a[this->op->ea & 0x07]|result)&0x80000000)!=0)) || ((this->cpu.a[this->op->ea & 0x07]&result&0x80000000)!=0);;
+				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.a[this->op->ea & 0x07]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.a[this->op->ea & 0x07])!=0);;
 				this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.a[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+				this->cpu.a[this->op->reg] = result;
 				break;
 			case 0x03 :
 				this->pendingException = ILLEGAL_INSTRUCTION;
@@ -3367,34 +3522,34 @@ void mc68k::SUBXhandler(void) {
 	} else {										// Dn to Dn operation
 		switch (size) {
 			case 0x00 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x000000FF;
-				result = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF) - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)&result&0x80)!=0);;
-				this->cpu.sr.flag.v = ((0x80&((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x000000FF))!=0);;
+				value = this->cpu.d[this->op->reg] & 0x000000FF;
+				result = (this->cpu.d[this->op->ea & 0x07] & 0x000000FF) - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80)==0) && ((((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)|result)&0x80)!=0)) || (((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)&result&0x80)!=0);;
+				this->cpu.sr.flag.v = ((0x80&((this->cpu.d[this->op->ea & 0x07] & 0x000000FF)^0x80)&value&(result^0x80))!=0)||((0x80&result&(value^0x80)&(this->cpu.d[this->op->ea & 0x07] & 0x000000FF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00000080) == 0x80);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x000000FF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFFFF00) | (result & 0x000000FF);
+				this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0xFFFFFF00) | (result & 0x000000FF);
 				break;
 			case 0x01 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0x0000FFFF;
-				result = (this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF) - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)&result&0x8000)!=0);;
-				this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0x0000FFFF))!=0);;
+				value = this->cpu.d[this->op->reg] & 0x0000FFFF;
+				result = (this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF) - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x8000)==0) && ((((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)|result)&0x8000)!=0)) || (((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)&result&0x8000)!=0);;
+				this->cpu.sr.flag.v = ((0x8000&((this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF)^0x8000)&value&(result^0x8000))!=0)||((0x8000&result&(value^0x8000)&(this->cpu.d[this->op->ea & 0x07] & 0x0000FFFF))!=0);;
 				this->cpu.sr.flag.n = ((result & 0x00008000) == 0x8000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & ((result & 0x0000FFFF) == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = (this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] & 0xFFFF0000) | (result & 0x0000FFFF);
+				this->cpu.d[this->op->reg] = (this->cpu.d[this->op->reg] & 0xFFFF0000) | (result & 0x0000FFFF);
 				break;
 			case 0x02 :
-				value = this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9];
-				result = this->cpu.d[this->cpu.instruction_reg & 0x0007] - value - this->cpu.sr.flag.x;
-				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[this->cpu.instruction_reg & 0x0007]|result)&0x80000000)!=0)) || ((this->cpu.d[this->cpu.instruction_reg & 0x0007]&result&0x80000000)!=0);;
-				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[this->cpu.instruction_reg & 0x0007]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[this->cpu.instruction_reg & 0x0007])!=0);;
+				value = this->cpu.d[this->op->reg];
+				result = this->cpu.d[this->op->ea & 0x07] - value - this->cpu.sr.flag.x;
+				this->cpu.sr.flag.c = (((value&0x80000000)==0) && (((this->cpu.d[this->op->ea & 0x07]|result)&0x80000000)!=0)) || ((this->cpu.d[this->op->ea & 0x07]&result&0x80000000)!=0);;
+				this->cpu.sr.flag.v = ((0x80000000&(this->cpu.d[this->op->ea & 0x07]^0x8000)&value&(result^0x80000000))!=0)||((0x80000000&result&(value^0x80000000)&this->cpu.d[this->op->ea & 0x07])!=0);;
 				this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 				this->cpu.sr.flag.z = this->cpu.sr.flag.z & (result == 0);
 				this->cpu.sr.flag.x = this->cpu.sr.flag.c;
-				this->cpu.d[(this->cpu.instruction_reg & 0x0E00) >> 9] = result;
+				this->cpu.d[this->op->reg] = result;
 				break;
 			case 0x03 :
 				this->pendingException = ILLEGAL_INSTRUCTION;
@@ -3407,9 +3562,9 @@ void mc68k::SUBXhandler(void) {
 void mc68k::SWAPhandler(void) {
 	unsigned int	value, result;
 
-	value = this->cpu.d[this->cpu.instruction_reg & 0x0007];
-	result = (((this->cpu.d[this->cpu.instruction_reg & 0x0007] & 0xFFFF0000) >> 16) | ((value & 0x0000FFFF) << 16));
-	this->cpu.d[this->cpu.instruction_reg & 0x0007] = result;
+	value = this->cpu.d[this->op->ea & 0x07];
+	result = (((this->cpu.d[this->op->ea & 0x07] & 0xFFFF0000) >> 16) | ((value & 0x0000FFFF) << 16));
+	this->cpu.d[this->op->ea & 0x07] = result;
 	this->cpu.sr.flag.n = ((result & 0x80000000) == 0x80000000);
 	this->cpu.sr.flag.z = (result == 0);
 	this->cpu.sr.flag.v = false;
@@ -3419,23 +3574,32 @@ void mc68k::SWAPhandler(void) {
 void mc68k::TAShandler(void) {
 	unsigned int	value;
 
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, 0x00);
+	value = this->getOperandValue(this->op->ea, 0x00);
 
 	this->cpu.sr.flag.z = ((value & 0x000000FF) == 0);
 	this->cpu.sr.flag.n = ((value & 0x00000080) == 0x80);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
 
-	this->rewindPC(this->cpu.instruction_reg & 0x3F);
-	this->setOperandValue(this->cpu.instruction_reg & 0x3F, 0x00, (value | 0x00000080));
+	this->rewindPC(this->op->ea);
+	this->setOperandValue(this->op->ea, 0x00, (value | 0x00000080));
+}
+
+void mc68k::TRAPhandler(void) {
+	this->pendingException = (TRAP0 + (this->cpu.instruction_reg & 0x000F));
+}
+
+void mc68k::TRAPVhandler(void) {
+	if (this->cpu.sr.flag.v)
+		this->pendingException = TRAPV_INSTRUCTION;
 }
 
 void mc68k::TSThandler(void) {
 	unsigned char	size;
 	unsigned int	value;
 
-	size = ((this->cpu.instruction_reg & 0x00C0) >> 6);
-	value = this->getOperandValue(this->cpu.instruction_reg & 0x3F, size);
+	size = this->op->size;
+	value = this->getOperandValue(this->op->ea, size);
 	this->cpu.sr.flag.c = false;
 	this->cpu.sr.flag.v = false;
 	switch (size) {
@@ -3460,10 +3624,10 @@ void mc68k::TSThandler(void) {
 
 void mc68k::UNLINKhandler(void) {
 	if (this->cpu.sr.flag.s)
-		this->cpu.ssp = this->cpu.a[this->cpu.instruction_reg & 0x0007];
+		this->cpu.ssp = this->cpu.a[this->op->ea & 0x07];
 	else
-		this->cpu.usp = this->cpu.a[this->cpu.instruction_reg & 0x0007];
-	this->cpu.a[this->cpu.instruction_reg & 0x0007] = this->readLong(this->cpu.usp);
+		this->cpu.usp = this->cpu.a[this->op->ea & 0x07];
+	this->cpu.a[this->op->ea & 0x07] = this->readLong(this->cpu.usp);
 	if (this->cpu.sr.flag.s)
 		this->cpu.ssp += 2;
 	else
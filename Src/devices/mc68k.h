@@ -134,6 +134,19 @@ typedef struct {
 	unsigned char	type;
 } MMU;
 
+/****** Decoder stuff ********************************************************/
+
+#define MC68K_MAX_HANDLERS		4		// Most handlers one opcode can run
+#define MC68K_MAX_HANDLER_LISTS	256		// Different handler lists, indexed by an unsigned char
+
+typedef struct {			// Pre-decoded opcode
+	unsigned char	handlers;			// Index into the handler lists
+	unsigned char	ea;					// Effective address, mode and register (bits 0-5)
+	unsigned char	size;				// Size (bits 6-7)
+	unsigned char	reg;				// Register (bits 9-11)
+	unsigned char	condition;			// Condition code for Bcc (bits 8-11)
+} OPCODE;
+
 
 
 /****** Class definition *********************************************************/
@@ -146,6 +159,8 @@ public:
 	int				Architecture;
 
 	bool			DEBUG;
+	bool			traceRegisters;		// Log the registers before every instruction
+	bool			linearDecode;		// Test every opcode against the chain of masks instead of using the decode table (for mc68kbench)
 
 	/****** Processors ***********************************************************/
 	CPU cpu;
@@ -160,11 +175,27 @@ public:
 	unsigned char	interruptLevel;		// Represents the state of the IPL[0..2] interrupt lines on the CPU
 	signed char		currentInterrupt;	// Represents the current interrupt being handled by the CPU (can this be replaced by FC0..FC2???)
 
+	/****** Statistics for the co-processor scheduler ****************************/
+	unsigned int	cyclesRun;			// Exec() steps taken, free running
+	unsigned int	instructionsRun;	// Instructions executed, free running
+
 	/****** Public functions *****************************************************/
 	void			Reset(void);
-	void			Exec(int Cycles);
+	void			Exec(int Cycles);	// Returns early when the tube changes state
 
 private:
+	typedef void	(mc68k::*HANDLER)(void);
+
+	/****** Decoder **************************************************************/
+	static OPCODE	decodeTable[0x10000];		// Built once, by the first constructor
+	static HANDLER	handlerLists[MC68K_MAX_HANDLER_LISTS][MC68K_MAX_HANDLERS + 1];	// NULL terminated
+	static int		handlerListCount;
+	const OPCODE	*op;						// Decoded form of the current instruction
+	OPCODE			linearOp;					// Decoded form when linearDecode is set
+	int				decodeOpcode(unsigned short opcode, HANDLER *list);
+	void			decodeFields(unsigned short opcode, OPCODE *decoded);
+	void			buildDecodeTable(void);
+
 	/****** Private functions ****************************************************/
 	unsigned char	readByte(unsigned int address);
 	unsigned short	readWord(unsigned int address);
@@ -188,11 +219,13 @@ private:
 	void			ANDhandler(void);
 	void			ANDIhandler(void);
 	void			ASxLSx_handler(void);
+	void			Bcchandler(void);
 	void			BCHGhandler(void);
 	void			BCLRhandler(void);
 	void			BSEThandler(void);
 	void			BTSThandler(void);
 	void			CHKhandler(void);
+	void			CLRhandler(void);
 	void			CMPhandler(void);
 	void			CMPAhandler(void);
 	void			CMPISUBIhandler(void);
@@ -203,11 +236,19 @@ private:
 	void			EORIhandler(void);
 	void			EXGhandler(void);
 	void			EXThandler(void);
+	void			ILLEGALhandler(void);
+	void			JMPhandler(void);
+	void			JSRhandler(void);
 	void			LEAhandler(void);
 	void			LINKhandler(void);
+	void			MOVEfromSRhandler(void);
 	void			MOVEhandler(void);
 	void			MOVEMhandler(void);
 	void			MOVEPhandler(void);
+	void			MOVEQhandler(void);
+	void			MOVEtoCCRhandler(void);
+	void			MOVEtoSRhandler(void);
+	void			MOVEUSPhandler(void);
 	void			MULShandler(void);
 	void			MULUhandler(void);
 	void			NBCDhandler(void);
@@ -215,13 +256,23 @@ private:
 	void			NOThandler(void);
 	void			ORhandler(void);
 	void			ORIhandler(void);
+	void			PEAhandler(void);
+	void			RESEThandler(void);
 	void			ROxROXx_handler(void);
+	void			RTEhandler(void);
+	void			RTRhandler(void);
+	void			RTShandler(void);
 	void			SBCDhandler(void);
+	void			SccDBcchandler(void);
+	void			STOPhandler(void);
+	void			SUBAhandler(void);
 	void			SUBhandler(void);
 	void			SUBQhandler(void);
 	void			SUBXhandler(void);
 	void			SWAPhandler(void);
 	void			TAShandler(void);
+	void			TRAPhandler(void);
+	void			TRAPVhandler(void);
 	void			TSThandler(void);
 	void			UNLINKhandler(void);
 
@@ -70,6 +70,10 @@ static unsigned char IRQCycles;
 
 unsigned char TubeintStatus=0; /* bit set (nums in IRQ_Nums) if interrupt being caused */
 unsigned char TubeNMIStatus=0; /* bit set (nums in NMI_Nums) if NMI being caused */
+
+/* Set whenever either side writes a register or takes data out of one, so a
+   co-processor running a long quantum knows to hand back to the host */
+bool TubeStateChanged=false;
 static unsigned int NMILock=0; /* Well I think NMI's are maskable - to stop repeated NMI's - the lock is released when an RTI is done */
 
 typedef int int16;
@@ -370,6 +374,9 @@ unsigned char ReadTubeFromHostSide(unsigned char IOAddr) {
 	if (! (EnableTube || AcornZ80 || ArmTube || mc68kTube_CiscOS) ) 
 		return(MachineType==3 ? 0xff : 0xfe); // return ff for master else return fe
 
+	if (IOAddr & 1)
+		TubeStateChanged=true;
+
 	switch (IOAddr) {
 	case 0:
 		TmpData=R1HStatus | R1Status;
@@ -440,6 +447,8 @@ void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData) {
 		   AcornZ80 || ArmTube || mc68kTube_CiscOS) ) 
 		return;
 
+	TubeStateChanged=true;
+
 	if (DebugEnabled) {
 		char info[200];
 		sprintf(info, "Tube: Write from host, addr %X value %02X", (int)IOAddr, (int)IOData);
@@ -509,6 +518,9 @@ unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr) {
 	if (TorchTube) 
 		return ReadTorchTubeFromHostSide(IOAddr);
 
+	if (IOAddr & 1)
+		TubeStateChanged=true;
+
 	switch (IOAddr) {
 	case 0:
 		TmpData=R1PStatus | R1Status;
@@ -580,6 +592,8 @@ void WriteTubeFromParasiteSide(unsigned char IOAddr,unsigned char IOData)
 		return;
 	}
 
+	TubeStateChanged=true;
+
 	if (DebugEnabled) {
 		char info[200];
 		sprintf(info, "Tube: Write from para, addr %X value %02X", (int)IOAddr, (int)IOData);
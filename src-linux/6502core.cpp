@@ -32,6 +32,7 @@
 #include <stdlib.h>
 
 #include "6502core.h"
+#include "6502ops.h"
 #include "beebmem.h"
 #include "beebsound.h"
 #include "disc8271.h"
@@ -57,6 +58,25 @@
 //--#define INLINE
 //--#endif
 
+/* The opcode handlers in Exec6502Slice are written with these macros so  */
+/* that the same code can be built as the usual switch statements, or     */
+/* with WITH_THREADED_6502 defined as labels dispatched to by a computed  */
+/* goto through a per-opcode-set handler table (needs GCC or clang).      */
+#ifdef WITH_THREADED_6502
+#	ifndef __GNUC__
+#		error WITH_THREADED_6502 needs a compiler with labels as values
+#	endif
+#	define OPCODE_SET_BEGIN(cond)
+#	define OPCODE_SET_END
+#	define OPCODE(n)	op_##n:
+#	define NEXT_OPCODE	goto OpcodeDone
+#else
+#	define OPCODE_SET_BEGIN(cond)	if (cond) { switch (CurrentInstruction) {
+#	define OPCODE_SET_END	default: BadCount++; } }
+#	define OPCODE(n)	case n:
+#	define NEXT_OPCODE	break
+#endif
+
 using namespace std;
 
 int CPUDebug=0;
@@ -71,6 +91,8 @@ static int CurrentInstruction;
 extern int DumpAfterEach;
 
 CycleCountT TotalCycles=0;
+/* Host instructions executed, for throughput figures (see headless.cpp) */
+unsigned long long TotalInstructions=0;
 
 int trace = 0;
 int ProgramCounter;
@@ -84,18 +106,6 @@ int SwitchOnCycles=2000000; // Reset delay
 unsigned char intStatus=0; /* bit set (nums in IRQ_Nums) if interrupt being caused */
 unsigned char NMIStatus=0; /* bit set (nums in NMI_Nums) if NMI being caused */
 unsigned int NMILock=0; /* Well I think NMI's are maskable - to stop repeated NMI's - the lock is released when an RTI is done */
-typedef int int16;
-INLINE static void SBCInstrHandler(int16 operand);
-enum PSRFlags {
-  FlagC=1,
-  FlagZ=2,
-  FlagI=4,
-  FlagD=8,
-  FlagB=16,
-  FlagV=64,
-  FlagN=128
-};
-
 /* Note how GETCFLAG is special since being bit 0 we don't need to test it to get a clean 0/1 */
 #define GETCFLAG ((PSR & FlagC))
 #define GETZFLAG ((PSR & FlagZ)>0)
@@ -188,40 +198,16 @@ bool IntDue=false;
    to it (usually -ve) */
 int CyclesToInt = NO_TIMER_INT_DUE;
 
-static unsigned char Branched;
-// Branched - 1 if the instruction branched
 int OpCodes=2; // 1 = documented only, 2 = commonoly used undocumenteds, 3 = full set
 int BHardware=0; // 0 = all hardware, 1 = basic hardware only
 // 1 if first cycle happened
 
-/* Get a two byte address from the program counter, and then post inc the program counter */
-#define GETTWOBYTEFROMPC(var) \
-  var=ReadPaged(ProgramCounter); \
-  var|=(ReadPaged(ProgramCounter+1)<<8); \
-  ProgramCounter+=2;
-
 #define WritePaged(addr,val) BeebWriteMem(addr,val)
 #define ReadPaged(Address) BeebReadMem(Address)
 
 void PollVIAs(unsigned int nCycles);
 void PollHardware(unsigned int Cycles);
 
-/*----------------------------------------------------------------------------*/
-INLINE void Carried() {
-	// Correct cycle count for indirection across page boundary
-	if (((CurrentInstruction & 0xf)==0x1 ||
-		 (CurrentInstruction & 0xf)==0x9 ||
-		 (CurrentInstruction & 0xf)==0xd) &&
-		(CurrentInstruction & 0xf0)!=0x90)
-	{
-		Cycles++;
-	}
-	else if (CurrentInstruction==0xBC ||
-			 CurrentInstruction==0xBE)
-	{
-		Cycles++;
-	}
-}
 /*----------------------------------------------------------------------------*/
 void DoIntCheck(void)
 {
@@ -292,35 +278,6 @@ void AdvanceCyclesForMemWrite(void)
 
 	DoIntCheck();
 }
-INLINE int SignExtendByte(signed char in) {
-  /*if (in & 0x80) return(in | 0xffffff00); else return(in); */
-  /* I think this should sign extend by virtue of the casts - gcc does anyway - the code
-  above will definitly do the trick */
-  return((int)in);
-} /* SignExtendByte */
-
-/*----------------------------------------------------------------------------*/
-/* Set the Z flag if 'in' is 0, and N if bit 7 is set - leave all other bits  */
-/* untouched.                                                                 */
-INLINE static void SetPSRZN(const unsigned char in) {
-  PSR&=~(FlagZ | FlagN);
-  PSR|=((in==0)<<1) | (in & 128);
-}; /* SetPSRZN */
-
-/*----------------------------------------------------------------------------*/
-/* Note: n is 128 for true - not 1                                            */
-INLINE static void SetPSR(int mask,int c,int z,int i,int d,int b, int v, int n) {
-  PSR&=~mask;
-  PSR|=c | (z<<1) | (i<<2) | (d<<3) | (b<<4) | (v<<6) | n;
-} /* SetPSR */
-
-/*----------------------------------------------------------------------------*/
-/* NOTE!!!!! n is 128 or 0 - not 1 or 0                                       */
-INLINE static void SetPSRCZN(int c,int z, int n) {
-  PSR&=~(FlagC | FlagZ | FlagN);
-  PSR|=c | (z<<1) | n;
-} /* SetPSRCZN */
-
 /*----------------------------------------------------------------------------*/
 void DumpRegs(void) {
   static char FlagNames[]="CZIDB-VNczidb-vn";
@@ -334,179 +291,40 @@ void DumpRegs(void) {
 } /* DumpRegs */
 
 /*----------------------------------------------------------------------------*/
-INLINE static void Push(unsigned char ToPush) {
-  BEEBWRITEMEM_DIRECT(0x100+StackReg,ToPush);
-  StackReg--;
-} /* Push */
-
-/*----------------------------------------------------------------------------*/
-INLINE static unsigned char Pop(void) {
-  StackReg++;
-  return(WholeRam[0x100+StackReg]);
-} /* Pop */
-
-/*----------------------------------------------------------------------------*/
-INLINE static void PushWord(int16 topush) {
-  Push((topush>>8) & 255);
-  Push(topush & 255);
-} /* PushWord */
-
-/*----------------------------------------------------------------------------*/
-INLINE static int16 PopWord() {
-  int16 RetValue;
-
-  RetValue=Pop();
-  RetValue|=(Pop()<<8);
-  return(RetValue);
-} /* PopWord */
-
-/*-------------------------------------------------------------------------*/
-/* Relative addressing mode handler                                        */
-INLINE static int16 RelAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-
-  /* For branches - is this correct - i.e. is the program counter incremented
-     at the correct time? */
-  EffectiveAddress=SignExtendByte((signed char)ReadPaged(ProgramCounter++));
-  EffectiveAddress+=ProgramCounter;
-
-  return(EffectiveAddress);
-} /* RelAddrModeHandler */
+/* The host processor's side of the shared instruction handlers (6502ops.h). */
+/* Cycles are counted at the same points as the hardware sees them, and the  */
+/* VIAs are brought up to date at each memory access within the instruction. */
+struct HostBus {
+  static INLINE int &ProgramCounter(void) { return(::ProgramCounter); }
+  static INLINE int &Accumulator(void) { return(::Accumulator); }
+  static INLINE int &XReg(void) { return(::XReg); }
+  static INLINE int &YReg(void) { return(::YReg); }
+  static INLINE unsigned char &StackReg(void) { return(::StackReg); }
+  static INLINE unsigned char &PSR(void) { return(::PSR); }
+  static INLINE unsigned char Fetch(int Address) { return(ReadPaged(Address)); }
+  static INLINE unsigned char Read(int Address) { return(ReadPaged(Address)); }
+  static INLINE void Write(int Address,unsigned char Value) { WritePaged(Address,Value); }
+  static INLINE unsigned char &Ram(int Address) { return(WholeRam[Address]); }
+};
 
-/*----------------------------------------------------------------------------*/
-INLINE static void ADCInstrHandler(int16 operand) {
-  /* NOTE! Not sure about C and V flags */
-  int TmpResultV,TmpResultC;
-  if (!GETDFLAG) {
-    TmpResultC=Accumulator+operand+GETCFLAG;
-    TmpResultV=(signed char)Accumulator+(signed char)operand+GETCFLAG;
-    Accumulator=TmpResultC & 255;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN, (TmpResultC & 256)>0,Accumulator==0,0,0,0,((Accumulator & 128)>0) ^ (TmpResultV<0),(Accumulator & 128));
-  } else {
-    int ZFlag=0,NFlag=0,CFlag=0,VFlag=0;
-    int TmpResult,TmpCarry=0;
-    int ln,hn;
-
-    /* Z flag determined from 2's compl result, not BCD result! */
-    TmpResult=Accumulator+operand+GETCFLAG;
-    ZFlag=((TmpResult & 0xff)==0);
-
-    ln=(Accumulator & 0xf)+(operand & 0xf)+GETCFLAG;
-    if (ln>9) {
-      ln += 6;
-      ln &= 0xf;
-      TmpCarry=0x10;
-    }
-    hn=(Accumulator & 0xf0)+(operand & 0xf0)+TmpCarry;
-    /* N and V flags are determined before high nibble is adjusted.
-       NOTE: V is not always correct */
-    NFlag=hn & 128;
-    VFlag=(hn ^ Accumulator) & 128 && !((Accumulator ^ operand) & 128);
-    if (hn>0x90) {
-      hn += 0x60;
-      hn &= 0xf0;
-      CFlag=1;
-    }
-    Accumulator=hn|ln;
-	ZFlag=(Accumulator==0);
-	NFlag=(Accumulator&128);
-    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
+struct HostClock {
+  static INLINE int Opcode(void) { return(CurrentInstruction); }
+  static INLINE void AddCycles(int n) { Cycles+=n; }
+
+  /* The 6502 writes the unmodified value back a cycle after reading it, */
+  /* then the result at the normal write point of the instruction        */
+  static INLINE void ModifyCycles(int Address,unsigned char OldValue) {
+    Cycles+=1;
+    PollVIAs(1);
+    WritePaged(Address,OldValue);
+    Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
+    PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
   }
-} /* ADCInstrHandler */
+};
 
-/*----------------------------------------------------------------------------*/
-INLINE static void ANDInstrHandler(int16 operand) {
-  Accumulator=Accumulator & operand;
-  PSR&=~(FlagZ | FlagN);
-  PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-} /* ANDInstrHandler */
-
-INLINE static void ASLInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-  oldVal=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,oldVal);
-  newVal=(((unsigned int)oldVal)<<1) & 254;
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,newVal);
-  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
-} /* ASLInstrHandler */
-
-INLINE static void TRBInstrHandler(int16 address) {
-	unsigned char oldVal,newVal;
-	oldVal=ReadPaged(address);
-	newVal=(Accumulator ^ 255) & oldVal;
-    WritePaged(address,newVal);
-    PSR&=253;
-	PSR|=((Accumulator & oldVal)==0) ? 2 : 0;
-} // TRBInstrHandler
-
-INLINE static void TSBInstrHandler(int16 address) {
-	unsigned char oldVal,newVal;
-	oldVal=ReadPaged(address);
-	newVal=Accumulator | oldVal;
-    WritePaged(address,newVal);
-    PSR&=253;
-	PSR|=((Accumulator & oldVal)==0) ? 2 : 0;
-} // TSBInstrHandler
-
-INLINE static void ASLInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-  /* Accumulator */
-  oldVal=Accumulator;
-  Accumulator=newVal=(((unsigned int)Accumulator)<<1) & 254;
-  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
-} /* ASLInstrHandler_Acc */
-
-INLINE static void BCCInstrHandler(void) {
-  if (!GETCFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BCCInstrHandler */
-
-INLINE static void BCSInstrHandler(void) {
-  if (GETCFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BCSInstrHandler */
-
-INLINE static void BEQInstrHandler(void) {
-  if (GETZFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BEQInstrHandler */
-
-INLINE static void BITInstrHandler(int16 operand) {
-  PSR&=~(FlagZ | FlagN | FlagV);
-  /* z if result 0, and NV to top bits of operand */
-  PSR|=(((Accumulator & operand)==0)<<1) | (operand & 192);
-} /* BITInstrHandler */
-
-INLINE static void BMIInstrHandler(void) {
-  if (GETNFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BMIInstrHandler */
-
-INLINE static void BNEInstrHandler(void) {
-  if (!GETZFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BNEInstrHandler */
-
-INLINE static void BPLInstrHandler(void) {
-  if (!GETNFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-}; /* BPLInstrHandler */
+/* Exec6502Slice is built for each variant, the code outside it that does */
+/* not depend on the variant uses the NMOS build.                         */
+typedef M6502<HostBus,CPU_NMOS6502,HostClock> HostCPU;
 
 INLINE static void BRKInstrHandler(void) {
   char errstr[250];
@@ -516,275 +334,13 @@ INLINE static void BRKInstrHandler(void) {
   //fclose(InstrLog);
   exit(1); 
   }
-  PushWord(ProgramCounter+1);
-  SetPSR(FlagB,0,0,0,0,1,0,0); /* Set B before pushing */
-  Push(PSR);
-  SetPSR(FlagI,0,0,1,0,0,0,0); /* Set I after pushing - see Birnbaum */
+  HostCPU::PushWord(ProgramCounter+1);
+  HostCPU::SetPSR(FlagB,0,0,0,0,1,0,0); /* Set B before pushing */
+  HostCPU::Push(PSR);
+  HostCPU::SetPSR(FlagI,0,0,1,0,0,0,0); /* Set I after pushing - see Birnbaum */
   ProgramCounter=BeebReadMem(0xfffe) | (BeebReadMem(0xffff)<<8);
 } /* BRKInstrHandler */
 
-INLINE static void BVCInstrHandler(void) {
-  if (!GETVFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BVCInstrHandler */
-
-INLINE static void BVSInstrHandler(void) {
-  if (GETVFLAG) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else ProgramCounter++;
-} /* BVSInstrHandler */
-
-INLINE static void BRAInstrHandler(void) {
-    ProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-} /* BRAnstrHandler */
-
-INLINE static void CMPInstrHandler(int16 operand) {
-  /* NOTE! Should we consult D flag ? */
-  unsigned char result=Accumulator-operand;
-  unsigned char CFlag;
-  CFlag=0; if (Accumulator>=operand) CFlag=FlagC;
-  SetPSRCZN(CFlag,Accumulator==operand,result & 128);
-} /* CMPInstrHandler */
-
-INLINE static void CPXInstrHandler(int16 operand) {
-  unsigned char result=(XReg-operand);
-  SetPSRCZN(XReg>=operand,XReg==operand,result & 128);
-} /* CPXInstrHandler */
-
-INLINE static void CPYInstrHandler(int16 operand) {
-  unsigned char result=(YReg-operand);
-  SetPSRCZN(YReg>=operand,YReg==operand,result & 128);
-} /* CPYInstrHandler */
-
-INLINE static void DECInstrHandler(int16 address) {
-  unsigned char val;
-
-  val=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,val);
-  val=(val-1);
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,val);
-  SetPSRZN(val);
-} /* DECInstrHandler */
-
-INLINE static void DEXInstrHandler(void) {
-  XReg=(XReg-1) & 255;
-  SetPSRZN(XReg);
-} /* DEXInstrHandler */
-
-INLINE static void DEAInstrHandler(void) {
-  Accumulator=(Accumulator-1) & 255;
-  SetPSRZN(Accumulator);
-} /* DEAInstrHandler */
-
-INLINE static void EORInstrHandler(int16 operand) {
-  Accumulator^=operand;
-  SetPSRZN(Accumulator);
-} /* EORInstrHandler */
-
-INLINE static void INCInstrHandler(int16 address) {
-  unsigned char val;
-
-  val=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,val);
-  val=(val+1) & 255;
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,val);
-  SetPSRZN(val);
-} /* INCInstrHandler */
-
-INLINE static void INXInstrHandler(void) {
-  XReg+=1;
-  XReg&=255;
-  SetPSRZN(XReg);
-} /* INXInstrHandler */
-
-INLINE static void INAInstrHandler(void) {
-  Accumulator+=1;
-  Accumulator&=255;
-  SetPSRZN(Accumulator);
-} /* INAInstrHandler */
-
-INLINE static void JSRInstrHandler(int16 address) {
-  PushWord(ProgramCounter-1);
-  ProgramCounter=address;
-/*  if (ProgramCounter==0xffdd) {
-	  // OSCLI logging for elite debugging
-	  unsigned char *bptr;
-	  char pcbuf[256]; char *pcptr=pcbuf;
-	  int blk=((YReg*256)+XReg);
-	  bptr=WholeRam+((WholeRam[blk+1]*256)+WholeRam[blk]);
-  	  while((*bptr != 13) && ((pcptr-pcbuf)<254)) {
-		  *pcptr=*bptr; pcptr++;bptr++; 
-	  } 
-	  *pcptr=0;
-	  fprintf(osclilog,"%s\n",pcbuf);
-  }
-  / * if (ProgramCounter==0xffdd) {
-	  char errstr[250];
-	  sprintf(errstr,"OSFILE called\n");
-	  MessageBox(GETHWND,errstr,"BBC Emulator",MB_OKCANCEL|MB_ICONERROR);
-  }*/
-
-} /* JSRInstrHandler */
-
-INLINE static void LDAInstrHandler(int16 operand) {
-  Accumulator=operand;
-  SetPSRZN(Accumulator);
-} /* LDAInstrHandler */
-
-INLINE static void LDXInstrHandler(int16 operand) {
-  XReg=operand;
-  SetPSRZN(XReg);
-} /* LDXInstrHandler */
-
-INLINE static void LDYInstrHandler(int16 operand) {
-  YReg=operand;
-  SetPSRZN(YReg);
-} /* LDYInstrHandler */
-
-INLINE static void LSRInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-  oldVal=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,oldVal);
-  newVal=(((unsigned int)oldVal)>>1) & 127;
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,newVal);
-  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
-} /* LSRInstrHandler */
-
-INLINE static void LSRInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-  /* Accumulator */
-  oldVal=Accumulator;
-  Accumulator=newVal=(((unsigned int)Accumulator)>>1) & 127;
-  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
-} /* LSRInstrHandler_Acc */
-
-INLINE static void ORAInstrHandler(int16 operand) {
-  Accumulator=Accumulator | operand;
-  SetPSRZN(Accumulator);
-} /* ORAInstrHandler */
-
-INLINE static void ROLInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-
-  oldVal=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,oldVal);
-  newVal=((unsigned int)oldVal<<1) & 254;
-  newVal+=GETCFLAG;
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,newVal);
-  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
-} /* ROLInstrHandler */
-
-INLINE static void ROLInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-
-  oldVal=Accumulator;
-  newVal=((unsigned int)oldVal<<1) & 254;
-  newVal+=GETCFLAG;
-  Accumulator=newVal;
-  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
-} /* ROLInstrHandler_Acc */
-
-INLINE static void RORInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-
-  oldVal=ReadPaged(address);
-  Cycles+=1;
-  PollVIAs(1);
-  WritePaged(address,oldVal);
-  newVal=((unsigned int)oldVal>>1) & 127;
-  newVal+=GETCFLAG*128;
-  Cycles+=CyclesToMemWrite[CurrentInstruction] - 1;
-  PollVIAs(CyclesToMemWrite[CurrentInstruction] - 1);
-  WritePaged(address,newVal);
-  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
-} /* RORInstrHandler */
-
-INLINE static void RORInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-
-  oldVal=Accumulator;
-  newVal=((unsigned int)oldVal>>1) & 127;
-  newVal+=GETCFLAG*128;
-  Accumulator=newVal;
-  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
-} /* RORInstrHandler_Acc */
-
-INLINE static void SBCInstrHandler(int16 operand) {
-  /* NOTE! Not sure about C and V flags */
-  int TmpResultV,TmpResultC;
-  unsigned char nhn,nln;
-  if (!GETDFLAG) {
-    TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GETCFLAG);
-    TmpResultC=Accumulator-operand-(1-GETCFLAG);
-    Accumulator=TmpResultC & 255;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN, TmpResultC>=0,Accumulator==0,0,0,0,
-      ((Accumulator & 128)>0) ^ ((TmpResultV & 256)!=0),(Accumulator & 128));
-  } else {
-    int ZFlag=0,NFlag=0,CFlag=1,VFlag=0;
-    int TmpResult,TmpCarry=0;
-    int ln,hn,oln,ohn;
-	nhn=(Accumulator>>4)&15; nln=Accumulator & 15;
-
-    /* Z flag determined from 2's compl result, not BCD result! */
-    TmpResult=Accumulator-operand-(1-GETCFLAG);
-    ZFlag=((TmpResult & 0xff)==0);
-
-	ohn=operand & 0xf0; oln = operand & 0xf;
-	if ((oln>9) && ((Accumulator&15)<10)) { oln-=10; ohn+=0x10; } 
-	// promote the lower nibble to the next ten, and increase the higher nibble
-    ln=(Accumulator & 0xf)-oln-(1-GETCFLAG);
-    if (ln<0) {
-	  if ((Accumulator & 15)<10) ln-=6;
-      ln&=0xf;
-      TmpCarry=0x10;
-    }
-    hn=(Accumulator & 0xf0)-ohn-TmpCarry;
-    /* N and V flags are determined before high nibble is adjusted.
-       NOTE: V is not always correct */
-    NFlag=hn & 128;
-	TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GETCFLAG);
-	if ((TmpResultV<-128)||(TmpResultV>127)) VFlag=1; else VFlag=0;
-    if (hn<0) {
-      hn-=0x60;
-      hn&=0xf0;
-      CFlag=0;
-    }
-    Accumulator=hn|ln;
-	if (Accumulator==0) ZFlag=1;
-	NFlag=(hn &128);
-	CFlag=(TmpResult&256)==0;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
-  }
-} /* SBCInstrHandler */
-
-INLINE static void STXInstrHandler(int16 address) {
-  WritePaged(address,XReg);
-} /* STXInstrHandler */
-
-INLINE static void STYInstrHandler(int16 address) {
-  WritePaged(address,YReg);
-} /* STYInstrHandler */
-
 INLINE static void BadInstrHandler(int opcode) {
 	if (!IgnoreIllegalInstructions)
 	{
@@ -834,230 +390,6 @@ INLINE static void BadInstrHandler(int opcode) {
 	}
 } /* BadInstrHandler */
 
-/*-------------------------------------------------------------------------*/
-/* Absolute  addressing mode handler                                       */
-INLINE static int16 AbsAddrModeHandler_Data(void) {
-  int FullAddress;
-
-  /* Get the address from after the instruction */
-  
-  GETTWOBYTEFROMPC(FullAddress)
-
-  /* And then read it */
-  return(ReadPaged(FullAddress));
-} /* AbsAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute  addressing mode handler                                       */
-INLINE static int16 AbsAddrModeHandler_Address(void) {
-  int FullAddress;
-
-  /* Get the address from after the instruction */
-  GETTWOBYTEFROMPC(FullAddress)
-
-  /* And then read it */
-  return(FullAddress);
-} /* AbsAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page addressing mode handler                                       */
-INLINE static int16 ZeroPgAddrModeHandler_Address(void) {
-  return(ReadPaged(ProgramCounter++));
-} /* ZeroPgAddrModeHandler_Address */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with X preinc addressing mode handler                           */
-INLINE static int16 IndXAddrModeHandler_Data(void) {
-  unsigned char ZeroPageAddress;
-  int EffectiveAddress;
-
-  ZeroPageAddress=(ReadPaged(ProgramCounter++)+XReg) & 255;
-
-  EffectiveAddress=WholeRam[ZeroPageAddress] | (WholeRam[ZeroPageAddress+1]<<8);
-  return(ReadPaged(EffectiveAddress));
-} /* IndXAddrModeHandler_Data */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with X preinc addressing mode handler                           */
-INLINE static int16 IndXAddrModeHandler_Address(void) {
-  unsigned char ZeroPageAddress;
-  int EffectiveAddress;
-
-  ZeroPageAddress=(ReadPaged(ProgramCounter++)+XReg) & 255;
-
-  EffectiveAddress=WholeRam[ZeroPageAddress] | (WholeRam[ZeroPageAddress+1]<<8);
-  return(EffectiveAddress);
-} /* IndXAddrModeHandler_Address */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with Y postinc addressing mode handler                          */
-INLINE static int16 IndYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  unsigned char ZPAddr=ReadPaged(ProgramCounter++);
-  EffectiveAddress=WholeRam[ZPAddr]+YReg;
-  if (EffectiveAddress>0xff) Carried();
-  EffectiveAddress+=(WholeRam[ZPAddr+1]<<8);
-
-  return(ReadPaged(EffectiveAddress));
-} /* IndYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with Y postinc addressing mode handler                          */
-INLINE static int16 IndYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  unsigned char ZPAddr=ReadPaged(ProgramCounter++);
-  EffectiveAddress=WholeRam[ZPAddr]+YReg;
-  if (EffectiveAddress>0xff) Carried();
-  EffectiveAddress+=(WholeRam[ZPAddr+1]<<8);
-
-  return(EffectiveAddress);
-} /* IndYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page wih X offset addressing mode handler                          */
-INLINE static int16 ZeroPgXAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(ReadPaged(ProgramCounter++)+XReg) & 255;
-  return(WholeRam[EffectiveAddress]);
-} /* ZeroPgXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page wih X offset addressing mode handler                          */
-INLINE static int16 ZeroPgXAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(ReadPaged(ProgramCounter++)+XReg) & 255;
-  return(EffectiveAddress);
-} /* ZeroPgXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with X offset addressing mode handler                          */
-INLINE static int16 AbsXAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress);
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+XReg) & 0xff00)) Carried();
-  EffectiveAddress+=XReg;
-  EffectiveAddress&=0xffff;
-
-  return(ReadPaged(EffectiveAddress));
-} /* AbsXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with X offset addressing mode handler                          */
-INLINE static int16 AbsXAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress)
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+XReg) & 0xff00)) Carried();
-  EffectiveAddress+=XReg;
-  EffectiveAddress&=0xffff;
-
-  return(EffectiveAddress);
-} /* AbsXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with Y offset addressing mode handler                          */
-INLINE static int16 AbsYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress);
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+YReg) & 0xff00)) Carried();
-  EffectiveAddress+=YReg;
-  EffectiveAddress&=0xffff;
-
-  return(ReadPaged(EffectiveAddress));
-} /* AbsYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with Y offset addressing mode handler                          */
-INLINE static int16 AbsYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress)
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+YReg) & 0xff00)) Carried();
-  EffectiveAddress+=YReg;
-  EffectiveAddress&=0xffff;
-
-  return(EffectiveAddress);
-} /* AbsYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Indirect addressing mode handler                                        */
-INLINE static int16 IndAddrModeHandler_Address(void) {
-  /* For jump indirect only */
-  int VectorLocation;
-  int EffectiveAddress;
-
-  GETTWOBYTEFROMPC(VectorLocation)
-
-  /* Ok kiddies, deliberate bug time.
-  According to my BBC Master Reference Manual Part 2
-  the 6502 has a bug concerning this addressing mode and VectorLocation==xxFF
-  so, we're going to emulate that bug -- Richard Gellman */
-  if ((VectorLocation & 0xff)!=0xff || MachineType==3) {
-   EffectiveAddress=ReadPaged(VectorLocation);
-   EffectiveAddress|=ReadPaged(VectorLocation+1) << 8; }
-  else {
-   EffectiveAddress=ReadPaged(VectorLocation);
-   EffectiveAddress|=ReadPaged(VectorLocation-255) << 8;
-  }
-  return(EffectiveAddress);
-} /* IndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page Indirect addressing mode handler                                        */
-INLINE static int16 ZPIndAddrModeHandler_Address(void) {
-  int VectorLocation;
-  int EffectiveAddress;
-
-  VectorLocation=ReadPaged(ProgramCounter++);
-  EffectiveAddress=ReadPaged(VectorLocation)+(ReadPaged(VectorLocation+1)<<8);
-
-   // EffectiveAddress|=ReadPaged(VectorLocation+1) << 8; }
-  return(EffectiveAddress);
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page Indirect addressing mode handler                                        */
-INLINE static int16 ZPIndAddrModeHandler_Data(void) {
-  int VectorLocation;
-  int EffectiveAddress;
-
-  VectorLocation=ReadPaged(ProgramCounter++);
-  EffectiveAddress=ReadPaged(VectorLocation)+(ReadPaged(VectorLocation+1)<<8);
-
-   // EffectiveAddress|=ReadPaged(VectorLocation+1) << 8; }
-  return(ReadPaged(EffectiveAddress));
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Pre-indexed absolute Indirect addressing mode handler                                        */
-INLINE static int16 IndAddrXModeHandler_Address(void) {
-  /* For jump indirect only */
-  int VectorLocation;
-  int EffectiveAddress;
-
-  GETTWOBYTEFROMPC(VectorLocation)
-
-  EffectiveAddress=ReadPaged(VectorLocation+XReg);
-  EffectiveAddress|=ReadPaged(VectorLocation+1+XReg) << 8; 
-  EffectiveAddress&=0xffff;
-   // EffectiveAddress|=ReadPaged(VectorLocation+1) << 8; }
-  return(EffectiveAddress);
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page with Y offset addressing mode handler                         */
-INLINE static int16 ZeroPgYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(ReadPaged(ProgramCounter++)+YReg) & 255;
-  return(WholeRam[EffectiveAddress]);
-} /* ZeroPgYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page with Y offset addressing mode handler                         */
-INLINE static int16 ZeroPgYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(ReadPaged(ProgramCounter++)+YReg) & 255;
-  return(EffectiveAddress);
-} /* ZeroPgYAddrModeHandler */
-
 /*-------------------------------------------------------------------------*/
 /* Initialise 6502core                                                     */
 void Init6502core(void) {
@@ -1075,10 +407,10 @@ void Init6502core(void) {
 
 /*-------------------------------------------------------------------------*/
 void DoInterrupt(void) {
-  PushWord(ProgramCounter);
-  Push(PSR & ~FlagB);
+  HostCPU::PushWord(ProgramCounter);
+  HostCPU::Push(PSR & ~FlagB);
   ProgramCounter=BeebReadMem(0xfffe) | (BeebReadMem(0xffff)<<8);
-  SetPSR(FlagI,0,0,1,0,0,0,0);
+  HostCPU::SetPSR(FlagI,0,0,1,0,0,0,0);
   IRQCycles=7;
 } /* DoInterrupt */
 
@@ -1086,10 +418,10 @@ void DoInterrupt(void) {
 void DoNMI(void) {
   /*cerr << "Doing NMI\n"; */
   NMILock=1;
-  PushWord(ProgramCounter);
-  Push(PSR);
+  HostCPU::PushWord(ProgramCounter);
+  HostCPU::Push(PSR);
   ProgramCounter=BeebReadMem(0xfffa) | (BeebReadMem(0xfffb)<<8);
-  SetPSR(FlagI,0,0,1,0,0,0,0); /* Normal interrupts should be disabled during NMI ? */
+  HostCPU::SetPSR(FlagI,0,0,1,0,0,0,0); /* Normal interrupts should be disabled during NMI ? */
   IRQCycles=7;
 } /* DoNMI */
 
@@ -1153,17 +485,156 @@ void MemoryDump6502(int addr, int count)
 }
 
 /*-------------------------------------------------------------------------*/
-/* Execute one 6502 instruction, move program counter on                   */
-void Exec6502Instruction(void) {
-	static int OldNMIStatus;
+/* Execute 6502 instructions until nInstructions have been executed or, if */
+/* nCycles is non-zero, until at least nCycles 2MHz cycles have passed.    */
+/* Returns the number of cycles actually executed.                         */
+/* Built once for each of the host's variants and each OpCodes setting    */
+/* (OpSet), see Exec6502Machine, so the opcode set checks are constant.   */
+static int OldNMIStatus;
+
+template <int Variant, int OpSet> static int Exec6502Slice(int nInstructions, int nCycles) {
+	typedef M6502<HostBus,Variant,HostClock> CPU;
+#ifndef WITH_THREADED_6502
 	int BadCount=0;
-	int OldPC;
-	int loop,loopc;
+#endif
+	int loop;
+	int SliceCycles=0;
 	bool iFlagJustCleared;
 	bool iFlagJustSet;
 
-	loopc=(DebugEnabled ? 1 : 1024); // Makes debug window more responsive
-	for(loop=0;loop<loopc;loop++) {
+	// Devices may have been changed since the last slice
+	RescheduleHardware();
+	SyncVIAs();
+	if (EnableTube)
+		StartTubeSlice();
+#ifdef WITH_THREADED_6502
+	/* Documented opcodes */
+	static void * const DocumentedOps[256] = {
+		&&op_0x00, &&op_0x01, 0, 0, &&op_0x04, &&op_0x05, &&op_0x06, 0,
+		&&op_0x08, &&op_0x09, &&op_0x0a, 0, &&op_0x0c, &&op_0x0d, &&op_0x0e, 0,
+		&&op_0x10, &&op_0x11, &&op_0x12, 0, &&op_0x14, &&op_0x15, &&op_0x16, 0,
+		&&op_0x18, &&op_0x19, &&op_0x1a, 0, &&op_0x1c, &&op_0x1d, &&op_0x1e, 0,
+		&&op_0x20, &&op_0x21, 0, 0, &&op_0x24, &&op_0x25, &&op_0x26, 0,
+		&&op_0x28, &&op_0x29, &&op_0x2a, 0, &&op_0x2c, &&op_0x2d, &&op_0x2e, 0,
+		&&op_0x30, &&op_0x31, &&op_0x32, 0, &&op_0x34, &&op_0x35, &&op_0x36, 0,
+		&&op_0x38, &&op_0x39, &&op_0x3a, 0, &&op_0x3c, &&op_0x3d, &&op_0x3e, 0,
+		&&op_0x40, &&op_0x41, 0, 0, 0, &&op_0x45, &&op_0x46, 0,
+		&&op_0x48, &&op_0x49, &&op_0x4a, 0, &&op_0x4c, &&op_0x4d, &&op_0x4e, 0,
+		&&op_0x50, &&op_0x51, &&op_0x52, 0, 0, &&op_0x55, &&op_0x56, 0,
+		&&op_0x58, &&op_0x59, &&op_0x5a, 0, 0, &&op_0x5d, &&op_0x5e, 0,
+		&&op_0x60, &&op_0x61, 0, 0, &&op_0x64, &&op_0x65, &&op_0x66, 0,
+		&&op_0x68, &&op_0x69, &&op_0x6a, 0, &&op_0x6c, &&op_0x6d, &&op_0x6e, 0,
+		&&op_0x70, &&op_0x71, &&op_0x72, 0, &&op_0x74, &&op_0x75, &&op_0x76, 0,
+		&&op_0x78, &&op_0x79, &&op_0x7a, 0, &&op_0x7c, &&op_0x7d, &&op_0x7e, 0,
+		&&op_0x80, &&op_0x81, 0, 0, &&op_0x84, &&op_0x85, &&op_0x86, 0,
+		&&op_0x88, &&op_0x89, &&op_0x8a, 0, &&op_0x8c, &&op_0x8d, &&op_0x8e, 0,
+		&&op_0x90, &&op_0x91, &&op_0x92, 0, &&op_0x94, &&op_0x95, &&op_0x96, 0,
+		&&op_0x98, &&op_0x99, &&op_0x9a, 0, &&op_0x9c, &&op_0x9d, &&op_0x9e, 0,
+		&&op_0xa0, &&op_0xa1, &&op_0xa2, 0, &&op_0xa4, &&op_0xa5, &&op_0xa6, 0,
+		&&op_0xa8, &&op_0xa9, &&op_0xaa, 0, &&op_0xac, &&op_0xad, &&op_0xae, 0,
+		&&op_0xb0, &&op_0xb1, &&op_0xb2, 0, &&op_0xb4, &&op_0xb5, &&op_0xb6, 0,
+		&&op_0xb8, &&op_0xb9, &&op_0xba, 0, &&op_0xbc, &&op_0xbd, &&op_0xbe, 0,
+		&&op_0xc0, &&op_0xc1, 0, 0, &&op_0xc4, &&op_0xc5, &&op_0xc6, 0,
+		&&op_0xc8, &&op_0xc9, &&op_0xca, 0, &&op_0xcc, &&op_0xcd, &&op_0xce, 0,
+		&&op_0xd0, &&op_0xd1, &&op_0xd2, 0, 0, &&op_0xd5, &&op_0xd6, 0,
+		&&op_0xd8, &&op_0xd9, &&op_0xda, 0, 0, &&op_0xdd, &&op_0xde, 0,
+		&&op_0xe0, &&op_0xe1, 0, 0, &&op_0xe4, &&op_0xe5, &&op_0xe6, 0,
+		&&op_0xe8, &&op_0xe9, &&op_0xea, 0, &&op_0xec, &&op_0xed, &&op_0xee, 0,
+		&&op_0xf0, &&op_0xf1, &&op_0xf2, 0, 0, &&op_0xf5, &&op_0xf6, 0,
+		&&op_0xf8, &&op_0xf9, &&op_0xfa, 0, 0, &&op_0xfd, &&op_0xfe, 0
+	};
+	/* Undocumented opcodes, full set */
+	static void * const FullUndocumentedOps[256] = {
+		0, 0, 0, &&op_0x03, 0, 0, 0, &&op_0x07,
+		0, 0, 0, 0, 0, 0, 0, &&op_0x0f,
+		0, 0, 0, &&op_0x13, 0, 0, 0, &&op_0x17,
+		0, 0, 0, &&op_0x1b, 0, 0, 0, &&op_0x1f,
+		0, 0, 0, &&op_0x23, 0, 0, 0, &&op_0x27,
+		0, 0, 0, 0, 0, 0, 0, &&op_0x2f,
+		0, 0, 0, &&op_0x33, 0, 0, 0, &&op_0x37,
+		0, 0, 0, &&op_0x3b, 0, 0, 0, &&op_0x3f,
+		0, 0, 0, &&op_0x43, &&op_0x44, 0, 0, &&op_0x47,
+		0, 0, 0, 0, 0, 0, 0, &&op_0x4f,
+		0, 0, 0, &&op_0x53, &&op_0x54, 0, 0, &&op_0x57,
+		0, 0, 0, &&op_0x5b, &&op_0x5c, 0, 0, &&op_0x5f,
+		0, 0, 0, &&op_0x63, 0, 0, 0, &&op_0x67,
+		0, 0, 0, &&op_0x6b, 0, 0, 0, &&op_0x6f,
+		0, 0, 0, &&op_0x73, 0, 0, 0, &&op_0x77,
+		0, 0, 0, &&op_0x7b, 0, 0, 0, &&op_0x7f,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0x8b, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0xc3, 0, 0, 0, &&op_0xc7,
+		0, 0, 0, &&op_0xcb, 0, 0, 0, &&op_0xcf,
+		0, 0, 0, &&op_0xd3, &&op_0xd4, 0, 0, &&op_0xd7,
+		0, 0, 0, &&op_0xdb, &&op_0xdc, 0, 0, &&op_0xdf,
+		0, 0, 0, &&op_0xe3, 0, 0, 0, &&op_0xe7,
+		0, 0, 0, 0, 0, 0, 0, &&op_0xef,
+		0, 0, 0, &&op_0xf3, &&op_0xf4, 0, 0, &&op_0xf7,
+		0, 0, 0, &&op_0xfb, &&op_0xfc, 0, 0, &&op_0xff
+	};
+	/* Commonly used undocumented opcodes */
+	static void * const CommonUndocumentedOps[256] = {
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0x0b, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0x2b, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0x4b, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, &&op_0x83, 0, 0, 0, &&op_0x87,
+		0, 0, 0, 0, 0, 0, 0, &&op_0x8f,
+		0, 0, 0, &&op_0x93, 0, 0, 0, &&op_0x97,
+		0, 0, 0, &&op_0x9b, 0, 0, 0, &&op_0x9f,
+		0, 0, 0, &&op_0xa3, 0, 0, 0, &&op_0xa7,
+		0, 0, 0, &&op_0xab, 0, 0, 0, &&op_0xaf,
+		0, 0, 0, &&op_0xb3, 0, 0, 0, &&op_0xb7,
+		0, 0, 0, &&op_0xbb, 0, 0, 0, &&op_0xbf,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0
+	};
+	static void *OpcodeTable[256];
+	static int OpcodeTableSet=-1;
+
+	/* Build the handler table for this opcode set. Each opcode
+	   goes to the first of its handlers that the old switch statements
+	   would have run, or to BadOpcode if none of them would. */
+	if (OpcodeTableSet!=OpSet) {
+		for (int op=0;op<256;op++) {
+			if (OpSet>=1 && DocumentedOps[op])
+				OpcodeTable[op]=DocumentedOps[op];
+			else if (OpSet==3 && FullUndocumentedOps[op])
+				OpcodeTable[op]=FullUndocumentedOps[op];
+			else if (OpSet>=2 && CommonUndocumentedOps[op])
+				OpcodeTable[op]=CommonUndocumentedOps[op];
+			else
+				OpcodeTable[op]=&&BadOpcode;
+		}
+		OpcodeTableSet=OpSet;
+	}
+#endif
+
+	for(loop=0;nCycles ? (SliceCycles<nCycles) : (loop<nInstructions);loop++) {
 		/* Output debug info */
 //->		if (DebugEnabled && !DebugDisassembler(ProgramCounter,Accumulator,XReg,YReg,PSR,StackReg,true))
 //<-			continue;
@@ -1178,12 +649,13 @@ void Exec6502Instruction(void) {
 		if (Tube186Enabled)
 		         i186_execute(12 * 4);
 
-		Branched=0;
 		iFlagJustCleared=false;
 		iFlagJustSet=false;
 		Cycles=0;
 		IOCycles = 0;
+#ifndef WITH_THREADED_6502
 		BadCount=0;
+#endif
 		IntDue = false;
 
 		// Check for WRCHV, send char to speech output
@@ -1192,7 +664,6 @@ void Exec6502Instruction(void) {
 			mainWin->SpeakChar(Accumulator);
 
       /* Read an instruction and post inc program couter */
-		OldPC=ProgramCounter;
 		PrePC=ProgramCounter;
 		CurrentInstruction=ReadPaged(ProgramCounter++);
 		// cout << "Fetch at " << hex << (ProgramCounter-1) << " giving 0x" << CurrentInstruction << dec << "\n"; 
@@ -1205,120 +676,122 @@ void Exec6502Instruction(void) {
 		//	  fprintf(InstrLog,"%04x %02x %02x %02x %02x\n",ProgramCounter-1,CurrentInstruction,ReadPaged(ProgramCounter),ReadPaged(ProgramCounter+1),YReg);
 		//  }
 
-		if (OpCodes>=1) { // Documented opcodes
-			switch (CurrentInstruction) {
-			case 0x00:
+#ifdef WITH_THREADED_6502
+		goto *OpcodeTable[CurrentInstruction];
+#endif
+		OPCODE_SET_BEGIN(OpSet>=1) // Documented opcodes
+			OPCODE(0x00)
 				BRKInstrHandler();
-				break;
-			case 0x01:
-				ORAInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0x04:
-				if (MachineType==3) TSBInstrHandler(ZeroPgAddrModeHandler_Address()); else ProgramCounter+=1;
-				break;
-			case 0x05:
-				ORAInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0x06:
-				ASLInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0x08:
-				Push(PSR|48); /* PHP */
-				break;
-			case 0x09:
-				ORAInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0x0a:
-				ASLInstrHandler_Acc();
-				break;
-			case 0x0c:
-				if (MachineType==3) TSBInstrHandler(AbsAddrModeHandler_Address()); else ProgramCounter+=2;
-				break;
-			case 0x0d:
-				ORAInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0x0e:
-				ASLInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x10:
-				BPLInstrHandler();
-				break;
-			case 0x30:
-				BMIInstrHandler();
-				break;
-			case 0x50:
-				BVCInstrHandler();
-				break;
-			case 0x70:
-				BVSInstrHandler();
-				break;
-			case 0x80:
-				BRAInstrHandler();
-				break;
-			case 0x90:
-				BCCInstrHandler();
-				break;
-			case 0xb0:
-				BCSInstrHandler();
-				break;
-			case 0xd0:
-				BNEInstrHandler();
-				break;
-			case 0xf0:
-				BEQInstrHandler();
-				break;
-			case 0x11:
-				ORAInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0x12:
-				if (MachineType==3) ORAInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0x14:
-				if (MachineType==3) TRBInstrHandler(ZeroPgAddrModeHandler_Address()); else ProgramCounter+=1;
-				break;
-			case 0x15:
-				ORAInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0x16:
-				ASLInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0x18:
+				NEXT_OPCODE;
+			OPCODE(0x01)
+				CPU::ORAInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x04)
+				if (CPU::CMOS) CPU::TSBInstrHandler(CPU::ZeroPgAddrModeHandler_Address()); else ProgramCounter+=1;
+				NEXT_OPCODE;
+			OPCODE(0x05)
+				CPU::ORAInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0x06)
+				CPU::ASLInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x08)
+				CPU::Push(PSR|48); /* PHP */
+				NEXT_OPCODE;
+			OPCODE(0x09)
+				CPU::ORAInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0x0a)
+				CPU::ASLInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x0c)
+				if (CPU::CMOS) CPU::TSBInstrHandler(CPU::AbsAddrModeHandler_Address()); else ProgramCounter+=2;
+				NEXT_OPCODE;
+			OPCODE(0x0d)
+				CPU::ORAInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x0e)
+				CPU::ASLInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x10)
+				CPU::BPLInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x30)
+				CPU::BMIInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x50)
+				CPU::BVCInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x70)
+				CPU::BVSInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x80)
+				CPU::BRAInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x90)
+				CPU::BCCInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0xb0)
+				CPU::BCSInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0xd0)
+				CPU::BNEInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0xf0)
+				CPU::BEQInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x11)
+				CPU::ORAInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x12)
+				if (CPU::CMOS) CPU::ORAInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x14)
+				if (CPU::CMOS) CPU::TRBInstrHandler(CPU::ZeroPgAddrModeHandler_Address()); else ProgramCounter+=1;
+				NEXT_OPCODE;
+			OPCODE(0x15)
+				CPU::ORAInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x16)
+				CPU::ASLInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x18)
 				PSR&=255-FlagC; /* CLC */
-				break;
-			case 0x19:
-				ORAInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0x1a:
-				if (MachineType==3) INAInstrHandler();
-				break;
-			case 0x1c:
-				if (MachineType==3) TRBInstrHandler(AbsAddrModeHandler_Address()); else ProgramCounter+=2;
-				break;
-			case 0x1d:
-				ORAInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0x1e:
-				ASLInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			case 0x20:
-				JSRInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x21:
-				ANDInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0x24:
-				BITInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0x25:
-				ANDInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0x26:
-				ROLInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0x28:
+				NEXT_OPCODE;
+			OPCODE(0x19)
+				CPU::ORAInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x1a)
+				if (CPU::CMOS) CPU::INAInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x1c)
+				if (CPU::CMOS) CPU::TRBInstrHandler(CPU::AbsAddrModeHandler_Address()); else ProgramCounter+=2;
+				NEXT_OPCODE;
+			OPCODE(0x1d)
+				CPU::ORAInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x1e)
+				CPU::ASLInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x20)
+				CPU::JSRInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x21)
+				CPU::ANDInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x24)
+				CPU::BITInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0x25)
+				CPU::ANDInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0x26)
+				CPU::ROLInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x28)
 				{
 					unsigned char oldPSR=PSR;
-					PSR=Pop(); /* PLP */
+					PSR=CPU::Pop(); /* PLP */
 					if ((oldPSR ^ PSR) & FlagI)
 					{
 						if (PSR & FlagI)
@@ -1327,80 +800,80 @@ void Exec6502Instruction(void) {
 							iFlagJustCleared=true;
 					}
 				}
-				break;
-			case 0x29:
-				ANDInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0x2a:
-				ROLInstrHandler_Acc();
-				break;
-			case 0x2c:
-				BITInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0x2d:
-				ANDInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0x2e:
-				ROLInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x31:
-				ANDInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0x32:
-				if (MachineType==3) ANDInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0x34: /* BIT Absolute,X */
-				if (MachineType==3) BITInstrHandler(ZeroPgXAddrModeHandler_Data()); else ProgramCounter+=1;
-				break;
-			case 0x35:
-				ANDInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0x36:
-				ROLInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0x38:
+				NEXT_OPCODE;
+			OPCODE(0x29)
+				CPU::ANDInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0x2a)
+				CPU::ROLInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x2c)
+				CPU::BITInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x2d)
+				CPU::ANDInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x2e)
+				CPU::ROLInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x31)
+				CPU::ANDInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x32)
+				if (CPU::CMOS) CPU::ANDInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x34) /* BIT Absolute,X */
+				if (CPU::CMOS) CPU::BITInstrHandler(CPU::ZeroPgXAddrModeHandler_Data()); else ProgramCounter+=1;
+				NEXT_OPCODE;
+			OPCODE(0x35)
+				CPU::ANDInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x36)
+				CPU::ROLInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x38)
 				PSR|=FlagC; /* SEC */
-				break;
-			case 0x39:
-				ANDInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0x3a:
-				if (MachineType==3) DEAInstrHandler();
-				break;
-			case 0x3c: /* BIT Absolute,X */
-				if (MachineType==3) BITInstrHandler(AbsXAddrModeHandler_Data()); else ProgramCounter+=2;
-				break;
-			case 0x3d:
-				ANDInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0x3e:
-				ROLInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			case 0x40:
-				PSR=Pop(); /* RTI */
-				ProgramCounter=PopWord();
+				NEXT_OPCODE;
+			OPCODE(0x39)
+				CPU::ANDInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x3a)
+				if (CPU::CMOS) CPU::DEAInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0x3c) /* BIT Absolute,X */
+				if (CPU::CMOS) CPU::BITInstrHandler(CPU::AbsXAddrModeHandler_Data()); else ProgramCounter+=2;
+				NEXT_OPCODE;
+			OPCODE(0x3d)
+				CPU::ANDInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x3e)
+				CPU::ROLInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x40)
+				PSR=CPU::Pop(); /* RTI */
+				ProgramCounter=CPU::PopWord();
 				NMILock=0;
-				break;
-			case 0x41:
-				EORInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0x45:
-				EORInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0x46:
-				LSRInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0x48:
-				Push(Accumulator); /* PHA */
-				break;
-			case 0x49:
-				EORInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0x4a:
-				LSRInstrHandler_Acc();
-				break;
-			case 0x4c:
-				ProgramCounter=AbsAddrModeHandler_Address(); /* JMP */
+				NEXT_OPCODE;
+			OPCODE(0x41)
+				CPU::EORInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x45)
+				CPU::EORInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0x46)
+				CPU::LSRInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x48)
+				CPU::Push(Accumulator); /* PHA */
+				NEXT_OPCODE;
+			OPCODE(0x49)
+				CPU::EORInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0x4a)
+				CPU::LSRInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x4c)
+				ProgramCounter=CPU::AbsAddrModeHandler_Address(); /* JMP */
 				/*    if (ProgramCounter==0xffdd) {
 				// OSCLI logging for elite debugging
 				unsigned char *bptr;
@@ -1418,840 +891,816 @@ void Exec6502Instruction(void) {
 				sprintf(errstr,"OSFILE called\n");
 				MessageBox(GETHWND,errstr,"BBC Emulator",MB_OKCANCEL|MB_ICONERROR);
 				}*/
-				break;
-			case 0x4d:
-				EORInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0x4e:
-				LSRInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x51:
-				EORInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0x52:
-				if (MachineType==3) EORInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0x55:
-				EORInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0x56:
-				LSRInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0x58:
+				NEXT_OPCODE;
+			OPCODE(0x4d)
+				CPU::EORInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x4e)
+				CPU::LSRInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x51)
+				CPU::EORInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x52)
+				if (CPU::CMOS) CPU::EORInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x55)
+				CPU::EORInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x56)
+				CPU::LSRInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x58)
 				if (PSR & FlagI)
 					iFlagJustCleared=true;
 				PSR&=255-FlagI; /* CLI */
-				break;
-			case 0x59:
-				EORInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0x5a:
-				if (MachineType==3) Push(YReg); /* PHY */
-				break;
-			case 0x5d:
-				EORInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0x5e:
-				LSRInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			case 0x60:
-				ProgramCounter=PopWord()+1; /* RTS */
-				break;
-			case 0x61:
-				ADCInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0x64:
-				if (MachineType==3) BEEBWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),0); /* STZ Zero Page */
-				break;
-			case 0x65:
-				ADCInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0x66:
-				RORInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0x68:
-				Accumulator=Pop(); /* PLA */
+				NEXT_OPCODE;
+			OPCODE(0x59)
+				CPU::EORInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x5a)
+				if (CPU::CMOS) CPU::Push(YReg); /* PHY */
+				NEXT_OPCODE;
+			OPCODE(0x5d)
+				CPU::EORInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x5e)
+				CPU::LSRInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x60)
+				ProgramCounter=CPU::PopWord()+1; /* RTS */
+				NEXT_OPCODE;
+			OPCODE(0x61)
+				CPU::ADCInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x64)
+				if (CPU::CMOS) BEEBWRITEMEM_DIRECT(CPU::ZeroPgAddrModeHandler_Address(),0); /* STZ Zero Page */
+				NEXT_OPCODE;
+			OPCODE(0x65)
+				CPU::ADCInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0x66)
+				CPU::RORInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x68)
+				Accumulator=CPU::Pop(); /* PLA */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				break;
-			case 0x69:
-				ADCInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0x6a:
-				RORInstrHandler_Acc();
-				break;
-			case 0x6c:
-				ProgramCounter=IndAddrModeHandler_Address(); /* JMP */
-				break;
-			case 0x6d:
-				ADCInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0x6e:
-				RORInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x71:
-				ADCInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0x72:
-				if (MachineType==3) ADCInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0x74:
-				if (MachineType==3) { BEEBWRITEMEM_DIRECT(ZeroPgXAddrModeHandler_Address(),0); } else ProgramCounter+=1; /* STZ Zpg,X */
-				break;
-			case 0x75:
-				ADCInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0x76:
-				RORInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0x78:
+				NEXT_OPCODE;
+			OPCODE(0x69)
+				CPU::ADCInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0x6a)
+				CPU::RORInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x6c)
+				ProgramCounter=CPU::IndAddrModeHandler_Address(); /* JMP */
+				NEXT_OPCODE;
+			OPCODE(0x6d)
+				CPU::ADCInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x6e)
+				CPU::RORInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x71)
+				CPU::ADCInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x72)
+				if (CPU::CMOS) CPU::ADCInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x74)
+				if (CPU::CMOS) { BEEBWRITEMEM_DIRECT(CPU::ZeroPgXAddrModeHandler_Address(),0); } else ProgramCounter+=1; /* STZ Zpg,X */
+				NEXT_OPCODE;
+			OPCODE(0x75)
+				CPU::ADCInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x76)
+				CPU::RORInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x78)
 				if (!(PSR & FlagI))
 					iFlagJustSet = true;
 				PSR|=FlagI; /* SEI */
-				break;
-			case 0x79:
-				ADCInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0x7a:
-				if (MachineType==3) {
-					YReg=Pop(); /* PLY */
+				NEXT_OPCODE;
+			OPCODE(0x79)
+				CPU::ADCInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x7a)
+				if (CPU::CMOS) {
+					YReg=CPU::Pop(); /* PLY */
 					PSR&=~(FlagZ | FlagN);
 					PSR|=((XReg==0)<<1) | (YReg & 128);
 				}
-				break;
-			case 0x7c:
-				if (MachineType==3) ProgramCounter=IndAddrXModeHandler_Address(); /* JMP abs,X*/ else ProgramCounter+=2;
-				break;
-			case 0x7d:
-				ADCInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0x7e:
-				RORInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			case 0x81:
+				NEXT_OPCODE;
+			OPCODE(0x7c)
+				if (CPU::CMOS) ProgramCounter=CPU::IndAddrXModeHandler_Address(); /* JMP abs,X*/ else ProgramCounter+=2;
+				NEXT_OPCODE;
+			OPCODE(0x7d)
+				CPU::ADCInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0x7e)
+				CPU::RORInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x81)
 				AdvanceCyclesForMemWrite();
-				WritePaged(IndXAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x84:
+				WritePaged(CPU::IndXAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x84)
 				AdvanceCyclesForMemWrite();
-				BEEBWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),YReg);
-				break;
-			case 0x85:
+				BEEBWRITEMEM_DIRECT(CPU::ZeroPgAddrModeHandler_Address(),YReg);
+				NEXT_OPCODE;
+			OPCODE(0x85)
 				AdvanceCyclesForMemWrite();
-				BEEBWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x86:
+				BEEBWRITEMEM_DIRECT(CPU::ZeroPgAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x86)
 				AdvanceCyclesForMemWrite();
-				BEEBWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),XReg);
-				break;
-			case 0x88:
+				BEEBWRITEMEM_DIRECT(CPU::ZeroPgAddrModeHandler_Address(),XReg);
+				NEXT_OPCODE;
+			OPCODE(0x88)
 				YReg=(YReg-1) & 255; /* DEY */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((YReg==0)<<1) | (YReg & 128);
-				break;
-			case 0x89: /* BIT Immediate */
-				if (MachineType==3) BITInstrHandler(ReadPaged(ProgramCounter++));
-				break;
-			case 0x8a:
+				NEXT_OPCODE;
+			OPCODE(0x89) /* BIT Immediate */
+				if (CPU::CMOS) CPU::BITInstrHandler(ReadPaged(ProgramCounter++));
+				NEXT_OPCODE;
+			OPCODE(0x8a)
 				Accumulator=XReg; /* TXA */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				break;
-			case 0x8c:
+				NEXT_OPCODE;
+			OPCODE(0x8c)
 				AdvanceCyclesForMemWrite();
-				STYInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x8d:
+				CPU::STYInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x8d)
 				AdvanceCyclesForMemWrite();
-				WritePaged(AbsAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x8e:
+				WritePaged(CPU::AbsAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x8e)
 				AdvanceCyclesForMemWrite();
-				STXInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0x91:
+				CPU::STXInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x91)
 				AdvanceCyclesForMemWrite();
-				WritePaged(IndYAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x92:
+				WritePaged(CPU::IndYAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x92)
 				AdvanceCyclesForMemWrite();
-				if (MachineType==3) WritePaged(ZPIndAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x94:
+				if (CPU::CMOS) WritePaged(CPU::ZPIndAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x94)
 				AdvanceCyclesForMemWrite();
-				STYInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0x95:
+				CPU::STYInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x95)
 				AdvanceCyclesForMemWrite();
-				WritePaged(ZeroPgXAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x96:
+				WritePaged(CPU::ZeroPgXAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x96)
 				AdvanceCyclesForMemWrite();
-				STXInstrHandler(ZeroPgYAddrModeHandler_Address());
-				break;
-			case 0x98:
+				CPU::STXInstrHandler(CPU::ZeroPgYAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0x98)
 				Accumulator=YReg; /* TYA */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				break;
-			case 0x99:
+				NEXT_OPCODE;
+			OPCODE(0x99)
 				AdvanceCyclesForMemWrite();
-				WritePaged(AbsYAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x9a:
+				WritePaged(CPU::AbsYAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x9a)
 				StackReg=XReg; /* TXS */
-				break;
-			case 0x9c:
-				WritePaged(AbsAddrModeHandler_Address(),0); /* STZ Absolute */
+				NEXT_OPCODE;
+			OPCODE(0x9c)
+				WritePaged(CPU::AbsAddrModeHandler_Address(),0); /* STZ Absolute */
 				/* here's a curiosity, STZ Absolute IS on the 6502 UNOFFICIALLY
 				   and on the 65C12 OFFICIALLY. Something we should know? - Richard Gellman */
-				break;
-			case 0x9d:
+				NEXT_OPCODE;
+			OPCODE(0x9d)
 				AdvanceCyclesForMemWrite();
-				WritePaged(AbsXAddrModeHandler_Address(),Accumulator); /* STA */
-				break;
-			case 0x9e:
-				if (MachineType==3) { WritePaged(AbsXAddrModeHandler_Address(),0); } /* STZ Abs,X */ 
-				else WritePaged(AbsXAddrModeHandler_Address(),Accumulator & XReg);
-				break;
-			case 0xa0:
-				LDYInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xa1:
-				LDAInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0xa2:
-				LDXInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xa4:
-				LDYInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xa5:
-				LDAInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xa6:
-				LDXInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xa8:
+				WritePaged(CPU::AbsXAddrModeHandler_Address(),Accumulator); /* STA */
+				NEXT_OPCODE;
+			OPCODE(0x9e)
+				if (CPU::CMOS) { WritePaged(CPU::AbsXAddrModeHandler_Address(),0); } /* STZ Abs,X */ 
+				else WritePaged(CPU::AbsXAddrModeHandler_Address(),Accumulator & XReg);
+				NEXT_OPCODE;
+			OPCODE(0xa0)
+				CPU::LDYInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xa1)
+				CPU::LDAInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xa2)
+				CPU::LDXInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xa4)
+				CPU::LDYInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xa5)
+				CPU::LDAInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xa6)
+				CPU::LDXInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xa8)
 				YReg=Accumulator; /* TAY */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				break;
-			case 0xa9:
-				LDAInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xaa:
+				NEXT_OPCODE;
+			OPCODE(0xa9)
+				CPU::LDAInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xaa)
 				XReg=Accumulator; /* TXA */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				break;
-			case 0xac:
-				LDYInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xad:
-				LDAInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xae:
-				LDXInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xb1:
-				LDAInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0xb2:
-				if (MachineType==3) LDAInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0xb4:
-				LDYInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0xb5:
-				LDAInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0xb6:
-				LDXInstrHandler(ZeroPgYAddrModeHandler_Data());
-				break;
-			case 0xb8:
+				NEXT_OPCODE;
+			OPCODE(0xac)
+				CPU::LDYInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xad)
+				CPU::LDAInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xae)
+				CPU::LDXInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb1)
+				CPU::LDAInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb2)
+				if (CPU::CMOS) CPU::LDAInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb4)
+				CPU::LDYInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb5)
+				CPU::LDAInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb6)
+				CPU::LDXInstrHandler(CPU::ZeroPgYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb8)
 				PSR&=255-FlagV; /* CLV */
-				break;
-			case 0xb9:
-				LDAInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0xba:
+				NEXT_OPCODE;
+			OPCODE(0xb9)
+				CPU::LDAInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xba)
 				XReg=StackReg; /* TSX */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((XReg==0)<<1) | (XReg & 128);
-				break;
-			case 0xbc:
-				LDYInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0xbd:
-				LDAInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0xbe:
-				LDXInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0xc0:
-				CPYInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xc1:
-				CMPInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0xc4:
-				CPYInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xc5:
-				CMPInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xc6:
-				DECInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0xc8:
+				NEXT_OPCODE;
+			OPCODE(0xbc)
+				CPU::LDYInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xbd)
+				CPU::LDAInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xbe)
+				CPU::LDXInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xc0)
+				CPU::CPYInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xc1)
+				CPU::CMPInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xc4)
+				CPU::CPYInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xc5)
+				CPU::CMPInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xc6)
+				CPU::DECInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xc8)
 				YReg+=1; /* INY */
 				YReg&=255;
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((YReg==0)<<1) | (YReg & 128);
-				break;
-			case 0xc9:
-				CMPInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xca:
-				DEXInstrHandler();
-				break;
-			case 0xcc:
-				CPYInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xcd:
-				CMPInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xce:
-				DECInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0xd1:
-				CMPInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0xd2:
-				if (MachineType==3) CMPInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0xd5:
-				CMPInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0xd6:
-				DECInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0xd8:
+				NEXT_OPCODE;
+			OPCODE(0xc9)
+				CPU::CMPInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xca)
+				CPU::DEXInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0xcc)
+				CPU::CPYInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xcd)
+				CPU::CMPInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xce)
+				CPU::DECInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xd1)
+				CPU::CMPInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xd2)
+				if (CPU::CMOS) CPU::CMPInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xd5)
+				CPU::CMPInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xd6)
+				CPU::DECInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xd8)
 				PSR&=255-FlagD; /* CLD */
-				break;
-			case 0xd9:
-				CMPInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0xda:
-				if (MachineType==3) Push(XReg); /* PHX */
-				break;
-			case 0xdd:
-				CMPInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0xde:
-				DECInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			case 0xe0:
-				CPXInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xe1:
-				SBCInstrHandler(IndXAddrModeHandler_Data());
-				break;
-			case 0xe4:
-				CPXInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xe5:
-				SBCInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
-				break;
-			case 0xe6:
-				INCInstrHandler(ZeroPgAddrModeHandler_Address());
-				break;
-			case 0xe8:
-				INXInstrHandler();
-				break;
-			case 0xe9:
-				SBCInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
-				break;
-			case 0xea:
+				NEXT_OPCODE;
+			OPCODE(0xd9)
+				CPU::CMPInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xda)
+				if (CPU::CMOS) CPU::Push(XReg); /* PHX */
+				NEXT_OPCODE;
+			OPCODE(0xdd)
+				CPU::CMPInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xde)
+				CPU::DECInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xe0)
+				CPU::CPXInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xe1)
+				CPU::SBCInstrHandler(CPU::IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xe4)
+				CPU::CPXInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xe5)
+				CPU::SBCInstrHandler(WholeRam[ReadPaged(ProgramCounter++)]/*zp */);
+				NEXT_OPCODE;
+			OPCODE(0xe6)
+				CPU::INCInstrHandler(CPU::ZeroPgAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xe8)
+				CPU::INXInstrHandler();
+				NEXT_OPCODE;
+			OPCODE(0xe9)
+				CPU::SBCInstrHandler(ReadPaged(ProgramCounter++)); /* immediate */
+				NEXT_OPCODE;
+			OPCODE(0xea)
 				/* NOP */
-				break;
-			case 0xec:
-				CPXInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xed:
-				SBCInstrHandler(AbsAddrModeHandler_Data());
-				break;
-			case 0xee:
-				INCInstrHandler(AbsAddrModeHandler_Address());
-				break;
-			case 0xf1:
-				SBCInstrHandler(IndYAddrModeHandler_Data());
-				break;
-			case 0xf2:
-				if (MachineType==3) SBCInstrHandler(ZPIndAddrModeHandler_Data());
-				break;
-			case 0xf5:
-				SBCInstrHandler(ZeroPgXAddrModeHandler_Data());
-				break;
-			case 0xf6:
-				INCInstrHandler(ZeroPgXAddrModeHandler_Address());
-				break;
-			case 0xf8:
+				NEXT_OPCODE;
+			OPCODE(0xec)
+				CPU::CPXInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xed)
+				CPU::SBCInstrHandler(CPU::AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xee)
+				CPU::INCInstrHandler(CPU::AbsAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xf1)
+				CPU::SBCInstrHandler(CPU::IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xf2)
+				if (CPU::CMOS) CPU::SBCInstrHandler(CPU::ZPIndAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xf5)
+				CPU::SBCInstrHandler(CPU::ZeroPgXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xf6)
+				CPU::INCInstrHandler(CPU::ZeroPgXAddrModeHandler_Address());
+				NEXT_OPCODE;
+			OPCODE(0xf8)
 				PSR|=FlagD; /* SED */
-				break;
-			case 0xf9:
-				SBCInstrHandler(AbsYAddrModeHandler_Data());
-				break;
-			case 0xfa:
-				if (MachineType==3) {
-					XReg=Pop(); /* PLX */
+				NEXT_OPCODE;
+			OPCODE(0xf9)
+				CPU::SBCInstrHandler(CPU::AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xfa)
+				if (CPU::CMOS) {
+					XReg=CPU::Pop(); /* PLX */
 					PSR&=~(FlagZ | FlagN);
 					PSR|=((XReg==0)<<1) | (XReg & 128);
 				}
-				break;
-			case 0xfd:
-				SBCInstrHandler(AbsXAddrModeHandler_Data());
-				break;
-			case 0xfe:
-				INCInstrHandler(AbsXAddrModeHandler_Address());
-				break;
-			default:
-				BadCount++;
-			}
-		}
-		if (OpCodes==3) {
-			switch (CurrentInstruction) {
-			case 0x07: /* Undocumented Instruction: ASL zp and ORA zp */
+				NEXT_OPCODE;
+			OPCODE(0xfd)
+				CPU::SBCInstrHandler(CPU::AbsXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xfe)
+				CPU::INCInstrHandler(CPU::AbsXAddrModeHandler_Address());
+				NEXT_OPCODE;
+		OPCODE_SET_END
+		OPCODE_SET_BEGIN(OpSet==3)
+			OPCODE(0x07) /* Undocumented Instruction: ASL zp and ORA zp */
 			{
-				int16 zpaddr = ZeroPgAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::ZeroPgAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x03: /* Undocumented Instruction: ASL-ORA (zp,X) */
+			NEXT_OPCODE;
+			OPCODE(0x03) /* Undocumented Instruction: ASL-ORA (zp,X) */
 			{
-				int16 zpaddr = IndXAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::IndXAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x13: /* Undocumented Instruction: ASL-ORA (zp),Y */
+			NEXT_OPCODE;
+			OPCODE(0x13) /* Undocumented Instruction: ASL-ORA (zp),Y */
 			{
-				int16 zpaddr = IndYAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::IndYAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x0f: /* Undocumented Instruction: ASL-ORA abs */
+			NEXT_OPCODE;
+			OPCODE(0x0f) /* Undocumented Instruction: ASL-ORA abs */
 			{
-				int16 zpaddr = AbsAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::AbsAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x17: /* Undocumented Instruction: ASL-ORA zp,X */
+			NEXT_OPCODE;
+			OPCODE(0x17) /* Undocumented Instruction: ASL-ORA zp,X */
 			{
-				int16 zpaddr = ZeroPgXAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x1b: /* Undocumented Instruction: ASL-ORA abs,Y */
+			NEXT_OPCODE;
+			OPCODE(0x1b) /* Undocumented Instruction: ASL-ORA abs,Y */
 			{
-				int16 zpaddr = AbsYAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::AbsYAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x1f: /* Undocumented Instruction: ASL-ORA abs,X */
+			NEXT_OPCODE;
+			OPCODE(0x1f) /* Undocumented Instruction: ASL-ORA abs,X */
 			{
-				int16 zpaddr = AbsXAddrModeHandler_Address();
-				ASLInstrHandler(zpaddr);
-				ORAInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr = CPU::AbsXAddrModeHandler_Address();
+				CPU::ASLInstrHandler(zpaddr);
+				CPU::ORAInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x23: /* Undocumented Instruction: ROL-AND (zp,X) */
+			NEXT_OPCODE;
+			OPCODE(0x23) /* Undocumented Instruction: ROL-AND (zp,X) */
 			{
-				int16 zpaddr=IndXAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndXAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x27: /* Undocumented Instruction: ROL-AND zp */
+			NEXT_OPCODE;
+			OPCODE(0x27) /* Undocumented Instruction: ROL-AND zp */
 			{
-				int16 zpaddr=ZeroPgAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x2f: /* Undocumented Instruction: ROL-AND abs */
+			NEXT_OPCODE;
+			OPCODE(0x2f) /* Undocumented Instruction: ROL-AND abs */
 			{
-				int16 zpaddr=AbsAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x33: /* Undocumented Instruction: ROL-AND (zp),Y */
+			NEXT_OPCODE;
+			OPCODE(0x33) /* Undocumented Instruction: ROL-AND (zp),Y */
 			{
-				int16 zpaddr=IndYAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndYAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x37: /* Undocumented Instruction: ROL-AND zp,X */
+			NEXT_OPCODE;
+			OPCODE(0x37) /* Undocumented Instruction: ROL-AND zp,X */
 			{
-				int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x3b: /* Undocumented Instruction: ROL-AND abs.Y */
+			NEXT_OPCODE;
+			OPCODE(0x3b) /* Undocumented Instruction: ROL-AND abs.Y */
 			{
-				int16 zpaddr=AbsYAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsYAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x3f: /* Undocumented Instruction: ROL-AND abs.X */
+			NEXT_OPCODE;
+			OPCODE(0x3f) /* Undocumented Instruction: ROL-AND abs.X */
 			{
-				int16 zpaddr=AbsXAddrModeHandler_Address();
-				ROLInstrHandler(zpaddr);
-				ANDInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsXAddrModeHandler_Address();
+				CPU::ROLInstrHandler(zpaddr);
+				CPU::ANDInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x43: /* Undocumented Instruction: LSR-EOR (zp,X) */
+			NEXT_OPCODE;
+			OPCODE(0x43) /* Undocumented Instruction: LSR-EOR (zp,X) */
 			{
-				int16 zpaddr=IndXAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndXAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x47: /* Undocumented Instruction: LSR-EOR zp */
+			NEXT_OPCODE;
+			OPCODE(0x47) /* Undocumented Instruction: LSR-EOR zp */
 			{
-				int16 zpaddr=ZeroPgAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x4f: /* Undocumented Instruction: LSR-EOR abs */
+			NEXT_OPCODE;
+			OPCODE(0x4f) /* Undocumented Instruction: LSR-EOR abs */
 			{
-				int16 zpaddr=AbsAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x53: /* Undocumented Instruction: LSR-EOR (zp),Y */
+			NEXT_OPCODE;
+			OPCODE(0x53) /* Undocumented Instruction: LSR-EOR (zp),Y */
 			{
-				int16 zpaddr=IndYAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndYAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x57: /* Undocumented Instruction: LSR-EOR zp,X */
+			NEXT_OPCODE;
+			OPCODE(0x57) /* Undocumented Instruction: LSR-EOR zp,X */
 			{
-				int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x5b: /* Undocumented Instruction: LSR-EOR abs,Y */
+			NEXT_OPCODE;
+			OPCODE(0x5b) /* Undocumented Instruction: LSR-EOR abs,Y */
 			{
-				int16 zpaddr=AbsYAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsYAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x5f: /* Undocumented Instruction: LSR-EOR abs,X */
+			NEXT_OPCODE;
+			OPCODE(0x5f) /* Undocumented Instruction: LSR-EOR abs,X */
 			{
-				int16 zpaddr=AbsXAddrModeHandler_Address();
-				LSRInstrHandler(zpaddr);
-				EORInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsXAddrModeHandler_Address();
+				CPU::LSRInstrHandler(zpaddr);
+				CPU::EORInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x44:
-			case 0x54:
+			NEXT_OPCODE;
+			OPCODE(0x44)
+			OPCODE(0x54)
 				ProgramCounter+=1;
-				break;
-			case 0x5c:
+				NEXT_OPCODE;
+			OPCODE(0x5c)
 				ProgramCounter+=2;
-				break;
-			case 0x63: /* Undocumented Instruction: ROR-ADC (zp,X) */
+				NEXT_OPCODE;
+			OPCODE(0x63) /* Undocumented Instruction: ROR-ADC (zp,X) */
 			{
-				int16 zpaddr=IndXAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndXAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x67: /* Undocumented Instruction: ROR-ADC zp */
+			NEXT_OPCODE;
+			OPCODE(0x67) /* Undocumented Instruction: ROR-ADC zp */
 			{
-				int16 zpaddr=ZeroPgAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x6f: /* Undocumented Instruction: ROR-ADC abs */
+			NEXT_OPCODE;
+			OPCODE(0x6f) /* Undocumented Instruction: ROR-ADC abs */
 			{
-				int16 zpaddr=AbsAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x73: /* Undocumented Instruction: ROR-ADC (zp),Y */
+			NEXT_OPCODE;
+			OPCODE(0x73) /* Undocumented Instruction: ROR-ADC (zp),Y */
 			{
-				int16 zpaddr=IndYAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndYAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x77: /* Undocumented Instruction: ROR-ADC zp,X */
+			NEXT_OPCODE;
+			OPCODE(0x77) /* Undocumented Instruction: ROR-ADC zp,X */
 			{
-				int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x7b: /* Undocumented Instruction: ROR-ADC abs,Y */
+			NEXT_OPCODE;
+			OPCODE(0x7b) /* Undocumented Instruction: ROR-ADC abs,Y */
 			{
-				int16 zpaddr=AbsYAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsYAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0x7f: /* Undocumented Instruction: ROR-ADC abs,X */
+			NEXT_OPCODE;
+			OPCODE(0x7f) /* Undocumented Instruction: ROR-ADC abs,X */
 			{
-				int16 zpaddr=AbsXAddrModeHandler_Address();
-				RORInstrHandler(zpaddr);
-				ADCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsXAddrModeHandler_Address();
+				CPU::RORInstrHandler(zpaddr);
+				CPU::ADCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
+			NEXT_OPCODE;
 			// Undocumented DEC-CMP and INC-SBC Instructions
-			case 0xc3: // DEC-CMP (zp,X)
+			OPCODE(0xc3) // DEC-CMP (zp,X)
 			{
-				int16 zpaddr=IndXAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndXAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xc7: // DEC-CMP zp
+			NEXT_OPCODE;
+			OPCODE(0xc7) // DEC-CMP zp
 			{
-				int16 zpaddr=ZeroPgAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xcf: // DEC-CMP abs
+			NEXT_OPCODE;
+			OPCODE(0xcf) // DEC-CMP abs
 			{
-				int16 zpaddr=AbsAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xd3: // DEC-CMP (zp),Y
+			NEXT_OPCODE;
+			OPCODE(0xd3) // DEC-CMP (zp),Y
 			{
-				int16 zpaddr=IndYAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndYAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xd7: // DEC-CMP zp,X
+			NEXT_OPCODE;
+			OPCODE(0xd7) // DEC-CMP zp,X
 			{
-				int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xdb: // DEC-CMP abs,Y
+			NEXT_OPCODE;
+			OPCODE(0xdb) // DEC-CMP abs,Y
 			{
-				int16 zpaddr=AbsYAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsYAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xdf: // DEC-CMP abs,X
+			NEXT_OPCODE;
+			OPCODE(0xdf) // DEC-CMP abs,X
 			{
-				int16 zpaddr=AbsXAddrModeHandler_Address();
-				DECInstrHandler(zpaddr);
-				CMPInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsXAddrModeHandler_Address();
+				CPU::DECInstrHandler(zpaddr);
+				CPU::CMPInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xd4:
-			case 0xf4:
+			NEXT_OPCODE;
+			OPCODE(0xd4)
+			OPCODE(0xf4)
 				ProgramCounter+=1;
-				break;
-			case 0xdc:
-			case 0xfc:
+				NEXT_OPCODE;
+			OPCODE(0xdc)
+			OPCODE(0xfc)
 				ProgramCounter+=2;
-				break;
-			case 0xe3: // INC-SBC (zp,X)
+				NEXT_OPCODE;
+			OPCODE(0xe3) // INC-SBC (zp,X)
 			{
-				int16 zpaddr=IndXAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndXAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xe7: // INC-SBC zp
+			NEXT_OPCODE;
+			OPCODE(0xe7) // INC-SBC zp
 			{
-				int16 zpaddr=ZeroPgAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xef: // INC-SBC abs
+			NEXT_OPCODE;
+			OPCODE(0xef) // INC-SBC abs
 			{
-				int16 zpaddr=AbsAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xf3: // INC-SBC (zp).Y
+			NEXT_OPCODE;
+			OPCODE(0xf3) // INC-SBC (zp).Y
 			{
-				int16 zpaddr=IndYAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::IndYAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xf7: // INC-SBC zp,X
+			NEXT_OPCODE;
+			OPCODE(0xf7) // INC-SBC zp,X
 			{
-				int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::ZeroPgXAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xfb: // INC-SBC abs,Y
+			NEXT_OPCODE;
+			OPCODE(0xfb) // INC-SBC abs,Y
 			{
-				int16 zpaddr=AbsYAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsYAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
-			case 0xff: // INC-SBC abs,X
+			NEXT_OPCODE;
+			OPCODE(0xff) // INC-SBC abs,X
 			{
-				int16 zpaddr=AbsXAddrModeHandler_Address();
-				INCInstrHandler(zpaddr);
-				SBCInstrHandler(WholeRam[zpaddr]);
+				int16 zpaddr=CPU::AbsXAddrModeHandler_Address();
+				CPU::INCInstrHandler(zpaddr);
+				CPU::SBCInstrHandler(WholeRam[zpaddr]);
 			}
-			break;
+			NEXT_OPCODE;
 			// REALLY Undocumented instructions 6B, 8B and CB
-			case 0x6b:
-				ANDInstrHandler(WholeRam[ProgramCounter++]);
-				RORInstrHandler_Acc();
-				break;
-			case 0x8b:
+			OPCODE(0x6b)
+				CPU::ANDInstrHandler(WholeRam[ProgramCounter++]);
+				CPU::RORInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x8b)
 				Accumulator=XReg; /* TXA */
 				PSR&=~(FlagZ | FlagN);
 				PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-				ANDInstrHandler(WholeRam[ProgramCounter++]);
-				break;
-			case 0xcb:
+				CPU::ANDInstrHandler(WholeRam[ProgramCounter++]);
+				NEXT_OPCODE;
+			OPCODE(0xcb)
 				// SBX #n - I dont know if this uses the carry or not, i'm assuming its
 				// Subtract #n from X with carry.
 			{
 				unsigned char TmpAcc=Accumulator;
 				Accumulator=XReg;
-				SBCInstrHandler(WholeRam[ProgramCounter++]);
+				CPU::SBCInstrHandler(WholeRam[ProgramCounter++]);
 				XReg=Accumulator;
 				Accumulator=TmpAcc; // Fudge so that I dont have to do the whole SBC code again
 			}
-			break;
-			default:
-				BadCount++;
-				break;
-			}
-		}
-		if (OpCodes>=2) {
-			switch (CurrentInstruction) {
-			case 0x0b:
-			case 0x2b:
-				ANDInstrHandler(WholeRam[ProgramCounter++]); /* AND-MVC #n,b7 */
+			NEXT_OPCODE;
+		OPCODE_SET_END
+		OPCODE_SET_BEGIN(OpSet>=2)
+			OPCODE(0x0b)
+			OPCODE(0x2b)
+				CPU::ANDInstrHandler(WholeRam[ProgramCounter++]); /* AND-MVC #n,b7 */
 				PSR|=((Accumulator & 128)>>7);
-				break;
-			case 0x4b: /* Undocumented Instruction: AND imm and LSR A */
-				ANDInstrHandler(WholeRam[ProgramCounter++]);
-				LSRInstrHandler_Acc();
-				break;
-			case 0x87: /* Undocumented Instruction: SAX zp (i.e. (zp) = A & X) */
+				NEXT_OPCODE;
+			OPCODE(0x4b) /* Undocumented Instruction: AND imm and LSR A */
+				CPU::ANDInstrHandler(WholeRam[ProgramCounter++]);
+				CPU::LSRInstrHandler_Acc();
+				NEXT_OPCODE;
+			OPCODE(0x87) /* Undocumented Instruction: SAX zp (i.e. (zp) = A & X) */
 				/* This one does not seem to change the processor flags */
-				WholeRam[ZeroPgAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x83: /* Undocumented Instruction: SAX (zp,X) */
-				WholeRam[IndXAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x8f: /* Undocumented Instruction: SAX abs */
-				WholeRam[AbsAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x93: /* Undocumented Instruction: SAX (zp),Y */
-				WholeRam[IndYAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x97: /* Undocumented Instruction: SAX zp,Y */
-				WholeRam[ZeroPgYAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x9b: /* Undocumented Instruction: SAX abs,Y */
-				WholeRam[AbsYAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0x9f: /* Undocumented Instruction: SAX abs,X */
-				WholeRam[AbsXAddrModeHandler_Address()] = Accumulator & XReg;
-				break;
-			case 0xab: /* Undocumented Instruction: LAX #n */
-				LDAInstrHandler(WholeRam[ProgramCounter++]);
+				WholeRam[CPU::ZeroPgAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x83) /* Undocumented Instruction: SAX (zp,X) */
+				WholeRam[CPU::IndXAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x8f) /* Undocumented Instruction: SAX abs */
+				WholeRam[CPU::AbsAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x93) /* Undocumented Instruction: SAX (zp),Y */
+				WholeRam[CPU::IndYAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x97) /* Undocumented Instruction: SAX zp,Y */
+				WholeRam[CPU::ZeroPgYAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x9b) /* Undocumented Instruction: SAX abs,Y */
+				WholeRam[CPU::AbsYAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0x9f) /* Undocumented Instruction: SAX abs,X */
+				WholeRam[CPU::AbsXAddrModeHandler_Address()] = Accumulator & XReg;
+				NEXT_OPCODE;
+			OPCODE(0xab) /* Undocumented Instruction: LAX #n */
+				CPU::LDAInstrHandler(WholeRam[ProgramCounter++]);
 				XReg = Accumulator;
-				break;
-			case 0xa3: /* Undocumented Instruction: LAX (zp,X) */
-				LDAInstrHandler(IndXAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xa3) /* Undocumented Instruction: LAX (zp,X) */
+				CPU::LDAInstrHandler(CPU::IndXAddrModeHandler_Data());
 				XReg = Accumulator;
-				break;
-			case 0xa7: /* Undocumented Instruction: LAX zp */
-				LDAInstrHandler(WholeRam[WholeRam[ProgramCounter++]]);
+				NEXT_OPCODE;
+			OPCODE(0xa7) /* Undocumented Instruction: LAX zp */
+				CPU::LDAInstrHandler(WholeRam[WholeRam[ProgramCounter++]]);
 				XReg = Accumulator;
-				break;
-			case 0xaf: /* Undocumented Instruction: LAX abs */
-				LDAInstrHandler(AbsAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xaf) /* Undocumented Instruction: LAX abs */
+				CPU::LDAInstrHandler(CPU::AbsAddrModeHandler_Data());
 				XReg = Accumulator;
-				break;
-			case 0xb3: /* Undocumented Instruction: LAX (zp),Y */
-				LDAInstrHandler(IndYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb3) /* Undocumented Instruction: LAX (zp),Y */
+				CPU::LDAInstrHandler(CPU::IndYAddrModeHandler_Data());
 				XReg = Accumulator;
-				break;
-			case 0xb7: /* Undocumented Instruction: LAX zp,Y */
-				LDXInstrHandler(ZeroPgYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xb7) /* Undocumented Instruction: LAX zp,Y */
+				CPU::LDXInstrHandler(CPU::ZeroPgYAddrModeHandler_Data());
 				Accumulator = XReg;
-				break;
-			case 0xbb:
-			case 0xbf: /* Undocumented Instruction: LAX abs,Y */
-				LDAInstrHandler(AbsYAddrModeHandler_Data());
+				NEXT_OPCODE;
+			OPCODE(0xbb)
+			OPCODE(0xbf) /* Undocumented Instruction: LAX abs,Y */
+				CPU::LDAInstrHandler(CPU::AbsYAddrModeHandler_Data());
 				XReg = Accumulator;
-				break;
-			default:
-				BadCount++;
-			}
-		}
-		if (BadCount==OpCodes)
+				NEXT_OPCODE;
+		OPCODE_SET_END
+#ifdef WITH_THREADED_6502
+	BadOpcode:
+		BadInstrHandler(CurrentInstruction);
+	OpcodeDone:
+#else
+		if (BadCount==OpSet)
 			BadInstrHandler(CurrentInstruction);
-
-		// This block corrects the cycle count for the branch instructions
-		if ((CurrentInstruction==0x10) ||
-			(CurrentInstruction==0x30) ||
-			(CurrentInstruction==0x50) ||
-			(CurrentInstruction==0x70) ||
-			(CurrentInstruction==0x80) ||
-			(CurrentInstruction==0x90) ||
-			(CurrentInstruction==0xb0) ||
-			(CurrentInstruction==0xd0) ||
-			(CurrentInstruction==0xf0))
-		{
-			if (Branched)
-			{
-				Cycles++;
-				if ((ProgramCounter & 0xff00) != ((OldPC+2) & 0xff00))
-					Cycles+=1;
-			}
-		}
+#endif
 
 		Cycles += CyclesTable[CurrentInstruction] -
 			CyclesToMemRead[CurrentInstruction] - CyclesToMemWrite[CurrentInstruction];
 
 		PollVIAs(Cycles - ViaCycles);
 		PollHardware(Cycles);
+		SliceCycles+=Cycles;
 
 		// Check for IRQ
 		DoIntCheck();
@@ -2263,6 +1712,7 @@ void Exec6502Instruction(void) {
 			DoInterrupt();
 			PollHardware(IRQCycles);
 			PollVIAs(IRQCycles);
+			SliceCycles+=IRQCycles;
 			IRQCycles=0;
 		}
 
@@ -2273,6 +1723,7 @@ void Exec6502Instruction(void) {
 			DoNMI();
 			PollHardware(IRQCycles);
 			PollVIAs(IRQCycles);
+			SliceCycles+=IRQCycles;
 			IRQCycles=0;
 		}
 		OldNMIStatus=NMIStatus;
@@ -2280,8 +1731,80 @@ void Exec6502Instruction(void) {
 		if (EnableTube)
 			SyncTubeProcessor();
 	}
+
+	TotalInstructions+=loop;
+
+	// Leave the VIAs and a threaded second processor up to date for the
+	// debugger and state saving
+	EndTubeSlice();
+	SyncVIAs();
+
+	return SliceCycles;
+} /* Exec6502Slice */
+
+/*-------------------------------------------------------------------------*/
+/* Run a slice on the build of Exec6502Slice for the opcode set in use     */
+template <int Variant> static int Exec6502OpSet(int nInstructions, int nCycles) {
+	switch (OpCodes) {
+	case 1:
+		return Exec6502Slice<Variant,1>(nInstructions, nCycles);
+	case 3:
+		return Exec6502Slice<Variant,3>(nInstructions, nCycles);
+	default:
+		return Exec6502Slice<Variant,2>(nInstructions, nCycles);
+	}
+} /* Exec6502OpSet */
+
+/*-------------------------------------------------------------------------*/
+/* Run a slice on the build of Exec6502Slice for the machine's processor   */
+static int Exec6502Machine(int nInstructions, int nCycles) {
+	// The Master's 65C12 has the CMOS instructions and bug fixes
+	if (MachineType==3)
+		return Exec6502OpSet<CPU_65C12>(nInstructions, nCycles);
+
+	return Exec6502OpSet<CPU_NMOS6502>(nInstructions, nCycles);
+} /* Exec6502Machine */
+
+/*-------------------------------------------------------------------------*/
+/* Execute a batch of 6502 instructions, move program counter on           */
+void Exec6502Instruction(void) {
+	Exec6502Machine(DebugEnabled ? 1 : 1024, 0); // Makes debug window more responsive
 } /* Exec6502Instruction */
 
+/*-------------------------------------------------------------------------*/
+/* Execute 6502 instructions for (at least) nCycles 2MHz cycles            */
+int Exec6502Cycles(int nCycles) {
+	if (DebugEnabled || nCycles <= 0)
+		return Exec6502Machine(1, 0);
+
+	return Exec6502Machine(0, nCycles);
+} /* Exec6502Cycles */
+
+
+/* The VIAs are only polled when one of their timers is about to go
+   negative, which is the first point at which SysVIA_poll or UserVIA_poll
+   do anything other than count down. Cycles run before then are saved up
+   in ViaPendingCycles, and register accesses catch up through SyncVIAs. */
+static unsigned int ViaPendingCycles=0;
+static int ViaIdleCycles=0;
+
+static void CatchUpVIAs(void)
+{
+	if (ViaPendingCycles != 0)
+	{
+		SysVIA_poll(ViaPendingCycles);
+		UserVIA_poll(ViaPendingCycles);
+		ViaPendingCycles=0;
+	}
+}
+
+void SyncVIAs(void)
+{
+	CatchUpVIAs();
+
+	// The access may reload a timer, so poll properly next time
+	ViaIdleCycles=0;
+}
 
 void PollVIAs(unsigned int nCycles)
 {
@@ -2290,17 +1813,79 @@ void PollVIAs(unsigned int nCycles)
 		if (CyclesToInt != NO_TIMER_INT_DUE)
 			CyclesToInt -= nCycles;
 
-		SysVIA_poll(nCycles);
-		UserVIA_poll(nCycles);
+		ViaPendingCycles += nCycles;
+		if ((int)ViaPendingCycles > ViaIdleCycles)
+		{
+			int UserIdle;
+
+			CatchUpVIAs();
+			ViaIdleCycles=SysVIA_IdleCycles();
+			UserIdle=UserVIA_IdleCycles();
+			if (UserIdle < ViaIdleCycles)
+				ViaIdleCycles=UserIdle;
+		}
 
 		ViaCycles += nCycles;
 	}
 }
 
+/* PollHardware only calls the device poll routines once TotalCycles reaches
+   NextHardwareEvent, the earliest of the device triggers. Cycles run in the
+   meantime are saved up in HardwareCycles and passed on at the next poll. */
+static CycleCountT NextHardwareEvent=0;
+static unsigned int HardwareCycles=0;
+
+void RescheduleHardware(void)
+{
+	NextHardwareEvent=0;
+}
+
+#define EarliestEvent(var) if ((CycleCountT)(var) < Next) Next=(CycleCountT)(var);
+
+static CycleCountT FindNextHardwareEvent(void)
+{
+	// Never run past the point where the cycle counters need wrapping
+	CycleCountT Next=CycleCountWrap+1;
+
+	// Devices that are part way through something get polled every time
+	if ((MachineType==3 || !NativeFDC) && Disc1770Active())
+		return TotalCycles;
+#ifdef WITH_ECONET
+	if (EconetEnabled && EconetStateChanged)
+		return TotalCycles;
+#endif
+
+	EarliestEvent(VideoTriggerCount);
+	if (!BHardware) {
+		EarliestEvent(AtoDTrigger);
+		EarliestEvent(Serial_NextPoll());
+	}
+	EarliestEvent(Disc8271Trigger);
+	EarliestEvent(SoundTrigger);
+#ifdef WITH_ECONET
+	if (EconetEnabled) {
+		EarliestEvent(EconetTrigger);
+		// The trigger is left behind once flag fill ends
+		if (FlagFillActive)
+			EarliestEvent(EconetFlagFillTimeoutTrigger);
+	}
+#endif
+
+	return Next;
+}
+
 void PollHardware(unsigned int nCycles)
 {
 	TotalCycles+=nCycles;
 
+	if (TotalCycles < NextHardwareEvent)
+	{
+		HardwareCycles+=nCycles;
+		return;
+	}
+	nCycles+=HardwareCycles;
+	HardwareCycles=0;
+
 	if (TotalCycles > CycleCountWrap)
 	{
 		TotalCycles -= CycleCountWrap;
@@ -2343,6 +1928,8 @@ void PollHardware(unsigned int nCycles)
 		}
 	}
 #endif
+
+	NextHardwareEvent=FindNextHardwareEvent();
 }
 
 /*-------------------------------------------------------------------------*/
@@ -56,6 +56,7 @@ extern unsigned int Cycles;
 extern int ProgramCounter;
 extern int PrePC;
 extern CycleCountT TotalCycles;
+extern unsigned long long TotalInstructions;
 extern unsigned int NMILock;
 extern int DisplayCycles;
 
@@ -73,10 +74,24 @@ extern int CyclesToInt;
 /* Initialise 6502core                                                     */
 void Init6502core(void);
 
+/*-------------------------------------------------------------------------*/
+/* Make the next PollHardware call poll every device and work out when    */
+/* the next device event is due                                            */
+void RescheduleHardware(void);
+
+/*-------------------------------------------------------------------------*/
+/* Bring the VIA timers up to date before a VIA register is accessed       */
+void SyncVIAs(void);
+
 /*-------------------------------------------------------------------------*/
 /* Execute one 6502 instruction, move program counter on                   */
 void Exec6502Instruction(void);
 
+/*-------------------------------------------------------------------------*/
+/* Execute 6502 instructions for at least nCycles 2MHz cycles, returns the */
+/* number of cycles actually executed                                      */
+int Exec6502Cycles(int nCycles);
+
 void DoNMI(void);
 void core_dumpstate(void);
 void DoInterrupt(void);
@@ -0,0 +1,678 @@
+/****************************************************************************/
+/*              Beebem - (c) David Alan Gilbert 1994                        */
+/*              ------------------------------------                        */
+/* This program may be distributed freely within the following restrictions:*/
+/*                                                                          */
+/* 1) You may not charge for this program or for any part of it.            */
+/* 2) This copyright message must be distributed with all copies.           */
+/* 3) This program must be distributed complete with source code.  Binary   */
+/*    only distribution is not permitted.                                   */
+/* 4) The author offers no warrenties, or guarentees etc. - you use it at   */
+/*    your own risk.  If it messes something up or destroys your computer   */
+/*    thats YOUR problem.                                                   */
+/* 5) You may use small sections of code from this program in your own      */
+/*    applications - but you must acknowledge its use.  If you plan to use  */
+/*    large sections then please ask the author.                            */
+/*                                                                          */
+/* If you do not agree with any of the above then please do not use this    */
+/* program.                                                                 */
+/* Please report any problems to the author at beebem@treblig.org           */
+/****************************************************************************/
+/* 6502 instruction and addressing mode handlers, shared by the host 6502  */
+/* (6502core.cpp) and the 65C02 second processor (tube.cpp).               */
+/*                                                                         */
+/* The handlers are static members of M6502<Bus,Variant,Clock>:            */
+/*                                                                         */
+/*   Bus     - the registers and memory of one processor.  Provides        */
+/*             ProgramCounter(), Accumulator(), XReg(), YReg(), StackReg() */
+/*             and PSR() returning references to its registers, Fetch()    */
+/*             for bytes of the instruction stream, Read() and Write() for */
+/*             data, and Ram() for the zero page and stack, which never    */
+/*             hold I/O.                                                   */
+/*   Variant - CPU_NMOS6502, CPU_65C12 or CPU_65C02.                       */
+/*   Clock   - the cycle accounting.  Provides Opcode() for the current    */
+/*             instruction, AddCycles() and ModifyCycles(), which runs the */
+/*             cycles between the read and the write of a read-modify-     */
+/*             write instruction.                                          */
+/*                                                                         */
+/* All of these are fixed at compile time, so each processor gets its own  */
+/* handlers with the memory accessors inlined and no run time checks on    */
+/* the machine type.                                                       */
+
+#ifndef OPS6502_HEADER
+#define OPS6502_HEADER
+
+#ifndef INLINE
+#define INLINE inline
+#endif
+
+typedef int int16;
+
+enum PSRFlags {
+  FlagC=1,
+  FlagZ=2,
+  FlagI=4,
+  FlagD=8,
+  FlagB=16,
+  FlagV=64,
+  FlagN=128
+};
+
+enum M6502Variant {
+  CPU_NMOS6502, /* BBC B and B+ */
+  CPU_65C12,    /* Master 128 */
+  CPU_65C02     /* 6502 second processor */
+};
+
+template <class Bus, int Variant, class Clock> struct M6502 {
+
+/* Set if the CMOS instructions and bug fixes are present */
+enum { CMOS = (Variant != CPU_NMOS6502) };
+
+/*----------------------------------------------------------------------------*/
+static INLINE void Carried() {
+	// Correct cycle count for indirection across page boundary
+	int CurrentInstruction=Clock::Opcode();
+
+	if (((CurrentInstruction & 0xf)==0x1 ||
+		 (CurrentInstruction & 0xf)==0x9 ||
+		 (CurrentInstruction & 0xf)==0xd) &&
+		(CurrentInstruction & 0xf0)!=0x90)
+	{
+		Clock::AddCycles(1);
+	}
+	else if (CurrentInstruction==0xBC ||
+			 CurrentInstruction==0xBE)
+	{
+		Clock::AddCycles(1);
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+static INLINE int SignExtendByte(signed char in) {
+  /*if (in & 0x80) return(in | 0xffffff00); else return(in); */
+  /* I think this should sign extend by virtue of the casts - gcc does anyway - the code
+  above will definitly do the trick */
+  return((int)in);
+} /* SignExtendByte */
+
+/*----------------------------------------------------------------------------*/
+static INLINE int GetCFlag(void) { return(Bus::PSR() & FlagC); }
+static INLINE int GetZFlag(void) { return((Bus::PSR() & FlagZ)>0); }
+static INLINE int GetDFlag(void) { return((Bus::PSR() & FlagD)>0); }
+static INLINE int GetVFlag(void) { return((Bus::PSR() & FlagV)>0); }
+static INLINE int GetNFlag(void) { return((Bus::PSR() & FlagN)>0); }
+
+/*----------------------------------------------------------------------------*/
+/* Set the Z flag if 'in' is 0, and N if bit 7 is set - leave all other bits  */
+/* untouched.                                                                 */
+static INLINE void SetPSRZN(const unsigned char in) {
+  Bus::PSR()&=~(FlagZ | FlagN);
+  Bus::PSR()|=((in==0)<<1) | (in & 128);
+} /* SetPSRZN */
+
+/*----------------------------------------------------------------------------*/
+/* Note: n is 128 for true - not 1                                            */
+static INLINE void SetPSR(int mask,int c,int z,int i,int d,int b, int v, int n) {
+  Bus::PSR()&=~mask;
+  Bus::PSR()|=c | (z<<1) | (i<<2) | (d<<3) | (b<<4) | (v<<6) | n;
+} /* SetPSR */
+
+/*----------------------------------------------------------------------------*/
+/* NOTE!!!!! n is 128 or 0 - not 1 or 0                                       */
+static INLINE void SetPSRCZN(int c,int z, int n) {
+  Bus::PSR()&=~(FlagC | FlagZ | FlagN);
+  Bus::PSR()|=c | (z<<1) | n;
+} /* SetPSRCZN */
+
+/*----------------------------------------------------------------------------*/
+static INLINE void Push(unsigned char ToPush) {
+  Bus::Ram(0x100+Bus::StackReg())=ToPush;
+  Bus::StackReg()--;
+} /* Push */
+
+/*----------------------------------------------------------------------------*/
+static INLINE unsigned char Pop(void) {
+  Bus::StackReg()++;
+  return(Bus::Ram(0x100+Bus::StackReg()));
+} /* Pop */
+
+/*----------------------------------------------------------------------------*/
+static INLINE void PushWord(int16 topush) {
+  Push((topush>>8) & 255);
+  Push(topush & 255);
+} /* PushWord */
+
+/*----------------------------------------------------------------------------*/
+static INLINE int16 PopWord() {
+  int16 RetValue;
+
+  RetValue=Pop();
+  RetValue|=(Pop()<<8);
+  return(RetValue);
+} /* PopWord */
+
+/*----------------------------------------------------------------------------*/
+/* Get a two byte address from the program counter, and then post inc the    */
+/* program counter                                                            */
+static INLINE int FetchWord(void) {
+  int &ProgramCounter=Bus::ProgramCounter();
+  int Word;
+
+  Word=Bus::Fetch(ProgramCounter);
+  Word|=(Bus::Fetch(ProgramCounter+1)<<8);
+  ProgramCounter+=2;
+  return(Word);
+} /* FetchWord */
+
+/*----------------------------------------------------------------------------*/
+/* Write the result of a read-modify-write instruction                        */
+static INLINE void ModifyMem(int16 address,unsigned char oldVal,unsigned char newVal) {
+  Clock::ModifyCycles(address,oldVal);
+  Bus::Write(address,newVal);
+} /* ModifyMem */
+
+/*-------------------------------------------------------------------------*/
+/* Relative addressing mode handler                                        */
+static INLINE int16 RelAddrModeHandler_Data(void) {
+  int &ProgramCounter=Bus::ProgramCounter();
+  int EffectiveAddress;
+
+  /* For branches - is this correct - i.e. is the program counter incremented
+     at the correct time? */
+  EffectiveAddress=SignExtendByte((signed char)Bus::Fetch(ProgramCounter++));
+  EffectiveAddress+=ProgramCounter;
+
+  return(EffectiveAddress);
+} /* RelAddrModeHandler */
+
+/*----------------------------------------------------------------------------*/
+static INLINE void ADCInstrHandler(int16 operand) {
+  /* NOTE! Not sure about C and V flags */
+  int &Accumulator=Bus::Accumulator();
+  int TmpResultV,TmpResultC;
+  if (!GetDFlag()) {
+    TmpResultC=Accumulator+operand+GetCFlag();
+    TmpResultV=(signed char)Accumulator+(signed char)operand+GetCFlag();
+    Accumulator=TmpResultC & 255;
+    SetPSR(FlagC | FlagZ | FlagV | FlagN, (TmpResultC & 256)>0,Accumulator==0,0,0,0,((Accumulator & 128)>0) ^ (TmpResultV<0),(Accumulator & 128));
+  } else {
+    int ZFlag=0,NFlag=0,CFlag=0,VFlag=0;
+    int TmpResult,TmpCarry=0;
+    int ln,hn;
+
+    /* Z flag determined from 2's compl result, not BCD result! */
+    TmpResult=Accumulator+operand+GetCFlag();
+    ZFlag=((TmpResult & 0xff)==0);
+
+    ln=(Accumulator & 0xf)+(operand & 0xf)+GetCFlag();
+    if (ln>9) {
+      ln += 6;
+      ln &= 0xf;
+      TmpCarry=0x10;
+    }
+    hn=(Accumulator & 0xf0)+(operand & 0xf0)+TmpCarry;
+    /* N and V flags are determined before high nibble is adjusted.
+       NOTE: V is not always correct */
+    NFlag=hn & 128;
+    VFlag=(hn ^ Accumulator) & 128 && !((Accumulator ^ operand) & 128);
+    if (hn>0x90) {
+      hn += 0x60;
+      hn &= 0xf0;
+      CFlag=1;
+    }
+    Accumulator=hn|ln;
+	ZFlag=(Accumulator==0);
+	NFlag=(Accumulator&128);
+    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
+  }
+} /* ADCInstrHandler */
+
+/*----------------------------------------------------------------------------*/
+static INLINE void ANDInstrHandler(int16 operand) {
+  Bus::Accumulator()=Bus::Accumulator() & operand;
+  SetPSRZN(Bus::Accumulator());
+} /* ANDInstrHandler */
+
+static INLINE void ASLInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+  oldVal=Bus::Read(address);
+  newVal=(((unsigned int)oldVal)<<1) & 254;
+  ModifyMem(address,oldVal,newVal);
+  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
+} /* ASLInstrHandler */
+
+static INLINE void TRBInstrHandler(int16 address) {
+	unsigned char oldVal,newVal;
+	oldVal=Bus::Read(address);
+	newVal=(Bus::Accumulator() ^ 255) & oldVal;
+	Bus::Write(address,newVal);
+	Bus::PSR()&=253;
+	Bus::PSR()|=((Bus::Accumulator() & oldVal)==0) ? 2 : 0;
+} // TRBInstrHandler
+
+static INLINE void TSBInstrHandler(int16 address) {
+	unsigned char oldVal,newVal;
+	oldVal=Bus::Read(address);
+	newVal=Bus::Accumulator() | oldVal;
+	Bus::Write(address,newVal);
+	Bus::PSR()&=253;
+	Bus::PSR()|=((Bus::Accumulator() & oldVal)==0) ? 2 : 0;
+} // TSBInstrHandler
+
+static INLINE void ASLInstrHandler_Acc(void) {
+  unsigned char oldVal,newVal;
+  /* Accumulator */
+  oldVal=Bus::Accumulator();
+  Bus::Accumulator()=newVal=(((unsigned int)oldVal)<<1) & 254;
+  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
+} /* ASLInstrHandler_Acc */
+
+/* Take a relative branch. A taken branch costs one extra cycle, and a */
+/* second one if the destination is in a different page to the next    */
+/* instruction.                                                        */
+static INLINE void BranchTaken(void) {
+  int &ProgramCounter=Bus::ProgramCounter();
+  int NextPC=ProgramCounter+1;
+
+  ProgramCounter=RelAddrModeHandler_Data();
+  Clock::AddCycles(1);
+  if ((ProgramCounter & 0xff00) != (NextPC & 0xff00))
+    Clock::AddCycles(1);
+} /* BranchTaken */
+
+/* Branch if cond, otherwise step over the offset */
+static INLINE void BranchIf(int cond) {
+  if (cond) {
+    BranchTaken();
+  } else Bus::ProgramCounter()++;
+} /* BranchIf */
+
+static INLINE void BCCInstrHandler(void) { BranchIf(!GetCFlag()); }
+static INLINE void BCSInstrHandler(void) { BranchIf(GetCFlag()); }
+static INLINE void BEQInstrHandler(void) { BranchIf(GetZFlag()); }
+static INLINE void BMIInstrHandler(void) { BranchIf(GetNFlag()); }
+static INLINE void BNEInstrHandler(void) { BranchIf(!GetZFlag()); }
+static INLINE void BPLInstrHandler(void) { BranchIf(!GetNFlag()); }
+static INLINE void BVCInstrHandler(void) { BranchIf(!GetVFlag()); }
+static INLINE void BVSInstrHandler(void) { BranchIf(GetVFlag()); }
+static INLINE void BRAInstrHandler(void) { BranchTaken(); }
+
+static INLINE void BITInstrHandler(int16 operand) {
+  Bus::PSR()&=~(FlagZ | FlagN | FlagV);
+  /* z if result 0, and NV to top bits of operand */
+  Bus::PSR()|=(((Bus::Accumulator() & operand)==0)<<1) | (operand & 192);
+} /* BITInstrHandler */
+
+static INLINE void CMPInstrHandler(int16 operand) {
+  /* NOTE! Should we consult D flag ? */
+  int Accumulator=Bus::Accumulator();
+  unsigned char result=Accumulator-operand;
+  unsigned char CFlag;
+  CFlag=0; if (Accumulator>=operand) CFlag=FlagC;
+  SetPSRCZN(CFlag,Accumulator==operand,result & 128);
+} /* CMPInstrHandler */
+
+static INLINE void CPXInstrHandler(int16 operand) {
+  int XReg=Bus::XReg();
+  unsigned char result=(XReg-operand);
+  SetPSRCZN(XReg>=operand,XReg==operand,result & 128);
+} /* CPXInstrHandler */
+
+static INLINE void CPYInstrHandler(int16 operand) {
+  int YReg=Bus::YReg();
+  unsigned char result=(YReg-operand);
+  SetPSRCZN(YReg>=operand,YReg==operand,result & 128);
+} /* CPYInstrHandler */
+
+static INLINE void DECInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Read(address);
+  newVal=(oldVal-1);
+  ModifyMem(address,oldVal,newVal);
+  SetPSRZN(newVal);
+} /* DECInstrHandler */
+
+static INLINE void DEXInstrHandler(void) {
+  Bus::XReg()=(Bus::XReg()-1) & 255;
+  SetPSRZN(Bus::XReg());
+} /* DEXInstrHandler */
+
+static INLINE void DEAInstrHandler(void) {
+  Bus::Accumulator()=(Bus::Accumulator()-1) & 255;
+  SetPSRZN(Bus::Accumulator());
+} /* DEAInstrHandler */
+
+static INLINE void EORInstrHandler(int16 operand) {
+  Bus::Accumulator()^=operand;
+  SetPSRZN(Bus::Accumulator());
+} /* EORInstrHandler */
+
+static INLINE void INCInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Read(address);
+  newVal=(oldVal+1) & 255;
+  ModifyMem(address,oldVal,newVal);
+  SetPSRZN(newVal);
+} /* INCInstrHandler */
+
+static INLINE void INXInstrHandler(void) {
+  Bus::XReg()=(Bus::XReg()+1) & 255;
+  SetPSRZN(Bus::XReg());
+} /* INXInstrHandler */
+
+static INLINE void INAInstrHandler(void) {
+  Bus::Accumulator()=(Bus::Accumulator()+1) & 255;
+  SetPSRZN(Bus::Accumulator());
+} /* INAInstrHandler */
+
+static INLINE void JSRInstrHandler(int16 address) {
+  PushWord(Bus::ProgramCounter()-1);
+  Bus::ProgramCounter()=address;
+} /* JSRInstrHandler */
+
+static INLINE void LDAInstrHandler(int16 operand) {
+  Bus::Accumulator()=operand;
+  SetPSRZN(operand);
+} /* LDAInstrHandler */
+
+static INLINE void LDXInstrHandler(int16 operand) {
+  Bus::XReg()=operand;
+  SetPSRZN(operand);
+} /* LDXInstrHandler */
+
+static INLINE void LDYInstrHandler(int16 operand) {
+  Bus::YReg()=operand;
+  SetPSRZN(operand);
+} /* LDYInstrHandler */
+
+static INLINE void LSRInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+  oldVal=Bus::Read(address);
+  newVal=(((unsigned int)oldVal)>>1) & 127;
+  ModifyMem(address,oldVal,newVal);
+  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
+} /* LSRInstrHandler */
+
+static INLINE void LSRInstrHandler_Acc(void) {
+  unsigned char oldVal,newVal;
+  /* Accumulator */
+  oldVal=Bus::Accumulator();
+  Bus::Accumulator()=newVal=(((unsigned int)oldVal)>>1) & 127;
+  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
+} /* LSRInstrHandler_Acc */
+
+static INLINE void ORAInstrHandler(int16 operand) {
+  Bus::Accumulator()=Bus::Accumulator() | operand;
+  SetPSRZN(Bus::Accumulator());
+} /* ORAInstrHandler */
+
+static INLINE void ROLInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Read(address);
+  newVal=((unsigned int)oldVal<<1) & 254;
+  newVal+=GetCFlag();
+  ModifyMem(address,oldVal,newVal);
+  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
+} /* ROLInstrHandler */
+
+static INLINE void ROLInstrHandler_Acc(void) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Accumulator();
+  newVal=((unsigned int)oldVal<<1) & 254;
+  newVal+=GetCFlag();
+  Bus::Accumulator()=newVal;
+  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
+} /* ROLInstrHandler_Acc */
+
+static INLINE void RORInstrHandler(int16 address) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Read(address);
+  newVal=((unsigned int)oldVal>>1) & 127;
+  newVal+=GetCFlag()*128;
+  ModifyMem(address,oldVal,newVal);
+  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
+} /* RORInstrHandler */
+
+static INLINE void RORInstrHandler_Acc(void) {
+  unsigned char oldVal,newVal;
+
+  oldVal=Bus::Accumulator();
+  newVal=((unsigned int)oldVal>>1) & 127;
+  newVal+=GetCFlag()*128;
+  Bus::Accumulator()=newVal;
+  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
+} /* RORInstrHandler_Acc */
+
+static INLINE void SBCInstrHandler(int16 operand) {
+  /* NOTE! Not sure about C and V flags */
+  int &Accumulator=Bus::Accumulator();
+  int TmpResultV,TmpResultC;
+  if (!GetDFlag()) {
+    TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GetCFlag());
+    TmpResultC=Accumulator-operand-(1-GetCFlag());
+    Accumulator=TmpResultC & 255;
+    SetPSR(FlagC | FlagZ | FlagV | FlagN, TmpResultC>=0,Accumulator==0,0,0,0,
+      ((Accumulator & 128)>0) ^ ((TmpResultV & 256)!=0),(Accumulator & 128));
+  } else {
+    int ZFlag=0,NFlag=0,CFlag=1,VFlag=0;
+    int TmpResult,TmpCarry=0;
+    int ln,hn,oln,ohn;
+
+    /* Z flag determined from 2's compl result, not BCD result! */
+    TmpResult=Accumulator-operand-(1-GetCFlag());
+    ZFlag=((TmpResult & 0xff)==0);
+
+	ohn=operand & 0xf0; oln = operand & 0xf;
+	if ((oln>9) && ((Accumulator&15)<10)) { oln-=10; ohn+=0x10; }
+	// promote the lower nibble to the next ten, and increase the higher nibble
+    ln=(Accumulator & 0xf)-oln-(1-GetCFlag());
+    if (ln<0) {
+	  if ((Accumulator & 15)<10) ln-=6;
+      ln&=0xf;
+      TmpCarry=0x10;
+    }
+    hn=(Accumulator & 0xf0)-ohn-TmpCarry;
+    /* N and V flags are determined before high nibble is adjusted.
+       NOTE: V is not always correct */
+    NFlag=hn & 128;
+	TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GetCFlag());
+	if ((TmpResultV<-128)||(TmpResultV>127)) VFlag=1; else VFlag=0;
+    if (hn<0) {
+      hn-=0x60;
+      hn&=0xf0;
+      CFlag=0;
+    }
+    Accumulator=hn|ln;
+	if (Accumulator==0) ZFlag=1;
+	NFlag=(hn &128);
+	CFlag=(TmpResult&256)==0;
+    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
+  }
+} /* SBCInstrHandler */
+
+static INLINE void STXInstrHandler(int16 address) {
+  Bus::Write(address,Bus::XReg());
+} /* STXInstrHandler */
+
+static INLINE void STYInstrHandler(int16 address) {
+  Bus::Write(address,Bus::YReg());
+} /* STYInstrHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute  addressing mode handler                                       */
+static INLINE int16 AbsAddrModeHandler_Data(void) {
+  /* Get the address from after the instruction, and then read it */
+  return(Bus::Read(FetchWord()));
+} /* AbsAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute  addressing mode handler                                       */
+static INLINE int16 AbsAddrModeHandler_Address(void) {
+  return(FetchWord());
+} /* AbsAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page addressing mode handler                                       */
+static INLINE int16 ZeroPgAddrModeHandler_Address(void) {
+  return(Bus::Fetch(Bus::ProgramCounter()++));
+} /* ZeroPgAddrModeHandler_Address */
+
+/*-------------------------------------------------------------------------*/
+/* Indexed with X preinc addressing mode handler                           */
+static INLINE int16 IndXAddrModeHandler_Address(void) {
+  unsigned char ZeroPageAddress;
+  int EffectiveAddress;
+
+  ZeroPageAddress=(Bus::Fetch(Bus::ProgramCounter()++)+Bus::XReg()) & 255;
+
+  EffectiveAddress=Bus::Ram(ZeroPageAddress) | (Bus::Ram(ZeroPageAddress+1)<<8);
+  return(EffectiveAddress);
+} /* IndXAddrModeHandler_Address */
+
+/*-------------------------------------------------------------------------*/
+/* Indexed with X preinc addressing mode handler                           */
+static INLINE int16 IndXAddrModeHandler_Data(void) {
+  return(Bus::Read(IndXAddrModeHandler_Address()));
+} /* IndXAddrModeHandler_Data */
+
+/*-------------------------------------------------------------------------*/
+/* Indexed with Y postinc addressing mode handler                          */
+static INLINE int16 IndYAddrModeHandler_Address(void) {
+  int EffectiveAddress;
+  unsigned char ZPAddr=Bus::Fetch(Bus::ProgramCounter()++);
+  EffectiveAddress=Bus::Ram(ZPAddr)+Bus::YReg();
+  if (EffectiveAddress>0xff) Carried();
+  EffectiveAddress+=(Bus::Ram(ZPAddr+1)<<8);
+  EffectiveAddress&=0xffff;
+
+  return(EffectiveAddress);
+} /* IndYAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Indexed with Y postinc addressing mode handler                          */
+static INLINE int16 IndYAddrModeHandler_Data(void) {
+  return(Bus::Read(IndYAddrModeHandler_Address()));
+} /* IndYAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page wih X offset addressing mode handler                          */
+static INLINE int16 ZeroPgXAddrModeHandler_Address(void) {
+  return((Bus::Fetch(Bus::ProgramCounter()++)+Bus::XReg()) & 255);
+} /* ZeroPgXAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page wih X offset addressing mode handler                          */
+static INLINE int16 ZeroPgXAddrModeHandler_Data(void) {
+  return(Bus::Ram(ZeroPgXAddrModeHandler_Address()));
+} /* ZeroPgXAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute with X offset addressing mode handler                          */
+static INLINE int16 AbsXAddrModeHandler_Address(void) {
+  int EffectiveAddress;
+  EffectiveAddress=FetchWord();
+  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+Bus::XReg()) & 0xff00)) Carried();
+  EffectiveAddress+=Bus::XReg();
+  EffectiveAddress&=0xffff;
+
+  return(EffectiveAddress);
+} /* AbsXAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute with X offset addressing mode handler                          */
+static INLINE int16 AbsXAddrModeHandler_Data(void) {
+  return(Bus::Read(AbsXAddrModeHandler_Address()));
+} /* AbsXAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute with Y offset addressing mode handler                          */
+static INLINE int16 AbsYAddrModeHandler_Address(void) {
+  int EffectiveAddress;
+  EffectiveAddress=FetchWord();
+  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+Bus::YReg()) & 0xff00)) Carried();
+  EffectiveAddress+=Bus::YReg();
+  EffectiveAddress&=0xffff;
+
+  return(EffectiveAddress);
+} /* AbsYAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Absolute with Y offset addressing mode handler                          */
+static INLINE int16 AbsYAddrModeHandler_Data(void) {
+  return(Bus::Read(AbsYAddrModeHandler_Address()));
+} /* AbsYAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Indirect addressing mode handler                                        */
+static INLINE int16 IndAddrModeHandler_Address(void) {
+  /* For jump indirect only */
+  int VectorLocation;
+  int EffectiveAddress;
+
+  VectorLocation=FetchWord();
+
+  /* Ok kiddies, deliberate bug time.
+  According to my BBC Master Reference Manual Part 2
+  the 6502 has a bug concerning this addressing mode and VectorLocation==xxFF
+  so, we're going to emulate that bug -- Richard Gellman */
+  if ((VectorLocation & 0xff)!=0xff || CMOS) {
+   EffectiveAddress=Bus::Read(VectorLocation);
+   EffectiveAddress|=Bus::Read(VectorLocation+1) << 8; }
+  else {
+   EffectiveAddress=Bus::Read(VectorLocation);
+   EffectiveAddress|=Bus::Read(VectorLocation-255) << 8;
+  }
+  return(EffectiveAddress);
+} /* IndAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page Indirect addressing mode handler                              */
+static INLINE int16 ZPIndAddrModeHandler_Address(void) {
+  int VectorLocation;
+
+  VectorLocation=Bus::Fetch(Bus::ProgramCounter()++);
+  return(Bus::Ram(VectorLocation)+(Bus::Ram(VectorLocation+1)<<8));
+} /* ZPIndAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page Indirect addressing mode handler                              */
+static INLINE int16 ZPIndAddrModeHandler_Data(void) {
+  return(Bus::Read(ZPIndAddrModeHandler_Address()));
+} /* ZPIndAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Pre-indexed absolute Indirect addressing mode handler                   */
+static INLINE int16 IndAddrXModeHandler_Address(void) {
+  /* For jump indirect only */
+  int VectorLocation;
+  int EffectiveAddress;
+
+  VectorLocation=FetchWord();
+
+  EffectiveAddress=Bus::Read(VectorLocation+Bus::XReg());
+  EffectiveAddress|=Bus::Read(VectorLocation+1+Bus::XReg()) << 8;
+  EffectiveAddress&=0xffff;
+  return(EffectiveAddress);
+} /* IndAddrXModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page with Y offset addressing mode handler                         */
+static INLINE int16 ZeroPgYAddrModeHandler_Address(void) {
+  return((Bus::Fetch(Bus::ProgramCounter()++)+Bus::YReg()) & 255);
+} /* ZeroPgYAddrModeHandler */
+
+/*-------------------------------------------------------------------------*/
+/* Zero page with Y offset addressing mode handler                         */
+static INLINE int16 ZeroPgYAddrModeHandler_Data(void) {
+  return(Bus::Ram(ZeroPgYAddrModeHandler_Address()));
+} /* ZeroPgYAddrModeHandler */
+
+}; /* M6502 */
+
+#endif
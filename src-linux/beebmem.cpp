@@ -219,9 +219,116 @@ char *BeebMemPtrWithWrapMo7(int a, int n) {
 }; // BeebMemPtrWithWrapMo7
 
 
+/*----------------------------------------------------------------------------*/
+/* Per page memory maps for BeebReadMem/BeebWriteMem. Each entry points to the
+   256 bytes backing that page of the 6502 address space, or is NULL if the
+   page has to go through the slow path (I/O, ROM writes and shadow RAM that
+   depends on where the code doing the access is running from).
+   Rebuilt by UpdateMemMap whenever ROMSEL, ACCCON or the Integra-B latches
+   change so normal RAM/ROM accesses don't need to test the machine type. */
+static unsigned char *MemReadMap[256];
+static unsigned char *MemWriteMap[256];
+
+static void MapPages(unsigned char **Map, int FirstPage, int LastPage, unsigned char *Mem) {
+	int Page;
+
+	for (Page=FirstPage; Page<=LastPage; Page++) {
+		Map[Page]=(Mem!=NULL) ? Mem+((Page-FirstPage)<<8) : NULL;
+	}
+}
+
+static void UpdateMemMap(void) {
+	unsigned char *Rom=Roms[ROMSEL];
+
+	MapPages(MemReadMap,0x00,0xff,NULL);
+	MapPages(MemWriteMap,0x00,0xff,NULL);
+
+	MapPages(MemReadMap,0x00,0x2f,WholeRam);
+	MapPages(MemWriteMap,0x00,0x2f,WholeRam);
+	MapPages(MemReadMap,0x80,0xbf,Rom);
+	MapPages(MemReadMap,0xff,0xff,WholeRam+0xff00);
+
+	switch (MachineType) {
+	case 0:
+		MapPages(MemReadMap,0x30,0x7f,WholeRam+0x3000);
+		MapPages(MemWriteMap,0x30,0x7f,WholeRam+0x3000);
+		MapPages(MemReadMap,0xc0,0xfb,WholeRam+0xc000);
+		break;
+
+	case 1:
+		if ((ShEn==1) && (MemSel==0)) {
+			MapPages(MemReadMap,0x30,0x7f,ShadowRam);
+			MapPages(MemWriteMap,0x30,0x7f,ShadowRam);
+		} else {
+			MapPages(MemReadMap,0x30,0x7f,WholeRam+0x3000);
+			MapPages(MemWriteMap,0x30,0x7f,WholeRam+0x3000);
+		}
+		if (PrvEn==1) {
+			if (Prvs8==1 || Prvs4==1) {
+				MapPages(MemReadMap,0x80,0x83,Private);
+				MapPages(MemWriteMap,0x80,0x83,Private);
+			}
+			if (Prvs4==1) {
+				MapPages(MemReadMap,0x84,0x8f,Private+0x400);
+				MapPages(MemWriteMap,0x84,0x8f,Private+0x400);
+			}
+			if (Prvs1==1) {
+				MapPages(MemReadMap,0x90,0xaf,Private+0x1000);
+				MapPages(MemWriteMap,0x90,0xaf,Private+0x1000);
+			}
+		}
+		MapPages(MemReadMap,0xc0,0xfb,WholeRam+0xc000);
+		break;
+
+	case 2:
+		// Shadow RAM accesses depend on PrePC so have to take the slow path
+		if (Sh_Display==0) {
+			MapPages(MemReadMap,0x30,0x7f,WholeRam+0x3000);
+			MapPages(MemWriteMap,0x30,0x7f,WholeRam+0x3000);
+		}
+		if (MemSel==1) {
+			MapPages(MemReadMap,0x80,0xaf,Private);
+			MapPages(MemWriteMap,0x80,0xaf,Private);
+		}
+		MapPages(MemReadMap,0xc0,0xfb,WholeRam+0xc000);
+		break;
+
+	case 3:
+		// Sh_CPUE alone depends on PrePC so has to take the slow path
+		if (Sh_CPUX) {
+			MapPages(MemReadMap,0x30,0x7f,ShadowRAM+0x3000);
+			MapPages(MemWriteMap,0x30,0x7f,ShadowRAM+0x3000);
+		} else if (!Sh_CPUE) {
+			MapPages(MemReadMap,0x30,0x7f,WholeRam+0x3000);
+			MapPages(MemWriteMap,0x30,0x7f,WholeRam+0x3000);
+		}
+		if (PRAM>0) {
+			MapPages(MemReadMap,0x80,0x8f,PrivateRAM);
+			MapPages(MemWriteMap,0x80,0x8f,PrivateRAM);
+		}
+		if (FRAM) {
+			MapPages(MemReadMap,0xc0,0xdf,FSRam);
+			MapPages(MemWriteMap,0xc0,0xdf,FSRam);
+		} else {
+			MapPages(MemReadMap,0xc0,0xdf,WholeRam+0xc000);
+		}
+		MapPages(MemReadMap,0xe0,0xfb,WholeRam+0xe000);
+		break;
+	}
+} /* UpdateMemMap */
+
 /*----------------------------------------------------------------------------*/
 int BeebReadMem(int Address) {
 	int Value = 0xff;
+	unsigned char *Page = MemReadMap[(Address>>8) & 0xff];
+
+	// Plain RAM or ROM
+	if (Page!=NULL)
+		return(Page[Address & 0xff]);
+
+	// I/O accesses can change when devices next need polling
+	if (Address>=0xfc00 && Address<0xff00)
+		RescheduleHardware();
 
 // BBC B Start
   if (MachineType==0) {
@@ -495,6 +602,7 @@ static void DoRomChange(int NewBank) {
   if (MachineType!=3) {
     NewBank&=0xf; // strip top bit if Model B
     PagedRomReg=NewBank;
+    UpdateMemMap();
 	return;
   };
 
@@ -504,6 +612,7 @@ static void DoRomChange(int NewBank) {
 	  PRAM=(PagedRomReg & 128);
   }
 
+  UpdateMemMap();
 }; /* DoRomChange */
 /*----------------------------------------------------------------------------*/
 static void FiddleACCCON(unsigned char newValue) {
@@ -520,12 +629,24 @@ static void FiddleACCCON(unsigned char newValue) {
 	Sh_CPUX=ACCCON & 4;
 	Sh_CPUE=ACCCON & 2;
 	FRAM=ACCCON & 8;
+	UpdateMemMap();
 }
 /*----------------------------------------------------------------------------*/
 void BeebWriteMem(int Address, int Value) {
   	unsigned char oldshd;
+	unsigned char *Page = MemWriteMap[(Address>>8) & 0xff];
 /*  fprintf(stderr,"Write %x to 0x%x\n",Value,Address); */
 
+	// Plain RAM
+	if (Page!=NULL) {
+		Page[Address & 0xff]=Value;
+		return;
+	}
+
+	// I/O accesses can change when devices next need polling
+	if (Address>=0xfc00 && Address<0xff00)
+		RescheduleHardware();
+
 // BBC B Start
     if (MachineType==0) {
 	 if (Address<0x8000) {
@@ -579,9 +700,9 @@ void BeebWriteMem(int Address, int Value) {
 	 }
 
 	 if (Address==0xfe30) {
-		 DoRomChange(Value);
 		 MemSel = ((Value & 0x80)/0x80);
 		 PrvEn = ((Value & 0x40)/0x40);
+		 DoRomChange(Value);
 		 return;
 	 }
 	 
@@ -590,6 +711,7 @@ void BeebWriteMem(int Address, int Value) {
 		 Prvs1=((Value &0x10)/0x10);
 		 Prvs4=((Value &0x20)/0x20);
 		 Prvs8=((Value &0x40)/0x40);
+		 UpdateMemMap();
 		 return;
 	 }
 
@@ -675,8 +797,8 @@ void BeebWriteMem(int Address, int Value) {
 	 }
 
 	 if (Address>=0xfe30 && Address<0xfe34) {
-		 DoRomChange(Value);
 		 MemSel = ((Value & 0x80)/0x80);
+		 DoRomChange(Value);
 		 return;
 	 }
 	 
@@ -684,6 +806,7 @@ void BeebWriteMem(int Address, int Value) {
 		 oldshd=Sh_Display;
 		 Sh_Display=((Value &0x80)/0x80);
 		 if (Sh_Display!=oldshd) RedoMPTR();
+		 UpdateMemMap();
 		 return;
 	 }
 	}
@@ -1172,6 +1295,7 @@ void BeebMemInit(unsigned char LoadRoms,unsigned char SkipIntegraBConfig) {
   /* Put first ROM in */
   memcpy(WholeRam+0x8000,Roms[0xf],0x4000);
   PagedRomReg=0xf;
+  UpdateMemMap();
 
   // This CMOS stuff can be done anyway
   // Ah, bug with cmos.ram you say?	
@@ -1308,6 +1432,7 @@ void LoadRomRegsUEF(FILE *SUEF) {
 		FRAM=ACCCON & 8;
 		break;
 	}
+	UpdateMemMap();
 }
 
 void LoadMainMemUEF(FILE *SUEF) {
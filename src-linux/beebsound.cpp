@@ -79,8 +79,8 @@ int SoundSampleRate = PREFSAMPLERATE;
 int SoundVolume = 3;
 int SoundAutoTriggerTime;
 int SoundBufferSize,TSoundBufferSize;
-double CSC[4]={0,0,0,0},CSA[4]={0,0,0,0}; // ChangeSamps Adjusts
 char SoundExponentialVolume = 1;
+int SoundOversample = 1;
 
 /* Number of places to shift the volume */
 #define VOLMAG 3
@@ -98,7 +98,6 @@ FILE *sndlog=NULL;
 volatile struct BeebState {
 //<-
   unsigned int ToneFreq[4];
-  unsigned int ChangeSamps[4]; /* How often this channel should flip its otuput */
   unsigned int ToneVolume[4]; /* In units of /dev/dsp */
   struct {
     unsigned int FB:1; /* =0 for periodic, =1 for white */
@@ -122,13 +121,25 @@ __int64 SoundTrigger; /* Time to trigger a sound event */
 __int64 SoundTrigger2,STCycles; // BBC's Clock count for triggering host clock adjust
 int ASoundTrigger; // CPU cycle equivalent to trigger recalculation;
 
-static unsigned int GenIndex[4]; /* Used by the voice generators */
+/* Fixed point used for the generator periods */
+#define SOUND_FRAC_BITS 16
+#define SOUND_FRAC_ONE (1<<SOUND_FRAC_BITS)
+
+/* The noise generator is a 15 bit LFSR, set to this on a noise control write */
+#define NOISE_LFSR_BITS 15
+#define NOISE_LFSR_RESET (1<<(NOISE_LFSR_BITS-1))
+
+static unsigned int GenIndex[4]; /* Used by the voice generators, 16.16 samples into the current period */
 static int GenState[4];
+static unsigned int HalfPeriod[4]; /* Samples between flips of each tone output, 16.16 */
+static unsigned int NoisePeriod[3]; /* Samples between noise shifts for the three fixed rates, 16.16 */
+static unsigned int NoiseShiftReg=NOISE_LFSR_RESET;
 static int bufptr=0;
 int SoundDefault;
 double SoundTuning=0.0; // Tunning offset
 
 void PlayUpTil(double DestTime);
+static void SetSoundRates(void);
 int GetVol(int vol);
 BOOL bReRead=FALSE;
 volatile BOOL bDoSound=TRUE;
@@ -251,10 +262,141 @@ void MuteSound(void) {
 	Playing=FALSE;
 }
 
+/****************************************************************************/
+/* Block renderer for the 76489.
+   The registers stay put for the length of each PlayUpTil call, so rather
+   than working a sample at a time each channel is drawn as runs of samples.
+   A tone channel is a series of constant runs between output flips and the
+   noise channel a series of constant runs between shifts of its LFSR.  The
+   run loops have no dependencies between samples so the compiler can
+   vectorise them.
+
+   Periods are held in 16.16 fixed point samples at the internal rate, which
+   is SoundOversample times the output rate.  When oversampling, the internal
+   buffer is decimated to the output rate with a box filter. */
+
+/* Render the chip into MixBuf, up to this many internal samples at once */
+#define SOUND_BLOCK_SIZE 512
+
+static int MixBuf[SOUND_BLOCK_SIZE]; /* Chip output at the internal rate */
+static int ChipBuf[MAXBUFSIZE]; /* Chip output at the output rate */
+
+/* Add a constant run to the mix */
+static void MixRun(int *mix, int len, int val) {
+	for (int i=0;i<len;i++)
+		mix[i]+=val;
+}
+
+/* Advance a generator by some samples, returns how many times its output
+   flipped (or its LFSR shifted) */
+static unsigned int StepGen(int channel, int len, unsigned int period) {
+	unsigned int flips;
+
+	GenIndex[channel]+=(unsigned int)len<<SOUND_FRAC_BITS;
+	if (GenIndex[channel]<period)
+		return 0;
+	flips=GenIndex[channel]/period;
+	GenIndex[channel]-=flips*period;
+	return flips;
+}
+
+/* Samples until a generator next changes, at least one */
+static int SamplesToChange(int channel, unsigned int period) {
+	if (GenIndex[channel]>=period) return 1; /* The period just got shorter */
+	return (int)((period-GenIndex[channel]+SOUND_FRAC_ONE-1)>>SOUND_FRAC_BITS);
+}
+
+static void RenderTone(int *mix, int len, int channel) {
+	int vol=BeebState76489.ToneVolume[channel];
+	unsigned int period=HalfPeriod[channel];
+	int pos,run;
+
+	if (Speech[channel]) {
+		/* Too high to hear - the OS uses this for speech style output
+		   by modulating the volume */
+		MixRun(mix,len,vol-GetVol(7));
+		return;
+	}
+
+	for (pos=0;pos<len;pos+=run) {
+		run=SamplesToChange(channel,period);
+		if (run>len-pos) run=len-pos;
+		MixRun(mix+pos,run,GenState[channel] ? vol : -vol);
+		GenState[channel]^=StepGen(channel,run,period) & 1;
+	}
+}
+
+/* Shift the noise LFSR once, as the real chip does.  White noise taps
+   bits 0 and 1, periodic noise just rotates bit 0 round. */
+static void ShiftNoise(void) {
+	unsigned int fb;
+
+	if (BeebState76489.Noise.FB)
+		fb=(NoiseShiftReg ^ (NoiseShiftReg>>1)) & 1;
+	else
+		fb=NoiseShiftReg & 1;
+	NoiseShiftReg=(NoiseShiftReg>>1) | (fb<<(NOISE_LFSR_BITS-1));
+}
+
+static void RenderNoise(int *mix, int len) {
+	int vol=BeebState76489.ToneVolume[0];
+	unsigned int period,shifts;
+	int pos,run;
+
+	/* The LFSR shifts once per cycle of its clock, which is either a fixed
+	   divider or tone generator 1 */
+	if (BeebState76489.Noise.Freq==3)
+		period=HalfPeriod[1]*2;
+	else
+		period=NoisePeriod[BeebState76489.Noise.Freq];
+
+	for (pos=0;pos<len;pos+=run) {
+		run=SamplesToChange(0,period);
+		if (run>len-pos) run=len-pos;
+		MixRun(mix+pos,run,(NoiseShiftReg & 1) ? vol : -vol);
+		for (shifts=StepGen(0,run,period);shifts>0;shifts--)
+			ShiftNoise();
+	}
+	GenState[0]=NoiseShiftReg & 1;
+}
+
+/* Render len output samples of the chip into mix */
+static void RenderChip(int *mix, int len) {
+	int *out=mix;
+	int os=SoundOversample;
+	int block,channel,i,j,total;
+
+	if (os>1) out=MixBuf;
+
+	while (len>0) {
+		block=len;
+		if (block*os>SOUND_BLOCK_SIZE) block=SOUND_BLOCK_SIZE/os;
+		if (os>1) memset(out,0,block*os*sizeof(int));
+
+		if (SoundChipEnabled) {
+			for(channel=1;channel<=3;channel++)
+				if (ActiveChannel[channel]) RenderTone(out,block*os,channel);
+			if (ActiveChannel[0]) RenderNoise(out,block*os);
+		}
+
+		if (os>1) {
+			/* Decimate to the output rate */
+			for (i=0;i<block;i++) {
+				total=0;
+				for (j=0;j<os;j++)
+					total+=out[i*os+j];
+				mix[i]=total/os;
+			}
+		}
+		mix+=block; len-=block;
+		if (os==1) out=mix;
+	}
+}
+
 /****************************************************************************/
 /* DestTime is in samples */
 void PlayUpTil(double DestTime) {
-	int tmptotal,channel,bufinc,tapetotal;
+	int tmptotal,bufinc,tapetotal,i;
 	char Extras;
 	int SpeechPtr = 0;
 
@@ -269,139 +411,16 @@ void PlayUpTil(double DestTime) {
 	}
 
 	while (DestTime>OurTime) {
-		for(bufinc=0;(bufptr<SoundBufferSize) && ((OurTime+bufinc)<DestTime);bufptr++,bufinc++) {
-			int tt;
-			tmptotal=0;
-			Extras=4;
+		/* As many samples as fit in the buffer, up to DestTime */
+		bufinc=(int)ceil(DestTime-OurTime);
+		if (bufinc>SoundBufferSize-bufptr) bufinc=SoundBufferSize-bufptr;
 
-			if (SoundChipEnabled) {
-				// Begin of for loop
-				for(channel=1;channel<=3;channel++) {
-					if (ActiveChannel[channel]) {
-						if ((GenState[channel]) && (!Speech[channel]))
-							tmptotal+=BeebState76489.ToneVolume[channel];
-						if ((!GenState[channel]) && (!Speech[channel]))
-							tmptotal-=BeebState76489.ToneVolume[channel];
-						if (Speech[channel])
-							tmptotal+=(BeebState76489.ToneVolume[channel]-GetVol(7));
-						GenIndex[channel]++;
-						tt=(int)CSC[channel];
-						if (!PartSamples) tt=0;
-						if (GenIndex[channel]>=(BeebState76489.ChangeSamps[channel]+tt)) {
-							if (CSC[channel] >= 1.0)
-								CSC[channel]-=1.0;
-							CSC[channel]+=CSA[channel];
-							GenIndex[channel]=0;
-							GenState[channel]^=1;
-						}
-					}
-				} /* Channel loop */
-
-				/* Now put in noise generator stuff */
-				if (ActiveChannel[0]) { 
-					if (BeebState76489.Noise.FB) {
-						/* White noise */
-						if (GenState[0])
-							tmptotal+=BeebState76489.ToneVolume[0];
-						else
-							tmptotal-=BeebState76489.ToneVolume[0];
-						GenIndex[0]++;
-						switch (BeebState76489.Noise.Freq) {
-						case 0: /* Low */
-							if (GenIndex[0]>=(samplerate/10000)) {
-								GenIndex[0]=0;
-								GenState[0]=rand() & 1;
-							}
-							break;
-
-						case 1: /* Med */
-							if (GenIndex[0]>=(samplerate/5000)) {
-								GenIndex[0]=0;
-								GenState[0]=rand() & 1;
-							}
-							break;
-
-						case 2: /* High */
-							if (GenIndex[0]>=(samplerate/2500)) {
-								GenIndex[0]=0;
-								GenState[0]=rand() & 1;
-							}
-							break;
-
-						case 3: /* as channel 1 */
-							if (GenIndex[0]>=BeebState76489.ChangeSamps[1]) {
-								GenIndex[0]=0;
-								GenState[0]=rand() & 1;
-							}
-							break;
-						} /* Freq type switch */
-					} else {
-						/* Periodic */
-						if (GenState[0])
-							tmptotal+=BeebState76489.ToneVolume[0];
-						else
-							tmptotal-=BeebState76489.ToneVolume[0];
-						GenIndex[0]++;
-						switch (BeebState76489.Noise.Freq) {
-						case 2: /* Low */
-							if (GenState[0]) {
-								if (GenIndex[0]>=(samplerate/125)) {
-									GenIndex[0]=0;
-									GenState[0]=0;
-								}
-							} else {
-								if (GenIndex[0]>=(samplerate/1250)) {
-									GenIndex[0]=0;
-									GenState[0]=1;
-								}
-							}
-							break;
-
-						case 1: /* Med */
-							if (GenState[0]) {
-								if (GenIndex[0]>=(samplerate/250)) {
-									GenIndex[0]=0;
-									GenState[0]=0;
-								}
-							} else {
-								if (GenIndex[0]>=(samplerate/2500)) {
-									GenIndex[0]=0;
-									GenState[0]=1;
-								}
-							}
-							break;
-
-						case 0: /* High */
-							if (GenState[0]) {
-								if (GenIndex[0]>=(samplerate/500)) {
-									GenIndex[0]=0;
-									GenState[0]=0;
-								}
-							} else {
-								if (GenIndex[0]>=(samplerate/5000)) {
-									GenIndex[0]=0;
-									GenState[0]=1;
-								}
-							}
-							break;
-
-						case 3: /* Tone gen 1 */
-							if (GenState[0]) {
-								if (GenIndex[0]>=((BeebState76489.ChangeSamps[1]+(int)CSC[1])*31)) {
-									GenIndex[0]=0;
-									GenState[0]=0;
-								}
-							} else {
-								if (GenIndex[0]>=((BeebState76489.ChangeSamps[1]+(int)CSC[1]))) {
-									GenIndex[0]=0;
-									GenState[0]=1;
-								}
-							}
-							break;
-						} /* Freq type switch */
-					}
-				}
-			}
+		memset(ChipBuf,0,bufinc*sizeof(int));
+		RenderChip(ChipBuf,bufinc);
+
+		for(i=0;i<bufinc;i++,bufptr++) {
+			tmptotal=ChipBuf[i];
+			Extras=4;
 
 			// Mix in speech sound
 			if (SpeechEnabled) if (MachineType != 3) tmptotal += (SpeechBuf[SpeechPtr++]-128)*10;
@@ -504,7 +523,9 @@ static double CyclesToSamples(__int64 beebtime) {
 /*fprintf(stderr,"Convert tmp=%f\n",tmp); */
   LastBeebCycle=beebtime;
 
-  tmp*=(samplerate);
+  /* SDLSoundRatePPM is the SDL side's correction to keep the sound latency
+     steady */
+  tmp*=(samplerate)*(1.0+SDLSoundRatePPM/1000000.0);
   tmp/=2000000.0; /* Few - glad thats a double! */
 
   LastOurTime+=tmp;
@@ -514,6 +535,7 @@ static double CyclesToSamples(__int64 beebtime) {
 /****************************************************************************/
 static void PlayTilNow(void) {
   double nowsamps;
+  SoundCycles=TotalCycles;
   XtraCycles=TotalCycles-LastXtraCycles;
   nowsamps=CyclesToSamples(SoundCycles);
   LastXtraCycles=TotalCycles;
@@ -630,6 +652,8 @@ static void InitAudioDev(int sampleratein) {
 //++
 	DirectSoundEnabled=0;
 	samplerate = sampleratein;
+	if (SoundOversample!=2 && SoundOversample!=4) SoundOversample=1;
+	SetSoundRates();
 	SoundReset();
 	SoundEnabled=1;
 //<-
@@ -679,32 +703,31 @@ void LoadRelaySounds(void) {
 /****************************************************************************/
 /* The 'freqval' variable is the value as sene by the 76489                 */
 static void SetFreq(int Channel, int freqval) {
-  unsigned int freq;
-  int ChangeSamps; /* Number of samples after which to change */
   //fprintf(sndlog,"Channel %d - Value %d\n",Channel,freqval);
   double t;
   if (freqval==0) freqval=1;
   if (freqval<5) Speech[Channel]=1; else Speech[Channel]=0;
-/*  if (freqval==0) {
-    ChangeSamps=INT_MAX;
-  } else { */
-    freq=4000000/(32*freqval);
-/*    if (freq>samplerate) {
-      ChangeSamps=INT_MAX; // Way to high frequency - shut off 
-    } else {
-      if (freq>(samplerate/2)) {
-        // Hmm - a bit high - make it top out - change on every sample 
-        // What we should be doing is moving to sine wave at 1/6 samplerate 
-        ChangeSamps=2;
-      } else { */
-        ChangeSamps=(int)( (( (double)samplerate/(double)freq)/2.0) +SoundTuning);
-		t=( (( (double)samplerate/(double)freq)/2.0) +SoundTuning);
-		CSA[Channel]=(double)(t-ChangeSamps);
-		CSC[Channel]=0;
-      /* };
-    }; // freq<=samplerate 
-  }; / * Freqval!=0 */ 
-  BeebState76489.ChangeSamps[Channel]=ChangeSamps;
+
+  /* The output flips every freqval ticks of the 4MHz/16 clock, work out
+     how many samples that is at the internal rate */
+  t=((double)samplerate*freqval/250000.0+SoundTuning)*SoundOversample;
+  if (!PartSamples && t>=1.0) t=floor(t); /* Whole samples only */
+  HalfPeriod[Channel]=(t*SOUND_FRAC_ONE>=1.0) ? (unsigned int)(t*SOUND_FRAC_ONE) : 1;
+};
+
+/****************************************************************************/
+/* Work out the generator periods for the current sample rate */
+static void SetSoundRates(void) {
+  int Freq;
+
+  /* The fixed noise rates shift the LFSR once every 32, 64 or 128 ticks of
+     the 4MHz/16 clock */
+  for (Freq=0;Freq<3;Freq++)
+    NoisePeriod[Freq]=(unsigned int)((double)samplerate*SoundOversample*(32<<Freq)/250000.0*SOUND_FRAC_ONE);
+
+  SetFreq(1,BeebState76489.ToneFreq[0]);
+  SetFreq(2,BeebState76489.ToneFreq[1]);
+  SetFreq(3,BeebState76489.ToneFreq[2]);
 };
 
 /****************************************************************************/
@@ -750,6 +773,7 @@ void SoundChipReset(void) {
   BeebState76489.ToneFreq[3]=1000;
   BeebState76489.Noise.FB=0;
   BeebState76489.Noise.Freq=0;
+  NoiseShiftReg=NOISE_LFSR_RESET;
   ActiveChannel[0]=FALSE;
   ActiveChannel[1]=ActiveChannel[2]=ActiveChannel[3]=FALSE;
 }
@@ -902,6 +926,7 @@ void Sound_RegWrite(int value) {
       case 6: /* Noise control */
         BeebState76489.Noise.Freq=value &3;
         BeebState76489.Noise.FB=(value>>2)&1;
+        NoiseShiftReg=NOISE_LFSR_RESET;
 
         trigger = 1;
         break;
@@ -978,10 +1003,10 @@ void LoadSoundUEF(FILE *SUEF) {
 	BeebState76489.ToneVolume[0]=GetVol(15-Data);
 	if (Data!=15) ActiveChannel[0]=TRUE; else ActiveChannel[0]=FALSE;
 	BeebState76489.LastToneFreqSet=fgetc(SUEF);
-	GenIndex[0]=fget16(SUEF);
-	GenIndex[1]=fget16(SUEF);
-	GenIndex[2]=fget16(SUEF);
-	GenIndex[3]=fget16(SUEF);
+	GenIndex[0]=fget16(SUEF)<<SOUND_FRAC_BITS;
+	GenIndex[1]=fget16(SUEF)<<SOUND_FRAC_BITS;
+	GenIndex[2]=fget16(SUEF)<<SOUND_FRAC_BITS;
+	GenIndex[3]=fget16(SUEF)<<SOUND_FRAC_BITS;
 	ReloadingChip=FALSE;
 }
 
@@ -1001,8 +1026,8 @@ void SaveSoundUEF(FILE *SUEF) {
 	fputc(Noise,SUEF);
 	fputc(RealVolumes[0],SUEF);
 	fputc(BeebState76489.LastToneFreqSet,SUEF);
-	fput16(GenIndex[0],SUEF);
-	fput16(GenIndex[1],SUEF);
-	fput16(GenIndex[2],SUEF);
-	fput16(GenIndex[3],SUEF);
+	fput16(GenIndex[0]>>SOUND_FRAC_BITS,SUEF);
+	fput16(GenIndex[1]>>SOUND_FRAC_BITS,SUEF);
+	fput16(GenIndex[2]>>SOUND_FRAC_BITS,SUEF);
+	fput16(GenIndex[3]>>SOUND_FRAC_BITS,SUEF);
 }
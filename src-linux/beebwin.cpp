@@ -70,6 +70,10 @@
 #include "beebem_pages.h"
 //<+
 
+#ifdef BEEBEM_HEADLESS
+#include "headless.h"
+#endif
+
 // some LED based macros
 
 #define LED_COLOUR_TYPE (LEDByte&4)>>2
@@ -400,7 +404,9 @@ void BeebWin::Initialise()
 	SaveWindowPos();
 
 	SoundReset();
+#ifndef BEEBEM_HEADLESS
 	if (SoundDefault) SoundInit();
+#endif
 
 	if (SpeechDefault)
 		tms5220_start();
@@ -458,12 +464,41 @@ void BeebWin::doHorizLine(unsigned long Col, int y, int sx, int width) {
 //--            if (d<0) return;
 //--            memset(m_screen+d, Col, width);
 //++
-                int d, teletext_inc = 72;
-                unsigned char *p = NULL;
+                unsigned char *p = GetHorizLinePtr(y, sx, &width);
+
+                if (p == NULL){
+                        return;
+                }else if (VideoOutputXRGB){
+                        Uint32 *q = (Uint32*) p, pixel = XRGBPalette[Col & 0xff];
+                        for (int n = 0; n < width; n++) q[n] = pixel;
+                }else{
+                        memset(p, Col, width);
+                }
+//<-
+        };
 
+int BeebWin::GetHorizLineRow(int y) {
                 if (TeletextEnabled)
                         y/=TeletextStyle;
 
+		switch ( IsFullScreen()?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
+                        case RESOLUTION_320X240_S:
+                        case RESOLUTION_320X240_V:
+                        case RESOLUTION_320X256:
+				if(TeletextEnabled) y>>=1;
+                                break;
+                        default:
+                                break;
+                }
+
+                return y-2;
+        };
+
+unsigned char *BeebWin::GetHorizLinePtr(int y, int sx, int *width) {
+                int d, teletext_inc = 72;
+                unsigned char *p = NULL;
+
+                y = GetHorizLineRow(y)+2;
 
 //                switch (fullscreen
 //                 ?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
@@ -477,15 +512,15 @@ void BeebWin::doHorizLine(unsigned long Col, int y, int sx, int width) {
                         case RESOLUTION_640X480_V:
                                 break;
                         case RESOLUTION_320X240_S:
-				sx>>=1; if(TeletextEnabled) y>>=1; width>>=1;
+				sx>>=1; *width>>=1;
 				teletext_inc>>=1;
                                 break;
                         case RESOLUTION_320X240_V:
-				sx>>=1; if(TeletextEnabled) y>>=1; width>>=1;
+				sx>>=1; *width>>=1;
 				teletext_inc>>=1;
                                 break;
                         case RESOLUTION_320X256:
-				sx>>=1; if(TeletextEnabled) y>>=1; width>>=1;
+				sx>>=1; *width>>=1;
 				teletext_inc>>=1;
                                 break;
                         default:
@@ -494,7 +529,7 @@ void BeebWin::doHorizLine(unsigned long Col, int y, int sx, int width) {
 
                 if (y >= 600){
                         //pERROR(dL"[0332]: y >= 600 (is %d)", dR, (int) y);
-                        return;
+                        return NULL;
                 }
 
 //->            d = sx+(TeletextEnabled?36:0);
@@ -502,16 +537,15 @@ void BeebWin::doHorizLine(unsigned long Col, int y, int sx, int width) {
                 d = sx+(TeletextEnabled?teletext_inc:0);
 //<-
 
-                if ( d < 0) { return; } // qERROR("[0332]: d < 0"); return; }
+                if ( d < 0) { return NULL; } // qERROR("[0332]: d < 0"); return; }
 
                 p = (unsigned char*) GetSDLScreenLinePtr(y-2);
                 if (p == NULL){
                         qERROR("GetSDLScreenLinePtr returned NULL!");
                         exit(1);
-                }else{
-                        memset(p + d, Col, width);
                 }
-//<-
+
+                return p + d * (VideoOutputXRGB ? sizeof(Uint32) : 1);
         };
 
 void BeebWin::doInvHorizLine(unsigned long Col, int y, int sx, int width) {
@@ -575,6 +609,9 @@ void BeebWin::doInvHorizLine(unsigned long Col, int y, int sx, int width) {
                 if (vaddr == NULL) {
                         qERROR("GetSDLScreenLinePtr returned NULL!");
                         exit(1);
+                } else if (VideoOutputXRGB) {
+                        Uint32 *q = (Uint32*) vaddr + d;
+                        for (n = 0; n < width; n++) q[n] = InvertXRGBPixel(q[n], Col);
                 } else {
                         vaddr += d;
                         for (n = 0; n < width; n++) *(vaddr + n) ^= Col;
@@ -627,6 +664,9 @@ void BeebWin::doUHorizLine(unsigned long Col, int y, int sx, int width) {
                 if (p == NULL){
                         qERROR("GetSDLScreenLinePtr returned NULL!");
                         exit(1);
+                }else if (VideoOutputXRGB){
+                        Uint32 *q = (Uint32*) p + sx, pixel = XRGBPalette[Col & 0xff];
+                        for (int n = 0; n < width; n++) q[n] = pixel;
                 }else{
                         memset(p + sx, Col, width);
                 }
@@ -784,6 +824,12 @@ void BeebWin::CreateBitmap()
 //--		MessageBox(m_hWnd,"Cannot select the screen bitmap\n"
 //--					"Try running in a 256 colour mode",WindowTitle,MB_OK|MB_ICONERROR);
 //++
+	// The command line may have asked for the other pixel format.
+	if ((cfg_TrueColour != 0) != (VideoOutputXRGB != 0)){
+		Destroy_Screen();
+		Create_Screen();
+	}
+
 	SetBeebEmEmulatorCoresPalette(cols, palette_type);
 //<-
 }
@@ -1803,8 +1849,14 @@ int BeebWin::StartOfFrame(void)
 {
 	int FrameNum = 1;
 
+#ifdef BEEBEM_HEADLESS
+	/* Never throttled, and only draws the frames being dumped */
+	if (HeadlessDrawScreen)
+		FrameNum = 0;
+#else
 	if (UpdateTiming())
 		FrameNum = 0;
+#endif
 
 	return FrameNum;
 }
@@ -2017,7 +2069,7 @@ void BeebWin::updateLines(HDC hDC, int starty, int nlines)
 //--	}
 
 //+>
-	int i, TTLines=0;
+	int TTLines=0;
 
 
 // [TODO] Might want to make m_screen point to the SDL_Surface.
@@ -2045,11 +2097,7 @@ void BeebWin::updateLines(HDC hDC, int starty, int nlines)
 	}
 #endif
 
-	for(i = 0; i < nlines; i++){
-		if (i+starty < 600)
-			RenderLine(i+starty, (int) TeletextEnabled, ScreenAdjust);
-
-	}
+	PresentFrame(starty, nlines, (int) TeletextEnabled, ScreenAdjust);
 //<+
 
 }
@@ -2134,7 +2182,8 @@ BOOL BeebWin::UpdateTiming(void)
 		}
 		else
 		{
-			// Need to speed up, skip a frame
+			// Need to speed up, skip a frame.  The video code only
+			// keeps the CRTC timing going for skipped frames.
 			UpdateScreen = FALSE;
 
 			// Make sure we show at least one in 100 frames
@@ -3642,6 +3691,10 @@ void BeebWin::LoadPreferences()
 	if (!RegRes) {
 		SoundExponentialVolume=1;
 	}
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,"SoundOversample",dword))
+		SoundOversample = (int) dword;
+	else
+		SoundOversample = 1;
 	RegRes=SysReg.GetBinaryValue(HKEY_CURRENT_USER,CFG_REG_KEY,"TextToSpeechEnabled",&m_TextToSpeechEnabled,binsize);
 	if (!RegRes) {
 		m_TextToSpeechEnabled=0;
@@ -4070,11 +4123,51 @@ void BeebWin::LoadPreferences()
 	else
 		cfg_WantLowLatencySound = 1;
 
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SOUNDLATENCY,dword) && dword > 0)
+		cfg_SoundLatency = (int) dword;
+	else
+		cfg_SoundLatency = 20;
+
 	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SLEEP_TYPE,dword))
 		cfg_WaitType = dword;
 	else
 		cfg_WaitType = OPT_SLEEP_OS;
 
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_EMULATIONSLICE,dword))
+		cfg_EmulationSlice = (int) dword;
+	else
+		cfg_EmulationSlice = SLICE_INSTRUCTIONS;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SHOWHOSTOVERHEAD,dword))
+		cfg_ShowHostOverhead = (int) dword;
+	else
+		cfg_ShowHostOverhead = 0;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TUBETHREAD,dword))
+		cfg_TubeThread = (int) dword;
+	else
+		cfg_TubeThread = 0;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TUBESPEED,dword))
+		cfg_TubeSpeed = (int) dword;
+	else
+		cfg_TubeSpeed = 3;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_Z80LAZYFLAGS,dword))
+		cfg_Z80LazyFlags = (int) dword;
+	else
+		cfg_Z80LazyFlags = 0;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TRUECOLOUR,dword))
+		cfg_TrueColour = (int) dword;
+	else
+		cfg_TrueColour = 0;
+
+	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SCANLINEKERNEL,dword))
+		cfg_ScanLineKernel = (int) dword;
+	else
+		cfg_ScanLineKernel = 0;
+
 	if (SysReg.GetDWORDValue(HKEY_CURRENT_USER, CFG_REG_KEY, CFG_WINDOWEDRESOLUTION, dword))
 		cfg_Windowed_Resolution = (int) dword;
 	else
@@ -4146,6 +4239,7 @@ void BeebWin::SavePreferences()
 	SysReg.SetBinaryValue(HKEY_CURRENT_USER,CFG_REG_KEY,"Part Samples",&PartSamples,binsize);
 //	SysReg.SetBinaryValue(HKEY_CURRENT_USER,CFG_REG_KEY,"UseHostClock",&UseHostClock,binsize);
 	SysReg.SetBinaryValue(HKEY_CURRENT_USER,CFG_REG_KEY,"ExponentialVolume",&SoundExponentialVolume,binsize);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,"SoundOversample",SoundOversample);
 	SysReg.SetBinaryValue(HKEY_CURRENT_USER,CFG_REG_KEY,"TextToSpeechEnabled",&m_TextToSpeechEnabled,binsize);
 
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY, CFG_OPTIONS_STICKS, m_MenuIdSticks);
@@ -4235,7 +4329,15 @@ void BeebWin::SavePreferences()
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_EMULATECRTGRAPHICS, cfg_EmulateCrtGraphics);
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_EMUALTECRTTELETEXT, cfg_EmulateCrtTeletext);
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_WANTLOWLATENCYSOUND, cfg_WantLowLatencySound);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SOUNDLATENCY, cfg_SoundLatency);
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SLEEP_TYPE,cfg_WaitType);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_EMULATIONSLICE,cfg_EmulationSlice);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SHOWHOSTOVERHEAD,cfg_ShowHostOverhead);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TUBETHREAD,cfg_TubeThread);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TUBESPEED,cfg_TubeSpeed);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_Z80LAZYFLAGS,cfg_Z80LazyFlags);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_TRUECOLOUR,cfg_TrueColour);
+	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_SCANLINEKERNEL,cfg_ScanLineKernel);
 
 	SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_WINDOWEDRESOLUTION, cfg_Windowed_Resolution);
        SysReg.SetDWORDValue(HKEY_CURRENT_USER,CFG_REG_KEY,CFG_FULLSCREENRESOLUTION,cfg_Fullscreen_Resolution);
@@ -5630,6 +5732,38 @@ void BeebWin::ParseCommandLine()
 			{
 				TubeEnabled = atoi(__argv[++i]);
 			}
+			else if (stricmp(__argv[i], "-Slice") == 0)
+			{
+				++i;
+				if (stricmp(__argv[i], "line") == 0)
+					cfg_EmulationSlice = SLICE_SCANLINE;
+				else if (stricmp(__argv[i], "frame") == 0)
+					cfg_EmulationSlice = SLICE_FRAME;
+				else if ((a = atoi(__argv[i])) < 0)
+					invalid = true;
+				else
+					cfg_EmulationSlice = a;
+			}
+			else if (stricmp(__argv[i], "-TubeThread") == 0)
+			{
+				cfg_TubeThread = atoi(__argv[++i]);
+			}
+			else if (stricmp(__argv[i], "-TubeSpeed") == 0)
+			{
+				cfg_TubeSpeed = atoi(__argv[++i]);
+			}
+			else if (stricmp(__argv[i], "-Z80LazyFlags") == 0)
+			{
+				cfg_Z80LazyFlags = atoi(__argv[++i]);
+			}
+			else if (stricmp(__argv[i], "-TrueColour") == 0)
+			{
+				cfg_TrueColour = atoi(__argv[++i]);
+			}
+			else if (stricmp(__argv[i], "-ScanLineKernel") == 0)
+			{
+				cfg_ScanLineKernel = atoi(__argv[++i]);
+			}
 #ifdef WITH_ECONET
 			else if (stricmp(__argv[i], "-EcoStn") == 0)
 			{
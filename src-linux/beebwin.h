@@ -114,6 +114,16 @@ class BeebWin  {
 	void doInvHorizLine(unsigned long Col, int y, int sx, int width);
 	void doUHorizLine(unsigned long Col, int y, int sx, int width);
 
+	/* Where doHorizLine() would draw, scaled for the resolution: returns
+	 * the first pixel and sets *width to the pixel count, or NULL if it's
+	 * off the screen.
+	 */
+	unsigned char *GetHorizLinePtr(int y, int sx, int *width);
+
+	/* The video_output line doHorizLine() draws line y on.
+	 */
+	int GetHorizLineRow(int y);
+
 
 /*
 	void doHorizLine(unsigned long Col, int y, int sx, int width) {
@@ -284,6 +294,22 @@ class BeebWin  {
 //<-
 	}
 
+	/* For 32 bit XRGB video output, where ScreenAdjust is in pixels.
+	 */
+	Uint32 *GetLinePtr32(int y) {
+		unsigned char *p = NULL;
+		if (y > MAX_VIDEO_SCAN_LINES)
+			y = MAX_VIDEO_SCAN_LINES;
+
+		p = GetSDLScreenLinePtr(y);
+		if (p == NULL){
+			qERROR("GetSDLScreenLinePtr returned NULL!");
+			exit(1);
+		}
+
+		return (Uint32*) p + ScreenAdjust;
+	}
+
 	char *imageData(void) {
 //->		return (m_screen+ScreenAdjust>m_screen)?m_screen+ScreenAdjust:m_screen;
 //++
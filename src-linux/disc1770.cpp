@@ -288,6 +288,11 @@ void Write1770Register(unsigned char Register, unsigned char Value) {
 	}
 }
 
+// True while Poll1770 has a command or a drive spin down in progress
+bool Disc1770Active(void) {
+  return LightsOn[0] || LightsOn[1] || (Status & 1);
+}
+
 void Poll1770(int NCycles) {
   for (int d=0;d<2;d++) {
 	  if (LightsOn[d]) {
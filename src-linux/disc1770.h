@@ -16,6 +16,7 @@ void WriteFDCControlReg(unsigned char Value);
 unsigned char ReadFDCControlReg(void);
 void Reset1770(void);
 void Poll1770(int NCycles);
+bool Disc1770Active(void);
 void CreateADFSImage(char *ImageName,unsigned char Drive,unsigned char Tracks, HMENU dmenu);
 void Close1770Disc(char Drive);
 void Save1770UEF(FILE *SUEF);
@@ -76,6 +76,7 @@ extern bool EconetStateChanged;
 extern int EconetTrigger;
 extern int EconetFlagFillTimeoutTrigger;
 extern int EconetFlagFillTimeout;
+extern bool FlagFillActive;
 volatile extern struct MC6854 ADLC;
 
 extern unsigned char EconetStationNumber;
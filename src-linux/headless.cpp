@@ -0,0 +1,228 @@
+/****************************************************************************/
+/*                               Beebem                                     */
+/*                               ------                                     */
+/* This program may be distributed freely within the following restrictions:*/
+/*                                                                          */
+/* 1) You may not charge for this program or for any part of it.            */
+/* 2) This copyright message must be distributed with all copies.           */
+/* 3) This program must be distributed complete with source code.  Binary   */
+/*    only distribution is not permitted.                                   */
+/* 4) The author offers no warrenties, or guarentees etc. - you use it at   */
+/*    your own risk.  If it messes something up or destroys your computer   */
+/*    thats YOUR problem.                                                   */
+/* 5) You may use small sections of code from this program in your own      */
+/*    applications - but you must acknowledge its use.  If you plan to use  */
+/*    large sections then please ask the author.                            */
+/*                                                                          */
+/* If you do not agree with any of the above then please do not use this    */
+/* program.                                                                 */
+/****************************************************************************/
+
+/* Headless batch runner.
+ *
+ * beebem-headless is built from the same sources as beebem (with
+ * BEEBEM_HEADLESS defined) but replaces the SDL main loop with this one.
+ * There is no window or sound output and no speed throttling: the machine
+ * runs for a fixed number of emulated cycles as fast as the host allows,
+ * optionally writes out its RAM and screen, then reports how fast it went.
+ * beebem-headless-threaded is the same with the computed goto 6502 core
+ * (WITH_THREADED_6502), to compare the two on the same workload.
+ *
+ *   beebem-headless [-Cycles <n>] [-Tape <file.uef|file.csw>]
+ *                   [-DumpMemory <file>] [-DumpScreen <file.bmp>]
+ *                   [beebem options] [disc image]
+ *
+ * The machine configuration comes from the usual preferences plus any of
+ * beebem's own command line options (-Model, -Tube, ...).
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL.h>
+
+#include "main.h"
+#include "6502core.h"
+#include "beebmem.h"
+#include "tube.h"
+#include "serial.h"
+#include "csw.h"
+#include "log.h"
+#include "sdl.h"
+
+#include "beebem_pages.h"
+#include "fake_registry.h"
+#include "headless.h"
+
+/* Default run length, one minute of emulated time.
+ */
+#define HEADLESS_DEFAULT_CYCLES		(2000000ULL * 60)
+
+/* How much of the end of the run is drawn when a screen dump is wanted,
+ * enough for two whole frames.
+ */
+#define HEADLESS_DRAW_CYCLES		(2 * SLICE_FRAME)
+
+bool HeadlessDrawScreen = false;
+
+static unsigned long long RunCycles = HEADLESS_DEFAULT_CYCLES;
+static char *TapeFileName = NULL;
+static char *MemoryDumpName = NULL;
+static char *ScreenDumpName = NULL;
+
+/* Pull out the options that only mean something here, leaving the rest in
+ * __argc/__argv for BeebWin::ParseCommandLine.
+ */
+static bool ParseHeadlessOptions(int argc, char *argv[])
+{
+	char **args;
+	int i;
+
+	args = (char**) malloc(sizeof(char*) * (argc + 1));
+	if (args == NULL)
+		return false;
+
+	__argc = 0;
+	args[__argc++] = argv[0];
+
+	for (i = 1; i < argc; i++){
+		if (i+1 < argc && strcasecmp(argv[i], "-Cycles") == 0){
+			RunCycles = strtoull(argv[++i], NULL, 0);
+		}else if (i+1 < argc && strcasecmp(argv[i], "-Tape") == 0){
+			TapeFileName = argv[++i];
+		}else if (i+1 < argc && strcasecmp(argv[i], "-DumpMemory") == 0){
+			MemoryDumpName = argv[++i];
+		}else if (i+1 < argc && strcasecmp(argv[i], "-DumpScreen") == 0){
+			ScreenDumpName = argv[++i];
+		}else{
+			args[__argc++] = argv[i];
+		}
+	}
+	args[__argc] = NULL;
+	__argv = args;
+
+	return RunCycles > 0;
+}
+
+/* Load a tape image, picking the format from the file extension.
+ */
+static void LoadHeadlessTape(char *FileName)
+{
+	char *ext = strrchr(FileName, '.');
+
+	if (ext != NULL && strcasecmp(ext, ".csw") == 0)
+		LoadCSW(FileName);
+	else
+		LoadUEF(FileName);
+}
+
+/* Write the 32K of main RAM.
+ */
+static bool DumpMemory(const char *FileName)
+{
+	FILE *f = fopen(FileName, "wb");
+	bool ok;
+
+	if (f == NULL)
+		return false;
+
+	ok = fwrite(WholeRam, 1, 0x8000, f) == 0x8000;
+	if (fclose(f) != 0)
+		ok = false;
+
+	return ok;
+}
+
+int main(int argc, char *argv[])
+{
+	static char video_driver[] = "SDL_VIDEODRIVER=dummy";
+	unsigned long long cycles_run = 0;
+	Uint32 start_ticks, host_ticks;
+	double seconds;
+	int ret = 0;
+
+	if (! ParseHeadlessOptions(argc, argv)){
+		fprintf(stderr, "Usage: %s [-Cycles <n>] [-Tape <file>]"
+		 " [-DumpMemory <file>] [-DumpScreen <file.bmp>]"
+		 " [beebem options] [disc image]\n", argv[0]);
+		return 1;
+	}
+
+	Log_Init();
+
+	/* SDL still provides the emulator's frame buffer, it's just never put
+	 * on a real display.
+	 */
+	putenv(video_driver);
+	if (! InitialiseSDL(__argc, __argv)){
+		qFATAL("Unable to initialise SDL library!");
+		exit(1);
+	}
+
+	if (EG_Initialize() != EG_TRUE){
+		qFATAL("EG failed to initialize! Quiting.");
+		exit(1);
+	}
+
+	if (InitializeBeebEmGUI(screen_ptr) != EG_TRUE)
+		exit(1);
+
+	InitializeFakeRegistry();
+
+	mainWin=new BeebWin();
+	mainWin->Initialise();
+
+	if (TapeFileName != NULL)
+		LoadHeadlessTape(TapeFileName);
+
+	/* Run flat out.  Nothing is drawn until the frames that end up in the
+	 * screen dump.
+	 */
+	start_ticks = SDL_GetTicks();
+	while (cycles_run < RunCycles && done == 0){
+		if (ScreenDumpName != NULL && RunCycles - cycles_run <= HEADLESS_DRAW_CYCLES)
+			HeadlessDrawScreen = true;
+
+		cycles_run += Exec6502Cycles(SLICE_FRAME);
+	}
+	host_ticks = SDL_GetTicks() - start_ticks;
+
+	if (MemoryDumpName != NULL && ! DumpMemory(MemoryDumpName)){
+		fprintf(stderr, "Could not write memory dump to %s\n", MemoryDumpName);
+		ret = 1;
+	}
+
+	if (ScreenDumpName != NULL && SDL_SaveBMP(video_output, ScreenDumpName) != 0){
+		fprintf(stderr, "Could not write screen dump to %s: %s\n"
+		 , ScreenDumpName, SDL_GetError());
+		ret = 1;
+	}
+
+	seconds = (host_ticks > 0 ? host_ticks : 1) / 1000.0;
+	printf("Emulated %llu cycles (%.2f s) in %.2f s: %.0f cycles/s, %.2fx real time\n"
+	 , cycles_run, cycles_run / 2000000.0, host_ticks / 1000.0
+	 , cycles_run / seconds, cycles_run / 2000000.0 / seconds);
+	printf("%llu host instructions: %.0f instructions/s (%s 6502 core)\n"
+	 , TotalInstructions, TotalInstructions / seconds
+#ifdef WITH_THREADED_6502
+	 , "computed goto"
+#else
+	 , "switch"
+#endif
+	 );
+
+	StopTubeThread();
+	delete mainWin;
+
+	DestroyFakeRegistry();
+	DestroyBeebEmGUI();
+	UninitialiseSDL();
+	Log_UnInit();
+
+	return ret;
+}
@@ -0,0 +1,16 @@
+/* Headless batch runner for BeebEm (see headless.cpp)
+ */
+
+#ifndef HEADLESS_HEADER
+#define HEADLESS_HEADER
+
+#if HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+/* Set by the runner when the frames it is about to dump should be drawn,
+ * everything else is skipped.
+ */
+extern bool HeadlessDrawScreen;
+
+#endif
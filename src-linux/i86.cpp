@@ -242,8 +242,8 @@ static struct i86_timing cycles;
 
 extern int i386_dasm_one(char *buffer, UINT32 eip, int addr_size, int op_size);
 
-extern unsigned char TubeintStatus;
-extern unsigned char TubeNMIStatus;
+extern volatile unsigned char TubeintStatus;
+extern volatile unsigned char TubeNMIStatus;
 
 void io_write_byte_8(offs_t address, UINT8 data);
 UINT8 io_read_byte_8(offs_t address);
@@ -34,6 +34,7 @@
 
 #ifdef WITH_UNIX_EXTRAS
 #	include <sys/types.h>
+#	include <sys/time.h>
 #	include <dirent.h>
 #	include <pwd.h>
 #endif
@@ -204,6 +205,15 @@ void Quit(void)
 	done=1;
 }
 
+/* The headless runner has its own main loop in headless.cpp.
+ */
+#ifndef BEEBEM_HEADLESS
+
+/* Number of emulated cycles before X11's Caps Lock is released (about the
+ * same as the 20 passes of 1024 instructions it used to be).
+ */
+#define X11_CAPSLOCK_RELEASE_CYCLES 50000
+
 
 
 //------------------------------------------------
@@ -232,6 +242,10 @@ int main(int argc, char *argv[]){
 //+>
 	int X11_CapsLock_Down;
 	Uint32 ticks=SDL_GetTicks();
+	int slice_cycles;
+	CycleCountT slice_start;
+	Uint32 overhead_start = 0, overhead_time = 0, now;
+	int overhead_cycles = 0;
 //	int mouse_x=0, mouse_y=0, mouse_move_x, mouse_move_y;
 //	BOOL ignore_next_mouse_movement = FALSE;
 //	int buttons=0;
@@ -336,19 +350,6 @@ int main(int argc, char *argv[]){
 //--			}
 //--		}
 
-		/* As X11 sucks, we need to release the Caps Lock key ourselves, an event will not happen.
-		 * The X11_CapsLock_Down var basically counts down once per pass of the emulator core, when
-		 * it's 1, we assume enough time has passed to pass the core a release of the Beebs Caps Lock
-		 * key.
-		 */
-		if (X11_CapsLock_Down>0){
-			X11_CapsLock_Down--;
-			if (X11_CapsLock_Down == 0)
-				BeebKeyUp(4, 0);
-		}
-		
-
-
 		/* Toggle processing of either events to the emulator core, or events to the menu.
 		 */
 		SDL_Event event;
@@ -356,9 +357,64 @@ int main(int argc, char *argv[]){
 		if (showing_menu != 1){
 
 		/* Execute emulator:
+		 *
+		 * The core runs for cfg_EmulationSlice cycles (or one batch of
+		 * instructions if that's zero) before we look at SDL events, so
+		 * the bigger the slice the less host side work per emulated
+		 * second.
+		 */
+		slice_cycles = 0;
+		if (!mainWin->IsFrozen()){
+			now = HostMicroSeconds();
+			if (overhead_start != 0)
+				overhead_time += now - overhead_start;
+
+			if (cfg_EmulationSlice > 0){
+				slice_cycles = Exec6502Cycles(cfg_EmulationSlice);
+			}else{
+				slice_start = TotalCycles;
+				Exec6502Instruction();
+				slice_cycles = TotalCycles - slice_start;
+				if (slice_cycles < 0)
+					slice_cycles += CycleCountWrap;
+			}
+
+			overhead_start = HostMicroSeconds();
+
+			/* Report the host overhead once per emulated second,
+			 * followed by the sound, presentation and mode 7 figures
+			 * for the same second.
+			 */
+			overhead_cycles += slice_cycles;
+			if (overhead_cycles >= 2000000){
+				if (cfg_ShowHostOverhead){
+					pINFO(dL"Host overhead: %u us per emulated second"
+					 " (slice %d cycles).", dR, (unsigned int)
+					 ((double) overhead_time * 2000000.0 / overhead_cycles)
+					 , cfg_EmulationSlice);
+					ReportSoundStatistics();
+					ReportPresentationStatistics();
+					ReportMode7RowCacheStatistics();
+				}
+				overhead_time = 0;
+				overhead_cycles = 0;
+			}
+		}else{
+			overhead_start = 0;
+		}
+
+		/* As X11 sucks, we need to release the Caps Lock key ourselves, an event will not happen.
+		 * The X11_CapsLock_Down var counts down the emulated cycles since the key was pressed,
+		 * once it reaches 0 we assume enough time has passed to pass the core a release of the
+		 * Beebs Caps Lock key.
 		 */
-		if (!mainWin->IsFrozen())
-			Exec6502Instruction();
+		if (X11_CapsLock_Down>0){
+			X11_CapsLock_Down -= slice_cycles;
+			if (X11_CapsLock_Down <= 0){
+				X11_CapsLock_Down = 0;
+				BeebKeyUp(4, 0);
+			}
+		}
 
 		/* If the mouse cursor should be hidden (set on GUI),
 		 * then make sure it is hidden after a suitable delay.
@@ -479,8 +535,8 @@ int main(int argc, char *argv[]){
 					 */
 					if (ConvertSDLKeyToBBCKey(event.key.keysym /*, &pressed */, &col, &row)){
 
-						/* If X11 and Caps Lock then release automatically after 20
-						 * passes to the emulator core (doesn't X11 suck)..
+						/* If X11 and Caps Lock then release automatically after
+						 * X11_CAPSLOCK_RELEASE_CYCLES of emulation (doesn't X11 suck)..
 						 *
 						 * We'll only ever receive a pressed event for Caps Lock, so
 						 * emulate a release after x amount of time passes within the
@@ -491,7 +547,7 @@ int main(int argc, char *argv[]){
 						 */
 						if (event.key.keysym.sym == SDLK_CAPSLOCK && cfg_HaveX11){
 							 BeebKeyDown(4, 0);
-							 X11_CapsLock_Down = 20;
+							 X11_CapsLock_Down = X11_CAPSLOCK_RELEASE_CYCLES;
 						}else{
 
 							/* Process key in emulator core:
@@ -545,6 +601,10 @@ int main(int argc, char *argv[]){
 			}
 		
 		}else{
+			/* Time spent in the menu isn't host overhead.
+			 */
+			overhead_start = 0;
+
 			/* Make sure mouse pointer is shown when menu is displayed
 			 */
 			if (SDL_ShowCursor(SDL_QUERY) != SDL_ENABLE)
@@ -602,6 +662,7 @@ int main(int argc, char *argv[]){
 	 */
 	UnfullscreenBeforeExit();
 
+	StopTubeThread();
 	delete mainWin;
 //--	Kill_Serial();
 
@@ -618,3 +679,5 @@ int main(int argc, char *argv[]){
 
 	return(0);  
 } /* main */
+
+#endif /* BEEBEM_HEADLESS */
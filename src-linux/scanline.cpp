@@ -0,0 +1,215 @@
+/****************************************************************************/
+/*              Beebem - (c) David Alan Gilbert 1994                        */
+/*              ------------------------------------                        */
+/* This program may be distributed freely within the following restrictions:*/
+/*                                                                          */
+/* 1) You may not charge for this program or for any part of it.            */
+/* 2) This copyright message must be distributed with all copies.           */
+/* 3) This program must be distributed complete with source code.  Binary   */
+/*    only distribution is not permitted.                                   */
+/* 4) The author offers no warrenties, or guarentees etc. - you use it at   */
+/*    your own risk.  If it messes something up or destroys your computer   */
+/*    thats YOUR problem.                                                   */
+/* 5) You may use small sections of code from this program in your own      */
+/*    applications - but you must acknowledge its use.  If you plan to use  */
+/*    large sections then please ask the author.                            */
+/*                                                                          */
+/* If you do not agree with any of the above then please do not use this    */
+/* program.                                                                 */
+/* Please report any problems to the author at beebem@treblig.org           */
+/****************************************************************************/
+/* Scanline expanders for graphics modes 0-6.                              */
+/*                                                                         */
+/* video.cpp builds a table of the pixels for every value of a screen      */
+/* byte from the ULA palette (the fast tables), for the output format and  */
+/* width in use, and the expanders turn a whole row of screen bytes into   */
+/* pixels by gathering their entries from it.                              */
+/*                                                                         */
+/* The scalar kernel copies one entry per byte.  The AVX2 kernel gathers  */
+/* the screen bytes and their entries with vpgather, 32 bytes of pixels at */
+/* a time.  It is built with a target attribute so the rest of BeebEm      */
+/* doesn't need AVX2, and only selected when the CPU has it.               */
+/*                                                                         */
+/* Screen bytes are read as part of wider loads, so the AVX2 kernel stops  */
+/* a group short of the end of the row and leaves the rest to the scalar   */
+/* code rather than read past the last byte.                               */
+
+#if HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <string.h>
+
+#include "scanline.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define SCANLINE_X86_KERNELS
+#	include <immintrin.h>
+#endif
+
+/*--------------------------------------------------------------------------*/
+template <int EntrySize>
+static inline void ExpandBytes(unsigned char *Dest, const unsigned char *Src
+ , int Count, const unsigned char *Table)
+{
+	for (; Count > 0; Count--, Src+=8, Dest+=EntrySize)
+		memcpy(Dest, Table + *Src * EntrySize, EntrySize);
+}
+
+static void ExpandScanLineScalar(void *Dest, const unsigned char *Src
+ , int Count, const void *Table, int EntrySize)
+{
+	unsigned char *d = (unsigned char *) Dest;
+	const unsigned char *t = (const unsigned char *) Table;
+
+	switch (EntrySize) {
+	case 4:  ExpandBytes<4>(d, Src, Count, t); break;
+	case 8:  ExpandBytes<8>(d, Src, Count, t); break;
+	case 16: ExpandBytes<16>(d, Src, Count, t); break;
+	case 32: ExpandBytes<32>(d, Src, Count, t); break;
+	case 64: ExpandBytes<64>(d, Src, Count, t); break;
+	}
+}
+
+#ifdef SCANLINE_X86_KERNELS
+
+/*--------------------------------------------------------------------------*/
+/* 4 byte entries: gather 8 screen bytes as dwords, then their entries.
+ */
+__attribute__((target("avx2")))
+static void ExpandBytesAVX2_4(unsigned char *Dest, const unsigned char *Src
+ , int Count, const unsigned char *Table)
+{
+	const __m256i Offsets = _mm256_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56);
+	const __m256i Low = _mm256_set1_epi32(0xff);
+	__m256i idx;
+
+	for (; Count > 8; Count-=8, Src+=64, Dest+=32) {
+		idx = _mm256_and_si256(_mm256_i32gather_epi32((const int *) Src, Offsets, 1), Low);
+		_mm256_storeu_si256((__m256i *) Dest
+		 , _mm256_i32gather_epi32((const int *) Table, idx, 4));
+	}
+
+	ExpandBytes<4>(Dest, Src, Count, Table);
+}
+
+/* 8 byte entries: the 4 screen bytes are the low bytes of 32 contiguous
+ * bytes, so load and mask them, then gather their entries as quadwords.
+ */
+__attribute__((target("avx2")))
+static void ExpandBytesAVX2_8(unsigned char *Dest, const unsigned char *Src
+ , int Count, const unsigned char *Table)
+{
+	const __m256i Low = _mm256_set1_epi64x(0xff);
+	__m256i idx;
+
+	for (; Count > 4; Count-=4, Src+=32, Dest+=32) {
+		idx = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) Src), Low);
+		_mm256_storeu_si256((__m256i *) Dest
+		 , _mm256_i64gather_epi64((const long long *) Table, idx, 8));
+	}
+
+	ExpandBytes<8>(Dest, Src, Count, Table);
+}
+
+/* 16 byte and larger entries are whole vectors already.
+ */
+template <int EntrySize>
+__attribute__((target("avx2")))
+static void ExpandBytesAVX2(unsigned char *Dest, const unsigned char *Src
+ , int Count, const unsigned char *Table)
+{
+	const unsigned char *e0, *e1;
+	int j;
+
+	if (EntrySize == 16) {
+		for (; Count > 1; Count-=2, Src+=16, Dest+=32) {
+			e0 = Table + Src[0] * 16;
+			e1 = Table + Src[8] * 16;
+			_mm256_storeu_si256((__m256i *) Dest, _mm256_inserti128_si256(
+			 _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) e0))
+			 , _mm_loadu_si128((const __m128i *) e1), 1));
+		}
+	} else {
+		for (; Count > 0; Count--, Src+=8) {
+			e0 = Table + *Src * EntrySize;
+			for (j = 0; j < EntrySize; j+=32, Dest+=32)
+				_mm256_storeu_si256((__m256i *) Dest
+				 , _mm256_loadu_si256((const __m256i *) (e0 + j)));
+		}
+	}
+
+	ExpandBytes<EntrySize>(Dest, Src, Count, Table);
+}
+
+__attribute__((target("avx2")))
+static void ExpandScanLineAVX2(void *Dest, const unsigned char *Src
+ , int Count, const void *Table, int EntrySize)
+{
+	unsigned char *d = (unsigned char *) Dest;
+	const unsigned char *t = (const unsigned char *) Table;
+
+	switch (EntrySize) {
+	case 4:  ExpandBytesAVX2_4(d, Src, Count, t); break;
+	case 8:  ExpandBytesAVX2_8(d, Src, Count, t); break;
+	case 16: ExpandBytesAVX2<16>(d, Src, Count, t); break;
+	case 32: ExpandBytesAVX2<32>(d, Src, Count, t); break;
+	case 64: ExpandBytesAVX2<64>(d, Src, Count, t); break;
+	}
+}
+
+#endif /* SCANLINE_X86_KERNELS */
+
+/*--------------------------------------------------------------------------*/
+ScanLineExpanderPtr ExpandScanLine = ExpandScanLineScalar;
+
+static bool HaveScanLineKernel(int Kernel)
+{
+#ifdef SCANLINE_X86_KERNELS
+	__builtin_cpu_init();
+#endif
+
+	switch (Kernel) {
+	case SCANLINE_SCALAR:
+		return true;
+#ifdef SCANLINE_X86_KERNELS
+	case SCANLINE_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return false;
+	}
+}
+
+int SelectScanLineExpander(int Kernel)
+{
+	if (Kernel == SCANLINE_AUTO) {
+		Kernel = HaveScanLineKernel(SCANLINE_AVX2) ? SCANLINE_AVX2 : SCANLINE_SCALAR;
+	} else if (!HaveScanLineKernel(Kernel)) {
+		Kernel = SCANLINE_SCALAR;
+	}
+
+	switch (Kernel) {
+#ifdef SCANLINE_X86_KERNELS
+	case SCANLINE_AVX2:
+		ExpandScanLine = ExpandScanLineAVX2;
+		break;
+#endif
+	default:
+		Kernel = SCANLINE_SCALAR;
+		ExpandScanLine = ExpandScanLineScalar;
+		break;
+	}
+
+	return Kernel;
+}
+
+const char *ScanLineKernelName(int Kernel)
+{
+	switch (Kernel) {
+	case SCANLINE_AUTO:   return "auto";
+	case SCANLINE_SCALAR: return "scalar";
+	case SCANLINE_AVX2:   return "AVX2";
+	default:              return "unknown";
+	}
+}
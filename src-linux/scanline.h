@@ -0,0 +1,37 @@
+/* Scanline expansion for graphics modes 0-6 (see scanline.cpp)
+ */
+
+#ifndef SCANLINE_HEADER
+#define SCANLINE_HEADER
+
+#if HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+/* Expand Count bytes of screen memory into pixels.  The bytes are 8 apart,
+ * as they are along a character row, and each is replaced by its entry in
+ * Table: 256 entries of EntrySize bytes, which must be 4, 8, 16, 32 or 64.
+ */
+typedef void (*ScanLineExpanderPtr)(void *Dest, const unsigned char *Src
+ , int Count, const void *Table, int EntrySize);
+
+enum ScanLineKernel {
+	SCANLINE_AUTO,
+	SCANLINE_SCALAR,
+	SCANLINE_AVX2,
+	SCANLINE_KERNELS
+};
+
+/* The expander in use, the scalar one until SelectScanLineExpander() is
+ * called.
+ */
+extern ScanLineExpanderPtr ExpandScanLine;
+
+/* Use the given kernel, or with SCANLINE_AUTO the fastest the host CPU
+ * supports.  Returns the kernel actually used, which is the scalar one if
+ * the CPU can't run the one asked for.
+ */
+extern int SelectScanLineExpander(int Kernel);
+extern const char *ScanLineKernelName(int Kernel);
+
+#endif
@@ -0,0 +1,160 @@
+/* Micro-benchmark for the graphics mode scanline expanders (scanline.cpp).
+ *
+ * Builds the fast table for each ULA setting the way video.cpp does (2, 4
+ * and 16 colours, narrow and wide pixels, DoFastTable2 to
+ * DoFastTable16XStep8), in 8 and 32 bit output and at 640 and 320 pixels
+ * wide, then times every kernel the CPU supports expanding rows of random
+ * screen memory through it.  Each kernel's output is checked against the
+ * scalar one first.
+ *
+ *   make scanline-bench && ./scanline-bench [rows]
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "scanline.h"
+
+#define BENCH_DEFAULT_ROWS	200000
+
+/* Bytes of screen memory in a row of characters, enough for 80 columns
+ * plus the extra a SIMD load might look at.
+ */
+#define BENCH_ROW_BYTES		(80 * 8 + 64)
+
+struct BenchMode {
+	const char *Name;
+	int Colours;
+	int Narrow;
+};
+
+static const BenchMode Modes[] = {
+	{ "DoFastTable2 (mode 0)",        2,  1 },
+	{ "DoFastTable2XStep2 (mode 4)",  2,  0 },
+	{ "DoFastTable4 (mode 1)",        4,  1 },
+	{ "DoFastTable4XStep4 (mode 5)",  4,  0 },
+	{ "DoFastTable16 (mode 2)",       16, 1 },
+	{ "DoFastTable16XStep8",          16, 0 },
+};
+
+static unsigned int Pixels32[8] = {
+	0x000000, 0xff0000, 0x00ff00, 0xffff00,
+	0x0000ff, 0xff00ff, 0x00ffff, 0xffffff
+};
+
+static double MicroSeconds(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+/* The ULA takes the palette address of the left most pixel from bits 7, 5,
+ * 3 and 1 of the byte, then shifts it left filling with ones for each pixel
+ * after that.
+ */
+static int PaletteAddress(int Byte, int Pixel)
+{
+	int v = ((Byte << Pixel) | ((1 << Pixel) - 1)) & 0xff;
+
+	return ((v & 128) ? 8 : 0) | ((v & 32) ? 4 : 0)
+	 | ((v & 8) ? 2 : 0) | ((v & 2) ? 1 : 0);
+}
+
+/* Build a table of BytesPerPixel sized pixels, returning the entry size.
+ */
+static int BuildTable(unsigned char *Table, const BenchMode *Mode
+ , const unsigned char *Palette, int BytesPerPixel, int Half)
+{
+	// 8 pixels a byte with 2 colours, 4 with 4 and 2 with 16
+	int LogicalPixels = Mode->Colours == 2 ? 8 : (Mode->Colours == 4 ? 4 : 2);
+	int FullWidth = Mode->Narrow ? 8 : 16;
+	int Step = Half ? 2 : 1;
+	int Width = FullWidth / Step;
+	int EntrySize = Width * BytesPerPixel;
+	int b, x, col;
+
+	for (b = 0; b < 256; b++) {
+		for (x = 0; x < Width; x++) {
+			col = Palette[PaletteAddress(b, x * Step * LogicalPixels / FullWidth)];
+			if (BytesPerPixel == 1)
+				Table[b * EntrySize + x] = (unsigned char) col;
+			else
+				memcpy(Table + b * EntrySize + x * 4, &Pixels32[col], 4);
+		}
+	}
+
+	return EntrySize;
+}
+
+int main(int argc, char *argv[])
+{
+	static unsigned char Screen[BENCH_ROW_BYTES];
+	static unsigned char Table[256 * 64];
+	static unsigned char Out[2][80 * 64];
+	unsigned char Palette[16];
+	int Rows = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_ROWS;
+	int m, bpp, half, kernel, used, entry, count, r, i;
+	double start, ns;
+
+	if (Rows <= 0) {
+		fprintf(stderr, "Usage: %s [rows]\n", argv[0]);
+		return 1;
+	}
+
+	srand(1);
+	for (i = 0; i < BENCH_ROW_BYTES; i++)
+		Screen[i] = (unsigned char) rand();
+	for (i = 0; i < 16; i++)
+		Palette[i] = (unsigned char) (rand() & 7);
+
+	used = SelectScanLineExpander(SCANLINE_AUTO);
+	printf("Auto selects the %s kernel, %d rows per test\n\n"
+	 , ScanLineKernelName(used), Rows);
+	printf("%-28s %3s %4s  %-7s %10s\n", "Table", "bpp", "wide", "kernel", "ns/row");
+
+	for (m = 0; m < (int) (sizeof(Modes) / sizeof(Modes[0])); m++) {
+		// Modes 0-3 show 80 bytes a row, 4-6 40
+		count = Modes[m].Narrow ? 80 : 40;
+
+		for (bpp = 1; bpp <= 4; bpp += 3) {
+			for (half = 0; half <= 1; half++) {
+				entry = BuildTable(Table, &Modes[m], Palette, bpp, half);
+
+				SelectScanLineExpander(SCANLINE_SCALAR);
+				ExpandScanLine(Out[0], Screen, count, Table, entry);
+
+				for (kernel = SCANLINE_SCALAR; kernel < SCANLINE_KERNELS; kernel++) {
+					if (SelectScanLineExpander(kernel) != kernel)
+						continue;
+
+					memset(Out[1], 0, sizeof(Out[1]));
+					ExpandScanLine(Out[1], Screen, count, Table, entry);
+					if (memcmp(Out[0], Out[1], count * entry) != 0) {
+						printf("%s: %s kernel output differs\n"
+						 , Modes[m].Name, ScanLineKernelName(kernel));
+						return 1;
+					}
+
+					start = MicroSeconds();
+					for (r = 0; r < Rows; r++)
+						ExpandScanLine(Out[1], Screen + (r & 7), count, Table, entry);
+					ns = (MicroSeconds() - start) * 1000.0 / Rows;
+
+					printf("%-28s %3d %4d  %-7s %10.1f\n", Modes[m].Name
+					 , bpp * 8, half ? 320 : 640
+					 , ScanLineKernelName(kernel), ns);
+				}
+			}
+		}
+	}
+
+	return 0;
+}
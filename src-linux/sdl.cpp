@@ -35,31 +35,54 @@
 // For PaletteType
 #include "beebwin.h"
 
+// For FastTable_Valid
+#include "video.h"
+
 #include <string.h>
 
+#ifdef WITH_UNIX_EXTRAS
+#	include <sys/time.h>
+#endif
+
 
 #include "beebem_pages.h"
 
 
 
-// The SDL sound support code is nasty :-( 
+// The SDL sound support code:
 //
-// In order to handle sound without studying the BeebEm sound code in too much
-// detail, I'll (for now) just let it dump it's samples into this bloody huge
-// buffer instead..  The buffer is wrapped so once 1024*100 bytes are used
-// we index from 0 again.
-#define SOUND_BUFFER_SIZE (1024*100)
-Uint8 SDLSoundBuffer[SOUND_BUFFER_SIZE];
+// The BeebEm emulator core (the Windows code) dumps its samples into a ring
+// buffer and SDL's audio callback (which runs in its own thread) takes them
+// out again.  There is exactly one writer and one reader, so the ring needs
+// no lock: SDLSoundBufferIn is only changed by the emulator thread and
+// SDLSoundBufferOut is only changed by the audio thread.  Both count bytes
+// since the buffer was reset and are only wrapped (by masking) when used as
+// an index, so In - Out is always the number of bytes waiting to be played.
+//
+// The size must be a power of two.
+#define SOUND_BUFFER_SIZE (128*1024)
+#define SOUND_BUFFER_MASK (SOUND_BUFFER_SIZE-1)
+static Uint8 SDLSoundBuffer[SOUND_BUFFER_SIZE];
+
+static volatile unsigned long SDLSoundBufferIn;
+static volatile unsigned long SDLSoundBufferOut;
 
-// Offset within sound buffer for adding sound to the buffer:
-unsigned long SDLSoundBufferOffset_IN;
+// Set by anyone who wants the buffered sound cut down to size, done by the
+// audio thread the next time it runs.
+static volatile int SDLSoundCatchupWanted;
 
-// Offset within sound buffer for reading sound from the buffer:
-unsigned long SDLSoundBufferOffset_OUT;
+// Set by FlushSoundBuffer when everything buffered should go, again done by
+// the audio thread.  This takes priority over a catch up.
+static volatile int SDLSoundFlushWanted;
 
-// Number of bytes left in the buffer.  I.e.: the amount we've yet to read
-// (or dump if sound latency becomes too high):
-unsigned long SDLSoundBufferBytesHave;
+// Number of times SDL asked for more sound than we had (underruns) and
+// number of times the core gave us more than would fit (overruns):
+volatile unsigned long SDLSoundUnderruns;
+volatile unsigned long SDLSoundOverruns;
+
+// Make sure the other thread sees the buffer contents before the index that
+// says they're there (and is done with them before we overwrite them).
+#define SOUND_BUFFER_BARRIER() __sync_synchronize()
 
 unsigned int ScalingTable[1024];
 
@@ -76,146 +99,196 @@ unsigned int ScalingTable[1024];
 // we submit our request for a sound stream):
 int samples;
 
-// Sigh, look what I've reduced myself to..  The sound support here is truly
-// shocking.. Please feel free to rewrite it for me..
+// The sound format we asked SDL for (and got, as we force it):
+SDL_AudioSpec wanted;
+
+// Only call this while the audio callback is stopped.
 void InitializeSoundBuffer(void)
 {
-	SDLSoundBufferOffset_IN =0;
-	SDLSoundBufferOffset_OUT = 0;
-	SDLSoundBufferBytesHave = 0;
-
-	int i;
-	for(i=0; i< SOUND_BUFFER_SIZE; i++)
-		SDLSoundBuffer[i] = (Uint8) 0;	
+	SDLSoundBufferIn = 0;
+	SDLSoundBufferOut = 0;
+	SDLSoundCatchupWanted = 0;
+	SDLSoundFlushWanted = 0;
+	SDLSoundUnderruns = 0;
+	SDLSoundOverruns = 0;
+
+	memset(SDLSoundBuffer, 0, SOUND_BUFFER_SIZE);
 }
 
 // When the user switches to the menu, use it as an excuse to flush the buffer.
+// Everything still waiting is thrown away the next time the audio thread runs
+// (see fill_audio), so the first thing heard afterwards is new sound.
 void FlushSoundBuffer(void)
 {
-	InitializeSoundBuffer();
+	SDLSoundFlushWanted = 1;
+}
+
+// Guess what this does. 
+unsigned long HowManyBytesLeftInSDLSoundBuffer(void)
+{
+	return SDLSoundBufferIn - SDLSoundBufferOut;
 }
 
 // The BeebEm emulator core (the Windows code) calls this when it wants to
-// play some samples.  We place those samples in our bloody huge buffer 
-// instead.
+// play some samples.  We copy them into the ring in at most two pieces (either
+// side of the wrap).  Anything that doesn't fit is dropped.
 void AddBytesToSDLSoundBuffer(void *p, int len)
 {
-	int i;
-	Uint8 *pp;
-	pp = (Uint8*) p;
+	Uint8 *pp = (Uint8*) p;
+	unsigned long in = SDLSoundBufferIn;
+	unsigned long space = SOUND_BUFFER_SIZE - (in - SDLSoundBufferOut);
+	unsigned long offset, first;
 
-	//printf("ADDED %d BYTES\n %d %d %d", len, (int) pp[0], (int) pp[1], (int) pp[2]);
-
-	for(i=0; i<len; i++){
-		SDLSoundBuffer[SDLSoundBufferOffset_IN] = *(pp++);
+	if (len <= 0)
+		return;
 
-		SDLSoundBufferOffset_IN++;
-		if (SDLSoundBufferOffset_IN >= SOUND_BUFFER_SIZE)
-			SDLSoundBufferOffset_IN = (unsigned long) 0;
+	if ((unsigned long) len > space){
+		SDLSoundOverruns++;
+		len = space;
 	}
-	SDLSoundBufferBytesHave+=len;
+
+	offset = in & SOUND_BUFFER_MASK;
+	first = SOUND_BUFFER_SIZE - offset;
+	if (first > (unsigned long) len)
+		first = len;
+
+	memcpy(SDLSoundBuffer + offset, pp, first);
+	memcpy(SDLSoundBuffer, pp + first, len - first);
+
+	SOUND_BUFFER_BARRIER();
+	SDLSoundBufferIn = in + len;
 }
 
-// Returns a sequential buffer containing the next
-// block of sound for SDL to play.
-//
-// Due to the wrap effect of the bloody huge buffer above, I need to copy
-// the samples SDL will one into a sequencial list..
-Uint8 SequentialSDLSoundBuffer[10*1024]; // I'm assuming SDL wont want 10k..
+// Hands up to 'len' bytes of the ring straight to SDL_MixAudio (again in at
+// most two pieces) and returns how many it managed.  Only called from the
+// audio callback.
+static int MixBytesFromSDLSoundBuffer(Uint8 *stream, int len)
+{
+	unsigned long out = SDLSoundBufferOut;
+	unsigned long have = SDLSoundBufferIn - out;
+	unsigned long offset, first;
+
+	SOUND_BUFFER_BARRIER();
+
+	if ((unsigned long) len > have){
+		SDLSoundUnderruns++;
+		len = have;
+	}
 
-// Get pointer to above array..
-Uint8* GetSoundBufferPtr(void)
+	offset = out & SOUND_BUFFER_MASK;
+	first = SOUND_BUFFER_SIZE - offset;
+	if (first > (unsigned long) len)
+		first = len;
+
+	SDL_MixAudio(stream, SDLSoundBuffer + offset, first, SDL_MIX_MAXVOLUME);
+	if ((unsigned long) len > first)
+		SDL_MixAudio(stream + first, SDLSoundBuffer, len - first
+		 , SDL_MIX_MAXVOLUME);
+
+	SOUND_BUFFER_BARRIER();
+	SDLSoundBufferOut = out + len;
+
+	return len;
+}
+
+// We dump everything apart from two blocks overwise we're always living on a
+// knife edge.. (i.e.: we're max'ed out all the time and have no spare
+// resources to fall back on.  Only the audio thread moves SDLSoundBufferOut
+// so this just asks it to.
+void CatchupSound(void)
 {
-	return SequentialSDLSoundBuffer;
+	SDLSoundCatchupWanted = 1;
 }
 
-// Removes 'len' bytes from the bloody huge wrapped sound buffer and places it
-// into the sequencial list above..  If there are less than 'len' samples
-// available, it copies what's available into the sequencial buffer and returns
-// the actual amount it managed to copy.  So you need to check the return
-// value.
-int GetBytesFromSDLSoundBuffer(int len)
+// Drops all but 'keep' bytes from the ring.  Audio thread only.
+static void DropSoundBuffer(unsigned long keep)
 {
-	static unsigned int uiCatchedUpTimes = 0;
-	int i;
-	Uint8 *p;
+	unsigned long have = SDLSoundBufferIn - SDLSoundBufferOut;
 
-	// check for under sampling (len > SDLSoundBufferBytesHave)
-	// (this needs to be communicated back to the caller as the return
-	//  value).
-	if ( (unsigned long) len > SDLSoundBufferBytesHave)
-		len = SDLSoundBufferBytesHave;
+	if (have > keep)
+		SDLSoundBufferOut += have - keep;
+}
 
-	p = SequentialSDLSoundBuffer;
+static void DoCatchupSound(void)
+{
+	SDLSoundCatchupWanted = 0;
+	DropSoundBuffer((unsigned long) samples * 2);
+}
 
-	for(i=0; i<len; i++){
-		*(p++) = SDLSoundBuffer[SDLSoundBufferOffset_OUT];
-		
-		SDLSoundBufferOffset_OUT++;
-		if (SDLSoundBufferOffset_OUT >= SOUND_BUFFER_SIZE)
-                        SDLSoundBufferOffset_OUT = (unsigned long) 0;
+static void DoFlushSound(void)
+{
+	SDLSoundFlushWanted = 0;
+	SDLSoundCatchupWanted = 0;
+	DropSoundBuffer(0);
+}
+
+// Sound rate control (used when cfg_WantLowLatencySound is on):
+//
+// Rather than dumping sound whenever too much builds up, the audio callback
+// looks at how much is left in the ring after each block and nudges the rate
+// the core generates samples at (SDLSoundRatePPM, in parts per million) so
+// that settles on cfg_SoundLatency milliseconds.  The correction is limited
+// to +/-0.5% so the change in pitch can't be heard.  It's only if the core is
+// running way off real time (fixed speed settings, or a long stall) that
+// sound still gets thrown away.
+#define SOUND_RATE_MAX_PPM	5000
+// Seconds to take to work off an error in the fill level:
+#define SOUND_RATE_SECONDS	2.0
+// Weight given to each new fill measurement in the running average:
+#define SOUND_FILL_SMOOTHING	(1.0/16)
+
+volatile int SDLSoundRatePPM = 0;
+static double SDLSoundFillAverage = 0;
+
+static void UpdateSoundRate(void)
+{
+	double target = (double) cfg_SoundLatency * wanted.freq / 1000.0;
+	double fill = (double) HowManyBytesLeftInSDLSoundBuffer();
+	double ppm;
+
+	// Way too far behind to correct gently, so jump back to the target.
+	if (fill > target + wanted.freq / 2){
+		DropSoundBuffer((unsigned long) target);
+		fill = target;
 	}
 
-	SDLSoundBufferBytesHave-=len;
-
-//#ifdef WANT_LOW_LATENCY_SOUND
-	if (cfg_WantLowLatencySound){
-		// I really need to catchup if SDLSoundBufferBytesHave becomes too large
-		// otherwise the sound will lag more and more behind the action..
-		//
-		// Things shouldn't be getting out of sync as everything is timed to
-		// the systems clock..  But it is..
-		//
-		// Ok, so, if we have more than five blocks that SDL will want soon left
-		// in the sound buffer, lets catch-up by dumping some sound.
-		// Hopefully when some other task slows down beebem the sound will
-		// crackle but action sound effects will remain in sync.
-		//
-		// I'll make this optional in the final version so users can either
-		// have good but high latency sound, or maybe crap but low latency
-		// sound..
-		//
-		// I could also make sure that if the user switches to the Hatari GUI
-		// menu I use it as an excuse to dump everything in the sound buffer.
-		if (SDLSoundBufferBytesHave > ( (unsigned long) samples * 5)){
-			pDEBUG(dL"Dumping some sound samples, catched up %u times so far..", dR
-			 , ++uiCatchedUpTimes);
-	
-//			// we dump everything apart from two blocks overwise we're
-//			// always living on a knife edge.. (i.e.: we're max'ed out
-//			// all the time and have no spare resources to fall back on.
-//			while (SDLSoundBufferBytesHave > ( (unsigned long)samples * 2)){
-//				SDLSoundBufferOffset_OUT++;
-//				if (SDLSoundBufferOffset_OUT >= SOUND_BUFFER_SIZE)
-//					SDLSoundBufferOffset_OUT = (unsigned long) 0;
-//				SDLSoundBufferBytesHave--;
-//			}
-			CatchupSound();
+	SDLSoundFillAverage += (fill - SDLSoundFillAverage) * SOUND_FILL_SMOOTHING;
 
-		}
-	}
-//#endif
+	ppm = (target - SDLSoundFillAverage) * 1000000.0
+	 / (SOUND_RATE_SECONDS * wanted.freq);
+	if (ppm > SOUND_RATE_MAX_PPM)
+		ppm = SOUND_RATE_MAX_PPM;
+	if (ppm < -SOUND_RATE_MAX_PPM)
+		ppm = -SOUND_RATE_MAX_PPM;
 
-	return len;
+	SDLSoundRatePPM = (int) ppm;
 }
 
-void CatchupSound(void)
+// The latency the rate control is actually achieving: what's waiting in the
+// ring plus the block SDL is playing.
+int GetSDLSoundLatency(void)
 {
-                        // we dump everything apart from two blocks overwise we're
-                        // always living on a knife edge.. (i.e.: we're max'ed out
-                        // all the time and have no spare resources to fall back on.
-                        while (SDLSoundBufferBytesHave > ( (unsigned long)samples * 2)){
-                                SDLSoundBufferOffset_OUT++;
-                                if (SDLSoundBufferOffset_OUT >= SOUND_BUFFER_SIZE)
-                                        SDLSoundBufferOffset_OUT = (unsigned long) 0;
-                                SDLSoundBufferBytesHave--;
-                        }
+	if (wanted.freq == 0)
+		return 0;
+
+	return (int) ((SDLSoundFillAverage + samples) * 1000.0 / wanted.freq);
 }
 
-// Guess what this does. 
-unsigned long HowManyBytesLeftInSDLSoundBuffer(void)
+// Log the underruns and overruns since the last report and the latency
+// being held.  The totals are left alone for FreeSDLSound().
+void ReportSoundStatistics(void)
 {
-	return SDLSoundBufferBytesHave;
+	static unsigned long reported_underruns = 0;
+	static unsigned long reported_overruns = 0;
+	unsigned long underruns = SDLSoundUnderruns;
+	unsigned long overruns = SDLSoundOverruns;
+
+	pINFO(dL"Sound: %lu underruns, %lu overruns, latency %d ms.", dR
+	 , underruns - reported_underruns, overruns - reported_overruns
+	 , GetSDLSoundLatency());
+
+	reported_underruns = underruns;
+	reported_overruns = overruns;
 }
 
 /*
@@ -255,6 +328,60 @@ SDL_Surface *icon = NULL;
 SDL_Surface *video_output = NULL;
 SDL_Surface *screen_ptr = NULL;
 
+/* The pixel format video_output was created with (cfg_TrueColour), and the
+ * XRGB pixel for each of the core's colour numbers when it's 32 bit.
+ */
+int VideoOutputXRGB = 0;
+Uint32 XRGBPalette[256];
+
+static int CurrentPaletteType = BeebWin::RGB;
+
+/* Frame presentation:
+ *
+ * The emulator core draws into video_output through GetSDLScreenLinePtr(),
+ * which marks each line it hands out as dirty.  Once a frame (at VSYNC)
+ * BeebWin::updateLines() calls PresentFrame(), which only blits the dirty
+ * lines that differ from what it last presented, then updates the display
+ * once with the rows it touched merged into as few rectangles as possible.
+ *
+ * Anything that draws straight onto the window (ClearVideoWindow(), the GUI)
+ * must make the next frame present every line again.
+ */
+#define DIRTY_LINE_WORDS	((BEEBEM_VIDEO_CORE_SCREEN_HEIGHT+31)/32)
+
+static Uint32 DirtyLines[DIRTY_LINE_WORDS];
+static unsigned char *PresentedLines = NULL;
+static int PresentedPitch = 0;
+static int PresentAllLines = 1;
+
+static SDL_Rect PresentRects[BEEBEM_VIDEO_CORE_SCREEN_HEIGHT];
+static int NumPresentRects = 0;
+
+/* Time spent presenting frames since the last ReportPresentationStatistics().
+ */
+static unsigned long PresentMicroSeconds = 0;
+static unsigned long PresentedFrames = 0;
+
+static inline void MarkLineDirty(int line)
+{
+	if (line >= 0 && line < BEEBEM_VIDEO_CORE_SCREEN_HEIGHT)
+		DirtyLines[line >> 5] |= 1U << (line & 31);
+}
+
+static void CreatePresentedLines(int bytes_per_pixel)
+{
+	PresentedPitch = BEEBEM_VIDEO_CORE_SCREEN_WIDTH * bytes_per_pixel;
+	PresentedLines = (unsigned char*) malloc(PresentedPitch
+	 * BEEBEM_VIDEO_CORE_SCREEN_HEIGHT);
+	PresentAllLines = 1;
+}
+
+static void DestroyPresentedLines(void)
+{
+	free(PresentedLines);
+	PresentedLines = NULL;
+}
+
 /* If we're using X11, we need to release the Caps Lock key ourselves.
  */
 int	cfg_HaveX11 = 0;
@@ -270,76 +397,85 @@ int 	cfg_Fullscreen_Resolution = RESOLUTION_640X480_S; // -1;
 int	cfg_Windowed_Resolution = RESOLUTION_640X480_S;  // -1;
 int	cfg_VerticalOffset = ((512-480)/2);
 
-/* If this is defined then the sound code will dump samples (causing distortion)
- * whenever the buffer becomes too large (i.e.: over 5 lots of samples or some
- * such).  If I don't do this then the sound effects in games will happen
- * longer and longer after the event.
+/* If this is set the sound code keeps the amount of queued sound steady at
+ * cfg_SoundLatency ms by adjusting the sample rate slightly (see
+ * UpdateSoundRate).  If I don't do this then the sound effects in games will
+ * happen longer and longer after the event.
  *
  * This is coursed by other processes slowing down BeebEm and the timing of the
  * emulator becoming wrong.  BeebEm will try to compensate, by creating new
  * sound data for the missing time that's then dumped into my sound buffer.
- *
- * It should all work nicely, the emulator core will catchup to the current time
- * and I'll get lots of new sound to play, but the timings off somewhere
- * so this missing sound is converted from a catchup into a latency problem.
- * Unfortunely the more and more interruptions BeebEm has to handle the greater
- * the sound latency problem becomes..  So for I'm going to dump samples when
- * the latency is too great..  If you'd rather have nicer sound (with the
- * latency problem) then remove the definition below.
+ * The rate control soaks that up gradually rather than dumping samples.
  */
 //#define WANT_LOW_LATENCY_SOUND
 int	cfg_WantLowLatencySound = 1;
 
+/* Amount of sound (in ms) the low latency rate control tries to keep queued.
+ */
+int	cfg_SoundLatency = 20;
+
 /* Wait type for 'sleep'.
  */
 int	cfg_WaitType = OPT_SLEEP_OS;
 
-/*	-	-	-	-	-	-	-
+/* Number of cycles to run the emulator core for between SDL event polls.
  */
+int	cfg_EmulationSlice = SLICE_INSTRUCTIONS;
+int	cfg_ShowHostOverhead = 0;
 
-SDL_AudioSpec wanted;
+/* Run the 65C02 second processor on its own thread.
+ */
+int	cfg_TubeThread = 0;
+
+/* 65C02 second processor speed in MHz, 0 for unthrottled.
+ */
+int	cfg_TubeSpeed = 3;
+
+/* Have the emulator core draw 32 bit XRGB pixels.
+ */
+int	cfg_TrueColour = 0;
+
+/* Scanline expander kernel for graphics modes, 0 for the fastest the CPU has.
+ */
+int	cfg_ScanLineKernel = 0;
+
+/* Run the Z80 second processor with lazily evaluated flags.
+ */
+int	cfg_Z80LazyFlags = 0;
+
+/*	-	-	-	-	-	-	-
+ */
 
 void fill_audio(void *udata, Uint8 *stream, int len)
 {
-	Uint8 *p;
-
 	void *tmp_udata;
 	tmp_udata = udata;
 
+	if (SDLSoundFlushWanted)
+		DoFlushSound();
+	else if (SDLSoundCatchupWanted)
+		DoCatchupSound();
+
 	/* Only play if we have data left */
-	if (HowManyBytesLeftInSDLSoundBuffer() == 0)
+	if (HowManyBytesLeftInSDLSoundBuffer() == 0){
+		SDLSoundUnderruns++;
 		return;
-//	if ( audio_len == 0 )
-//		return;
-
-	// We can only play upto one sample.  I'll fix this later..
-//	len = ( len > samples ? samples : len );
-
-//	// Add debuging sound to sound buffer.
-//	AddBytesToSDLSoundBuffer(audio_pos, len);
-//	audio_pos += len;
-//	audio_len -= len;
-
-
+	}
 
-	
-	if (len > (int) HowManyBytesLeftInSDLSoundBuffer() )
-		len = HowManyBytesLeftInSDLSoundBuffer();
+	MixBytesFromSDLSoundBuffer(stream, len);
 
-	p = GetSoundBufferPtr();
-	len = GetBytesFromSDLSoundBuffer(len);
-	SDL_MixAudio(stream, p, len, SDL_MIX_MAXVOLUME);
+	// Keep the latency steady by adjusting the sample rate rather than
+	// dumping sound (see UpdateSoundRate).
+	if (cfg_WantLowLatencySound)
+		UpdateSoundRate();
+	else
+		SDLSoundRatePPM = 0;
 }
 
 int InitializeSDLSound(int soundfrequency)
 {
 	samples = REQUESTED_NUMBER_OF_SAMPLES;
 
-	// Offset within sound buffer.
-	SDLSoundBufferOffset_IN = 0;
-	SDLSoundBufferOffset_OUT = 0;
-	SDLSoundBufferBytesHave = 0;
-
 	wanted.freq = soundfrequency;
 	wanted.format = AUDIO_U8;
 	wanted.channels = 1;
@@ -359,6 +495,8 @@ int InitializeSDLSound(int soundfrequency)
 //      audio_len = SOUNDFILESIZE;
 
 	InitializeSoundBuffer();
+	SDLSoundRatePPM = 0;
+	SDLSoundFillAverage = 0;
 
 	SDL_PauseAudio(0);
 	SDL_Delay(500);
@@ -369,24 +507,42 @@ int InitializeSDLSound(int soundfrequency)
 void FreeSDLSound(void)
 {
 	SDL_CloseAudio();
+
+	if (SDLSoundUnderruns != 0 || SDLSoundOverruns != 0)
+		pINFO(dL"Sound buffer underruns: %lu, overruns: %lu, latency %d ms", dR
+		 , SDLSoundUnderruns, SDLSoundOverruns, GetSDLSoundLatency());
 }
 
-/* Setup palette.
+/* Set some of the colours the core's colour numbers stand for.  An 8 bit
+ * video_output (and window) get them as palette entries, a 32 bit one has
+ * them looked up as XRGB pixels.
  */
-void SetBeebEmEmulatorCoresPalette(unsigned char *cols, int palette_type)
+static void SetVideoOutputColors(SDL_Color *colors, int first, int n)
 {
-	SDL_Color colors[8];
+	if (VideoOutputXRGB){
+		for (int i = 0; i < n; ++i)
+			XRGBPalette[first+i] = SDL_MapRGB(video_output->format
+			 , colors[i].r, colors[i].g, colors[i].b);
+		return;
+	}
 
-	/* BeebEm video.cpp needs to use colors 0 to 7.
+	/* Set bitmaps palette.
 	 */
-	for(int i=0;i<8;i++)
-		*(cols++) = (unsigned char) i;
+	SDL_SetColors(video_output, colors, first, n);
 
-	if (screen_ptr == NULL){
-		fprintf(stderr, "Trying to read palette before window is"
-		 " opened!\nYou will need to fix this..");
-		exit(1);
-	}
+	/* Force X Servers palette to change to our colors.
+	 */
+//#ifdef WITH_FORCED_CM
+	SDL_SetColors(screen_ptr, colors, first, n);
+//#endif
+}
+
+/* Set the colours for the BBC's palette (plain RGB or one of the monitor
+ * types), the LEDs and the menus.
+ */
+static void SetVideoOutputPalette(int palette_type)
+{
+	SDL_Color colors[8];
 
 	/* Set the palette:
 	 */
@@ -418,16 +574,7 @@ void SetBeebEmEmulatorCoresPalette(unsigned char *cols, int palette_type)
 		colors[i].g = (int) g;
 		colors[i].b = (int) b;
 	}
-	
-	/* Set bitmaps palette.
-	 */
-	SDL_SetColors(video_output, colors, 0, 8);
-
-	/* Force X Servers palette to change to our colors.
-	 */
-//#ifdef WITH_FORCED_CM
-	SDL_SetColors(screen_ptr, colors, 0, 8);
-//#endif
+	SetVideoOutputColors(colors, 0, 8);
 
 	/* Set LED colors.
 	 */
@@ -435,11 +582,7 @@ void SetBeebEmEmulatorCoresPalette(unsigned char *cols, int palette_type)
 	colors[1].r = 255; colors[1].g = 0; colors[1].b = 0;
 	colors[2].r = 0; colors[2].g = 127; colors[2].b = 0;
 	colors[3].r = 0; colors[3].g = 255; colors[3].b = 0;
-	SDL_SetColors(video_output, colors, 64, 4);
-
-//#ifdef WITH_FORCED_CM
-	SDL_SetColors(screen_ptr, colors, 64, 4);
-//#endif
+	SetVideoOutputColors(colors, 64, 4);
 
 	/* Menu colors.
 	 */
@@ -458,12 +601,43 @@ void SetBeebEmEmulatorCoresPalette(unsigned char *cols, int palette_type)
         colors[3].b = (int) (colors[0].b * 0.9);
 
 
-	SDL_SetColors(video_output, colors, 68, 4);
+	SetVideoOutputColors(colors, 68, 4);
 
-//#ifdef WITH_FORCED_CM
-	SDL_SetColors(screen_ptr, colors, 68, 4);
-//#endif
+	/* 32 bit fast tables hold the colours themselves.
+	 */
+	if (VideoOutputXRGB)
+		FastTable_Valid=0;
+}
 
+/* Setup palette.
+ */
+void SetBeebEmEmulatorCoresPalette(unsigned char *cols, int palette_type)
+{
+	/* BeebEm video.cpp needs to use colors 0 to 7.
+	 */
+	for(int i=0;i<8;i++)
+		*(cols++) = (unsigned char) i;
+
+	if (screen_ptr == NULL){
+		fprintf(stderr, "Trying to read palette before window is"
+		 " opened!\nYou will need to fix this..");
+		exit(1);
+	}
+
+	CurrentPaletteType = palette_type;
+	SetVideoOutputPalette(palette_type);
+}
+
+/* The cursor inverts the colour number under it, so find the pixel's colour
+ * number and give the XRGB pixel for the inverted one.
+ */
+Uint32 InvertXRGBPixel(Uint32 pixel, int col)
+{
+	for (int i = 0; i < 8; ++i)
+		if (XRGBPalette[i] == pixel)
+			return XRGBPalette[(i ^ col) & 7];
+
+	return pixel ^ 0x00ffffff;
 }
 
 void CreateScalingTable(void)
@@ -480,13 +654,65 @@ int GetScaledScanline(int y)
 	return ScalingTable[y];
 }
 
+/* Create an area the BeebEm emulator core (the Windows code) can draw on.
+ * It's an 800x600 bitmap of 8 bit palette indices, or of 32 bit XRGB pixels
+ * if cfg_TrueColour is set.  It's only recreated if that's changed.
+ */
+static bool CreateVideoOutput(bool *created)
+{
+	int xrgb = cfg_TrueColour ? 1 : 0;
+
+	*created = false;
+	if (video_output != NULL && xrgb == VideoOutputXRGB)
+		return true;
+
+	if (video_output != NULL){
+		SDL_FreeSurface(video_output);
+		DestroyPresentedLines();
+	}
+
+	if (xrgb)
+		video_output = SDL_CreateRGBSurface(SDL_SWSURFACE
+		 , BEEBEM_VIDEO_CORE_SCREEN_WIDTH, BEEBEM_VIDEO_CORE_SCREEN_HEIGHT
+		 , 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0);
+	else
+		video_output = SDL_CreateRGBSurface(SDL_SWSURFACE
+		 , BEEBEM_VIDEO_CORE_SCREEN_WIDTH, BEEBEM_VIDEO_CORE_SCREEN_HEIGHT
+		 , 8, 0, 0, 0, 0);
+
+	if (video_output == NULL){
+		fprintf(stderr, "Unable to create a bitmap buffer: %s\n"
+		 , SDL_GetError());
+		return false;
+	}
+	VideoOutputXRGB = xrgb;
+	memset(video_output->pixels, 0, video_output->h * video_output->pitch);
+
+	// Keep a copy of what was last presented of each line.
+	CreatePresentedLines(video_output->format->BytesPerPixel);
+	if (PresentedLines == NULL){
+		fprintf(stderr, "Unable to allocate the presented lines buffer\n");
+		return false;
+	}
+
+	// The fast tables have to be rebuilt for the new pixel format.
+	FastTable_Valid=0;
+
+	*created = true;
+	return true;
+}
+
 int Create_Screen(void)
 {
         /* Initialize SDL applications window.
-         * NOTE: Both window and video_output surfaces are fixed to 8bit
-	 * depth at the moment.  I'll work on fixing it later.. 
+         * NOTE: The window has the same depth as video_output, 8 bit
+	 * palette indices or 32 bit XRGB pixels (cfg_TrueColour).
 	 */
 	Uint32 flags, width, height;
+	bool new_video_output;
+
+	if (! CreateVideoOutput(&new_video_output))
+		return false;
 
 //#define RESOLUTION_640X512	0
 //#define RESOLUTION_640X480_S	1
@@ -573,7 +799,7 @@ int Create_Screen(void)
 
  //      if ( (screen_ptr=SDL_SetVideoMode(SDL_WINDOW_WIDTH, SDL_WINDOW_HEIGHT
         if ( (screen_ptr=SDL_SetVideoMode(width, height
-	 , 8, flags ) ) == NULL){
+	 , VideoOutputXRGB ? 32 : 8, flags ) ) == NULL){
                 fprintf(stderr, "Unable to set video mode: %s\n"
 		 , SDL_GetError());
 
@@ -596,8 +822,12 @@ int Create_Screen(void)
 
 //DL_SetColors(SDL_Surface *surface, SDL_Color *colors, int firstcolor, int ncolors);
 
-	SDL_SetColors(screen_ptr, video_output->format->palette->colors, 0
-	 , video_output->format->palette->ncolors-1);
+	if (new_video_output)
+		SetVideoOutputPalette(CurrentPaletteType);
+
+	if (! VideoOutputXRGB)
+		SDL_SetColors(screen_ptr, video_output->format->palette->colors, 0
+		 , video_output->format->palette->ncolors-1);
 
 //printf("4: SDL_SetColors called\n");
 
@@ -619,7 +849,6 @@ void Destroy_Screen(void)
 int InitialiseSDL(int argc, char *argv[])
 {
 	char video_hardware[1024];
-	Uint32 flags;
 	int tmp_argc;
 	char **tmp_argv;
 
@@ -658,19 +887,6 @@ int InitialiseSDL(int argc, char *argv[])
 
 //	SDL_ShowCursor(SDL_DISABLE);		// SDL_ENABLE
 
-	/* Create an area the BeebEm emulator core (the Windows code)
-	 * can draw on.  It's hardwired to an 800x600 8bit byte per pixel
-	 * bitmap.
-	 */
-	flags = SDL_SWSURFACE; 
-	if ( (video_output = SDL_CreateRGBSurface(flags
-	 , BEEBEM_VIDEO_CORE_SCREEN_WIDTH, BEEBEM_VIDEO_CORE_SCREEN_HEIGHT
-	 , 8, 0, 0, 0, 0) ) == NULL){
-		fprintf(stderr, "Unable to create a bitmap buffer: %s\n"
-		 , SDL_GetError());
-		return false;
-	}
-
 	// Create scaling table to convert 512/256 to 480/240
 	CreateScalingTable();
 
@@ -702,6 +918,7 @@ void UninitialiseSDL(void)
 	SDL_CloseAudio();	
 	SDL_ShowCursor(SDL_ENABLE);
 	SDL_FreeSurface(video_output);
+	DestroyPresentedLines();
 }
 
 
@@ -904,6 +1121,36 @@ void SaferSleep2(unsigned int uiTicks)
 */
 
 
+// Add window rows to the area updated at the end of the frame.
+static void AddPresentRows(int y, int h)
+{
+	SDL_Rect *r;
+
+	if (y + h > screen_ptr->h)
+		h = screen_ptr->h - y;
+	if (y < 0 || h <= 0)
+		return;
+
+	// Lines arrive top to bottom, so only the last rectangle can grow.
+	if (NumPresentRects > 0){
+		r = &PresentRects[NumPresentRects-1];
+		if (y >= r->y && y <= r->y + r->h){
+			if (y + h > r->y + r->h)
+				r->h = y + h - r->y;
+			return;
+		}
+	}
+
+	if (NumPresentRects == BEEBEM_VIDEO_CORE_SCREEN_HEIGHT){
+		SDL_UpdateRects(screen_ptr, NumPresentRects, PresentRects);
+		NumPresentRects = 0;
+	}
+
+	r = &PresentRects[NumPresentRects++];
+	r->x = 0; r->y = y; r->w = screen_ptr->w; r->h = h;
+}
+
+
 // Clear video window
 void ClearVideoWindow(void)
 {
@@ -911,17 +1158,137 @@ void ClearVideoWindow(void)
 
 	SDL_FillRect(screen_ptr, NULL, col);
 	SDL_UpdateRect(screen_ptr,0,0,screen_ptr->w,screen_ptr->h);
+
+	PresentAllLines = 1;
 }
 
 
-void RenderLine(int line, int isTeletext, int xoffset)
+/* Work out which window row a teletext line of video_output goes to, the 480
+ * line resolutions scaling them down.  Several lines can share a row, the
+ * last one drawn being the one seen (the mode 7 glyph atlas in video.cpp
+ * merges them first).
+ */
+int GetTeletextWindowRow(int line, bool fullscreen_val)
+{
+	switch ( fullscreen_val?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
+	case RESOLUTION_640X480_S:
+	case RESOLUTION_640X480_V:
+	case RESOLUTION_320X240_S:
+	case RESOLUTION_320X240_V:
+		return GetScaledScanline(line);
+	default:
+		return line;
+	}
+}
+
+/* Work out which window row a line of video_output goes to.  Returns -1 if
+ * the line isn't shown, and sets scan_double if graphics lines are doubled
+ * up.
+ */
+static int GetWindowRow(int line, int isTeletext, bool fullscreen_val, int *scan_double)
+{
+	int disable_grille_for_teletext = 0;
+	int window_y;
+
+	*scan_double = 0;
+
+	// Render a teletext line
+	if (isTeletext){
+		
+		if (line <0 || line > 511)
+			return -1;
+
+		window_y = GetTeletextWindowRow(line, fullscreen_val);
+
+		switch ( fullscreen_val?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
+		case RESOLUTION_320X240_S:
+		case RESOLUTION_320X240_V:
+		case RESOLUTION_320X256:
+			disable_grille_for_teletext=1;
+			break;
+		default:
+			break;
+		}
+
+		// Even lines are left dark when emulating a CRT.
+		if ( cfg_EmulateCrtTeletext != 0 && (line & 1) == 0 && disable_grille_for_teletext == 0)
+			return -1;
+
+	// render a graphics mode line.
+	}else{
+		window_y = (line -32);
+
+		// Line may have moved off the top, so check here.
+		if (window_y < 0 || window_y > 255)
+			return -1;
+	
+		switch ( fullscreen_val?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
+		case RESOLUTION_640X512:
+			window_y = window_y * 2;
+			*scan_double = 1;
+			break;
+		case RESOLUTION_640X480_S:
+			window_y = GetScaledScanline(window_y*2);
+			*scan_double = 1;
+			break;
+		case RESOLUTION_640X480_V:
+			window_y = window_y * 2;
+			window_y -= cfg_VerticalOffset;
+			*scan_double = 1;
+			break;
+		case RESOLUTION_320X240_S:
+			window_y = GetScaledScanline(window_y+1);
+			break;
+		case RESOLUTION_320X240_V:
+			window_y -= cfg_VerticalOffset>>1;
+			break;
+		case RESOLUTION_320X256:
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Line may be unwanted.
+	if (window_y < 0 || window_y >= screen_ptr->h)
+		return -1;
+
+	return window_y;
+}
+
+
+// Blit one line of video_output to the window.
+static void RenderLine(int line, int window_y, int scan_double)
+{
+	SDL_Rect src, dst;
+
+	src.x=0; src.y=line; src.w=screen_ptr->w; src.h=1;
+	dst.x=0; dst.y=window_y; dst.w=screen_ptr->w; dst.h=1;
+
+	SDL_BlitSurface(video_output, &src, screen_ptr, &dst);
+
+	// Graphics mode is never more than 256 scanlines so
+	// double up the lines
+	if ( scan_double && (! cfg_EmulateCrtGraphics) ){
+		src = dst;
+		dst.y +=1;
+		SDL_BlitSurface(screen_ptr, &src, screen_ptr, &dst);
+		AddPresentRows(window_y, 2);
+	}else{
+		AddPresentRows(window_y, 1);
+	}
+}
+
+
+void PresentFrame(int starty, int nlines, int isTeletext, int xoffset)
 {
 	static int last_isTeletext = 1, last_xoffset = 0, last_mode_graphics = 0, last_mode_text = 0;
+	static int last_vertical_offset = 0;
 
 	bool fullscreen_val = false;
-
-	int scan_double = 0;
-	int disable_grille_for_teletext = 0;
+	int line, endy, width, window_y, scan_double, last_window_y;
+	unsigned char *p, *q;
+	Uint32 bit, start_time;
 
 	if (mainWin!=NULL) fullscreen_val = mainWin->IsFullScreen();
 
@@ -937,191 +1304,96 @@ void RenderLine(int line, int isTeletext, int xoffset)
 		last_mode_text = cfg_EmulateCrtTeletext;
 	}
 
-	// Don't bother to render if not active.
-	if ( (SDL_GetAppState() & SDL_APPACTIVE) == 0)
-		return;
+	// Lines move when the vertical offset does.
+	if (cfg_VerticalOffset != last_vertical_offset){
+		ClearVideoWindow();
+		last_vertical_offset = cfg_VerticalOffset;
+	}
 
-	//printf("%d\n", xoffset);
+	// Don't bother to render if not active, and redraw everything once we
+	// are again.
+	if ( (SDL_GetAppState() & SDL_APPACTIVE) == 0){
+		PresentAllLines = 1;
+		return;
+	}
 
 	// If mode changes between teletext and graphics clear the screen.
 	// *** this could really be nasty with split gfx res stuff.  Fuck it..
 	if (last_isTeletext != isTeletext || last_xoffset != xoffset){
-
-
-//		Uint32 col = SDL_MapRGB(screen_ptr->format, 0x00, 0x00, 0x00);
-//
-//		SDL_FillRect(screen_ptr, NULL, col);
-//		SDL_UpdateRect(screen_ptr,0,0,SDL_WINDOW_WIDTH,SDL_WINDOW_HEIGHT);
 		ClearVideoWindow();
-
-		//fprintf(stderr, "*** CLEARING WHOLE SCREEN ***\n");
-		//SDL_Delay(3000);
 		last_isTeletext = isTeletext;
 		last_xoffset = xoffset;
 	}
 
 	// Make sure we're trying to draw within a sane part of the bitmap
-	if (video_output != NULL && screen_ptr != NULL){
-		SDL_Rect src, dst;
-
-		// Render a teletext line
-		if (isTeletext){
-			
-			if (line <0 || line > 511)
-				return;
-
-			int window_y = line;
-			// Fix height for some resolutions:
-//			switch ( fullscreen?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
-			switch ( fullscreen_val?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
-			case RESOLUTION_640X512:
-				break;
-			case RESOLUTION_640X480_S:
-				//window_y = (window_y * 0.94);
-				window_y = GetScaledScanline(window_y);
-				break;
-			case RESOLUTION_640X480_V:
-				//window_y = (window_y * 0.94);
-				window_y = GetScaledScanline(window_y);
-				break;
-			case RESOLUTION_320X240_S:
-				//window_y = (window_y * 0.94);
-				window_y = GetScaledScanline(window_y);
-				disable_grille_for_teletext =1;
-				break;
-			case RESOLUTION_320X240_V:
-				//window_y = (window_y * 0.94);
-				window_y = GetScaledScanline(window_y);
-				disable_grille_for_teletext=1;
-				break;
-			case RESOLUTION_320X256:
-				disable_grille_for_teletext=1;
-				break;
-			default:
-				break;
-			}
-
+	if (video_output == NULL || screen_ptr == NULL || PresentedLines == NULL)
+		return;
 
-//#ifdef EMULATE_CRT
-			if ( cfg_EmulateCrtTeletext == 0 || (line & 1) == 1 || disable_grille_for_teletext ==1){
-//#endif
-//				src.x=36; src.y=line; src.w=SDL_WINDOW_WIDTH - (36 + 124); src.h=1;
-//				dst.x= (36+124) / 2; dst.y=line +6; dst.w=SDL_WINDOW_WIDTH - (36 + 124); dst.h=1;
-
-//				src.x=0; src.y=line; src.w=SDL_WINDOW_WIDTH; src.h=1;
-//				dst.x=0; dst.y=line; dst.w=SDL_WINDOW_WIDTH; dst.h=1;
-			src.x=0; src.y=line; src.w=screen_ptr->w; src.h=1;
-			dst.x=0; dst.y=window_y; dst.w=screen_ptr->w; dst.h=1;
-
-				//dst.x +=40; dst.w -=40; dst.y+=8;
-
-				if (dst.y < screen_ptr->h){
-					SDL_BlitSurface(video_output, &src
-					 , screen_ptr, &dst);
-					SDL_UpdateRect(screen_ptr, dst.x, dst.y
-					 , dst.w, dst.h);
-				}
-//#ifdef EMULATE_CRT
-			}
-//#endif
+	start_time = HostMicroSeconds();
 
-		// render a graphics mode line.
-		}else{
-			int window_y;
-			window_y = (line -32);
+	endy = starty + nlines;
+	if (endy > BEEBEM_VIDEO_CORE_SCREEN_HEIGHT)
+		endy = BEEBEM_VIDEO_CORE_SCREEN_HEIGHT;
+	if (starty < 0)
+		starty = 0;
 
+	width = screen_ptr->w;
+	if (width > BEEBEM_VIDEO_CORE_SCREEN_WIDTH)
+		width = BEEBEM_VIDEO_CORE_SCREEN_WIDTH;
+	width *= video_output->format->BytesPerPixel;
 
+	NumPresentRects = 0;
+	last_window_y = -1;
 
-			// Line may have moved off the top, so check here.
-			if (window_y < 0 || window_y > 255)
-				return;
-	
-		
-//			switch ( fullscreen?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
-			switch ( fullscreen_val?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
-			case RESOLUTION_640X512:
-				window_y = window_y * 2;
-				scan_double = 1;
-				break;
-			case RESOLUTION_640X480_S:
-				//window_y = (window_y * 2 * 0.94);
-				window_y = GetScaledScanline(window_y*2);
-				scan_double = 1;
-				break;
-			case RESOLUTION_640X480_V:
-				window_y = window_y * 2;
-				window_y -= cfg_VerticalOffset;
-				scan_double = 1;
-				break;
-			case RESOLUTION_320X240_S:
-				//window_y = ((window_y+1) * 0.94);
-				window_y = GetScaledScanline(window_y+1);
-				scan_double = 0;
-				break;
-			case RESOLUTION_320X240_V:
-				window_y -= cfg_VerticalOffset>>1;
-				scan_double = 0;
-				break;
-			case RESOLUTION_320X256:
-				scan_double = 0;
-				break;
-			default:
-				scan_double = 0;
-				break;
-			}
-			// Only do this if 512.
-			//window_y = window_y * 2;
-
-			// Line may be unwanted.
-			if (window_y <0)
-				return;
+	for (line = starty; line < endy; line++){
+		bit = 1U << (line & 31);
+		window_y = GetWindowRow(line, isTeletext, fullscreen_val, &scan_double);
 
+		p = (unsigned char *) video_output->pixels + line * video_output->pitch;
+		q = PresentedLines + line * PresentedPitch;
 
-			src.x=0; src.y=line; 
+		// A line that shares its window row with the one before it
+		// (scaled resolutions) must be drawn after it again.
+		if (! PresentAllLines && window_y != last_window_y){
+			if ((DirtyLines[line >> 5] & bit) == 0)
+				continue;
 
-//			src.w=SDL_WINDOW_WIDTH;
-			src.w=screen_ptr->w;
-
-//			printf("kjlfkjdflfjd\n");
-
-			src.h=1;
-
-			dst.x=0;			
+			if (memcmp(p, q, width) == 0){
+				DirtyLines[line >> 5] &= ~bit;
+				continue;
+			}
+		}
 
-			dst.y=window_y;
+		memcpy(q, p, width);
+		DirtyLines[line >> 5] &= ~bit;
 
-//			dst.w=SDL_WINDOW_WIDTH;
-			dst.w=screen_ptr->w;
+		if (window_y >= 0){
+			RenderLine(line, window_y, scan_double);
+			last_window_y = window_y;
+		}
+	}
 
-			dst.h=1;
+	PresentAllLines = 0;
 
-			if (dst.h<screen_ptr->h){
-				SDL_BlitSurface(video_output, &src, screen_ptr
-				 , &dst);
-				SDL_UpdateRect(screen_ptr, 0, window_y
-				 , screen_ptr->w, 1);
-			}
+	if (NumPresentRects > 0)
+		SDL_UpdateRects(screen_ptr, NumPresentRects, PresentRects);
 
-//			printf("Line: %d %d\n", (int) dst.y, (int) dst.h);
+	PresentMicroSeconds += HostMicroSeconds() - start_time;
+	PresentedFrames++;
+}
 
-			// Graphics mode is never more than 256 scanlines so
-			// double up the lines
-			src = dst;
-			dst.y +=1;
+/* Log the average time PresentFrame() took since the last report, then
+ * start counting again.
+ */
+void ReportPresentationStatistics(void)
+{
+	if (PresentedFrames > 0)
+		pINFO(dL"Frame presentation: %lu us per frame over %lu frames"
+		 " (%d bit video output).", dR, PresentMicroSeconds / PresentedFrames
+		 , PresentedFrames, VideoOutputXRGB ? 32 : 8);
 
-//#ifndef EMULATE_CRT
-			if ( scan_double && (! cfg_EmulateCrtGraphics) ){
-//				printf("Doing scan double\n");
-				SDL_BlitSurface(screen_ptr, &src, screen_ptr
-				 , &dst);
-				SDL_UpdateRect(screen_ptr, 0, window_y+1
-				 , screen_ptr->w, 1);
-			}
-//#endif
-//			SDL_UpdateRect(screen_ptr, 0, window_y , SDL_WINDOW_WIDTH
-//			 , 2);
-		}
-	}
+	PresentMicroSeconds = 0;
+	PresentedFrames = 0;
 }
 
 
@@ -1218,9 +1490,28 @@ void RenderFullscreenFPS(const char *str, int y)
 
 	SDL_FillRect(video_output, &rect, SDL_MapRGB(video_output->format, col.r, col.g, col.b) );
 	EG_Draw_String(video_output, &col, EG_FALSE, &rect, 0, (char*) str);
+
+	for (int line = rect.y; line < rect.y + rect.h; line++)
+		MarkLineDirty(line);
 }
 
 
+/* Host clock in microseconds, used to measure how much time the main loop
+ * spends outside the emulator core.  SDL_GetTicks is too coarse for a single
+ * slice so use gettimeofday where we can.
+ */
+Uint32 HostMicroSeconds(void)
+{
+#ifdef WITH_UNIX_EXTRAS
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (Uint32) (tv.tv_sec * 1000000 + tv.tv_usec);
+#else
+	return SDL_GetTicks() * 1000;
+#endif
+}
+
 void SetWindowTitle(char *title)
 {
 	SDL_WM_SetCaption(title, NULL);
@@ -1245,6 +1536,8 @@ unsigned char* GetSDLScreenLinePtr(int line)
 
 	//printf("%d %d\n", low, high);
 
+	MarkLineDirty(line < 0 ? 0 : line);
+
 	if(line<0){
 		//printf("*** ASKED TO RENDER TO LINE %d [low=%d, high=%d\n", line, low, high);
 		//SDL_Delay(500);
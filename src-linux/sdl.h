@@ -42,6 +42,11 @@ extern int cfg_EmulateCrtTeletext;
 #define CFG_WANTLOWLATENCYSOUND "WantLowLatencySound"
 extern int cfg_WantLowLatencySound;
 
+/* Sound latency (ms) to aim for when cfg_WantLowLatencySound is set.
+ */
+#define CFG_SOUNDLATENCY	"SoundLatency"
+extern int cfg_SoundLatency;
+
 #define RESOLUTION_640X512      0
 #define RESOLUTION_640X480_S    1
 #define RESOLUTION_640X480_V    2
@@ -74,19 +79,95 @@ extern int cfg_VerticalOffset;
 #define CFG_SLEEP_TYPE	"SleepType"
 extern int cfg_WaitType;
 
+/* Emulation slice:
+ *
+ * The number of 2MHz cycles the emulator core runs for before the main loop
+ * services SDL events and GUI state.  Zero keeps the original behaviour of
+ * servicing events after every batch of 1024 instructions.  It's set via the
+ * config file or the -Slice command line option.
+ */
+#define SLICE_INSTRUCTIONS	0
+#define SLICE_SCANLINE		128	// 64us at 2MHz
+#define SLICE_FRAME		40000	// 20ms at 2MHz
+#define CFG_EMULATIONSLICE	"EmulationSlice"
+extern int cfg_EmulationSlice;
+
+/* If set, the main loop logs the host time spent outside the emulator core
+ * (per emulated second) so the effect of the slice size can be measured.
+ * Each subsystem's figures for the same second follow on their own lines:
+ * sound underruns, overruns and latency, frame presentation time and the
+ * mode 7 row cache hit rate.
+ */
+#define CFG_SHOWHOSTOVERHEAD	"ShowHostOverhead"
+extern int cfg_ShowHostOverhead;
+
+/* If set, the 65C02 second processor runs on its own host thread and only
+ * meets the BBC at tube register accesses (see tube.cpp).  It's set via the
+ * config file or the -TubeThread command line option.
+ */
+#define CFG_TUBETHREAD		"TubeThread"
+extern int cfg_TubeThread;
+
+/* Speed of the 65C02 second processor in MHz, 3 like the real thing, up to
+ * 64, or 0 to run it unthrottled (see tube.cpp).  It's set via the config
+ * file or the -TubeSpeed command line option and takes effect on reset.
+ */
+#define CFG_TUBESPEED		"TubeSpeed"
+extern int cfg_TubeSpeed;
+
+/* If set, the Z80 second processor records the operands of its ALU
+ * instructions and only works out F when something reads it (see z80.cpp).
+ * It's set via the config file or the -Z80LazyFlags command line option.
+ */
+#define CFG_Z80LAZYFLAGS	"Z80LazyFlags"
+extern int cfg_Z80LazyFlags;
+
+/* If set, the emulator core draws 32 bit XRGB pixels into a 32 bit window
+ * instead of 8 bit palette indices (see video.cpp).  It's set via the config
+ * file or the -TrueColour command line option.
+ */
+#define CFG_TRUECOLOUR		"TrueColour"
+extern int cfg_TrueColour;
+
+/* Which kernel expands graphics mode scanlines: 0 picks the fastest the host
+ * CPU supports, 1 is scalar and 2 AVX2 (see scanline.cpp).  It's set
+ * via the config file or the -ScanLineKernel command line option.
+ */
+#define CFG_SCANLINEKERNEL	"ScanLineKernel"
+extern int cfg_ScanLineKernel;
+
 /*	-	-	-	-
  */
 
 extern int InitialiseSDL(int argc, char *argv[]);
 extern void UninitialiseSDL(void);
-extern void RenderLine(int, int, int);
+extern void PresentFrame(int starty, int nlines, int isTeletext, int xoffset);
+extern int GetTeletextWindowRow(int line, bool fullscreen_val);
 extern void SaferSleep(unsigned int);
 extern unsigned char* GetSDLScreenLinePtr(int);
 extern void SetWindowTitle(char*);
 extern int ConvertSDLKeyToBBCKey(SDL_keysym, int*, /* int*, */ int*);
 extern void SetBeebEmEmulatorCoresPalette(unsigned char*, int);
+extern Uint32 InvertXRGBPixel(Uint32, int);
+extern Uint32 HostMicroSeconds(void);
+
+/* Set when video_output holds 32 bit XRGB pixels, XRGBPalette giving the
+ * pixel for each of the core's colour numbers.
+ */
+extern int VideoOutputXRGB;
+extern Uint32 XRGBPalette[256];
+
+/* Each logs its own figures for the ShowHostOverhead report, counting
+ * from the previous call.
+ */
+extern void ReportPresentationStatistics(void);
+extern void ReportSoundStatistics(void);
 
 extern void AddBytesToSDLSoundBuffer(void*, int);
+extern volatile unsigned long SDLSoundUnderruns;
+extern volatile unsigned long SDLSoundOverruns;
+extern volatile int SDLSoundRatePPM;
+extern int GetSDLSoundLatency(void);
 
 extern void CatchupSound(void);
 extern void ClearVideoWindow(void);
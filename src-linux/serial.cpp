@@ -335,6 +335,19 @@ unsigned char Read_SERPROC(void) {
 	return(SP_Control);
 }
 
+/* Returns the earliest cycle count at which Serial_Poll has anything to do.
+   With the cassette motor off only a pending write needs polling. */
+CycleCountT Serial_NextPoll(void)
+{
+	if (SerialChannel==CASSETTE && Cass_Relay!=1)
+		return (TxD > 0) ? TapeTrigger : CycleCountTMax;
+
+	if (SerialChannel==RS423 && !SerialPortEnabled)
+		return CycleCountTMax;
+
+	return TotalCycles;
+}
+
 void Serial_Poll(void)
 {
 
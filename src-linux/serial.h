@@ -16,6 +16,7 @@ unsigned char Read_SERPROC(void);
 extern unsigned char SerialPortEnabled;
 extern unsigned char SerialPort;
 void Serial_Poll(void);
+CycleCountT Serial_NextPoll(void);
 void InitSerialPort(void);
 void Kill_Serial(void);
 void LoadUEF(char *UEFName);
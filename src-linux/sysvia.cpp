@@ -307,6 +307,7 @@ void SysVIAWrite(int Address, int Value) {
   //fprintf(vialog,"SYSTEM VIA Write of %d (%02x) to address %d\n",Value,Value,Address);
   /* cerr << "SysVIAWrite: Address=0x" << hex << Address << " Value=0x" << Value << dec << " at " << TotalCycles << "\n";
   DumpRegs(); */
+  SyncVIAs();
 
 	if (DebugEnabled) {
 		char info[200];
@@ -431,6 +432,7 @@ int SysVIARead(int Address) {
   //fprintf(vialog,"SYSTEM VIA Read of address %02x (%d)\n",Address,Address);
   /* cerr << "SysVIARead: Address=0x" << hex << Address << dec << " at " << TotalCycles << "\n";
   DumpRegs(); */
+  SyncVIAs();
   switch (Address) {
     case 0: /* IRB read */
 	  // Clear bit 4 of IFR from ATOD Conversion
@@ -613,6 +615,18 @@ void SysVIA_poll(unsigned int ncycles) {
 //  }
 }
 
+/* Number of cycles SysVIA_poll can be put off for - nothing happens until */
+/* a counting timer goes negative                                          */
+int SysVIA_IdleCycles(void) {
+  int idle=SysVIAState.timer1c;
+
+  if (SysVIAState.timer2c<idle &&
+      (SysVIAState.timer2c<0 || !(SysVIAState.acr & 0x20)))
+    idle=SysVIAState.timer2c;
+
+  return (idle>0) ? idle : 0;
+}
+
 /*--------------------------------------------------------------------------*/
 void SysVIAReset(void) {
   int row,col;
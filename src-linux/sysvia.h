@@ -42,6 +42,7 @@ void SysVIAReset(void);
 void SysVIA_poll_real(void);
 
 void SysVIA_poll(unsigned int ncycles);
+int SysVIA_IdleCycles(void);
 
 void BeebKeyUp(int row, int col);
 void BeebKeyDown(int row, int col);
@@ -31,7 +31,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <SDL.h>
+
 #include "6502core.h"
+#include "6502ops.h"
 #include "main.h"
 #include "beebmem.h"
 #include "tube.h"
@@ -39,6 +42,7 @@
 #include "uefstate.h"
 #include "z80mem.h"
 #include "z80.h"
+#include "sdl.h"
 
 //>++
 #include "user_config.h"
@@ -51,15 +55,17 @@
 //-- #define INLINE
 //-- #endif
 
-// Some interrupt set macros
-#define SETTUBEINT(a) TubeintStatus|=1<<a
-#define RESETTUBEINT(a) TubeintStatus&=~(1<<a)
+// Some interrupt set macros.  Atomic, as a threaded 65C02 (cfg_TubeThread)
+// reads the interrupt lines without taking TubeLock.
+#define SETTUBEINT(a) __sync_fetch_and_or(&TubeintStatus, 1<<a)
+#define RESETTUBEINT(a) __sync_fetch_and_and(&TubeintStatus, ~(1<<a))
+#define SETTUBENMI(a) __sync_fetch_and_or(&TubeNMIStatus, 1<<a)
+#define RESETTUBENMI(a) __sync_fetch_and_and(&TubeNMIStatus, ~(1<<a))
 
 static int CurrentInstruction;
 unsigned char TubeRam[65536];
 extern int DumpAfterEach;
 unsigned char TubeEnabled,Tube186Enabled,AcornZ80,EnableTube;
-unsigned char TubeMachineType=3;
 
 CycleCountT TotalTubeCycles=0;  
 
@@ -68,8 +74,8 @@ static int Accumulator,XReg,YReg;
 static unsigned char StackReg,PSR;
 static unsigned char IRQCycles;
 
-unsigned char TubeintStatus=0; /* bit set (nums in IRQ_Nums) if interrupt being caused */
-unsigned char TubeNMIStatus=0; /* bit set (nums in NMI_Nums) if NMI being caused */
+volatile unsigned char TubeintStatus=0; /* bit set (nums in IRQ_Nums) if interrupt being caused */
+volatile unsigned char TubeNMIStatus=0; /* bit set (nums in NMI_Nums) if NMI being caused */
 
 //->
 //## 'NMILock' is declared global in 6502core.cpp and external in 6502core.h.
@@ -91,18 +97,6 @@ unsigned char TubeNMIStatus=0; /* bit set (nums in NMI_Nums) if NMI being caused
 static unsigned int tube_NMILock=0;
 //<-
 
-typedef int int16;
-
-enum PSRFlags {
-  FlagC=1,
-  FlagZ=2,
-  FlagI=4,
-  FlagD=8,
-  FlagB=16,
-  FlagV=64,
-  FlagN=128
-};
-
 /* Note how GETCFLAG is special since being bit 0 we don't need to test it to get a clean 0/1 */
 #define GETCFLAG ((PSR & FlagC))
 #define GETZFLAG ((PSR & FlagZ)>0)
@@ -139,8 +133,6 @@ static int TubeCyclesTable[]={
    allow fernangling by memory subsystem */
 unsigned int TubeCycles;
 
-static unsigned char Branched;
-// Branched - 1 if the instruction branched
 
 /* A macro to speed up writes - uses a local variable called 'tmpaddr' */
 #define TUBEREADMEM_FAST(a) ((a<0xfef8)?TubeRam[a]:TubeReadMem(a))
@@ -211,12 +203,12 @@ void UpdateR4Interrupt(void) {
 void UpdateR3Interrupt(void) {
 	if ((R1Status & TubeM) && !(R1Status & TubeV) &&
 		( (R3HPPtr > 0) || (R3PHPtr == 0) ))
-		TubeNMIStatus|=(1<<R3);
+		SETTUBENMI(R3);
 	else if ((R1Status & TubeM) && (R1Status & TubeV) &&
 		( (R3HPPtr > 1) || (R3PHPtr == 0) ))
-		TubeNMIStatus|=(1<<R3);
+		SETTUBENMI(R3);
 	else
-		TubeNMIStatus&=~(1<<R3);
+		RESETTUBENMI(R3);
 }
 
 void UpdateHostR4Interrupt(void) {
@@ -226,6 +218,101 @@ void UpdateHostR4Interrupt(void) {
 		intStatus&=~(1<<tube);
 }
 
+/*-------------------------------------------------------------------*/
+// Threaded second processor (cfg_TubeThread)
+//
+// The 65C02 runs on its own host thread while the host is inside
+// Exec6502Slice and is parked at the end of every slice, so resets, state
+// saving and the debugger always see both processors stopped.  Each side
+// publishes how far it has got (in 3MHz tube cycles).  The two only meet
+// when either of them touches the tube registers, where the one that is
+// ahead waits for the other to catch up, and at the end of each host
+// instruction, where neither may get more than TUBE_THREAD_SKEW cycles
+// ahead of the other.
+
+#define TUBE_THREAD_PARKED	0
+#define TUBE_THREAD_RUNNING	1
+#define TUBE_THREAD_STOPPING	2
+#define TUBE_THREAD_QUIT	3
+
+#define TUBE_THREAD_SKEW	3000	// 1ms at 3MHz
+
+#define TUBE_THREAD_BARRIER()	__sync_synchronize()
+
+static SDL_Thread *TubeThread = NULL;
+static SDL_mutex *TubeLock = NULL;	// Guards the tube registers
+static SDL_sem *TubeGo = NULL;
+static SDL_sem *TubeParked = NULL;
+
+static volatile int TubeThreadState = TUBE_THREAD_PARKED;
+static volatile CycleCountT TubeHostTime = 0;	// TotalCycles/2*3
+static volatile CycleCountT TubeParaTime = 0;	// TotalTubeCycles
+static volatile int TubeResetPending = 0;	// Host asked for a 65C02 reset
+static volatile int TubeHostIRQPending = 0;	// Parasite changed R4 for the host
+
+// Host side, before it touches the registers
+static void TubeHostRendezvous(void) {
+	TubeHostTime=TotalCycles/2*3;
+	TUBE_THREAD_BARRIER();
+	while (TubeParaTime < TubeHostTime)
+		SDL_Delay(0);
+	SDL_LockMutex(TubeLock);
+	if (TubeHostIRQPending) {
+		TubeHostIRQPending=0;
+		UpdateHostR4Interrupt();
+	}
+}
+
+// Parasite side.  Once the host has finished its slice it stops publishing
+// its time, so a parasite that is ahead just carries on.
+static void TubeParasiteRendezvous(void) {
+	while (TubeHostTime < TotalTubeCycles && TubeThreadState == TUBE_THREAD_RUNNING)
+		SDL_Delay(0);
+	SDL_LockMutex(TubeLock);
+}
+
+/*-------------------------------------------------------------------*/
+// Turbo second processor (cfg_TubeSpeed)
+//
+// The 65C02 keeps time in 3MHz cycles whatever speed it runs at, so the
+// rendezvous with the host, cycle wrapping and saved state are unchanged.
+// At other speeds each instruction is charged its share of those cycles,
+// with the remainder carried over to the next.
+//
+// Unthrottled, the 65C02 is charged nothing.  On its own thread it just
+// runs flat out, keeping level with the host's time.  In line it runs
+// for up to TUBE_UNTHROTTLED_RATIO times as many cycles as the host has
+// run since the last sync, but gives way as soon as it reads a tube
+// status register that isn't ready, as nothing it is waiting for can
+// happen until the host runs again.
+
+#define TUBE_MAX_SPEED		64	// MHz
+#define TUBE_UNTHROTTLED_RATIO	64
+
+static int TubeSpeed = 3;		// MHz, 0 for unthrottled
+static int TubeCycleFraction = 0;	// Remainder of 3*TubeCycles/TubeSpeed
+static int TubeParasiteWaiting = 0;	// Polled a register that wasn't ready
+
+static void SetTubeSpeed(void) {
+	TubeSpeed=cfg_TubeSpeed;
+	if (TubeSpeed < 0 || TubeSpeed > TUBE_MAX_SPEED) {
+		pWARN(dL"Tube speed must be 0 to %d MHz, using 3MHz.", dR, TUBE_MAX_SPEED);
+		TubeSpeed=cfg_TubeSpeed=3;
+	}
+	TubeCycleFraction=0;
+}
+
+INLINE static void AdvanceTubeClock(int Cycles) {
+	if (TubeSpeed == 3) {
+		TotalTubeCycles+=Cycles;
+	}
+	else if (TubeSpeed != 0) {
+		TubeCycleFraction+=Cycles*3;
+		TotalTubeCycles+=TubeCycleFraction/TubeSpeed;
+		TubeCycleFraction%=TubeSpeed;
+	}
+}
+
 
 /*-------------------------------------------------------------------*/
 // Torch tube memory/io handling functions
@@ -399,10 +486,15 @@ unsigned char ReadTubeFromHostSide(unsigned char IOAddr) {
 //++
 	unsigned char TmpData=0,TmpCntr;
 //<-
+	bool Threaded;
 
 	if (! (EnableTube || Tube186Enabled || AcornZ80) ) 
 		return(MachineType==3 ? 0xff : 0xfe); // return ff for master else return fe
 
+	Threaded=(TubeThreadState != TUBE_THREAD_PARKED);
+	if (Threaded)
+		TubeHostRendezvous();
+
 	switch (IOAddr) {
 	case 0:
 		TmpData=R1HStatus | R1Status;
@@ -456,6 +548,9 @@ unsigned char ReadTubeFromHostSide(unsigned char IOAddr) {
 		break;
 	}
 
+	if (Threaded)
+		SDL_UnlockMutex(TubeLock);
+
 	if (DebugEnabled) {
 		char info[200];
 		sprintf(info, "Tube: Read from host, addr %X value %02X", (int)IOAddr, (int)TmpData);
@@ -466,6 +561,8 @@ unsigned char ReadTubeFromHostSide(unsigned char IOAddr) {
 }
 
 void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData) {
+	bool Threaded;
+
 	if (! (EnableTube || Tube186Enabled || AcornZ80) ) 
 		return;
 
@@ -475,6 +572,10 @@ void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData) {
 		DebugDisplayTrace(DEBUG_TUBE, true, info);
 	}
 
+	Threaded=(TubeThreadState != TUBE_THREAD_PARKED);
+	if (Threaded)
+		TubeHostRendezvous();
+
 	switch (IOAddr) {
 	case 0:
 		// S bit controls write of status flags
@@ -483,9 +584,13 @@ void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData) {
 		else
 			R1Status&=~IOData;
 
-		// Reset required?
-		if (R1Status & TubeP)
-			Reset65C02();
+		// Reset required?  A threaded 65C02 resets itself.
+		if (R1Status & TubeP) {
+			if (Threaded)
+				TubeResetPending=1;
+			else
+				Reset65C02();
+		}
 		if (R1Status & TubeT)
 			ResetTube();
 
@@ -530,6 +635,9 @@ void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData) {
 		UpdateR4Interrupt();
 		break;
 	}
+
+	if (Threaded)
+		SDL_UnlockMutex(TubeLock);
 }
 
 unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr) {
@@ -541,6 +649,9 @@ unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr) {
 	if (TorchTube) 
 		return ReadTorchTubeFromHostSide(IOAddr);
 
+	if (TubeThreadState != TUBE_THREAD_PARKED)
+		TubeParasiteRendezvous();
+
 	switch (IOAddr) {
 	case 0:
 		TmpData=R1PStatus | R1Status;
@@ -595,6 +706,12 @@ unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr) {
 		break;
 	}
 
+	if (!(IOAddr & 1) && (TmpData & (TubeDataAv | TubeNotFull)) != (TubeDataAv | TubeNotFull))
+		TubeParasiteWaiting=1;
+
+	if (TubeThreadState != TUBE_THREAD_PARKED)
+		SDL_UnlockMutex(TubeLock);
+
 	if (DebugEnabled) {
 		char info[200];
 		sprintf(info, "Tube: Read from para, addr %X value %02X", (int)IOAddr, (int)TmpData);
@@ -618,6 +735,9 @@ void WriteTubeFromParasiteSide(unsigned char IOAddr,unsigned char IOData)
 		DebugDisplayTrace(DEBUG_TUBE, false, info);
 	}
 
+	if (TubeThreadState != TUBE_THREAD_PARKED)
+		TubeParasiteRendezvous();
+
 	switch (IOAddr) {
 	case 0:
 		// Cannot write status flags from parasite
@@ -656,9 +776,16 @@ void WriteTubeFromParasiteSide(unsigned char IOAddr,unsigned char IOData)
 		R4PHData=IOData;
 		R4HStatus|=TubeDataAv;
 		R4PStatus&=~TubeNotFull;
-		UpdateHostR4Interrupt();
+		// The host's interrupt state belongs to the host thread
+		if (TubeThreadState != TUBE_THREAD_PARKED)
+			TubeHostIRQPending=1;
+		else
+			UpdateHostR4Interrupt();
 		break;
 	}
+
+	if (TubeThreadState != TUBE_THREAD_PARKED)
+		SDL_UnlockMutex(TubeLock);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -676,462 +803,39 @@ unsigned char TubeReadMem(unsigned int IOAddr) {
 		return(ReadTubeFromParasiteSide(IOAddr-0xfef8));
 }
 
-/* Get a two byte address from the program counter, and then post inc the program counter */
-#define GETTWOBYTEFROMPC(var) \
-  var=TubeRam[TubeProgramCounter]; \
-  var|=(TubeRam[TubeProgramCounter+1]<<8); \
-  TubeProgramCounter+=2;
-
-/*----------------------------------------------------------------------------*/
-INLINE void Carried() {
-	// Correct cycle count for indirection across page boundary
-	if (((CurrentInstruction & 0xf)==0x1 ||
-		 (CurrentInstruction & 0xf)==0x9 ||
-		 (CurrentInstruction & 0xf)==0xd) &&
-		(CurrentInstruction & 0xf0)!=0x90)
-	{
-		TubeCycles++;
-	}
-	else if (CurrentInstruction==0xBC ||
-			 CurrentInstruction==0xBE)
-	{
-		TubeCycles++;
-	}
-}
-
-/*----------------------------------------------------------------------------*/
-INLINE int SignExtendByte(signed char in) {
-  /*if (in & 0x80) return(in | 0xffffff00); else return(in); */
-  /* I think this should sign extend by virtue of the casts - gcc does anyway - the code
-  above will definitly do the trick */
-  return((int)in);
-} /* SignExtendByte */
-
-/*----------------------------------------------------------------------------*/
-/* Set the Z flag if 'in' is 0, and N if bit 7 is set - leave all other bits  */
-/* untouched.                                                                 */
-INLINE static void SetPSRZN(const unsigned char in) {
-  PSR&=~(FlagZ | FlagN);
-  PSR|=((in==0)<<1) | (in & 128);
-}; /* SetPSRZN */
-
-/*----------------------------------------------------------------------------*/
-/* Note: n is 128 for true - not 1                                            */
-INLINE static void SetPSR(int mask,int c,int z,int i,int d,int b, int v, int n) {
-  PSR&=~mask;
-  PSR|=c | (z<<1) | (i<<2) | (d<<3) | (b<<4) | (v<<6) | n;
-} /* SetPSR */
-
 /*----------------------------------------------------------------------------*/
-/* NOTE!!!!! n is 128 or 0 - not 1 or 0                                       */
-INLINE static void SetPSRCZN(int c,int z, int n) {
-  PSR&=~(FlagC | FlagZ | FlagN);
-  PSR|=c | (z<<1) | n;
-} /* SetPSRCZN */
-
-/*----------------------------------------------------------------------------*/
-
-/*----------------------------------------------------------------------------*/
-INLINE static void Push(unsigned char ToPush) {
-  TUBEWRITEMEM_DIRECT(0x100+StackReg,ToPush);
-  StackReg--;
-} /* Push */
-
-/*----------------------------------------------------------------------------*/
-INLINE static unsigned char Pop(void) {
-  StackReg++;
-  return(TubeRam[0x100+StackReg]);
-} /* Pop */
-
-/*----------------------------------------------------------------------------*/
-INLINE static void PushWord(int16 topush) {
-  Push((topush>>8) & 255);
-  Push(topush & 255);
-} /* PushWord */
-
-/*----------------------------------------------------------------------------*/
-INLINE static int16 PopWord() {
-  int16 RetValue;
-
-  RetValue=Pop();
-  RetValue|=(Pop()<<8);
-  return(RetValue);
-} /* PopWord */
-
-/*-------------------------------------------------------------------------*/
-/* Relative addressing mode handler                                        */
-INLINE static int16 RelAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-
-  /* For branches - is this correct - i.e. is the program counter incremented
-     at the correct time? */
-  EffectiveAddress=SignExtendByte((signed char)TubeRam[TubeProgramCounter++]);
-  EffectiveAddress+=TubeProgramCounter;
-
-  return(EffectiveAddress);
-} /* RelAddrModeHandler */
+/* The 65C02's side of the shared instruction handlers (6502ops.h).  Its RAM  */
+/* is only ever seen by the tube, so only the time taken by each instruction */
+/* is counted.                                                               */
+struct TubeBus {
+  static INLINE int &ProgramCounter(void) { return(TubeProgramCounter); }
+  static INLINE int &Accumulator(void) { return(::Accumulator); }
+  static INLINE int &XReg(void) { return(::XReg); }
+  static INLINE int &YReg(void) { return(::YReg); }
+  static INLINE unsigned char &StackReg(void) { return(::StackReg); }
+  static INLINE unsigned char &PSR(void) { return(::PSR); }
+  static INLINE unsigned char Fetch(int Address) { return(TubeRam[Address]); }
+  static INLINE unsigned char Read(int Address) { return(TUBEREADMEM_FAST(Address)); }
+  static INLINE void Write(int Address,unsigned char Value) { TUBEWRITEMEM_FAST(Address,Value) }
+  static INLINE unsigned char &Ram(int Address) { return(TubeRam[Address]); }
+};
 
-/*----------------------------------------------------------------------------*/
-INLINE static void ADCInstrHandler(int16 operand) {
-  /* NOTE! Not sure about C and V flags */
-  int TmpResultV,TmpResultC;
-  if (!GETDFLAG) {
-    TmpResultC=Accumulator+operand+GETCFLAG;
-    TmpResultV=(signed char)Accumulator+(signed char)operand+GETCFLAG;
-    Accumulator=TmpResultC & 255;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN, (TmpResultC & 256)>0,Accumulator==0,0,0,0,((Accumulator & 128)>0) ^ (TmpResultV<0),(Accumulator & 128));
-  } else {
-    int ZFlag=0,NFlag=0,CFlag=0,VFlag=0;
-    int TmpResult,TmpCarry=0;
-    int ln,hn;
-
-    /* Z flag determined from 2's compl result, not BCD result! */
-    TmpResult=Accumulator+operand+GETCFLAG;
-    ZFlag=((TmpResult & 0xff)==0);
-
-    ln=(Accumulator & 0xf)+(operand & 0xf)+GETCFLAG;
-    if (ln>9) {
-      ln += 6;
-      ln &= 0xf;
-      TmpCarry=0x10;
-    }
-    hn=(Accumulator & 0xf0)+(operand & 0xf0)+TmpCarry;
-    /* N and V flags are determined before high nibble is adjusted.
-       NOTE: V is not always correct */
-    NFlag=hn & 128;
-    VFlag=(hn ^ Accumulator) & 128 && !((Accumulator ^ operand) & 128);
-    if (hn>0x90) {
-      hn += 0x60;
-      hn &= 0xf0;
-      CFlag=1;
-    }
-    Accumulator=hn|ln;
-	ZFlag=(Accumulator==0);
-	NFlag=(Accumulator&128);
-    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
-  }
-} /* ADCInstrHandler */
+struct TubeClock {
+  static INLINE int Opcode(void) { return(CurrentInstruction); }
+  static INLINE void AddCycles(int n) { TubeCycles+=n; }
+  static INLINE void ModifyCycles(int Address,unsigned char OldValue) {}
+};
 
-/*----------------------------------------------------------------------------*/
-INLINE static void ANDInstrHandler(int16 operand) {
-  Accumulator=Accumulator & operand;
-  PSR&=~(FlagZ | FlagN);
-  PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-} /* ANDInstrHandler */
-
-INLINE static void ASLInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-  oldVal=TUBEREADMEM_FAST(address);
-  newVal=(((unsigned int)oldVal)<<1) & 254;
-  TUBEWRITEMEM_FAST(address,newVal);
-  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
-} /* ASLInstrHandler */
-
-INLINE static void TRBInstrHandler(int16 address) {
-	unsigned char oldVal,newVal;
-	oldVal=TUBEREADMEM_FAST(address);
-	newVal=(Accumulator ^ 255) & oldVal;
-    TUBEWRITEMEM_FAST(address,newVal);
-    PSR&=253;
-	PSR|=((Accumulator & oldVal)==0) ? 2 : 0;
-} // TRBInstrHandler
-
-INLINE static void TSBInstrHandler(int16 address) {
-	unsigned char oldVal,newVal;
-	oldVal=TUBEREADMEM_FAST(address);
-	newVal=Accumulator | oldVal;
-    TUBEWRITEMEM_FAST(address,newVal);
-    PSR&=253;
-	PSR|=((Accumulator & oldVal)==0) ? 2 : 0;
-} // TSBInstrHandler
-
-INLINE static void ASLInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-  /* Accumulator */
-  oldVal=Accumulator;
-  Accumulator=newVal=(((unsigned int)Accumulator)<<1) & 254;
-  SetPSRCZN((oldVal & 128)>0, newVal==0,newVal & 128);
-} /* ASLInstrHandler_Acc */
-
-INLINE static void BCCInstrHandler(void) {
-  if (!GETCFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BCCInstrHandler */
-
-INLINE static void BCSInstrHandler(void) {
-  if (GETCFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BCSInstrHandler */
-
-INLINE static void BEQInstrHandler(void) {
-  if (GETZFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BEQInstrHandler */
-
-INLINE static void BITInstrHandler(int16 operand) {
-  PSR&=~(FlagZ | FlagN | FlagV);
-  /* z if result 0, and NV to top bits of operand */
-  PSR|=(((Accumulator & operand)==0)<<1) | (operand & 192);
-} /* BITInstrHandler */
-
-INLINE static void BMIInstrHandler(void) {
-  if (GETNFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BMIInstrHandler */
-
-INLINE static void BNEInstrHandler(void) {
-  if (!GETZFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BNEInstrHandler */
-
-INLINE static void BPLInstrHandler(void) {
-  if (!GETNFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-}; /* BPLInstrHandler */
+typedef M6502<TubeBus,CPU_65C02,TubeClock> TubeCPU;
 
 INLINE static void BRKInstrHandler(void) {
-  PushWord(TubeProgramCounter+1);
-  SetPSR(FlagB,0,0,0,0,1,0,0); /* Set B before pushing */
-  Push(PSR);
-  SetPSR(FlagI,0,0,1,0,0,0,0); /* Set I after pushing - see Birnbaum */
+  TubeCPU::PushWord(TubeProgramCounter+1);
+  TubeCPU::SetPSR(FlagB,0,0,0,0,1,0,0); /* Set B before pushing */
+  TubeCPU::Push(PSR);
+  TubeCPU::SetPSR(FlagI,0,0,1,0,0,0,0); /* Set I after pushing - see Birnbaum */
   TubeProgramCounter=TubeReadMem(0xfffe) | (TubeReadMem(0xffff)<<8);
 } /* BRKInstrHandler */
 
-INLINE static void BVCInstrHandler(void) {
-  if (!GETVFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BVCInstrHandler */
-
-INLINE static void BVSInstrHandler(void) {
-  if (GETVFLAG) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-  } else TubeProgramCounter++;
-} /* BVSInstrHandler */
-
-INLINE static void BRAInstrHandler(void) {
-    TubeProgramCounter=RelAddrModeHandler_Data();
-    Branched=1;
-} /* BRAnstrHandler */
-
-INLINE static void CMPInstrHandler(int16 operand) {
-  /* NOTE! Should we consult D flag ? */
-  unsigned char result=Accumulator-operand;
-  unsigned char CFlag;
-  CFlag=0; if (Accumulator>=operand) CFlag=FlagC;
-  SetPSRCZN(CFlag,Accumulator==operand,result & 128);
-} /* CMPInstrHandler */
-
-INLINE static void CPXInstrHandler(int16 operand) {
-  unsigned char result=(XReg-operand);
-  SetPSRCZN(XReg>=operand,XReg==operand,result & 128);
-} /* CPXInstrHandler */
-
-INLINE static void CPYInstrHandler(int16 operand) {
-  unsigned char result=(YReg-operand);
-  SetPSRCZN(YReg>=operand,YReg==operand,result & 128);
-} /* CPYInstrHandler */
-
-INLINE static void DECInstrHandler(int16 address) {
-  unsigned char val;
-
-  val=TUBEREADMEM_FAST(address);
-
-  val=(val-1);
-
-  TUBEWRITEMEM_FAST(address,val);
-  SetPSRZN(val);
-} /* DECInstrHandler */
-
-INLINE static void DEXInstrHandler(void) {
-  XReg=(XReg-1) & 255;
-  SetPSRZN(XReg);
-} /* DEXInstrHandler */
-
-INLINE static void DEAInstrHandler(void) {
-  Accumulator=(Accumulator-1) & 255;
-  SetPSRZN(Accumulator);
-} /* DEAInstrHandler */
-
-INLINE static void EORInstrHandler(int16 operand) {
-  Accumulator^=operand;
-  SetPSRZN(Accumulator);
-} /* EORInstrHandler */
-
-INLINE static void INCInstrHandler(int16 address) {
-  unsigned char val;
-
-  val=TUBEREADMEM_FAST(address);
-
-  val=(val+1) & 255;
-
-  TUBEWRITEMEM_FAST(address,val);
-  SetPSRZN(val);
-} /* INCInstrHandler */
-
-INLINE static void INXInstrHandler(void) {
-  XReg+=1;
-  XReg&=255;
-  SetPSRZN(XReg);
-} /* INXInstrHandler */
-
-INLINE static void INAInstrHandler(void) {
-  Accumulator+=1;
-  Accumulator&=255;
-  SetPSRZN(Accumulator);
-} /* INAInstrHandler */
-
-INLINE static void JSRInstrHandler(int16 address) {
-  PushWord(TubeProgramCounter-1);
-  TubeProgramCounter=address;
-} /* JSRInstrHandler */
-
-INLINE static void LDAInstrHandler(int16 operand) {
-  Accumulator=operand;
-  SetPSRZN(Accumulator);
-} /* LDAInstrHandler */
-
-INLINE static void LDXInstrHandler(int16 operand) {
-  XReg=operand;
-  SetPSRZN(XReg);
-} /* LDXInstrHandler */
-
-INLINE static void LDYInstrHandler(int16 operand) {
-  YReg=operand;
-  SetPSRZN(YReg);
-} /* LDYInstrHandler */
-
-INLINE static void LSRInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-  oldVal=TUBEREADMEM_FAST(address);
-  newVal=(((unsigned int)oldVal)>>1) & 127;
-  TUBEWRITEMEM_FAST(address,newVal);
-  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
-} /* LSRInstrHandler */
-
-INLINE static void LSRInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-  /* Accumulator */
-  oldVal=Accumulator;
-  Accumulator=newVal=(((unsigned int)Accumulator)>>1) & 127;
-  SetPSRCZN((oldVal & 1)>0, newVal==0,0);
-} /* LSRInstrHandler_Acc */
-
-INLINE static void ORAInstrHandler(int16 operand) {
-  Accumulator=Accumulator | operand;
-  SetPSRZN(Accumulator);
-} /* ORAInstrHandler */
-
-INLINE static void ROLInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-
-  oldVal=TUBEREADMEM_FAST(address);
-  newVal=((unsigned int)oldVal<<1) & 254;
-  newVal+=GETCFLAG;
-  TUBEWRITEMEM_FAST(address,newVal);
-  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
-} /* ROLInstrHandler */
-
-INLINE static void ROLInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-
-  oldVal=Accumulator;
-  newVal=((unsigned int)oldVal<<1) & 254;
-  newVal+=GETCFLAG;
-  Accumulator=newVal;
-  SetPSRCZN((oldVal & 128)>0,newVal==0,newVal & 128);
-} /* ROLInstrHandler_Acc */
-
-INLINE static void RORInstrHandler(int16 address) {
-  unsigned char oldVal,newVal;
-
-  oldVal=TUBEREADMEM_FAST(address);
-  newVal=((unsigned int)oldVal>>1) & 127;
-  newVal+=GETCFLAG*128;
-  TUBEWRITEMEM_FAST(address,newVal);
-  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
-} /* RORInstrHandler */
-
-INLINE static void RORInstrHandler_Acc(void) {
-  unsigned char oldVal,newVal;
-
-  oldVal=Accumulator;
-  newVal=((unsigned int)oldVal>>1) & 127;
-  newVal+=GETCFLAG*128;
-  Accumulator=newVal;
-  SetPSRCZN(oldVal & 1,newVal==0,newVal & 128);
-} /* RORInstrHandler_Acc */
-
-INLINE static void SBCInstrHandler(int16 operand) {
-  /* NOTE! Not sure about C and V flags */
-  int TmpResultV,TmpResultC;
-  unsigned char nhn,nln;
-  if (!GETDFLAG) {
-    TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GETCFLAG);
-    TmpResultC=Accumulator-operand-(1-GETCFLAG);
-    Accumulator=TmpResultC & 255;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN, TmpResultC>=0,Accumulator==0,0,0,0,
-      ((Accumulator & 128)>0) ^ ((TmpResultV & 256)!=0),(Accumulator & 128));
-  } else {
-    int ZFlag=0,NFlag=0,CFlag=1,VFlag=0;
-    int TmpResult,TmpCarry=0;
-    int ln,hn,oln,ohn;
-	nhn=(Accumulator>>4)&15; nln=Accumulator & 15;
-
-    /* Z flag determined from 2's compl result, not BCD result! */
-    TmpResult=Accumulator-operand-(1-GETCFLAG);
-    ZFlag=((TmpResult & 0xff)==0);
-
-	ohn=operand & 0xf0; oln = operand & 0xf;
-	if ((oln>9) && ((Accumulator&15)<10)) { oln-=10; ohn+=0x10; } 
-	// promote the lower nibble to the next ten, and increase the higher nibble
-    ln=(Accumulator & 0xf)-oln-(1-GETCFLAG);
-    if (ln<0) {
-	  if ((Accumulator & 15)<10) ln-=6;
-      ln&=0xf;
-      TmpCarry=0x10;
-    }
-    hn=(Accumulator & 0xf0)-ohn-TmpCarry;
-    /* N and V flags are determined before high nibble is adjusted.
-       NOTE: V is not always correct */
-    NFlag=hn & 128;
-	TmpResultV=(signed char)Accumulator-(signed char)operand-(1-GETCFLAG);
-	if ((TmpResultV<-128)||(TmpResultV>127)) VFlag=1; else VFlag=0;
-    if (hn<0) {
-      hn-=0x60;
-      hn&=0xf0;
-      CFlag=0;
-    }
-    Accumulator=hn|ln;
-	if (Accumulator==0) ZFlag=1;
-	NFlag=(hn &128);
-	CFlag=(TmpResult&256)==0;
-    SetPSR(FlagC | FlagZ | FlagV | FlagN,CFlag,ZFlag,0,0,0,VFlag,NFlag);
-  }
-} /* SBCInstrHandler */
-
-INLINE static void STXInstrHandler(int16 address) {
-  TUBEWRITEMEM_FAST(address,XReg);
-} /* STXInstrHandler */
-
-INLINE static void STYInstrHandler(int16 address) {
-  TUBEWRITEMEM_FAST(address,YReg);
-} /* STYInstrHandler */
-
 INLINE static void BadInstrHandler(int opcode) {
 	if (!IgnoreIllegalInstructions)
 	{
@@ -1179,240 +883,6 @@ INLINE static void BadInstrHandler(int opcode) {
 	}
 } /* BadInstrHandler */
 
-/*-------------------------------------------------------------------------*/
-/* Absolute  addressing mode handler                                       */
-INLINE static int16 AbsAddrModeHandler_Data(void) {
-  int FullAddress;
-
-  /* Get the address from after the instruction */
-  
-  GETTWOBYTEFROMPC(FullAddress)
-
-  /* And then read it */
-  return(TUBEREADMEM_FAST(FullAddress));
-} /* AbsAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute  addressing mode handler                                       */
-INLINE static int16 AbsAddrModeHandler_Address(void) {
-  int FullAddress;
-
-  /* Get the address from after the instruction */
-  GETTWOBYTEFROMPC(FullAddress)
-
-  /* And then read it */
-  return(FullAddress);
-} /* AbsAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page addressing mode handler                                       */
-INLINE static int16 ZeroPgAddrModeHandler_Address(void) {
-  return(TubeRam[TubeProgramCounter++]);
-} /* ZeroPgAddrModeHandler_Address */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with X preinc addressing mode handler                           */
-INLINE static int16 IndXAddrModeHandler_Data(void) {
-  unsigned char ZeroPageAddress;
-  int EffectiveAddress;
-
-  ZeroPageAddress=(TubeRam[TubeProgramCounter++]+XReg) & 255;
-
-  EffectiveAddress=TubeRam[ZeroPageAddress] | (TubeRam[ZeroPageAddress+1]<<8);
-  return(TUBEREADMEM_FAST(EffectiveAddress));
-} /* IndXAddrModeHandler_Data */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with X preinc addressing mode handler                           */
-INLINE static int16 IndXAddrModeHandler_Address(void) {
-  unsigned char ZeroPageAddress;
-  int EffectiveAddress;
-
-  ZeroPageAddress=(TubeRam[TubeProgramCounter++]+XReg) & 255;
-
-  EffectiveAddress=TubeRam[ZeroPageAddress] | (TubeRam[ZeroPageAddress+1]<<8);
-  return(EffectiveAddress);
-} /* IndXAddrModeHandler_Address */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with Y postinc addressing mode handler                          */
-INLINE static int16 IndYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  unsigned char ZPAddr=TubeRam[TubeProgramCounter++];
-  EffectiveAddress=TubeRam[ZPAddr]+YReg;
-  if (EffectiveAddress>0xff) Carried();
-
-  EffectiveAddress+=(TubeRam[ZPAddr+1]<<8);
-
-  return(TUBEREADMEM_FAST(EffectiveAddress));
-} /* IndYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Indexed with Y postinc addressing mode handler                          */
-INLINE static int16 IndYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  unsigned char ZPAddr=TubeRam[TubeProgramCounter++];
-  EffectiveAddress=TubeRam[ZPAddr]+YReg;
-
-  if (EffectiveAddress>0xff) Carried();
-
-  EffectiveAddress+=(TubeRam[ZPAddr+1]<<8);
-
-  return(EffectiveAddress);
-} /* IndYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page wih X offset addressing mode handler                          */
-INLINE static int16 ZeroPgXAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(TubeRam[TubeProgramCounter++]+XReg) & 255;
-  return(TubeRam[EffectiveAddress]);
-} /* ZeroPgXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page wih X offset addressing mode handler                          */
-INLINE static int16 ZeroPgXAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(TubeRam[TubeProgramCounter++]+XReg) & 255;
-  return(EffectiveAddress);
-} /* ZeroPgXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with X offset addressing mode handler                          */
-INLINE static int16 AbsXAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress);
-
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+XReg) & 0xff00)) Carried();
-
-  EffectiveAddress+=XReg;
-  EffectiveAddress&=0xffff;
-
-  return(TUBEREADMEM_FAST(EffectiveAddress));
-} /* AbsXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with X offset addressing mode handler                          */
-INLINE static int16 AbsXAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress)
-
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+XReg) & 0xff00)) Carried();
-
-  EffectiveAddress+=XReg;
-  EffectiveAddress&=0xffff;
-
-  return(EffectiveAddress);
-} /* AbsXAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with Y offset addressing mode handler                          */
-INLINE static int16 AbsYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress);
-
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+YReg) & 0xff00)) Carried();
-
-  EffectiveAddress+=YReg;
-  EffectiveAddress&=0xffff;
-
-  return(TUBEREADMEM_FAST(EffectiveAddress));
-} /* AbsYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Absolute with Y offset addressing mode handler                          */
-INLINE static int16 AbsYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  GETTWOBYTEFROMPC(EffectiveAddress)
-
-  if ((EffectiveAddress & 0xff00)!=((EffectiveAddress+YReg) & 0xff00)) Carried();
-
-  EffectiveAddress+=YReg;
-  EffectiveAddress&=0xffff;
-
-  return(EffectiveAddress);
-} /* AbsYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Indirect addressing mode handler                                        */
-INLINE static int16 IndAddrModeHandler_Address(void) {
-  /* For jump indirect only */
-  int VectorLocation;
-  int EffectiveAddress;
-
-  GETTWOBYTEFROMPC(VectorLocation)
-
-  /* Ok kiddies, deliberate bug time.
-  According to my BBC Master Reference Manual Part 2
-  the 6502 has a bug concerning this addressing mode and VectorLocation==xxFF
-  so, we're going to emulate that bug -- Richard Gellman */
-  if ((VectorLocation & 0xff)!=0xff || TubeMachineType==3) {
-   EffectiveAddress=TUBEREADMEM_FAST(VectorLocation);
-   EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation+1) << 8; }
-  else {
-   EffectiveAddress=TUBEREADMEM_FAST(VectorLocation);
-   EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation-255) << 8;
-  }
-  return(EffectiveAddress);
-} /* IndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page Indirect addressing mode handler                                        */
-INLINE static int16 ZPIndAddrModeHandler_Address(void) {
-  int VectorLocation;
-  int EffectiveAddress;
-
-  VectorLocation=TubeRam[TubeProgramCounter++];
-  EffectiveAddress=TubeRam[VectorLocation]+(TubeRam[VectorLocation+1]<<8);
-
-   // EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation+1) << 8; }
-  return(EffectiveAddress);
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page Indirect addressing mode handler                                        */
-INLINE static int16 ZPIndAddrModeHandler_Data(void) {
-  int VectorLocation;
-  int EffectiveAddress;
-
-  VectorLocation=TubeRam[TubeProgramCounter++];
-  EffectiveAddress=TubeRam[VectorLocation]+(TubeRam[VectorLocation+1]<<8);
-
-   // EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation+1) << 8; }
-  return(TubeRam[EffectiveAddress]);
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Pre-indexed absolute Indirect addressing mode handler                                        */
-INLINE static int16 IndAddrXModeHandler_Address(void) {
-  /* For jump indirect only */
-  int VectorLocation;
-  int EffectiveAddress;
-
-  GETTWOBYTEFROMPC(VectorLocation)
-  EffectiveAddress=TUBEREADMEM_FAST(VectorLocation+XReg);
-  EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation+1+XReg) << 8; 
-
-   // EffectiveAddress|=TUBEREADMEM_FAST(VectorLocation+1) << 8; }
-  return(EffectiveAddress);
-} /* ZPIndAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page with Y offset addressing mode handler                         */
-INLINE static int16 ZeroPgYAddrModeHandler_Data(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(TubeRam[TubeProgramCounter++]+YReg) & 255;
-  return(TubeRam[EffectiveAddress]);
-} /* ZeroPgYAddrModeHandler */
-
-/*-------------------------------------------------------------------------*/
-/* Zero page with Y offset addressing mode handler                         */
-INLINE static int16 ZeroPgYAddrModeHandler_Address(void) {
-  int EffectiveAddress;
-  EffectiveAddress=(TubeRam[TubeProgramCounter++]+YReg) & 255;
-  return(EffectiveAddress);
-} /* ZeroPgYAddrModeHandler */
-
 /*-------------------------------------------------------------------------*/
 /* Reset processor */
 void Reset65C02(void) {
@@ -1453,6 +923,7 @@ void Reset65C02(void) {
 
   TubeProgramCounter=TubeReadMem(0xfffc) | (TubeReadMem(0xfffd)<<8);
   TotalTubeCycles=TotalCycles/2*3;
+  SetTubeSpeed();
 }
 
 /* Reset Tube */
@@ -1497,10 +968,10 @@ void Init65C02core(void) {
 
 /*-------------------------------------------------------------------------*/
 void DoTubeInterrupt(void) {
-  PushWord(TubeProgramCounter);
-  Push(PSR & ~FlagB);
+  TubeCPU::PushWord(TubeProgramCounter);
+  TubeCPU::Push(PSR & ~FlagB);
   TubeProgramCounter=TubeReadMem(0xfffe) | (TubeReadMem(0xffff)<<8);
-  SetPSR(FlagI,0,0,1,0,0,0,0);
+  TubeCPU::SetPSR(FlagI,0,0,1,0,0,0,0);
   IRQCycles=7;
 } /* DoInterrupt */
 
@@ -1508,10 +979,10 @@ void DoTubeInterrupt(void) {
 void DoTubeNMI(void) {
   /*cerr << "Doing NMI\n"; */
   tube_NMILock=1;
-  PushWord(TubeProgramCounter);
-  Push(PSR);
+  TubeCPU::PushWord(TubeProgramCounter);
+  TubeCPU::Push(PSR);
   TubeProgramCounter=TubeReadMem(0xfffa) | (TubeReadMem(0xfffb)<<8);
-  SetPSR(FlagI,0,0,1,0,0,0,0); /* Normal interrupts should be disabled during NMI ? */
+  TubeCPU::SetPSR(FlagI,0,0,1,0,0,0,0); /* Normal interrupts should be disabled during NMI ? */
   IRQCycles=7;
 } /* DoNMI */
 
@@ -1520,7 +991,7 @@ void DoTubeNMI(void) {
 void Exec65C02Instruction(void) {
   static int tmpaddr;
   static int OldTubeNMIStatus;
-  int OldPC;
+  int NMILines;
 
   // Output debug info
 //--  if (DebugEnabled)
@@ -1529,315 +1000,312 @@ void Exec65C02Instruction(void) {
   // For the Master, check Shadow Ram Presence
   // Note, this has to be done BEFORE reading an instruction due to Bit E and the PC
   /* Read an instruction and post inc program couter */
-  OldPC=TubeProgramCounter;
-
   CurrentInstruction=TubeRam[TubeProgramCounter++];
   // cout << "Fetch at " << hex << (TubeProgramCounter-1) << " giving 0x" << CurrentInstruction << dec << "\n"; 
   TubeCycles=TubeCyclesTable[CurrentInstruction]; 
   /*Stats[CurrentInstruction]++; */
-  Branched=0;
   switch (CurrentInstruction) {
     case 0x00:
       BRKInstrHandler();
       break;
     case 0x01:
-      ORAInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
 	case 0x04:
-	  if (TubeMachineType==3) TSBInstrHandler(ZeroPgAddrModeHandler_Address()); else TubeProgramCounter+=1;
+	  if (TubeCPU::CMOS) TubeCPU::TSBInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address()); else TubeProgramCounter+=1;
 	  break;
     case 0x05:
-      ORAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::ORAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0x06:
-      ASLInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::ASLInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0x08:
-      Push(PSR|48); /* PHP */
+      TubeCPU::Push(PSR|48); /* PHP */
       break;
     case 0x09:
-      ORAInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::ORAInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0x0a:
-      ASLInstrHandler_Acc();
+      TubeCPU::ASLInstrHandler_Acc();
       break;
 	case 0x0c:
-	  if (TubeMachineType==3) TSBInstrHandler(AbsAddrModeHandler_Address()); else TubeProgramCounter+=2;
+	  if (TubeCPU::CMOS) TubeCPU::TSBInstrHandler(TubeCPU::AbsAddrModeHandler_Address()); else TubeProgramCounter+=2;
 	  break;
     case 0x0d:
-      ORAInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0x0e:
-      ASLInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::ASLInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x10:
-      BPLInstrHandler();
+      TubeCPU::BPLInstrHandler();
       break;
     case 0x30:
-      BMIInstrHandler();
+      TubeCPU::BMIInstrHandler();
       break;
     case 0x50:
-      BVCInstrHandler();
+      TubeCPU::BVCInstrHandler();
       break;
     case 0x70:
-      BVSInstrHandler();
+      TubeCPU::BVSInstrHandler();
       break;
     case 0x80:
-      BRAInstrHandler();
+      TubeCPU::BRAInstrHandler();
       break;
     case 0x90:
-      BCCInstrHandler();
+      TubeCPU::BCCInstrHandler();
       break;
     case 0xb0:
-      BCSInstrHandler();
+      TubeCPU::BCSInstrHandler();
       break;
     case 0xd0:
-      BNEInstrHandler();
+      TubeCPU::BNEInstrHandler();
       break;
     case 0xf0:
-      BEQInstrHandler();
+      TubeCPU::BEQInstrHandler();
       break;
     case 0x11:
-      ORAInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0x12:
-      if (TubeMachineType==3) ORAInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::ORAInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
 	case 0x14:
-	  if (TubeMachineType==3) TRBInstrHandler(ZeroPgAddrModeHandler_Address()); else TubeProgramCounter+=1;
+	  if (TubeCPU::CMOS) TubeCPU::TRBInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address()); else TubeProgramCounter+=1;
 	  break;
     case 0x15:
-      ORAInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0x16:
-      ASLInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::ASLInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0x18:
       PSR&=255-FlagC; /* CLC */
       break;
     case 0x19:
-      ORAInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0x1a:
-      if (TubeMachineType==3) INAInstrHandler();
+      if (TubeCPU::CMOS) TubeCPU::INAInstrHandler();
       break;
 	case 0x1c:
-	  if (TubeMachineType==3) TRBInstrHandler(AbsAddrModeHandler_Address()); else TubeProgramCounter+=2;
+	  if (TubeCPU::CMOS) TubeCPU::TRBInstrHandler(TubeCPU::AbsAddrModeHandler_Address()); else TubeProgramCounter+=2;
 	  break;
     case 0x1d:
-      ORAInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::ORAInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0x1e:
-      ASLInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::ASLInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0x20:
-      JSRInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::JSRInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x21:
-      ANDInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0x24:
-      BITInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::BITInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0x25:
-      ANDInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::ANDInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0x26:
-      ROLInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::ROLInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0x28:
-      PSR=Pop(); /* PLP */
+      PSR=TubeCPU::Pop(); /* PLP */
       break;
     case 0x29:
-      ANDInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::ANDInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0x2a:
-      ROLInstrHandler_Acc();
+      TubeCPU::ROLInstrHandler_Acc();
       break;
     case 0x2c:
-      BITInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::BITInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0x2d:
-      ANDInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0x2e:
-      ROLInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::ROLInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x31:
-      ANDInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0x32:
-      if (TubeMachineType==3) ANDInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::ANDInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0x34: /* BIT Absolute,X */
-      if (TubeMachineType==3) BITInstrHandler(ZeroPgXAddrModeHandler_Data()); else TubeProgramCounter+=1;
+      if (TubeCPU::CMOS) TubeCPU::BITInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data()); else TubeProgramCounter+=1;
       break;
     case 0x35:
-      ANDInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0x36:
-      ROLInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::ROLInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0x38:
       PSR|=FlagC; /* SEC */
       break;
     case 0x39:
-      ANDInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0x3a:
-      if (TubeMachineType==3) DEAInstrHandler();
+      if (TubeCPU::CMOS) TubeCPU::DEAInstrHandler();
       break;
     case 0x3c: /* BIT Absolute,X */
-      if (TubeMachineType==3) BITInstrHandler(AbsXAddrModeHandler_Data()); else TubeProgramCounter+=2;
+      if (TubeCPU::CMOS) TubeCPU::BITInstrHandler(TubeCPU::AbsXAddrModeHandler_Data()); else TubeProgramCounter+=2;
       break;
     case 0x3d:
-      ANDInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::ANDInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0x3e:
-      ROLInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::ROLInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0x40:
-      PSR=Pop(); /* RTI */
-      TubeProgramCounter=PopWord();
+      PSR=TubeCPU::Pop(); /* RTI */
+      TubeProgramCounter=TubeCPU::PopWord();
 	tube_NMILock=0;
       break;
     case 0x41:
-      EORInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0x45:
-      EORInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::EORInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0x46:
-      LSRInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::LSRInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0x48:
-      Push(Accumulator); /* PHA */
+      TubeCPU::Push(Accumulator); /* PHA */
       break;
     case 0x49:
-      EORInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::EORInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0x4a:
-      LSRInstrHandler_Acc();
+      TubeCPU::LSRInstrHandler_Acc();
       break;
     case 0x4c:
-      TubeProgramCounter=AbsAddrModeHandler_Address(); /* JMP */
+      TubeProgramCounter=TubeCPU::AbsAddrModeHandler_Address(); /* JMP */
       break;
     case 0x4d:
-      EORInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0x4e:
-      LSRInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::LSRInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x51:
-      EORInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0x52:
-      if (TubeMachineType==3) EORInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::EORInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0x55:
-      EORInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0x56:
-      LSRInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::LSRInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0x58:
       PSR&=255-FlagI; /* CLI */
       break;
     case 0x59:
-      EORInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0x5a:
-      if (TubeMachineType==3) Push(YReg); /* PHY */
+      if (TubeCPU::CMOS) TubeCPU::Push(YReg); /* PHY */
       break;
     case 0x5d:
-      EORInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::EORInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0x5e:
-      LSRInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::LSRInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0x60:
-      TubeProgramCounter=PopWord()+1; /* RTS */
+      TubeProgramCounter=TubeCPU::PopWord()+1; /* RTS */
       break;
     case 0x61:
-      ADCInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0x64:
-      if (TubeMachineType==3) TUBEWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),0); /* STZ Zero Page */
+      if (TubeCPU::CMOS) TUBEWRITEMEM_DIRECT(TubeCPU::ZeroPgAddrModeHandler_Address(),0); /* STZ Zero Page */
       break;
     case 0x65:
-      ADCInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::ADCInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0x66:
-      RORInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::RORInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0x68:
-      Accumulator=Pop(); /* PLA */
+      Accumulator=TubeCPU::Pop(); /* PLA */
       PSR&=~(FlagZ | FlagN);
       PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
       break;
     case 0x69:
-      ADCInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::ADCInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0x6a:
-      RORInstrHandler_Acc();
+      TubeCPU::RORInstrHandler_Acc();
       break;
     case 0x6c:
-      TubeProgramCounter=IndAddrModeHandler_Address(); /* JMP */
+      TubeProgramCounter=TubeCPU::IndAddrModeHandler_Address(); /* JMP */
       break;
     case 0x6d:
-      ADCInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0x6e:
-      RORInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::RORInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x71:
-      ADCInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0x72:
-      if (TubeMachineType==3) ADCInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::ADCInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0x74:
-	  if (TubeMachineType==3) { TUBEFASTWRITE(ZeroPgXAddrModeHandler_Address(),0); } else TubeProgramCounter+=1; /* STZ Zpg,X */
+	  if (TubeCPU::CMOS) { TUBEFASTWRITE(TubeCPU::ZeroPgXAddrModeHandler_Address(),0); } else TubeProgramCounter+=1; /* STZ Zpg,X */
       break;
     case 0x75:
-      ADCInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0x76:
-      RORInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::RORInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0x78:
       PSR|=FlagI; /* SEI */
       break;
     case 0x79:
-      ADCInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0x7a:
-		if (TubeMachineType==3) {
-			YReg=Pop(); /* PLY */
+		if (TubeCPU::CMOS) {
+			YReg=TubeCPU::Pop(); /* PLY */
 			PSR&=~(FlagZ | FlagN);
 			PSR|=((XReg==0)<<1) | (YReg & 128);
 		}
 	  break;
     case 0x7c:
-      if (TubeMachineType==3) TubeProgramCounter=IndAddrXModeHandler_Address(); /* JMP abs,X*/ else TubeProgramCounter+=2;
+      if (TubeCPU::CMOS) TubeProgramCounter=TubeCPU::IndAddrXModeHandler_Address(); /* JMP abs,X*/ else TubeProgramCounter+=2;
       break;
     case 0x7d:
-      ADCInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::ADCInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0x7e:
-      RORInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::RORInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0x81:
-      TUBEFASTWRITE(IndXAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::IndXAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x84:
-      TUBEWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),YReg);
+      TUBEWRITEMEM_DIRECT(TubeCPU::ZeroPgAddrModeHandler_Address(),YReg);
       break;
     case 0x85:
-      TUBEWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEWRITEMEM_DIRECT(TubeCPU::ZeroPgAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x86:
-      TUBEWRITEMEM_DIRECT(ZeroPgAddrModeHandler_Address(),XReg);
+      TUBEWRITEMEM_DIRECT(TubeCPU::ZeroPgAddrModeHandler_Address(),XReg);
       break;
     case 0x88:
       YReg=(YReg-1) & 255; /* DEY */
@@ -1845,7 +1313,7 @@ void Exec65C02Instruction(void) {
       PSR|=((YReg==0)<<1) | (YReg & 128);
       break;
     case 0x89: /* BIT Immediate */
-      if (TubeMachineType==3) BITInstrHandler(TubeRam[TubeProgramCounter++]);
+      if (TubeCPU::CMOS) TubeCPU::BITInstrHandler(TubeRam[TubeProgramCounter++]);
       break;
     case 0x8a:
       Accumulator=XReg; /* TXA */
@@ -1853,28 +1321,28 @@ void Exec65C02Instruction(void) {
       PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
       break;
     case 0x8c:
-      STYInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::STYInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x8d:
-      TUBEFASTWRITE(AbsAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::AbsAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x8e:
-      STXInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::STXInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0x91:
-      TUBEFASTWRITE(IndYAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::IndYAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x92:
-      if (TubeMachineType==3) TUBEFASTWRITE(ZPIndAddrModeHandler_Address(),Accumulator); /* STA */
+      if (TubeCPU::CMOS) TUBEFASTWRITE(TubeCPU::ZPIndAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x94:
-      STYInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::STYInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0x95:
-      TUBEFASTWRITE(ZeroPgXAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::ZeroPgXAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x96:
-      STXInstrHandler(ZeroPgYAddrModeHandler_Address());
+      TubeCPU::STXInstrHandler(TubeCPU::ZeroPgYAddrModeHandler_Address());
       break;
     case 0x98:
       Accumulator=YReg; /* TYA */
@@ -1882,40 +1350,40 @@ void Exec65C02Instruction(void) {
       PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
       break;
     case 0x99:
-      TUBEFASTWRITE(AbsYAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::AbsYAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x9a:
       StackReg=XReg; /* TXS */
       break;
     case 0x9c:
-      TUBEFASTWRITE(AbsAddrModeHandler_Address(),0); /* STZ Absolute */
+      TUBEFASTWRITE(TubeCPU::AbsAddrModeHandler_Address(),0); /* STZ Absolute */
 	  /* here's a curiosity, STZ Absolute IS on the 6502 UNOFFICIALLY
 	  and on the 65C12 OFFICIALLY. Something we should know? - Richard Gellman */
       break;
     case 0x9d:
-      TUBEFASTWRITE(AbsXAddrModeHandler_Address(),Accumulator); /* STA */
+      TUBEFASTWRITE(TubeCPU::AbsXAddrModeHandler_Address(),Accumulator); /* STA */
       break;
     case 0x9e:
-		if (TubeMachineType==3) { TUBEFASTWRITE(AbsXAddrModeHandler_Address(),0); } /* STZ Abs,X */ 
-		else TubeRam[AbsXAddrModeHandler_Address()] = Accumulator & XReg;
+		if (TubeCPU::CMOS) { TUBEFASTWRITE(TubeCPU::AbsXAddrModeHandler_Address(),0); } /* STZ Abs,X */ 
+		else TubeRam[TubeCPU::AbsXAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0xa0:
-      LDYInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::LDYInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xa1:
-      LDAInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0xa2:
-      LDXInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::LDXInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xa4:
-      LDYInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::LDYInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xa5:
-      LDAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::LDAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xa6:
-      LDXInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::LDXInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xa8:
       YReg=Accumulator; /* TAY */
@@ -1923,7 +1391,7 @@ void Exec65C02Instruction(void) {
       PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
       break;
     case 0xa9:
-      LDAInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::LDAInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xaa:
       XReg=Accumulator; /* TXA */
@@ -1931,34 +1399,34 @@ void Exec65C02Instruction(void) {
       PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
       break;
     case 0xac:
-      LDYInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::LDYInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xad:
-      LDAInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xae:
-      LDXInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::LDXInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xb1:
-      LDAInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0xb2:
-      if (TubeMachineType==3) LDAInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::LDAInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0xb4:
-      LDYInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::LDYInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0xb5:
-      LDAInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0xb6:
-      LDXInstrHandler(ZeroPgYAddrModeHandler_Data());
+      TubeCPU::LDXInstrHandler(TubeCPU::ZeroPgYAddrModeHandler_Data());
       break;
     case 0xb8:
       PSR&=255-FlagV; /* CLV */
       break;
     case 0xb9:
-      LDAInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0xba:
       XReg=StackReg; /* TSX */
@@ -1966,28 +1434,28 @@ void Exec65C02Instruction(void) {
       PSR|=((XReg==0)<<1) | (XReg & 128);
       break;
     case 0xbc:
-      LDYInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::LDYInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0xbd:
-      LDAInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0xbe:
-      LDXInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::LDXInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0xc0:
-      CPYInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::CPYInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xc1:
-      CMPInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0xc4:
-      CPYInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::CPYInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xc5:
-      CMPInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::CMPInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xc6:
-      DECInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::DECInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0xc8:
       YReg+=1; /* INY */
@@ -1996,256 +1464,256 @@ void Exec65C02Instruction(void) {
       PSR|=((YReg==0)<<1) | (YReg & 128);
       break;
     case 0xc9:
-      CMPInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::CMPInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xca:
-      DEXInstrHandler();
+      TubeCPU::DEXInstrHandler();
       break;
     case 0xcc:
-      CPYInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::CPYInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xcd:
-      CMPInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xce:
-      DECInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::DECInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0xd1:
-      CMPInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0xd2:
-      if (TubeMachineType==3) CMPInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::CMPInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0xd5:
-      CMPInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0xd6:
-      DECInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::DECInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0xd8:
       PSR&=255-FlagD; /* CLD */
       break;
     case 0xd9:
-      CMPInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0xda:
-      if (TubeMachineType==3) Push(XReg); /* PHX */
+      if (TubeCPU::CMOS) TubeCPU::Push(XReg); /* PHX */
       break;
     case 0xdd:
-      CMPInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::CMPInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0xde:
-      DECInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::DECInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0xe0:
-      CPXInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::CPXInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xe1:
-      SBCInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       break;
     case 0xe4:
-      CPXInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::CPXInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xe5:
-      SBCInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
+      TubeCPU::SBCInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]/*zp */);
       break;
     case 0xe6:
-      INCInstrHandler(ZeroPgAddrModeHandler_Address());
+      TubeCPU::INCInstrHandler(TubeCPU::ZeroPgAddrModeHandler_Address());
       break;
     case 0xe8:
-      INXInstrHandler();
+      TubeCPU::INXInstrHandler();
       break;
     case 0xe9:
-      SBCInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
+      TubeCPU::SBCInstrHandler(TubeRam[TubeProgramCounter++]); /* immediate */
       break;
     case 0xea:
       /* NOP */
       break;
     case 0xec:
-      CPXInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::CPXInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xed:
-      SBCInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       break;
     case 0xee:
-      INCInstrHandler(AbsAddrModeHandler_Address());
+      TubeCPU::INCInstrHandler(TubeCPU::AbsAddrModeHandler_Address());
       break;
     case 0xf1:
-      SBCInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       break;
     case 0xf2:
-      if (TubeMachineType==3) SBCInstrHandler(ZPIndAddrModeHandler_Data());
+      if (TubeCPU::CMOS) TubeCPU::SBCInstrHandler(TubeCPU::ZPIndAddrModeHandler_Data());
       break;
     case 0xf5:
-      SBCInstrHandler(ZeroPgXAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Data());
       break;
     case 0xf6:
-      INCInstrHandler(ZeroPgXAddrModeHandler_Address());
+      TubeCPU::INCInstrHandler(TubeCPU::ZeroPgXAddrModeHandler_Address());
       break;
     case 0xf8:
       PSR|=FlagD; /* SED */
       break;
     case 0xf9:
-      SBCInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       break;
     case 0xfa:
-		if (TubeMachineType==3) {
-	  XReg=Pop(); /* PLX */
+		if (TubeCPU::CMOS) {
+	  XReg=TubeCPU::Pop(); /* PLX */
       PSR&=~(FlagZ | FlagN);
       PSR|=((XReg==0)<<1) | (XReg & 128);
 		}
 		break;
     case 0xfd:
-      SBCInstrHandler(AbsXAddrModeHandler_Data());
+      TubeCPU::SBCInstrHandler(TubeCPU::AbsXAddrModeHandler_Data());
       break;
     case 0xfe:
-      INCInstrHandler(AbsXAddrModeHandler_Address());
+      TubeCPU::INCInstrHandler(TubeCPU::AbsXAddrModeHandler_Address());
       break;
     case 0x07: /* Undocumented Instruction: ASL zp and ORA zp */
       {
-        int16 zpaddr = ZeroPgAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::ZeroPgAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x03: /* Undocumented Instruction: ASL-ORA (zp,X) */
       {
-        int16 zpaddr = IndXAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::IndXAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x13: /* Undocumented Instruction: ASL-ORA (zp),Y */
       {
-        int16 zpaddr = IndYAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::IndYAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x0f: /* Undocumented Instruction: ASL-ORA abs */
       {
-        int16 zpaddr = AbsAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::AbsAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x17: /* Undocumented Instruction: ASL-ORA zp,X */
       {
-        int16 zpaddr = ZeroPgXAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::ZeroPgXAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x1b: /* Undocumented Instruction: ASL-ORA abs,Y */
       {
-        int16 zpaddr = AbsYAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::AbsYAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
     case 0x1f: /* Undocumented Instruction: ASL-ORA abs,X */
       {
-        int16 zpaddr = AbsXAddrModeHandler_Address();
-        ASLInstrHandler(zpaddr);
-        ORAInstrHandler(TubeRam[zpaddr]);
+        int16 zpaddr = TubeCPU::AbsXAddrModeHandler_Address();
+        TubeCPU::ASLInstrHandler(zpaddr);
+        TubeCPU::ORAInstrHandler(TubeRam[zpaddr]);
       }
       break;
 	case 0x23: /* Undocumented Instruction: ROL-AND (zp,X) */
 		{
-		int16 zpaddr=IndXAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndXAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x27: /* Undocumented Instruction: ROL-AND zp */
 		{
-		int16 zpaddr=ZeroPgAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x2f: /* Undocumented Instruction: ROL-AND abs */
 		{
-		int16 zpaddr=AbsAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x33: /* Undocumented Instruction: ROL-AND (zp),Y */
 		{
-		int16 zpaddr=IndYAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndYAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x37: /* Undocumented Instruction: ROL-AND zp,X */
 		{
-		int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgXAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x3b: /* Undocumented Instruction: ROL-AND abs.Y */
 		{
-		int16 zpaddr=AbsYAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsYAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x3f: /* Undocumented Instruction: ROL-AND abs.X */
 		{
-		int16 zpaddr=AbsXAddrModeHandler_Address();
-		ROLInstrHandler(zpaddr);
-		ANDInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsXAddrModeHandler_Address();
+		TubeCPU::ROLInstrHandler(zpaddr);
+		TubeCPU::ANDInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x43: /* Undocumented Instruction: LSR-EOR (zp,X) */
 		{
-		int16 zpaddr=IndXAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndXAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x47: /* Undocumented Instruction: LSR-EOR zp */
 		{
-		int16 zpaddr=ZeroPgAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x4f: /* Undocumented Instruction: LSR-EOR abs */
 		{
-		int16 zpaddr=AbsAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x53: /* Undocumented Instruction: LSR-EOR (zp),Y */
 		{
-		int16 zpaddr=IndYAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndYAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x57: /* Undocumented Instruction: LSR-EOR zp,X */
 		{
-		int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgXAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x5b: /* Undocumented Instruction: LSR-EOR abs,Y */
 		{
-		int16 zpaddr=AbsYAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsYAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x5f: /* Undocumented Instruction: LSR-EOR abs,X */
 		{
-		int16 zpaddr=AbsXAddrModeHandler_Address();
-		LSRInstrHandler(zpaddr);
-		EORInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsXAddrModeHandler_Address();
+		TubeCPU::LSRInstrHandler(zpaddr);
+		TubeCPU::EORInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x44:
@@ -2257,161 +1725,161 @@ void Exec65C02Instruction(void) {
 		break;
 	case 0x63: /* Undocumented Instruction: ROR-ADC (zp,X) */
 		{
-		int16 zpaddr=IndXAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndXAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x67: /* Undocumented Instruction: ROR-ADC zp */
 		{
-		int16 zpaddr=ZeroPgAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x6f: /* Undocumented Instruction: ROR-ADC abs */
 		{
-		int16 zpaddr=AbsAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x73: /* Undocumented Instruction: ROR-ADC (zp),Y */
 		{
-		int16 zpaddr=IndYAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndYAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x77: /* Undocumented Instruction: ROR-ADC zp,X */
 		{
-		int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgXAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x7b: /* Undocumented Instruction: ROR-ADC abs,Y */
 		{
-		int16 zpaddr=AbsYAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsYAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0x7f: /* Undocumented Instruction: ROR-ADC abs,X */
 		{
-		int16 zpaddr=AbsXAddrModeHandler_Address();
-		RORInstrHandler(zpaddr);
-		ADCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsXAddrModeHandler_Address();
+		TubeCPU::RORInstrHandler(zpaddr);
+		TubeCPU::ADCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
     case 0x0b:
 	case 0x2b:
-      ANDInstrHandler(TubeRam[TubeProgramCounter++]); /* AND-MVC #n,b7 */
+      TubeCPU::ANDInstrHandler(TubeRam[TubeProgramCounter++]); /* AND-MVC #n,b7 */
 	  PSR|=((Accumulator & 128)>>7);
       break;
     case 0x4b: /* Undocumented Instruction: AND imm and LSR A */
-      ANDInstrHandler(TubeRam[TubeProgramCounter++]);
-      LSRInstrHandler_Acc();
+      TubeCPU::ANDInstrHandler(TubeRam[TubeProgramCounter++]);
+      TubeCPU::LSRInstrHandler_Acc();
       break;
     case 0x87: /* Undocumented Instruction: SAX zp (i.e. (zp) = A & X) */
       /* This one does not seem to change the processor flags */
-      TubeRam[ZeroPgAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::ZeroPgAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x83: /* Undocumented Instruction: SAX (zp,X) */
-      TubeRam[IndXAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::IndXAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x8f: /* Undocumented Instruction: SAX abs */
-      TubeRam[AbsAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::AbsAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x93: /* Undocumented Instruction: SAX (zp),Y */
-      TubeRam[IndYAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::IndYAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x97: /* Undocumented Instruction: SAX zp,Y */
-      TubeRam[ZeroPgYAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::ZeroPgYAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x9b: /* Undocumented Instruction: SAX abs,Y */
-      TubeRam[AbsYAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::AbsYAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0x9f: /* Undocumented Instruction: SAX abs,X */
-      TubeRam[AbsXAddrModeHandler_Address()] = Accumulator & XReg;
+      TubeRam[TubeCPU::AbsXAddrModeHandler_Address()] = Accumulator & XReg;
       break;
     case 0xab: /* Undocumented Instruction: LAX #n */
-      LDAInstrHandler(TubeRam[TubeProgramCounter++]);
+      TubeCPU::LDAInstrHandler(TubeRam[TubeProgramCounter++]);
       XReg = Accumulator;
       break;
     case 0xa3: /* Undocumented Instruction: LAX (zp,X) */
-      LDAInstrHandler(IndXAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::IndXAddrModeHandler_Data());
       XReg = Accumulator;
       break;
     case 0xa7: /* Undocumented Instruction: LAX zp */
-      LDAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]);
+      TubeCPU::LDAInstrHandler(TubeRam[TubeRam[TubeProgramCounter++]]);
       XReg = Accumulator;
       break;
     case 0xaf: /* Undocumented Instruction: LAX abs */
-      LDAInstrHandler(AbsAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::AbsAddrModeHandler_Data());
       XReg = Accumulator;
       break;
     case 0xb3: /* Undocumented Instruction: LAX (zp),Y */
-      LDAInstrHandler(IndYAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::IndYAddrModeHandler_Data());
       XReg = Accumulator;
       break;
     case 0xb7: /* Undocumented Instruction: LAX zp,Y */
-      LDXInstrHandler(ZeroPgYAddrModeHandler_Data());
+      TubeCPU::LDXInstrHandler(TubeCPU::ZeroPgYAddrModeHandler_Data());
       Accumulator = XReg;
       break;
 	case 0xbb:
     case 0xbf: /* Undocumented Instruction: LAX abs,Y */
-      LDAInstrHandler(AbsYAddrModeHandler_Data());
+      TubeCPU::LDAInstrHandler(TubeCPU::AbsYAddrModeHandler_Data());
       XReg = Accumulator;
       break;
 	// Undocumented DEC-CMP and INC-SBC Instructions
 	case 0xc3: // DEC-CMP (zp,X)
 		{
-		int16 zpaddr=IndXAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndXAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xc7: // DEC-CMP zp
 		{
-		int16 zpaddr=ZeroPgAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xcf: // DEC-CMP abs
 		{
-		int16 zpaddr=AbsAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xd3: // DEC-CMP (zp),Y
 		{
-		int16 zpaddr=IndYAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndYAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xd7: // DEC-CMP zp,X
 		{
-		int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgXAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xdb: // DEC-CMP abs,Y
 		{
-		int16 zpaddr=AbsYAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsYAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xdf: // DEC-CMP abs,X
 		{
-		int16 zpaddr=AbsXAddrModeHandler_Address();
-		DECInstrHandler(zpaddr);
-		CMPInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsXAddrModeHandler_Address();
+		TubeCPU::DECInstrHandler(zpaddr);
+		TubeCPU::CMPInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xd4:
@@ -2424,63 +1892,63 @@ void Exec65C02Instruction(void) {
 		break;
 	case 0xe3: // INC-SBC (zp,X)
 		{
-		int16 zpaddr=IndXAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndXAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xe7: // INC-SBC zp
 		{
-		int16 zpaddr=ZeroPgAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xef: // INC-SBC abs
 		{
-		int16 zpaddr=AbsAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xf3: // INC-SBC (zp).Y
 		{
-		int16 zpaddr=IndYAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::IndYAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xf7: // INC-SBC zp,X
 		{
-		int16 zpaddr=ZeroPgXAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::ZeroPgXAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xfb: // INC-SBC abs,Y
 		{
-		int16 zpaddr=AbsYAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsYAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	case 0xff: // INC-SBC abs,X
 		{
-		int16 zpaddr=AbsXAddrModeHandler_Address();
-		INCInstrHandler(zpaddr);
-		SBCInstrHandler(TubeRam[zpaddr]);
+		int16 zpaddr=TubeCPU::AbsXAddrModeHandler_Address();
+		TubeCPU::INCInstrHandler(zpaddr);
+		TubeCPU::SBCInstrHandler(TubeRam[zpaddr]);
 		}
 		break;
 	// REALLY Undocumented instructions 6B, 8B and CB
     case 0x6b:
-		ANDInstrHandler(TubeRam[TubeProgramCounter++]);
-		RORInstrHandler_Acc();
+		TubeCPU::ANDInstrHandler(TubeRam[TubeProgramCounter++]);
+		TubeCPU::RORInstrHandler_Acc();
 		break;
 	case 0x8b:
 		Accumulator=XReg; /* TXA */
 		PSR&=~(FlagZ | FlagN);
 		PSR|=((Accumulator==0)<<1) | (Accumulator & 128);
-		ANDInstrHandler(TubeRam[TubeProgramCounter++]);
+		TubeCPU::ANDInstrHandler(TubeRam[TubeProgramCounter++]);
 		break;
 	case 0xcb:
 		// SBX #n - I dont know if this uses the carry or not, i'm assuming its
@@ -2488,7 +1956,7 @@ void Exec65C02Instruction(void) {
 		{
 			unsigned char TmpAcc=Accumulator;
 			Accumulator=XReg;
-			SBCInstrHandler(TubeRam[TubeProgramCounter++]);
+			TubeCPU::SBCInstrHandler(TubeRam[TubeProgramCounter++]);
 			XReg=Accumulator;
 			Accumulator=TmpAcc; // Fudge so that I dont have to do the whole SBC code again
 		}
@@ -2500,46 +1968,189 @@ void Exec65C02Instruction(void) {
 
   }; /* OpCode switch */
 
-  // This block corrects the cycle count for the branch instructions
-  if ((CurrentInstruction==0x10) ||
-      (CurrentInstruction==0x30) ||
-      (CurrentInstruction==0x50) ||
-      (CurrentInstruction==0x70) ||
-      (CurrentInstruction==0x80) ||
-      (CurrentInstruction==0x90) ||
-      (CurrentInstruction==0xb0) ||
-      (CurrentInstruction==0xd0) ||
-      (CurrentInstruction==0xf0))
-  {
-    if (Branched)
-    {
-      TubeCycles++;
-      if ((TubeProgramCounter & 0xff00) != ((OldPC+2) & 0xff00))
-        TubeCycles+=1;
-    }
-  }
-
   TubeCycles+=IRQCycles;
   IRQCycles=0; // IRQ Timing
   // End of cycle correction
 
   if ((TubeintStatus) && (!GETIFLAG)) DoTubeInterrupt();
   
-  TotalTubeCycles+=TubeCycles;
+  AdvanceTubeClock(TubeCycles);
 
-  if ((TubeNMIStatus) && (!OldTubeNMIStatus)) DoTubeNMI();
-  OldTubeNMIStatus=TubeNMIStatus;
+  // Read the NMI lines once, the host may change them under a threaded 65C02
+  NMILines=TubeNMIStatus;
+  if ((NMILines) && (!OldTubeNMIStatus)) DoTubeNMI();
+  OldTubeNMIStatus=NMILines;
 } /* Exec6502Instruction */
 
 /*-------------------------------------------------------------------------*/
+/*-------------------------------------------------------------------------*/
+static int TubeThreadMain(void *data) {
+	CycleCountT Limit;
+
+	for (;;) {
+		SDL_SemWait(TubeGo);
+		if (TubeThreadState == TUBE_THREAD_QUIT)
+			break;
+
+		for (;;) {
+			if (TubeResetPending) {
+				SDL_LockMutex(TubeLock);
+				TubeResetPending=0;
+				Reset65C02();
+				TotalTubeCycles=TubeHostTime;
+				SDL_UnlockMutex(TubeLock);
+			}
+
+			Limit=TubeHostTime;
+			if (TubeThreadState == TUBE_THREAD_RUNNING)
+				Limit+=TUBE_THREAD_SKEW;
+
+			if (TubeSpeed == 0) {
+				// Unthrottled, always level with the host
+				if (TubeThreadState == TUBE_THREAD_STOPPING)
+					break;
+				Exec65C02Instruction();
+				TotalTubeCycles=TubeHostTime;
+				TubeParaTime=TotalTubeCycles;
+			}
+			else if (TotalTubeCycles < Limit) {
+				Exec65C02Instruction();
+				TubeParaTime=TotalTubeCycles;
+			}
+			else if (TubeThreadState == TUBE_THREAD_STOPPING)
+				break;
+			else
+				SDL_Delay(0);
+		}
+
+		SDL_SemPost(TubeParked);
+	}
+
+	return 0;
+}
+
+static void ParkTubeThread(void) {
+	TUBE_THREAD_BARRIER();
+	TubeThreadState=TUBE_THREAD_STOPPING;
+	SDL_SemWait(TubeParked);
+	TubeThreadState=TUBE_THREAD_PARKED;
+	TUBE_THREAD_BARRIER();
+}
+
+static void ResumeTubeThread(void) {
+	TubeParaTime=TotalTubeCycles;
+	TubeThreadState=TUBE_THREAD_RUNNING;
+	TUBE_THREAD_BARRIER();
+	SDL_SemPost(TubeGo);
+}
+
+// Called at the start of each host slice.  Falls back to running the
+// 65C02 in line if the thread can't be had or the debugger is tracing.
+void StartTubeSlice(void) {
+	if (!cfg_TubeThread || DebugEnabled || TubeThreadState != TUBE_THREAD_PARKED)
+		return;
+
+	if (TubeThread == NULL) {
+		TubeLock=SDL_CreateMutex();
+		TubeGo=SDL_CreateSemaphore(0);
+		TubeParked=SDL_CreateSemaphore(0);
+		if (TubeLock != NULL && TubeGo != NULL && TubeParked != NULL)
+			TubeThread=SDL_CreateThread(TubeThreadMain, NULL);
+		if (TubeThread == NULL) {
+			pWARN(dL"Unable to start the tube thread, running it in line.", dR);
+			cfg_TubeThread=0;
+			return;
+		}
+	}
+
+	TubeHostTime=TotalCycles/2*3;
+	ResumeTubeThread();
+}
+
+// Called at the end of each host slice.  Lets the 65C02 catch up with the
+// host and parks it there.
+void EndTubeSlice(void) {
+	if (TubeThreadState == TUBE_THREAD_PARKED)
+		return;
+
+	TubeHostTime=TotalCycles/2*3;
+	ParkTubeThread();
+
+	if (TubeHostIRQPending) {
+		TubeHostIRQPending=0;
+		UpdateHostR4Interrupt();
+	}
+}
+
+void StopTubeThread(void) {
+	if (TubeThread == NULL)
+		return;
+
+	if (TubeThreadState != TUBE_THREAD_PARKED)
+		ParkTubeThread();
+	TubeThreadState=TUBE_THREAD_QUIT;
+	TUBE_THREAD_BARRIER();
+	SDL_SemPost(TubeGo);
+	SDL_WaitThread(TubeThread, NULL);
+	TubeThread=NULL;
+	TubeThreadState=TUBE_THREAD_PARKED;
+
+	SDL_DestroySemaphore(TubeParked);
+	SDL_DestroySemaphore(TubeGo);
+	SDL_DestroyMutex(TubeLock);
+}
+
 void WrapTubeCycles(void) {
+	bool Threaded=(TubeThreadState != TUBE_THREAD_PARKED);
+
+	// TotalCycles has already been wrapped, so park the thread at the last
+	// time the host published.
+	if (Threaded)
+		ParkTubeThread();
+
 	TotalTubeCycles -= CycleCountWrap/2*3;
+
+	if (Threaded) {
+		TubeHostTime -= CycleCountWrap/2*3;
+		ResumeTubeThread();
+	}
 }
 
 void SyncTubeProcessor(void) {
+	CycleCountT HostTime=TotalCycles/2*3;
+	int Budget;
+
 	// This proc syncronises the two processors on a cycle based timing.
-	// Second pro runs at 3MHz
-	while (TotalTubeCycles<(TotalCycles/2*3)) {
+	// Second pro runs at cfg_TubeSpeed MHz, 3MHz by default
+	if (TubeThreadState == TUBE_THREAD_RUNNING) {
+		TubeHostTime=TotalCycles/2*3;
+		TUBE_THREAD_BARRIER();
+		if (TubeHostIRQPending) {
+			SDL_LockMutex(TubeLock);
+			TubeHostIRQPending=0;
+			UpdateHostR4Interrupt();
+			SDL_UnlockMutex(TubeLock);
+		}
+		while (TubeHostTime - TubeParaTime > TUBE_THREAD_SKEW)
+			SDL_Delay(0);
+		return;
+	}
+
+	if (TubeSpeed == 0) {
+		if (TotalTubeCycles >= HostTime)
+			return;
+
+		Budget=(HostTime-TotalTubeCycles)*TUBE_UNTHROTTLED_RATIO;
+		TubeParasiteWaiting=0;
+		while (Budget > 0 && !TubeParasiteWaiting) {
+			Exec65C02Instruction();
+			Budget-=TubeCycles;
+		}
+		TotalTubeCycles=HostTime;
+		return;
+	}
+
+	while (TotalTubeCycles<HostTime) {
 		Exec65C02Instruction();
 	}
 }
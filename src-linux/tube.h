@@ -35,8 +35,8 @@ void ResetTube(void);
 extern unsigned char EnableTube,TubeEnabled,Tube186Enabled,AcornZ80;
 extern int TorchTubeActive;
 
-extern unsigned char TubeintStatus; /* bit set (nums in IRQ_Nums) if interrupt being caused */
-extern unsigned char TubeNMIStatus; /* bit set (nums in NMI_Nums) if NMI being caused */
+extern volatile unsigned char TubeintStatus; /* bit set (nums in IRQ_Nums) if interrupt being caused */
+extern volatile unsigned char TubeNMIStatus; /* bit set (nums in NMI_Nums) if NMI being caused */
 
 // EnableTube - Should the tube be enabled on next start - 1=yes
 // TubeEnabled - Is the tube enabled by default - 1=yes
@@ -63,6 +63,9 @@ void DoTubeNMI(void);
 void DoTubeInterrupt(void);
 void WrapTubeCycles(void);
 void SyncTubeProcessor(void);
+void StartTubeSlice(void);
+void EndTubeSlice(void);
+void StopTubeThread(void);
 unsigned char ReadTubeFromHostSide(unsigned char IOAddr);
 unsigned char ReadTubeFromParasiteSide(unsigned char IOAddr);
 void WriteTubeFromHostSide(unsigned char IOAddr,unsigned char IOData);
@@ -89,6 +89,7 @@ static void UpdateIFRTopBit(void) {
 void UserVIAWrite(int Address, int Value) {
   /* cerr << "UserVIAWrite: Address=0x" << hex << Address << " Value=0x" << Value << dec << " at " << TotalCycles << "\n";
   DumpRegs(); */
+  SyncVIAs();
 
 	if (DebugEnabled) {
 		char info[200];
@@ -220,6 +221,7 @@ int UserVIARead(int Address) {
   int tmp = 0xff;
   /* cerr << "UserVIARead: Address=0x" << hex << Address << dec << " at " << TotalCycles << "\n";
   DumpRegs(); */
+  SyncVIAs();
 
   switch (Address) {
     case 0: /* IRB read */
@@ -405,6 +407,22 @@ void UserVIA_poll(unsigned int ncycles) {
 //  }
 }
 
+/* Number of cycles UserVIA_poll can be put off for - nothing happens until */
+/* a counting timer goes negative. The AMX mouse and printer are checked on */
+/* every poll so they are never idle.                                       */
+int UserVIA_IdleCycles(void) {
+  int idle=UserVIAState.timer1c;
+
+  if (AMXMouseEnabled || PrinterEnabled)
+    return 0;
+
+  if (UserVIAState.timer2c<idle &&
+      (UserVIAState.timer2c<0 || !(UserVIAState.acr & 0x20)))
+    idle=UserVIAState.timer2c;
+
+  return (idle>0) ? idle : 0;
+}
+
 
 /*--------------------------------------------------------------------------*/
 void UserVIAReset(void) {
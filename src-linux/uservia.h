@@ -39,6 +39,7 @@ void UserVIAWrite(int Address, int Value);
 int UserVIARead(int Address);
 void UserVIAReset(void);
 void UserVIA_poll(unsigned int ncycles);
+int UserVIA_IdleCycles(void);
 
 void uservia_dumpstate(void);
 
@@ -46,6 +46,7 @@
 #include "beebsound.h"
 #include "debug.h"
 #include "teletext.h"
+#include "scanline.h"
 
 #ifdef BEEB_DOTIME
 #include <sys/times.h>
@@ -60,6 +61,7 @@
 //++
 #include "sdl.h"
 #include "user_config.h"
+#include "log.h"
 //<+
 
 using namespace std;
@@ -76,8 +78,20 @@ EightUChars FastTable[256];
 SixteenUChars FastTableDWidth[256]; /* For mode 4,5,6 */
 int FastTable_Valid=0;
 
-typedef void (*LineRoutinePtr)(void);
-LineRoutinePtr LineRoutine;
+/* The same tables as 32 bit XRGB pixels, for when the video output is
+   32 bit (cfg_TrueColour) */
+static Uint32 FastTable32[256][8];
+static Uint32 FastTableDWidth32[256][16];
+
+/* Every other pixel of whichever table is in use, for a 320 wide screen.
+   The entries are packed at ScanLineEntrySize bytes apart */
+static unsigned char FastTableHalf[256*8];
+static Uint32 FastTableHalf32[256*8];
+
+/* The table the scanline expander (scanline.cpp) reads, and the size of
+   each of its entries in bytes */
+static const void *ScanLineTable;
+static int ScanLineEntrySize;
 
 /* Translates middle bits of VideoULA_ControlReg to number of colours */
 static int NColsLookup[]={16, 4, 2, 0 /* Not supported 16? */, 0, 16, 4, 2}; /* Based on AUG 379 */
@@ -152,6 +166,33 @@ static int Mode7DoubleHeightFlags[80]; /* Pessimistic size for this flags - if 1
 static int CurrentLineBottom=0;
 static int NextLineBottom=0; // 1 if the next line of double height should be bottoms only
 
+/* Mode 7 row cache. Most teletext pages don't change from frame to frame, so
+   the pixels DoMode7Row() draws for each row are kept along with everything
+   they were drawn from, and an unchanged row is copied back rather than
+   decoded again. Rows are cached by their position on the screen */
+#define MODE7_CACHE_ROWS 32
+#define MODE7_CACHE_COLUMNS 40
+#define MODE7_CACHE_LINE_BYTES (MODE7_CACHE_COLUMNS*12*sizeof(Uint32))
+typedef struct {
+  int Valid;
+  int PixmapLine;
+  int Count;                 /* Characters in the row */
+  unsigned char Bytes[MODE7_CACHE_COLUMNS];
+  int LineBottom;            /* CurrentLineBottom it was drawn with */
+  int UsesFlash;             /* If set the row depends on Mode7FlashOn */
+  int FlashOn;
+  int Style;                 /* TeletextStyle */
+  int Width;                 /* screen_width */
+  int Resolution;            /* Active cfg_*_Resolution */
+  int XRGB;                  /* VideoOutputXRGB */
+  unsigned long Colours[8];  /* mainWin->cols, as pixels if XRGB */
+  int NextLineBottom;        /* What the row set NextLineBottom to */
+  unsigned char Pixels[20][MODE7_CACHE_LINE_BYTES];
+} Mode7RowCacheEntry;
+static Mode7RowCacheEntry Mode7RowCache[MODE7_CACHE_ROWS];
+static unsigned long Mode7RowCacheHits=0;   /* Rows copied from the cache */
+static unsigned long Mode7RowCacheMisses=0; /* Rows decoded afresh */
+
 /* Flash every half second(?) i.e. 25 x 50Hz fields */
 // No. On time is longer than off time. - according to my datasheet, its 0.75Hz with 3:1 ON:OFF ratio. - Richard Gellman
 // cant see that myself.. i think it means on for 0.75 secs, off for 0.25 secs
@@ -167,11 +208,9 @@ int Mode7FlashTrigger=MODE7ONFIELDS;
 int Video_RefreshFrequency=1;
 /* The number of the current frame - starts at Video_RefreshFrequency - at 0 actually refresh */
 static int FrameNum=0;
+/* Set at the end of a teletext frame to clear the vsync interrupt on the next line */
+static int Mode7DoCA1Int=0;
 
-static void LowLevelDoScanLineNarrow();
-static void LowLevelDoScanLineWide();
-static void LowLevelDoScanLineNarrowNot4Bytes();
-static void LowLevelDoScanLineWideNot4Bytes();
 static void VideoAddCursor(void);
 void AdjustVideo();
 void VideoAddLEDs(void);
@@ -183,6 +222,8 @@ void VideoAddLEDs(void);
 static int screen_width;
 static void set_screen_width(void)
 {
+	int old_width = screen_width;
+
 //	screen_width = fullscreen;
 
 //	switch (fullscreen?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution) {
@@ -195,6 +236,10 @@ static void set_screen_width(void)
 	default:
 		screen_width=320;
 	}
+
+	/* The scanline table depends on the width */
+	if (screen_width != old_width)
+		FastTable_Valid=0;
 }
 //<+
 
@@ -282,6 +327,127 @@ static void BuildMode7Font(void) {
 	  } // check for valid char to modify
   } // character loop.
 }; /* BuildMode7Font */
+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Mode 7 glyph atlas. DoMode7Row() draws each character from masks of the
+   rows it ends up as in the window, built from EM7Font for the resolution.
+   At 320 wide each pair of font pixels becomes one pixel, and where several
+   font scanlines land on the same window row (the halved height of the 320
+   modes and the 0.94 scaling of the 480 line ones) they are merged into it
+   instead of all but the last being lost. A merged pixel is set if any of
+   its sources are, so thin strokes and the character rounding survive.
+   Which scanlines share a row depends on the resolution and where the row
+   is on the screen, so a plane of the atlas is built for each pattern of
+   them the first time it's drawn. Each holds the normal, double height top
+   and bottom glyphs of the alpha and both graphics fonts */
+#define MODE7_ATLAS_PLANES 16
+#define MODE7_ATLAS_NORMAL 0
+#define MODE7_ATLAS_TOP 1
+#define MODE7_ATLAS_BOTTOM 2
+typedef struct {
+  int Valid;
+  int HalfWidth;                /* 6 pixels a character rather than 12 */
+  int Lines;                    /* Video output lines the row is drawn on */
+  unsigned int Sources[20];     /* Bit n set if font scanline n shows on it */
+  unsigned short Glyph[3][3][96][20]; /* Height, font type, character, line */
+} Mode7AtlasPlane;
+static Mode7AtlasPlane Mode7Atlas[MODE7_ATLAS_PLANES];
+static int Mode7AtlasNext=0;
+
+/* Each 12 bit glyph line as 0 for background and 0xff for foreground pixels */
+static unsigned char Mode7AtlasPixels[4096][12];
+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Forget the atlas planes, the font or the resolution having changed */
+static void ResetMode7Atlas(void) {
+  int plane,mask,pix;
+
+  for(plane=0;plane<MODE7_ATLAS_PLANES;plane++) Mode7Atlas[plane].Valid=0;
+  Mode7AtlasNext=0;
+
+  for(mask=0;mask<4096;mask++)
+    for(pix=0;pix<12;pix++)
+      Mode7AtlasPixels[mask][pix]=(mask & (0x800>>pix)) ? 0xff : 0;
+}; /* ResetMode7Atlas */
+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Fill in the glyphs of an atlas plane whose line pattern has been set up */
+static void BuildMode7AtlasPlane(Mode7AtlasPlane *Plane) {
+  int height,type,ch,line,scanline,src,pix;
+  unsigned int mask,half;
+
+  for(height=0;height<3;height++)
+    for(type=0;type<3;type++)
+      for(ch=0;ch<96;ch++)
+        for(line=0;line<Plane->Lines;line++) {
+          mask=0;
+          for(scanline=0;scanline<20;scanline++) {
+            if (!(Plane->Sources[line] & (1<<scanline))) continue;
+            if (height==MODE7_ATLAS_NORMAL) src=scanline;
+            else if (height==MODE7_ATLAS_TOP) src=scanline>>1;
+            else src=10+(scanline>>1);
+            mask|=EM7Font[type][ch][src];
+          };
+          mask&=0xfff;
+
+          if (Plane->HalfWidth) {
+            /* Pixel pairs, packed into the left 6 bits */
+            for(half=0,pix=0;pix<6;pix++)
+              if (mask & (0xc00>>(pix*2))) half|=0x800>>pix;
+            mask=half;
+          };
+          Plane->Glyph[height][type][ch][line]=mask;
+        };
+}; /* BuildMode7AtlasPlane */
+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Find the atlas plane for the teletext row being drawn, building it if need be.
+   First[] gets the first scanline drawn on each of its lines */
+static Mode7AtlasPlane *GetMode7AtlasPlane(int *First) {
+  Mode7AtlasPlane *Plane;
+  int Line[20],Window[20];
+  unsigned int Drawn[20],Sources[20];
+  int Lines=0,HalfWidth=(screen_width==320);
+  bool fullscreen_val=mainWin->IsFullScreen();
+  int scanline,line,i,plane;
+
+  /* The video output lines the scanlines are drawn on */
+  for(scanline=0+(TeletextStyle-1);scanline<20;scanline+=TeletextStyle) {
+    line=mainWin->GetHorizLineRow(VideoState.PixmapLine+scanline);
+    for(i=0;i<Lines && Line[i]!=line;i++);
+    if (i==Lines) {
+      Line[Lines]=line;
+      Drawn[Lines]=0;
+      First[Lines]=scanline;
+      Lines++;
+    };
+    Drawn[i]|=1<<scanline;
+  };
+
+  /* Lines that share a window row all show everything drawn on it */
+  for(i=0;i<Lines;i++) Window[i]=GetTeletextWindowRow(Line[i],fullscreen_val);
+  for(i=0;i<Lines;i++) {
+    Sources[i]=0;
+    for(line=0;line<Lines;line++)
+      if (Window[line]==Window[i]) Sources[i]|=Drawn[line];
+  };
+
+  for(plane=0;plane<MODE7_ATLAS_PLANES;plane++) {
+    Plane=&Mode7Atlas[plane];
+    if (Plane->Valid && Plane->HalfWidth==HalfWidth && Plane->Lines==Lines
+     && memcmp(Plane->Sources,Sources,Lines*sizeof(unsigned int))==0)
+      return Plane;
+  };
+
+  Plane=&Mode7Atlas[Mode7AtlasNext];
+  Mode7AtlasNext=(Mode7AtlasNext+1)%MODE7_ATLAS_PLANES;
+  Plane->HalfWidth=HalfWidth;
+  Plane->Lines=Lines;
+  memcpy(Plane->Sources,Sources,Lines*sizeof(unsigned int));
+  BuildMode7AtlasPlane(Plane);
+  Plane->Valid=1;
+  return Plane;
+}; /* GetMode7AtlasPlane */
 /*-------------------------------------------------------------------------------------------------------------*/
 static void DoFastTable16(void) {
   unsigned int beebpixvl,beebpixvr;
@@ -593,6 +759,51 @@ static void DoFastTable2XStep2(void) {
   }; /* beebpixv */
 }; /* DoFastTable2XStep2 */
 
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Translate the fast table just built from colour numbers to 32 bit XRGB pixels */
+static void DoFastTable32(void) {
+  int beebpixv,pix;
+
+  if (VideoULA_ControlReg & 0x10) {
+    for(beebpixv=0;beebpixv<256;beebpixv++)
+      for(pix=0;pix<8;pix++)
+        FastTable32[beebpixv][pix]=XRGBPalette[FastTable[beebpixv].data[pix]];
+  } else {
+    for(beebpixv=0;beebpixv<256;beebpixv++)
+      for(pix=0;pix<16;pix++)
+        FastTableDWidth32[beebpixv][pix]=XRGBPalette[FastTableDWidth[beebpixv].data[pix]];
+  };
+}; /* DoFastTable32 */
+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Pick the table the scanline expander reads for the current ULA mode and
+   output format, building the half width one from the full one for 320 */
+static void DoScanLineTable(void) {
+  int narrow=(VideoULA_ControlReg & 0x10)!=0;
+  int pixels=narrow ? 8 : 16;
+  const unsigned char *full8=narrow ? FastTable[0].data : FastTableDWidth[0].data;
+  const Uint32 *full32=narrow ? FastTable32[0] : FastTableDWidth32[0];
+  int beebpixv,pix;
+
+  if (screen_width == 640) {
+    ScanLineTable=VideoOutputXRGB ? (const void *)full32 : (const void *)full8;
+    ScanLineEntrySize=pixels*(VideoOutputXRGB ? sizeof(Uint32) : 1);
+    return;
+  };
+
+  pixels/=2;
+  for(beebpixv=0;beebpixv<256;beebpixv++)
+    for(pix=0;pix<pixels;pix++) {
+      if (VideoOutputXRGB)
+        FastTableHalf32[beebpixv*pixels+pix]=full32[beebpixv*pixels*2+pix*2];
+      else
+        FastTableHalf[beebpixv*pixels+pix]=full8[beebpixv*pixels*2+pix*2];
+    };
+
+  ScanLineTable=VideoOutputXRGB ? (const void *)FastTableHalf32 : (const void *)FastTableHalf;
+  ScanLineEntrySize=pixels*(VideoOutputXRGB ? sizeof(Uint32) : 1);
+}; /* DoScanLineTable */
+
 /*-------------------------------------------------------------------------------------------------------------*/
 /* Check validity of fast table, and if invalid rebuild.
    The fast table accelerates the translation of beeb video memory
@@ -601,12 +812,6 @@ static void DoFastTable(void) {
   /* if it's already OK then quit */
   if (FastTable_Valid) return;
 
-  if (!(CRTC_HorizontalDisplayed & 3)) {
-    LineRoutine=(VideoULA_ControlReg & 0x10)?LowLevelDoScanLineNarrow:LowLevelDoScanLineWide;
-  } else {
-    LineRoutine=(VideoULA_ControlReg & 0x10)?LowLevelDoScanLineNarrowNot4Bytes:LowLevelDoScanLineWideNot4Bytes;
-  };
-
   /* What happens next dpends on the number of colours */
   switch (NColsLookup[(VideoULA_ControlReg & 0x1c) >> 2]) {
     case 2:
@@ -639,6 +844,9 @@ static void DoFastTable(void) {
     default:
       break;
   }; /* Colours/pixel switch */
+
+  if (FastTable_Valid && VideoOutputXRGB) DoFastTable32();
+  if (FastTable_Valid) DoScanLineTable();
 }; /* DoFastTable */
 
 /*-------------------------------------------------------------------------------------------------------------*/
@@ -688,8 +896,10 @@ static void VideoStartOfFrame(void) {
 
 //--#ifdef WIN32
   /* FrameNum is determined by the window handler */
-  if (mainWin)
+  if (mainWin) {
     FrameNum = mainWin->StartOfFrame();
+    set_screen_width();
+  }
 //--#else
 //--  /* If FrameNum hits 0 we actually refresh */
 //--  if (FrameNum--==0) {
@@ -753,175 +963,63 @@ static void VideoStartOfFrame(void) {
 }; /* VideoStartOfFrame */
 
 
-/*--------------------------------------------------------------------------*/
-/* Scanline processing for modes with fast 6845 clock - i.e. narrow pixels  */
-static void LowLevelDoScanLineNarrow() {
-  unsigned char *CurrentPtr;
-  int BytesToGo=CRTC_HorizontalDisplayed;
-
-//+>
-  if (screen_width == 640){
-//<+
-  EightUChars *vidPtr=mainWin->GetLinePtr(VideoState.PixmapLine);
-
-  /* If the step is 4 then each byte corresponds to one entry in the fasttable
-     and thus we can copy it really easily (and fast!) */
-  CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-
-  /* This should help the compiler - it doesn't need to test for end of loop
-     except every 4 entries */
-  BytesToGo/=4;
-  for(;BytesToGo;CurrentPtr+=32,BytesToGo--) {
-    *(vidPtr++)=FastTable[*CurrentPtr];
-    *(vidPtr++)=FastTable[*(CurrentPtr+8)];
-    *(vidPtr++)=FastTable[*(CurrentPtr+16)];
-    *(vidPtr++)=FastTable[*(CurrentPtr+24)];
-  };
-//+>
-  }else{
-	unsigned char *vidPtr2
-	 = (unsigned char*) mainWin->GetLinePtr(VideoState.PixmapLine);
-
-	CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-	for(;BytesToGo;CurrentPtr+=8,BytesToGo--) {
-		*(vidPtr2++)=FastTable[*CurrentPtr].data[0];
-		*(vidPtr2++)=FastTable[*CurrentPtr].data[2];
-		*(vidPtr2++)=FastTable[*CurrentPtr].data[4];
-		*(vidPtr2++)=FastTable[*CurrentPtr].data[6];
-	}
-  }
-//<+
-
-}; /* LowLevelDoScanLineNarrow() */
-
-/*--------------------------------------------------------------------------*/
-/* Scanline processing for modes with fast 6845 clock - i.e. narrow pixels  */
-/* This version handles screen modes where there is not a multiple of 4     */
-/* bytes per scanline.                                                      */
-static void LowLevelDoScanLineNarrowNot4Bytes() {
-  unsigned char *CurrentPtr;
-  int BytesToGo=CRTC_HorizontalDisplayed;
-//+>
-  if (screen_width == 640){
-//<+
-  EightUChars *vidPtr=mainWin->GetLinePtr(VideoState.PixmapLine);
 
-  /* If the step is 4 then each byte corresponds to one entry in the fasttable
-     and thus we can copy it really easily (and fast!) */
-    CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
+/*-------------------------------------------------------------------------------------------------------------*/
+/* The colours a teletext row can be drawn in, as the pixels they end up as */
+static void Mode7RowColours(unsigned long *Colours) {
+  int i;
 
-  for(;BytesToGo;CurrentPtr+=8,BytesToGo--)
-    (vidPtr++)->eightbyte=FastTable[*CurrentPtr].eightbyte;
+  for(i=0;i<8;i++)
+    Colours[i]=VideoOutputXRGB ? XRGBPalette[mainWin->cols[i]] : mainWin->cols[i];
+}; /* Mode7RowColours */
 
-//+>
-  }else{
-    BytesToGo=CRTC_HorizontalDisplayed;
-    unsigned char *vidPtr2
-      = (unsigned char*) mainWin->GetLinePtr16(VideoState.PixmapLine);
-    CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-    for(;BytesToGo;CurrentPtr+=8,BytesToGo--) {
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[0];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[2];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[4];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[6];
-//      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[8];
-//      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[10];
-//      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[12];
-//      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[14];
-    }
-  }
-//<+
+/*-------------------------------------------------------------------------------------------------------------*/
+/* The resolution setting in use, which changes how rows are scaled onto the window */
+static int Mode7Resolution(void) {
+  return mainWin->IsFullScreen()?cfg_Fullscreen_Resolution:cfg_Windowed_Resolution;
+}; /* Mode7Resolution */
 
-}; /* LowLevelDoScanLineNarrowNot4Bytes() */
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Check if the cache entry for the current row was drawn from the same bytes and state */
+static int Mode7RowCacheMatches(const Mode7RowCacheEntry *Cache, const char *CurrentPtr,
+                                const unsigned long *Colours) {
+  return Cache->Valid
+    && Cache->PixmapLine==VideoState.PixmapLine
+    && Cache->Count==CRTC_HorizontalDisplayed
+    && Cache->LineBottom==CurrentLineBottom
+    && (!Cache->UsesFlash || Cache->FlashOn==Mode7FlashOn)
+    && Cache->Style==TeletextStyle
+    && Cache->Width==screen_width
+    && Cache->Resolution==Mode7Resolution()
+    && Cache->XRGB==VideoOutputXRGB
+    && memcmp(Cache->Colours,Colours,sizeof(Cache->Colours))==0
+    && memcmp(Cache->Bytes,CurrentPtr,Cache->Count)==0;
+}; /* Mode7RowCacheMatches */
 
-/*-----------------------------------------------------------------------------*/
-/* Scanline processing for the low clock rate modes                            */
-static void LowLevelDoScanLineWide() {
-  unsigned char *CurrentPtr;
-  int BytesToGo=CRTC_HorizontalDisplayed;
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Copy the pixels of the current row into the cache entry (Save) or back out of it */
+static void Mode7RowCacheCopy(Mode7RowCacheEntry *Cache, int Save) {
+  int CurrentScanLine,width;
+  unsigned char *p;
 
-//+>
-  if (screen_width == 640){
-//<+
-  SixteenUChars *vidPtr=mainWin->GetLinePtr16(VideoState.PixmapLine);
-
-  /* If the step is 4 then each byte corresponds to one entry in the fasttable
-     and thus we can copy it really easily (and fast!) */
-    CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-
-  /* This should help the compiler - it doesn't need to test for end of loop
-     except every 4 entries */
-  BytesToGo/=4;
-  for(;BytesToGo;CurrentPtr+=32,BytesToGo--) {
-    *(vidPtr++)=FastTableDWidth[*CurrentPtr];
-    *(vidPtr++)=FastTableDWidth[*(CurrentPtr+8)];
-    *(vidPtr++)=FastTableDWidth[*(CurrentPtr+16)];
-    *(vidPtr++)=FastTableDWidth[*(CurrentPtr+24)];
+  for(CurrentScanLine=0+(TeletextStyle-1);CurrentScanLine<20;CurrentScanLine+=TeletextStyle) {
+    width=12*Cache->Count;
+    p=mainWin->GetHorizLinePtr(VideoState.PixmapLine+CurrentScanLine,0,&width);
+    if (p==NULL) continue;
+    width*=VideoOutputXRGB ? sizeof(Uint32) : 1;
+    if (Save)
+      memcpy(Cache->Pixels[CurrentScanLine],p,width);
+    else
+      memcpy(p,Cache->Pixels[CurrentScanLine],width);
   };
-//+>
-  }else{
-    BytesToGo=CRTC_HorizontalDisplayed;
-    unsigned char *vidPtr2
-      = (unsigned char*) mainWin->GetLinePtr16(VideoState.PixmapLine);
-    CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-    for(;BytesToGo;CurrentPtr+=8,BytesToGo--) {
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[0];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[2];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[4];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[6];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[8];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[10];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[12];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[14];
-    }
-  }
-//<+
-
-}; /* LowLevelDoScanLineWide */
-
-/*-----------------------------------------------------------------------------*/
-/* Scanline processing for the low clock rate modes                            */
-/* This version handles cases where the screen width is not divisible by 4     */
-static void LowLevelDoScanLineWideNot4Bytes() {
-  unsigned char *CurrentPtr;
-  int BytesToGo=CRTC_HorizontalDisplayed;
-
-//+>
-  if (screen_width == 640){
-//<+
-  SixteenUChars *vidPtr=mainWin->GetLinePtr16(VideoState.PixmapLine);
-  CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-  for(;BytesToGo;CurrentPtr+=8,BytesToGo--)
-    *(vidPtr++)=FastTableDWidth[*CurrentPtr];
-//+>
-  }else{
-    BytesToGo=CRTC_HorizontalDisplayed;
-    unsigned char *vidPtr2
-      = (unsigned char*) mainWin->GetLinePtr16(VideoState.PixmapLine);
-    CurrentPtr=(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp;
-    for(;BytesToGo;CurrentPtr+=8,BytesToGo--) {
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[0];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[2];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[4];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[6];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[8];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[10];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[12];
-      *(vidPtr2++)=FastTableDWidth[*CurrentPtr].data[14];
-    }
-  }
-//<+
-
-}; /* LowLevelDoScanLineWideNot4Bytes */
+}; /* Mode7RowCacheCopy */
 
 /*-------------------------------------------------------------------------------------------------------------*/
 /* Do all the pixel rows for one row of teletext characters                                                    */
 static void DoMode7Row(void) {
   char *CurrentPtr=VideoState.DataPtr;
   int CurrentChar;
-  int XStep;
   unsigned char byte;
-  unsigned int tmp;
 
   unsigned int Foreground=mainWin->cols[7];
   unsigned int ActualForeground;
@@ -933,19 +1031,40 @@ static void DoMode7Row(void) {
   int HoldGraph=0; /* I.e. don't hold graphics - I don't know what hold graphics is anyway! */
   // That's ok. Nobody else does either, and nor do I. - Richard Gellman.
   int HoldGraphChar=32; // AHA! we know what it is now, this is the character to "hold" during control codes
-  unsigned int CurrentCol[20]={0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff
-  ,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff,0xffffff};
-  int CurrentLen[20]={0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-  int CurrentStartX[20]={0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-  int CurrentScanLine;
-  int CurrentX=0;
-  int CurrentPixel;
-  unsigned int col;
+  Mode7AtlasPlane *Plane;
+  int First[20]; /* First scanline drawn on each line of the atlas plane */
+  unsigned char *LinePtr[20];
+  const unsigned short *Glyph;
+  const unsigned char *Mask;
+  Uint32 ForePixel,BackPixel;
+  int CharPixels,line,width,pix;
   int FontTypeIndex=0; /* 0=alpha, 1=contiguous graphics, 2=separated graphics */
+  int UsesFlash=0;
+  unsigned long Colours[8];
+  Mode7RowCacheEntry *Cache=&Mode7RowCache[(VideoState.PixmapLine/20)%MODE7_CACHE_ROWS];
 
   if (CRTC_HorizontalDisplayed>80) return; /* Not possible on beeb - and would break the double height lookup array */
 
-  XStep=1;
+  if ((CRTC_ScanLinesPerChar<=9) || (THalfMode)) TeletextStyle=2; else TeletextStyle=1;
+
+  /* Unchanged since it was last drawn? */
+  Mode7RowColours(Colours);
+  if (Mode7RowCacheMatches(Cache,CurrentPtr,Colours)) {
+    Mode7RowCacheCopy(Cache,0);
+    Mode7RowCacheHits++;
+    CurrentLineBottom=Cache->NextLineBottom;
+    NextLineBottom=0;
+    return;
+  };
+  Mode7RowCacheMisses++;
+
+  /* Where each line of the row's glyphs goes */
+  Plane=GetMode7AtlasPlane(First);
+  CharPixels=Plane->HalfWidth ? 6 : 12;
+  for(line=0;line<Plane->Lines;line++) {
+    width=12*CRTC_HorizontalDisplayed;
+    LinePtr[line]=mainWin->GetHorizLinePtr(VideoState.PixmapLine+First[line],0,&width);
+  };
 
   for(CurrentChar=0;CurrentChar<CRTC_HorizontalDisplayed;CurrentChar++) {
     byte=CurrentPtr[CurrentChar]; 
@@ -966,6 +1085,7 @@ static void DoMode7Row(void) {
 
         case 136:
           Flash=1;
+          UsesFlash=1;
           break;
 
         case 137:
@@ -1026,7 +1146,6 @@ static void DoMode7Row(void) {
       FontTypeIndex=Graphics?(Separated?2:1):0;
     }; /* test for special character */
 	if ((CurrentLineBottom) && ((byte&127)>31) && (!DoubleHeight)) byte=32;
-	if ((CRTC_ScanLinesPerChar<=9) || (THalfMode)) TeletextStyle=2; else TeletextStyle=1;
     /* Top bit never reaches character generator */
     byte&=127;
     /* Our font table goes from character 32 up */
@@ -1034,78 +1153,75 @@ static void DoMode7Row(void) {
 
     /* Conceal flashed text if necessary */
     ActualForeground=(Flash && !Mode7FlashOn)?Background:Foreground;
-    if (!DoubleHeight) {
-      for(CurrentScanLine=0+(TeletextStyle-1);CurrentScanLine<20;CurrentScanLine+=TeletextStyle) {
-        tmp=EM7Font[FontTypeIndex][byte][CurrentScanLine];
-		//tmp=1365;
-        if ((tmp==0) || (tmp==255)) {
-          col=(tmp==0)?Background:ActualForeground;
-          if (col==CurrentCol[CurrentScanLine]) CurrentLen[CurrentScanLine]+=12*XStep; else {
-            if (CurrentLen[CurrentScanLine])
-              mainWin->doHorizLine(CurrentCol[CurrentScanLine],VideoState.PixmapLine+CurrentScanLine,CurrentStartX[CurrentScanLine],CurrentLen[CurrentScanLine]);
-            CurrentCol[CurrentScanLine]=col;
-            CurrentStartX[CurrentScanLine]=CurrentX;
-            CurrentLen[CurrentScanLine]=12*XStep;
-          }; /* same colour */
-        } else {
-          for(CurrentPixel=0x800;CurrentPixel;CurrentPixel=CurrentPixel>>1) {
-            /* Background or foreground ? */
-            col=(tmp & CurrentPixel)?ActualForeground:Background;
-
-            /* Do we need to draw ? */
-            if (col==CurrentCol[CurrentScanLine]) CurrentLen[CurrentScanLine]+=XStep; else {
-              if (CurrentLen[CurrentScanLine]) 
-                mainWin->doHorizLine(CurrentCol[CurrentScanLine],VideoState.PixmapLine+CurrentScanLine,CurrentStartX[CurrentScanLine],CurrentLen[CurrentScanLine]);
-              CurrentCol[CurrentScanLine]=col;
-              CurrentStartX[CurrentScanLine]=CurrentX;
-              CurrentLen[CurrentScanLine]=XStep;
-            }; /* Fore/back ground */
-            CurrentX+=XStep;
-          }; /* Pixel within byte */
-          CurrentX-=12*XStep;
-        }; /* tmp!=0 */
-      }; /* Scanline for */
-      CurrentX+=12*XStep;
+    ForePixel=XRGBPalette[ActualForeground & 0xff];
+    BackPixel=XRGBPalette[Background & 0xff];
+
+    /* Copy the glyph from the atlas in its colours */
+    Glyph=Plane->Glyph[!DoubleHeight ? MODE7_ATLAS_NORMAL
+     : (CurrentLineBottom ? MODE7_ATLAS_BOTTOM : MODE7_ATLAS_TOP)][FontTypeIndex][byte];
+    for(line=0;line<Plane->Lines;line++) {
+      if (LinePtr[line]==NULL) continue;
+      Mask=Mode7AtlasPixels[Glyph[line]];
+      if (VideoOutputXRGB) {
+        Uint32 *q=(Uint32 *)LinePtr[line]+CurrentChar*CharPixels;
+        for(pix=0;pix<CharPixels;pix++) q[pix]=Mask[pix] ? ForePixel : BackPixel;
+      } else {
+        unsigned char *q=LinePtr[line]+CurrentChar*CharPixels;
+        for(pix=0;pix<CharPixels;pix++) q[pix]=(ActualForeground & Mask[pix]) | (Background & ~Mask[pix]);
+      };
+    };
+
+    if (!DoubleHeight)
       Mode7DoubleHeightFlags[CurrentChar]=1; /* Not double height - so if the next line is double height it will be top half */
-    } else {
-      int ActualScanLine;
-      /* Double height! */
-      for(CurrentPixel=0x800;CurrentPixel;CurrentPixel=CurrentPixel>>1) {
-        for(CurrentScanLine=0+(TeletextStyle-1);CurrentScanLine<20;CurrentScanLine+=TeletextStyle) {
-          if (!CurrentLineBottom) ActualScanLine=CurrentScanLine >> 1; else ActualScanLine=10+(CurrentScanLine>>1);
-          /* Background or foreground ? */
-          col=(EM7Font[FontTypeIndex][byte][ActualScanLine] & CurrentPixel)?ActualForeground:Background;
-
-          /* Do we need to draw ? */
-          if (col==CurrentCol[CurrentScanLine]) CurrentLen[CurrentScanLine]+=XStep; else {
-            if (CurrentLen[CurrentScanLine])  {
-              mainWin->doHorizLine(CurrentCol[CurrentScanLine],VideoState.PixmapLine+CurrentScanLine,CurrentStartX[CurrentScanLine],CurrentLen[CurrentScanLine]);
-            };
-            CurrentCol[CurrentScanLine]=col;
-            CurrentStartX[CurrentScanLine]=CurrentX;
-            CurrentLen[CurrentScanLine]=XStep;
-          }; /* Fore/back ground */
-        }; /* Scanline for */
-        CurrentX+=XStep;
-      }; /* Pixel within byte */
-      Mode7DoubleHeightFlags[CurrentChar]^=1; /* Not double height - so if the next line is double height it will be top half */
-	};
+    else
+      Mode7DoubleHeightFlags[CurrentChar]^=1;
   }; /* character loop */
 
-  /* Finish off right bits of scan line */
-  for(CurrentScanLine=0+(TeletextStyle-1);CurrentScanLine<20;CurrentScanLine+=TeletextStyle) {
-    if (CurrentLen[CurrentScanLine])
-      mainWin->doHorizLine(CurrentCol[CurrentScanLine],VideoState.PixmapLine+CurrentScanLine,CurrentStartX[CurrentScanLine],CurrentLen[CurrentScanLine]);
+  /* Keep the row for next frame */
+  Cache->Valid=CRTC_HorizontalDisplayed<=MODE7_CACHE_COLUMNS;
+  if (Cache->Valid) {
+    Cache->PixmapLine=VideoState.PixmapLine;
+    Cache->Count=CRTC_HorizontalDisplayed;
+    memcpy(Cache->Bytes,CurrentPtr,Cache->Count);
+    Cache->LineBottom=CurrentLineBottom;
+    Cache->UsesFlash=UsesFlash;
+    Cache->FlashOn=Mode7FlashOn;
+    Cache->Style=TeletextStyle;
+    Cache->Width=screen_width;
+    Cache->Resolution=Mode7Resolution();
+    Cache->XRGB=VideoOutputXRGB;
+    memcpy(Cache->Colours,Colours,sizeof(Cache->Colours));
+    Cache->NextLineBottom=NextLineBottom;
+    Mode7RowCacheCopy(Cache,1);
   };
   CurrentLineBottom=NextLineBottom;
   NextLineBottom=0;
 }; /* DoMode7Row */
 /*-------------------------------------------------------------------------------------------------------------*/
+/* Log how many mode 7 rows came from the row cache since the last report,
+   then start counting again */
+void ReportMode7RowCacheStatistics(void) {
+  unsigned long rows=Mode7RowCacheHits+Mode7RowCacheMisses;
+
+  if (rows>0)
+    pINFO(dL"Mode 7 row cache: %lu%% hits (%lu hits, %lu misses).", dR,
+     Mode7RowCacheHits*100/rows, Mode7RowCacheHits, Mode7RowCacheMisses);
+
+  Mode7RowCacheHits=0;
+  Mode7RowCacheMisses=0;
+}; /* ReportMode7RowCacheStatistics */
+/*-------------------------------------------------------------------------------------------------------------*/
 /* Actually does the work of decoding beeb memory and plotting the line to X */
 static void LowLevelDoScanLine() {
   /* Update acceleration tables */
   DoFastTable();
-  if (FastTable_Valid) LineRoutine();
+  if (FastTable_Valid) {
+    void *vidPtr=VideoOutputXRGB ? (void *)mainWin->GetLinePtr32(VideoState.PixmapLine)
+     : (void *)mainWin->GetLinePtr(VideoState.PixmapLine);
+
+    ExpandScanLine(vidPtr,(unsigned char *)VideoState.DataPtr+VideoState.InCharLineUp,
+     CRTC_HorizontalDisplayed,ScanLineTable,ScanLineEntrySize);
+  };
 }; /* LowLevelDoScanLine */
 
 void RedoMPTR(void) {
@@ -1114,42 +1230,138 @@ void RedoMPTR(void) {
 	//FastTable_Valid=0;
 }
 
+/*-------------------------------------------------------------------------------------------------------------*/
+/* Scanline processing for frames that aren't being shown.  Only the CRTC
+   timing the rest of the machine sees is kept going (the character row
+   address, the vsync interrupts and the scanline trigger) along with the
+   pixmap line counts that place the next frame that is shown.  No memory
+   is decoded and nothing is drawn. */
+static void VideoSkipScanLine(void) {
+  if (VideoState.IsTeletext) {
+    if (Mode7DoCA1Int) {
+      SysVIATriggerCA1Int(0);
+      Mode7DoCA1Int=0;
+    };
+
+    if ((VideoState.CharLine!=-1) && (VideoState.CharLine<CRTC_VerticalDisplayed)) {
+      VideoState.Addr+=CRTC_HorizontalDisplayed;
+      VideoState.PixmapLine+=20;
+    };
+
+    /* Move onto next physical scanline as far as timing is concerned */
+    VideoState.InCharLineUp+=1;
+    if ((VideoState.CharLine==-1 && VideoState.InCharLineUp>=CRTC_VerticalTotalAdjust) ||
+        (VideoState.CharLine!=-1)) {
+      VideoState.CharLine++;
+      VideoState.InCharLineUp=0;
+    }
+
+    if (VideoState.CharLine>CRTC_VerticalTotal) {
+      VScreenAdjust=-100+(((CRTC_VerticalTotal+1)-(CRTC_VerticalSyncPos-1))*(20/TeletextStyle));
+      AdjustVideo();
+      VideoStartOfFrame();
+      VideoState.PreviousLastPixmapLine=VideoState.PixmapLine;
+      VideoState.PixmapLine=0;
+      SysVIATriggerCA1Int(1);
+      Mode7DoCA1Int=1;
+    }else {
+      if (VideoState.CharLine!=-1)  {
+        IncTrigger((CRTC_HorizontalTotal+1)*((VideoULA_ControlReg & 16)?1:2)*((VideoState.CharLine==1)?9:10),VideoTriggerCount);
+      } else {
+        IncTrigger((CRTC_HorizontalTotal+1)*((VideoULA_ControlReg & 16)?1:2),VideoTriggerCount);
+      };
+    };
+  } else {
+    /* Non teletext. */
+    if (VideoState.CharLine!=-1 && VideoState.CharLine<CRTC_VerticalDisplayed) {
+      if (VideoState.FirstPixmapLine==-1)
+        VideoState.FirstPixmapLine=VideoState.PixmapLine;
+      if (VideoState.LastPixmapLine<VideoState.PixmapLine)
+        VideoState.LastPixmapLine=VideoState.PixmapLine;
+      if (VideoState.InCharLineUp==0)
+        VideoState.Addr+=CRTC_HorizontalDisplayed;
+    }
+    VideoState.PixmapLine++;
+    if (VideoState.PixmapLine > MAX_VIDEO_SCAN_LINES)
+      VideoState.PixmapLine = MAX_VIDEO_SCAN_LINES;
+
+    /* Move onto next physical scanline as far as timing is concerned */
+    VideoState.InCharLineUp+=1;
+    if (VideoState.VSyncState) {
+      if (!(--VideoState.VSyncState)) {
+        SysVIATriggerCA1Int(0);
+      };
+    };
+
+    if ((VideoState.CharLine!=-1 && VideoState.InCharLineUp>CRTC_ScanLinesPerChar) ||
+        (VideoState.CharLine==-1 && VideoState.InCharLineUp>=CRTC_VerticalTotalAdjust)) {
+      VideoState.CharLine++;
+      if ((VideoState.VSyncState==0) && (VideoState.CharLine==CRTC_VerticalSyncPos)) {
+        if (VideoState.FirstPixmapLine<0)
+          VideoState.FirstPixmapLine=0;
+        if (VideoState.FirstPixmapLine>32)
+          VideoState.FirstPixmapLine=32;
+        if ((VideoState.LastPixmapLine-VideoState.FirstPixmapLine)<255)
+          VideoState.LastPixmapLine=255+VideoState.FirstPixmapLine;
+
+        VideoState.PreviousFirstPixmapLine=VideoState.FirstPixmapLine;
+        VideoState.FirstPixmapLine=-1;
+        VideoState.PreviousLastPixmapLine=VideoState.LastPixmapLine;
+        VideoState.LastPixmapLine=0;
+        VideoState.PixmapLine=0;
+
+        SysVIATriggerCA1Int(1);
+        VideoState.VSyncState=3;
+      };
+
+      VideoState.InCharLineUp=0;
+    };
+
+    if (VideoState.CharLine>CRTC_VerticalTotal) {
+      VScreenAdjust=0;
+      VideoStartOfFrame();
+      AdjustVideo();
+    } else {
+      IncTrigger((CRTC_HorizontalTotal+1)*((VideoULA_ControlReg & 16)?1:2),VideoTriggerCount);
+    }
+  }; /* Teletext if */
+}; /* VideoSkipScanLine */
+
 /*-------------------------------------------------------------------------------------------------------------*/
 void VideoDoScanLine(void) {
   int l;
 
-//+>
-	set_screen_width();
-//<-
+  /* Frames that won't be shown only need their timing */
+  if (FrameNum) {
+    VideoSkipScanLine();
+    return;
+  }
 
   /* cerr << "CharLine=" << VideoState.CharLine << " InCharLineUp=" << VideoState.InCharLineUp << "\n"; */
   if (VideoState.IsTeletext) {
-    static int DoCA1Int=0;
-    if (DoCA1Int) {
+    if (Mode7DoCA1Int) {
       SysVIATriggerCA1Int(0);
-      DoCA1Int=0;
+      Mode7DoCA1Int=0;
     }; 
 
     /* Clear the next 20 scan lines */
-    if (!FrameNum) {
-      if (VScreenAdjust>0 && VideoState.PixmapLine==0)
-        for (l=-VScreenAdjust; l<0; ++l)
-//->          mainWin->doHorizLine(0, l, -36, 800);
+    if (VScreenAdjust>0 && VideoState.PixmapLine==0)
+      for (l=-VScreenAdjust; l<0; ++l)
+//->        mainWin->doHorizLine(0, l, -36, 800);
 //++
 		mainWin->doHorizLine(0, l, -72, 800);
 //+<
-      for (l=0; l<20 && VideoState.PixmapLine+l<512; ++l)
-//--        mainWin->doHorizLine(0, VideoState.PixmapLine+l, -36, 800);
+    for (l=0; l<20 && VideoState.PixmapLine+l<512; ++l)
+//--      mainWin->doHorizLine(0, VideoState.PixmapLine+l, -36, 800);
 //++
 	  	mainWin->doHorizLine(0, VideoState.PixmapLine+l, -72, 800);
 //+<
-    }
 
     if ((VideoState.CharLine!=-1) && (VideoState.CharLine<CRTC_VerticalDisplayed)) {
       ova=VideoState.Addr; ovn=CRTC_HorizontalDisplayed;
       VideoState.DataPtr=BeebMemPtrWithWrapMo7(VideoState.Addr,CRTC_HorizontalDisplayed);
       VideoState.Addr+=CRTC_HorizontalDisplayed;
-      if (!FrameNum) DoMode7Row();
+      DoMode7Row();
       VideoState.PixmapLine+=20;
     };
 
@@ -1165,22 +1377,20 @@ void VideoDoScanLine(void) {
       // Changed so that whole screen is still visible after *TV255
       VScreenAdjust=-100+(((CRTC_VerticalTotal+1)-(CRTC_VerticalSyncPos-1))*(20/TeletextStyle));
       AdjustVideo();
-      if (!FrameNum) {
-        VideoAddCursor();
-        VideoAddLEDs();
-        // Clear rest of screen below virtical total
-        for (l=VideoState.PixmapLine; l<500/TeletextStyle; ++l)
-//--          mainWin->doHorizLine(0, l, -36, 800);
+      VideoAddCursor();
+      VideoAddLEDs();
+      // Clear rest of screen below virtical total
+      for (l=VideoState.PixmapLine; l<500/TeletextStyle; ++l)
+//--        mainWin->doHorizLine(0, l, -36, 800);
 //++
 		mainWin->doHorizLine(0, l, -72, 800);
 //<+
-        mainWin->updateLines(0,(500/TeletextStyle));
-      }
+      mainWin->updateLines(0,(500/TeletextStyle));
       VideoStartOfFrame();
       VideoState.PreviousLastPixmapLine=VideoState.PixmapLine;
       VideoState.PixmapLine=0;
       SysVIATriggerCA1Int(1);
-      DoCA1Int=1;
+      Mode7DoCA1Int=1;
     }else {
       if (VideoState.CharLine!=-1)  {
         IncTrigger((CRTC_HorizontalTotal+1)*((VideoULA_ControlReg & 16)?1:2)*((VideoState.CharLine==1)?9:10),VideoTriggerCount);
@@ -1192,8 +1402,10 @@ void VideoDoScanLine(void) {
     /* Non teletext. */
 
     /* Clear the scan line */
-    if (!FrameNum)
-    memset(mainWin->GetLinePtr(VideoState.PixmapLine),0,800);
+    if (VideoOutputXRGB)
+      memset(mainWin->GetLinePtr32(VideoState.PixmapLine),0,800*sizeof(Uint32));
+    else
+      memset(mainWin->GetLinePtr(VideoState.PixmapLine),0,800);
 
     if (VideoState.CharLine!=-1) {
       if (VideoState.CharLine<CRTC_VerticalDisplayed) {
@@ -1211,8 +1423,7 @@ void VideoDoScanLine(void) {
         };
   
         if ((VideoState.InCharLineUp<8) && ((CRTC_InterlaceAndDelay & 0x30)!=48)) {
-          if (!FrameNum)
-            LowLevelDoScanLine();
+          LowLevelDoScanLine();
         }
         VideoState.PixmapLine++;
       }
@@ -1273,15 +1484,13 @@ void VideoDoScanLine(void) {
 
     if (VideoState.CharLine>CRTC_VerticalTotal) {
       VScreenAdjust=0;
-      if (!FrameNum) {
-        VideoAddCursor();
-        VideoAddLEDs();
-		CurY=-1;
-        int n = VideoState.PreviousLastPixmapLine-VideoState.PreviousFirstPixmapLine+1;
-        if (n > MAX_VIDEO_SCAN_LINES)
-          n = MAX_VIDEO_SCAN_LINES;
-        mainWin->updateLines(VideoState.PreviousFirstPixmapLine, n);
-      }
+      VideoAddCursor();
+      VideoAddLEDs();
+      CurY=-1;
+      int n = VideoState.PreviousLastPixmapLine-VideoState.PreviousFirstPixmapLine+1;
+      if (n > MAX_VIDEO_SCAN_LINES)
+        n = MAX_VIDEO_SCAN_LINES;
+      mainWin->updateLines(VideoState.PreviousFirstPixmapLine, n);
       VideoStartOfFrame();
       AdjustVideo();
     } else {
@@ -1293,6 +1502,7 @@ void VideoDoScanLine(void) {
 
 /*-------------------------------------------------------------------------------------------------------------*/
 void AdjustVideo() {
+	if (mainWin) set_screen_width();
 	ActualScreenWidth=CRTC_HorizontalDisplayed*HSyncModifier;
 	if (ActualScreenWidth>800) ActualScreenWidth=800;
 	if (ActualScreenWidth<640) ActualScreenWidth=640;
@@ -1313,12 +1523,17 @@ void AdjustVideo() {
 /*-------------------------------------------------------------------------------------------------------------*/
 void VideoInit(void) {
 //  char *environptr;
+  int row;
+
   VideoStartOfFrame();
   ova=0x3000; ovn=640;
   VideoState.DataPtr=BeebMemPtrWithWrap(0x3000,640);
   SetTrigger(99,VideoTriggerCount); /* Give time for OS to set mode up before doing anything silly */
   FastTable_Valid=0;
   BuildMode7Font();
+  ResetMode7Atlas();
+  for(row=0;row<MODE7_CACHE_ROWS;row++) Mode7RowCache[row].Valid=0;
+  SelectScanLineExpander(cfg_ScanLineKernel);
 
 //--#ifndef WIN32
 //--  environptr=getenv("BeebVideoRefreshFreq");
@@ -54,6 +54,7 @@ extern unsigned char CRTC_LightPenHigh;        /* R16 */
 extern unsigned char CRTC_LightPenLow;         /* R17 */
 extern unsigned int ActualScreenWidth;
 extern long ScreenAdjust;
+extern int FastTable_Valid;
 
 void RedoMPTR(void);
 void CRTCWrite(int Address, int Value);
@@ -78,4 +79,7 @@ void SaveVideoUEF(FILE *SUEF);
 void LoadVideoUEF(FILE *SUEF);
 extern char TeletextStyle;
 extern int THalfMode;
+
+/* Logs the mode 7 row cache hit rate since the previous call */
+void ReportMode7RowCacheStatistics(void);
 #endif
@@ -21,6 +21,20 @@ int MessageBox(HWND hwnd, const char *message_p, const char *title_p, int type)
 
 	tmp_hwnd = hwnd;
 
+#ifdef BEEBEM_HEADLESS
+	/* Nobody to press a button, so log it and take the first one (or
+	 * Cancel rather than retrying forever).
+	 */
+	pWARN(dL"%s: %s", dR, title_p, message_p);
+	switch (type & 0xf){
+	case MB_ABORTRETRYIGNORE:	return IDABORT;
+	case MB_YESNOCANCEL:
+	case MB_YESNO:			return IDYES;
+	case MB_RETRYCANCEL:		return IDCANCEL;
+	default:			return IDOK;
+	}
+#endif
+
 	// [TODO] Add support for default button, BeebEm doesn't use it anyway.
 	selected = 1;
 
@@ -3007,6 +3007,144 @@ simz80(FASTREG PC)
     return (PC&0xffff)|0x10000;	/* flag non-bios stop */
 }
 
+/* Lazy flags.
+
+   simz80_lazy() runs the 8-bit ADD, SUB, AND, XOR, OR and CP
+   instructions itself without working out F, it just keeps the
+   operands and result.  F is only built when an instruction that
+   reads or partly updates the flags comes along (or the debugger
+   looks at AF), which in CP/M code is a small fraction of the ALU
+   operations.  Everything else goes through simz80() as before.
+   Selected with cfg_Z80LazyFlags. */
+
+#define FLAGS_NEUTRAL	0		/* doesn't touch F */
+#define FLAGS_LAZY	1		/* sets all of F from its operands */
+#define FLAGS_USED	2		/* reads F, or only sets some of it */
+
+#define LAZY_NONE	(-1)		/* F in af[af_sel] is up to date */
+
+static unsigned char flag_use[256];
+static int lazy_op = LAZY_NONE;		/* ALU operation, bits 3-5 of the opcode */
+static FASTWORK lazy_acu, lazy_temp, lazy_sum;
+
+void z80_reset_lazy_flags(void)
+{
+    static const unsigned char neutral[] = {
+	0x00, 0x01, 0x02, 0x03, 0x06, 0x0A, 0x0B, 0x0E,
+	0x10, 0x11, 0x12, 0x13, 0x16, 0x18, 0x1A, 0x1B, 0x1E,
+	0x21, 0x22, 0x23, 0x26, 0x2A, 0x2B, 0x2E,
+	0x31, 0x32, 0x33, 0x36, 0x3A, 0x3B, 0x3E,
+	0xC1, 0xC3, 0xC5, 0xC7, 0xC9, 0xCD, 0xCF,
+	0xD1, 0xD3, 0xD5, 0xD7, 0xD9, 0xDB, 0xDF,
+	0xE1, 0xE3, 0xE5, 0xE7, 0xE9, 0xEB, 0xEF,
+	0xF3, 0xF7, 0xF9, 0xFB, 0xFF
+    };
+    static const unsigned char lazy[] = {
+	0xC6, 0xD6, 0xE6, 0xEE, 0xF6, 0xFE
+    };
+    unsigned int i;
+
+    for (i = 0; i < 256; i++)
+	flag_use[i] = FLAGS_USED;
+    for (i = 0; i < sizeof(neutral); i++)
+	flag_use[neutral[i]] = FLAGS_NEUTRAL;
+    for (i = 0x40; i < 0x80; i++)		/* LD r,r' and HALT */
+	flag_use[i] = FLAGS_NEUTRAL;
+    for (i = 0x80; i < 0xC0; i++)		/* but ADC and SBC read the carry */
+	if ((i & 0xe8) != 0x88)
+	    flag_use[i] = FLAGS_LAZY;
+    for (i = 0; i < sizeof(lazy); i++)
+	flag_use[lazy[i]] = FLAGS_LAZY;
+
+    lazy_op = LAZY_NONE;
+}
+
+/* Build F from the last lazy ALU operation, the same way simz80() does */
+void z80_materialise_flags(void)
+{
+    FASTWORK sum = lazy_sum, cbits = lazy_acu ^ lazy_temp ^ lazy_sum;
+    FASTREG f;
+
+    if (lazy_op == LAZY_NONE)
+	return;
+
+    switch (lazy_op) {
+    case 0:			/* ADD */
+	f = (sum & 0xa8) | (((sum & 0xff) == 0) << 6) | (cbits & 0x10) |
+	    (((cbits >> 6) ^ (cbits >> 5)) & 4) | ((cbits >> 8) & 1);
+	break;
+    case 2:			/* SUB */
+	f = (sum & 0xa8) | (((sum & 0xff) == 0) << 6) | (cbits & 0x10) |
+	    (((cbits >> 6) ^ (cbits >> 5)) & 4) | 2 | ((cbits >> 8) & 1);
+	break;
+    case 4:			/* AND */
+	f = (sum & 0xa8) | ((sum == 0) << 6) | 0x10 | partab[sum];
+	break;
+    case 5:			/* XOR */
+    case 6:			/* OR */
+	f = (sum & 0xa8) | ((sum == 0) << 6) | partab[sum];
+	break;
+    default:			/* CP */
+	f = (sum & 0x80) | (((sum & 0xff) == 0) << 6) | (lazy_temp & 0x28) |
+	    (((cbits >> 6) ^ (cbits >> 5)) & 4) | 2 |
+	    (cbits & 0x10) | ((cbits >> 8) & 1);
+	break;
+    }
+
+    af[af_sel] = (af[af_sel] & 0xff00) | f;
+    lazy_op = LAZY_NONE;
+}
+
+FASTWORK
+simz80_lazy(FASTREG PC)
+{
+    FASTREG AF, HL;
+    FASTWORK op, temp, acu, sum;
+
+    op = GetBYTE(PC);
+    if (flag_use[op] != FLAGS_LAZY) {
+	if (flag_use[op] == FLAGS_USED)
+	    z80_materialise_flags();
+	return simz80(PC);
+    }
+
+    PC++;
+    AF = af[af_sel];
+    if (op >= 0xc0)
+	temp = GetBYTE_pp(PC);
+    else {
+	switch (op & 7) {
+	case 0: temp = hreg(regs[regs_sel].bc); break;
+	case 1: temp = lreg(regs[regs_sel].bc); break;
+	case 2: temp = hreg(regs[regs_sel].de); break;
+	case 3: temp = lreg(regs[regs_sel].de); break;
+	case 4: temp = hreg(regs[regs_sel].hl); break;
+	case 5: temp = lreg(regs[regs_sel].hl); break;
+	case 6: HL = regs[regs_sel].hl; temp = GetBYTE(HL); break;
+	default: temp = hreg(AF); break;
+	}
+    }
+
+    acu = hreg(AF);
+    lazy_op = (op >> 3) & 7;
+    switch (lazy_op) {
+    case 0: sum = acu + temp; break;
+    case 4: sum = acu & temp; break;
+    case 5: sum = acu ^ temp; break;
+    case 6: sum = acu | temp; break;
+    default: sum = acu - temp; break;	/* SUB and CP */
+    }
+    lazy_acu = acu;
+    lazy_temp = temp;
+    lazy_sum = sum;
+
+    if (lazy_op != 7)
+	Sethreg(AF, sum);
+    af[af_sel] = AF;
+
+    return (PC&0xffff)|0x10000;
+}
+
 extern int inROM;
 
 void z80_NMI_Interrupt(void)
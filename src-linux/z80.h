@@ -53,6 +53,9 @@ extern volatile int stopsim;
 #endif
 
 extern FASTWORK simz80(FASTREG PC);
+extern FASTWORK simz80_lazy(FASTREG PC);
+void z80_reset_lazy_flags(void);
+void z80_materialise_flags(void);
 
 #define FLAG_C	1
 #define FLAG_N	2
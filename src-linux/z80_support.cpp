@@ -12,6 +12,7 @@
 #include "beebmem.h"
 
 #include "tube.h"
+#include "sdl.h"
 
 extern int trace;
 
@@ -83,6 +84,7 @@ AF'0000 MZ5H3VNC BC'0000 DE'0000 HL'0000 IY=0000 R=00 SP=0000:00,00,00,00
 void Disp_RegSet1(char *str)
 
 {
+	z80_materialise_flags();
 	sprintf(str, "AF=%04X ",af[0]);
 	sprintf(str + strlen(str), (af[0] & 128) ? "M" : "P");
 	sprintf(str + strlen(str), (af[0] & 64) ? "Z" : ".");
@@ -100,6 +102,7 @@ void Disp_RegSet1(char *str)
 void Disp_RegSet2(char *str)
 
 {
+	z80_materialise_flags();
 	sprintf(str, "AF'%04X ",af[1]);
 	sprintf(str + strlen(str), (af[1] & 128) ? "M" : "P");
 	sprintf(str + strlen(str), (af[1] & 64) ? "Z" : ".");
@@ -228,7 +231,10 @@ void z80_execute()
 //--		if (DebugEnabled)
 //--			DebugDisassembler(pc, 0, 0, 0, 0, 0, false);
 		
-		pc = simz80(pc);
+		if (cfg_Z80LazyFlags)
+			pc = simz80_lazy(pc);
+		else
+			pc = simz80(pc);
 
 		if (AcornZ80)
 		{
@@ -295,6 +301,7 @@ FILE *f;
     af[0]=0; regs[0].bc=0; regs[0].de=0; regs[0].hl=0;
     af[1]=0; regs[1].bc=0; regs[1].de=0; regs[1].hl=0;
     ix=0; iy=0; ir=0; regs_sel = 0;
+    z80_reset_lazy_flags();
 
 }
 
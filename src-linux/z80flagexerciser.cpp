@@ -0,0 +1,253 @@
+/* Flag exerciser for the lazy flags Z80 core (simz80_lazy in z80.cpp).
+ *
+ * In the spirit of ZEXDOC, but comparing the two cores with each other
+ * rather than against CRCs from real hardware.  Every ALU opcode that
+ * simz80_lazy() handles itself (ADD, SUB, AND, XOR, OR and CP on each
+ * register, (HL) and immediate) is run for every accumulator and operand
+ * value.  Each run is followed by LD B,C (which leaves F alone) and then
+ * by each instruction in a list that reads or partly updates the flags.
+ * The same three instructions are run through simz80() from the same
+ * state, and after z80_materialise_flags() the registers and memory must
+ * be the same.  The flags going in also change from run to run, so every
+ * F value is seen with every opcode.
+ *
+ *   make z80-flag-exerciser && ./z80-flag-exerciser
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "z80mem.h"
+#include "z80.h"
+
+#define EXERCISER_CODE		0x0100	/* Where the instructions go */
+#define EXERCISER_DATA		0x4000	/* What HL points at */
+#define EXERCISER_STACK		0x8000
+
+/* Instructions that read F or only set some of it, as run after the ALU
+ * operation.  Jumps go to addresses that are plain memory, so whether or
+ * not they're taken shows up in PC.
+ */
+struct FlagUser {
+	const char *Name;
+	unsigned char Bytes[3];
+	int Length;
+};
+
+static const FlagUser FlagUsers[] = {
+	{ "PUSH AF",    { 0xF5 },             1 },
+	{ "DAA",        { 0x27 },             1 },
+	{ "CCF",        { 0x3F },             1 },
+	{ "SCF",        { 0x37 },             1 },
+	{ "RLA",        { 0x17 },             1 },
+	{ "RRA",        { 0x1F },             1 },
+	{ "INC A",      { 0x3C },             1 },
+	{ "DEC B",      { 0x05 },             1 },
+	{ "ADD HL,BC",  { 0x09 },             1 },
+	{ "ADC A,B",    { 0x88 },             1 },
+	{ "SBC A,B",    { 0x98 },             1 },
+	{ "ADC A,n",    { 0xCE, 0x5A },       2 },
+	{ "SBC A,n",    { 0xDE, 0xA5 },       2 },
+	{ "JP NZ,nn",   { 0xC2, 0x00, 0x20 }, 3 },
+	{ "JP Z,nn",    { 0xCA, 0x00, 0x20 }, 3 },
+	{ "JP NC,nn",   { 0xD2, 0x00, 0x20 }, 3 },
+	{ "JP C,nn",    { 0xDA, 0x00, 0x20 }, 3 },
+	{ "JP PO,nn",   { 0xE2, 0x00, 0x20 }, 3 },
+	{ "JP PE,nn",   { 0xEA, 0x00, 0x20 }, 3 },
+	{ "JP P,nn",    { 0xF2, 0x00, 0x20 }, 3 },
+	{ "JP M,nn",    { 0xFA, 0x00, 0x20 }, 3 },
+	{ "JR NZ,e",    { 0x20, 0x10 },       2 },
+	{ "JR C,e",     { 0x38, 0x10 },       2 },
+	{ "RET Z",      { 0xC8 },             1 },
+	{ "RET NC",     { 0xD0 },             1 },
+	{ "RLC A",      { 0xCB, 0x07 },       2 },
+	{ "BIT 3,B",    { 0xCB, 0x58 },       2 },
+	{ "NEG",        { 0xED, 0x44 },       2 },
+	{ "SBC HL,BC",  { 0xED, 0x42 },       2 },
+	{ "LDI",        { 0xED, 0xA0 },       2 },
+};
+
+#define FLAG_USERS	((int) (sizeof(FlagUsers) / sizeof(FlagUsers[0])))
+
+static unsigned char Memory[0x10000];
+int inROM;
+
+unsigned char ReadZ80Mem(int pc)
+{
+	return Memory[pc & 0xffff];
+}
+
+void WriteZ80Mem(int pc, unsigned char data)
+{
+	Memory[pc & 0xffff] = data;
+}
+
+int in(unsigned int port)
+{
+	return 0xff;
+}
+
+void out(unsigned int port, unsigned char value)
+{
+}
+
+struct Z80State {
+	WORD af, bc, de, hl, sp, pc;
+	unsigned char Stack[4];
+	unsigned char Data[2];
+};
+
+static double MicroSeconds(void)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+static void SetState(int A, int F, int B, int C)
+{
+	af_sel = 0;
+	regs_sel = 0;
+	af[0] = (WORD) ((A << 8) | F);
+	regs[0].bc = (WORD) ((B << 8) | C);
+	regs[0].de = 0x1357;
+	regs[0].hl = EXERCISER_DATA;
+	sp = EXERCISER_STACK - 2;
+	pc = EXERCISER_CODE;
+}
+
+static void GetState(Z80State *State)
+{
+	State->af = af[0];
+	State->bc = regs[0].bc;
+	State->de = regs[0].de;
+	State->hl = regs[0].hl;
+	State->sp = sp;
+	State->pc = pc;
+	memcpy(State->Stack, Memory + EXERCISER_STACK - 4, sizeof(State->Stack));
+	memcpy(State->Data, Memory + EXERCISER_DATA, sizeof(State->Data));
+}
+
+/* Run the three instructions at EXERCISER_CODE on one of the cores.
+ */
+static void Run(int Lazy, Z80State *State, int A, int F, int Operand)
+{
+	int i;
+
+	// The operand is in B, C and (HL), so it's there whichever is used
+	SetState(A, F, Operand, Operand);
+	Memory[EXERCISER_DATA] = (unsigned char) Operand;
+	Memory[EXERCISER_DATA + 1] = 0;
+	Memory[EXERCISER_STACK - 2] = 0x34;
+	Memory[EXERCISER_STACK - 1] = 0x12;
+	Memory[EXERCISER_STACK - 3] = Memory[EXERCISER_STACK - 4] = 0;
+
+	for (i = 0; i < 3; i++)
+		pc = Lazy ? simz80_lazy(pc) : simz80(pc);
+	if (Lazy)
+		z80_materialise_flags();
+
+	GetState(State);
+}
+
+static void PrintState(const char *Core, const Z80State *State)
+{
+	printf("  %-6s AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X PC=%04X"
+	 " stack=%02X%02X%02X%02X (HL)=%02X\n", Core
+	 , State->af, State->bc, State->de, State->hl, State->sp, State->pc
+	 , State->Stack[0], State->Stack[1], State->Stack[2], State->Stack[3]
+	 , State->Data[0]);
+}
+
+/* Time a run of ALU operations each followed by a conditional jump, the
+ * pattern lazy flags is meant for.
+ */
+static double TimeCore(int Lazy, int Loops)
+{
+	static const unsigned char Loop[] = {
+		0x80,			// ADD A,B
+		0xA9,			// XOR C
+		0xFE, 0x40,		// CP 40H
+		0x91,			// SUB C
+		0xB0,			// OR B
+		0xE6, 0x7F,		// AND 7FH
+		0xC2, 0x00, 0x01	// JP NZ,0100H
+	};
+	double start;
+	int n, i;
+
+	memcpy(Memory + EXERCISER_CODE, Loop, sizeof(Loop));
+	SetState(1, 0, 3, 5);
+
+	start = MicroSeconds();
+	for (n = 0; n < Loops; n++)
+		for (i = 0; i < 7; i++)
+			pc = Lazy ? simz80_lazy(pc) : simz80(pc);
+	if (Lazy)
+		z80_materialise_flags();
+
+	return (MicroSeconds() - start) * 1000.0 / (Loops * 7.0);
+}
+
+int main(int argc, char *argv[])
+{
+	Z80State Eager, Lazy;
+	int op, user, A, Operand, F = 0, len;
+	unsigned long runs = 0, failures = 0;
+
+	z80_reset_lazy_flags();
+
+	for (op = 0x80; op <= 0xFE; op++) {
+		// ADC and SBC read the carry so they aren't done lazily
+		if (op < 0xC0 ? (op & 0xe8) == 0x88 : (op & 0xc7) != 0xc6 || op == 0xCE || op == 0xDE)
+			continue;
+
+		len = op >= 0xC0 ? 2 : 1;
+		for (user = 0; user < FLAG_USERS; user++) {
+			int opfailures = 0;
+
+			memset(Memory, 0, sizeof(Memory));
+			Memory[EXERCISER_CODE] = (unsigned char) op;
+			Memory[EXERCISER_CODE + len] = 0x41;	// LD B,C
+			memcpy(Memory + EXERCISER_CODE + len + 1, FlagUsers[user].Bytes
+			 , FlagUsers[user].Length);
+
+			for (A = 0; A < 256; A++) {
+				for (Operand = 0; Operand < 256; Operand++) {
+					if (len == 2)
+						Memory[EXERCISER_CODE + 1] = (unsigned char) Operand;
+
+					Run(0, &Eager, A, F, Operand);
+					Run(1, &Lazy, A, F, Operand);
+					runs++;
+
+					if (memcmp(&Eager, &Lazy, sizeof(Eager)) != 0) {
+						if (opfailures++ < 4) {
+							printf("%02X then %s: A=%02X F=%02X operand=%02X\n"
+							 , op, FlagUsers[user].Name, A, F, Operand);
+							PrintState("simz80", &Eager);
+							PrintState("lazy", &Lazy);
+						}
+						failures++;
+					}
+
+					F = (F + 1) & 0xff;
+				}
+			}
+		}
+	}
+
+	printf("%lu runs, %lu differences\n", runs, failures);
+
+	printf("ALU/jump loop: simz80 %.1f ns, simz80_lazy %.1f ns per instruction\n"
+	 , TimeCore(0, 2000000), TimeCore(1, 2000000));
+
+	return failures != 0;
+}